@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/esm/refid.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr std::size_t inputSize = 1024;
+    constexpr std::size_t dataSize = 16 * 1024;
+    constexpr int tilesPerRow = 1024;
+
+    // File based database to include cost of syncing on commit
+    struct TemporaryDbFile
+    {
+        std::filesystem::path mPath = std::filesystem::temp_directory_path() / "openmw_navmeshdb_benchmark.db";
+
+        TemporaryDbFile() { std::filesystem::remove(mPath); }
+
+        ~TemporaryDbFile() { std::filesystem::remove(mPath); }
+    };
+
+    // Navmesh tiles are reasonably compressible, use a small alphabet to get a similar ratio
+    std::vector<std::byte> generateData(std::size_t size, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<int> distribution(0, 15);
+        std::vector<std::byte> result(size);
+        std::generate(result.begin(), result.end(), [&] { return static_cast<std::byte>(distribution(random)); });
+        return result;
+    }
+
+    TilePosition makeTilePosition(std::size_t index)
+    {
+        return TilePosition(static_cast<int>(index % tilesPerRow), static_cast<int>(index / tilesPerRow));
+    }
+
+    void insertTiles(benchmark::State& state)
+    {
+        const std::size_t tilesPerTransaction = static_cast<std::size_t>(state.range(0));
+        const TemporaryDbFile file;
+        NavMeshDb db(file.mPath.string(), std::numeric_limits<std::uint64_t>::max());
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        std::minstd_rand random;
+        const std::vector<std::byte> data = generateData(dataSize, random);
+        std::vector<std::byte> input = generateData(inputSize, random);
+        std::optional<Sqlite3::Transaction> transaction;
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            if (tilesPerTransaction > 1 && !transaction.has_value())
+                transaction.emplace(db.startTransaction());
+            input[n % input.size()] = static_cast<std::byte>(n);
+            db.insertTile(TileId{ static_cast<std::int64_t>(n + 1) }, worldspace, makeTilePosition(n),
+                TileVersion{ 1 }, input, data);
+            ++n;
+            if (transaction.has_value() && n % tilesPerTransaction == 0)
+            {
+                transaction->commit();
+                transaction.reset();
+            }
+        }
+
+        if (transaction.has_value())
+            transaction->commit();
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(n));
+    }
+
+    void getTileData(benchmark::State& state)
+    {
+        const std::size_t tiles = static_cast<std::size_t>(state.range(0));
+        const TemporaryDbFile file;
+        NavMeshDb db(file.mPath.string(), std::numeric_limits<std::uint64_t>::max());
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        std::minstd_rand random;
+        const std::vector<std::byte> data = generateData(dataSize, random);
+        std::vector<std::vector<std::byte>> inputs;
+        inputs.reserve(tiles);
+
+        {
+            Sqlite3::Transaction transaction = db.startTransaction();
+            for (std::size_t i = 0; i < tiles; ++i)
+            {
+                inputs.push_back(generateData(inputSize, random));
+                db.insertTile(TileId{ static_cast<std::int64_t>(i + 1) }, worldspace, makeTilePosition(i),
+                    TileVersion{ 1 }, inputs.back(), data);
+            }
+            transaction.commit();
+        }
+
+        std::uniform_int_distribution<std::size_t> distribution(0, tiles - 1);
+
+        for (auto _ : state)
+        {
+            const std::size_t i = distribution(random);
+            benchmark::DoNotOptimize(db.getTileData(worldspace, makeTilePosition(i), inputs[i]));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK(insertTiles)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+BENCHMARK(getTileData)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
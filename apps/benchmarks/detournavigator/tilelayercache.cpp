@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/agentbounds.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/tilelayercache.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <osg/Math>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr std::size_t doorAngles = 16;
+
+    RecastSettings makeSettings()
+    {
+        RecastSettings result;
+        result.mBorderSize = 16;
+        result.mCellHeight = 0.2f;
+        result.mCellSize = 0.2f;
+        result.mDetailSampleDist = 6;
+        result.mDetailSampleMaxError = 1;
+        result.mMaxClimb = 34;
+        result.mMaxSimplificationError = 1.3f;
+        result.mMaxSlope = 49;
+        result.mRecastScaleFactor = 0.017647058823529415f;
+        result.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mMaxEdgeLen = 12;
+        result.mMaxVertsPerPoly = 6;
+        result.mRegionMergeArea = 400;
+        result.mRegionMinArea = 64;
+        result.mTileSize = 64;
+        return result;
+    }
+
+    // Tile with static boxes standing on the ground and a door rotated around its hinge by different angles
+    std::vector<std::shared_ptr<const RecastMesh>> makeRecastMeshes(
+        const RecastSettings& settings, const TilePosition& tilePosition)
+    {
+        const float tileSize = getTileSize(settings) / settings.mRecastScaleFactor;
+        const osg::Vec2f center = (osg::Vec2f(tilePosition.x(), tilePosition.y()) + osg::Vec2f(0.5f, 0.5f)) * tileSize;
+
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> position(-tileSize / 2, tileSize / 2);
+        std::uniform_real_distribution<float> extent(16, 64);
+        std::uniform_real_distribution<float> angle(0, osg::PIf);
+
+        std::vector<std::pair<std::unique_ptr<btBoxShape>, btTransform>> boxes;
+        for (int i = 0; i < 32; ++i)
+        {
+            const btVector3 halfExtents(extent(random), extent(random), extent(random));
+            const btVector3 origin(center.x() + position(random), center.y() + position(random), halfExtents.z());
+            const btQuaternion rotation(btVector3(0, 0, 1), angle(random));
+            boxes.emplace_back(std::make_unique<btBoxShape>(halfExtents), btTransform(rotation, origin));
+        }
+
+        const btBoxShape door(btVector3(64, 4, 96));
+
+        std::vector<std::shared_ptr<const RecastMesh>> result;
+        for (std::size_t i = 0; i < doorAngles; ++i)
+        {
+            RecastMeshBuilder builder(makeRealTileBoundsWithBorder(settings, tilePosition));
+            builder.addHeightfield(osg::Vec2i(0, 0), 8192, 0);
+            for (const auto& [shape, transform] : boxes)
+                builder.addObject(*shape, transform, AreaType_ground);
+            const btQuaternion rotation(btVector3(0, 0, 1), osg::PI_2f * static_cast<float>(i) / doorAngles);
+            const btVector3 hinge(center.x(), center.y(), 96);
+            builder.addObstacle(door, btTransform(rotation, hinge + quatRotate(rotation, btVector3(64, 0, 0))));
+            result.push_back(std::move(builder).create(Version{ .mGeneration = 1, .mRevision = i }));
+        }
+
+        return result;
+    }
+
+    void prepareNavMeshTileDataWithoutCache(benchmark::State& state)
+    {
+        const RecastSettings settings = makeSettings();
+        const TilePosition tilePosition(1, 1);
+        const AgentBounds agentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("worldspace");
+        const std::vector<std::shared_ptr<const RecastMesh>> recastMeshes = makeRecastMeshes(settings, tilePosition);
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(prepareNavMeshTileData(
+                *recastMeshes[n % recastMeshes.size()], worldspace, tilePosition, agentBounds, settings));
+            ++n;
+        }
+    }
+
+    void prepareNavMeshTileDataWithTileLayerCache(benchmark::State& state)
+    {
+        const RecastSettings settings = makeSettings();
+        const TilePosition tilePosition(1, 1);
+        const AgentBounds agentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("worldspace");
+        const std::vector<std::shared_ptr<const RecastMesh>> recastMeshes = makeRecastMeshes(settings, tilePosition);
+        TileLayerCache cache(16 * 1024 * 1024);
+        std::size_t n = 0;
+
+        prepareNavMeshTileData(recastMeshes.front(), worldspace, tilePosition, agentBounds, settings, cache);
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(prepareNavMeshTileData(
+                recastMeshes[n % recastMeshes.size()], worldspace, tilePosition, agentBounds, settings, cache));
+            ++n;
+        }
+    }
+
+    BENCHMARK(prepareNavMeshTileDataWithoutCache)->Unit(benchmark::kMillisecond);
+    BENCHMARK(prepareNavMeshTileDataWithTileLayerCache)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include "components/esm/defs.hpp"
+#include "components/esm3/compressedsavedgame.hpp"
+#include "components/esm3/esmreader.hpp"
+#include "components/esm3/esmwriter.hpp"
+#include "components/esm3/formatversion.hpp"
+#include "components/files/memorystream.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // Roughly the size of the cell states of a long playthrough
+    constexpr int cellsCount = 4096;
+    constexpr std::size_t cellStateSize = 8 * 1024;
+
+    template <class Random>
+    std::string generateCellState(Random& random)
+    {
+        // References of a cell state share a lot of bytes, make some repetitions to be similarly compressible
+        std::uniform_int_distribution<int> distribution('A', 'z');
+        std::string result;
+        result.reserve(cellStateSize);
+        while (result.size() < cellStateSize)
+        {
+            const std::string part(static_cast<std::size_t>(distribution(random) % 16 + 1), distribution(random));
+            result += part;
+            std::generate_n(std::back_inserter(result), 16, [&] { return static_cast<char>(distribution(random)); });
+        }
+        result.resize(cellStateSize);
+        return result;
+    }
+
+    const std::string& getRecords()
+    {
+        static const std::string records = [] {
+            std::minstd_rand random;
+            std::ostringstream stream;
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::CurrentSaveGameFormatVersion);
+            writer.save(stream);
+            writer.startRecord(ESM::REC_SAVE);
+            writer.writeHNString("PLNA", "player");
+            writer.endRecord(ESM::REC_SAVE);
+            for (int i = 0; i < cellsCount; ++i)
+            {
+                writer.startRecord(ESM::REC_CSTA);
+                writer.writeCellId(ESM::RefId::esm3ExteriorCell(i % 64, i / 64));
+                writer.writeHNString("DATA", generateCellState(random));
+                writer.endRecord(ESM::REC_CSTA);
+            }
+            writer.close();
+            return stream.str();
+        }();
+        return records;
+    }
+
+    const std::string& getCompressed()
+    {
+        static const std::string compressed = [] {
+            std::ostringstream stream;
+            ESM::writeCompressedSavedGame(getRecords(), stream, 1);
+            return stream.str();
+        }();
+        return compressed;
+    }
+
+    void writeCompressed(benchmark::State& state)
+    {
+        const std::string& records = getRecords();
+        for (auto _ : state)
+        {
+            std::ostringstream stream;
+            ESM::writeCompressedSavedGame(records, stream, static_cast<std::size_t>(state.range(0)));
+            benchmark::DoNotOptimize(stream);
+        }
+        state.SetBytesProcessed(state.iterations() * records.size());
+    }
+
+    void readCompressed(benchmark::State& state)
+    {
+        const std::string& compressed = getCompressed();
+        for (auto _ : state)
+        {
+            Files::IMemStream stream(compressed.data(), compressed.size());
+            ESM::CompressedSavedGameReader reader(stream);
+            benchmark::DoNotOptimize(reader.readAll(static_cast<std::size_t>(state.range(0))));
+        }
+        state.SetBytesProcessed(state.iterations() * getRecords().size());
+    }
+
+    void readCompressedProfile(benchmark::State& state)
+    {
+        const std::string& compressed = getCompressed();
+        for (auto _ : state)
+        {
+            Files::IMemStream stream(compressed.data(), compressed.size());
+            ESM::CompressedSavedGameReader reader(stream);
+            benchmark::DoNotOptimize(reader.readProfile());
+        }
+    }
+
+    // Baseline: plain saved game is copied into memory as is
+    void readPlain(benchmark::State& state)
+    {
+        const std::string& records = getRecords();
+        for (auto _ : state)
+        {
+            Files::IMemStream stream(records.data(), records.size());
+            std::string result(records.size(), '\0');
+            stream.read(result.data(), result.size());
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetBytesProcessed(state.iterations() * records.size());
+    }
+
+    void iterateRecords(benchmark::State& state)
+    {
+        const std::string& records = getRecords();
+        for (auto _ : state)
+        {
+            ESM::ESMReader reader;
+            reader.open(std::make_unique<Files::IMemStream>(records.data(), records.size()), "saved game");
+            std::size_t count = 0;
+            while (reader.hasMoreRecs())
+            {
+                reader.getRecName();
+                reader.getRecHeader();
+                reader.skipRecord();
+                ++count;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+    }
+}
+
+BENCHMARK(writeCompressed)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(readCompressed)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(readCompressedProfile)->Unit(benchmark::kMicrosecond);
+BENCHMARK(readPlain)->Unit(benchmark::kMillisecond);
+BENCHMARK(iterateRecords)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,224 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/exception.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/program.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Counts to 100 doing arithmetic on all kinds of locals
+    constexpr std::string_view loopScript = R"mwscript(
+begin loop
+short i
+long total
+float value
+set i to 0
+set total to 0
+while ( i < 100 )
+    set total to total + i * 2
+    set value to value + 0.5 * i
+    set i to i + 1
+endwhile
+end
+)mwscript";
+
+    // Typical local script executed every frame: a state machine with a few checks and assignments
+    constexpr std::string_view stateScript = R"mwscript(
+begin state
+short state
+short counter
+float timer
+if ( state == 0 )
+    set timer to timer + 0.016
+    if ( timer > 5 )
+        set state to 1
+        set timer to 0
+    endif
+elseif ( state == 1 )
+    set counter to counter + 1
+    if ( counter >= 10 )
+        set state to 2
+    endif
+elseif ( state == 2 )
+    set timer to timer + 0.016
+    if ( timer > 1 )
+        set state to 0
+        set counter to 0
+        set timer to 0
+    endif
+endif
+end
+)mwscript";
+
+    class CompilerContext : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+
+        char getGlobalType(const std::string& /*name*/) const override { return ' '; }
+
+        std::pair<char, bool> getMemberType(const std::string& /*name*/, const ESM::RefId& /*id*/) const override
+        {
+            return { ' ', false };
+        }
+
+        bool isId(const ESM::RefId& /*name*/) const override { return false; }
+    };
+
+    // Supports only locals, the benchmark measures the interpreter itself
+    class InterpreterContext : public Interpreter::Context
+    {
+    public:
+        ESM::RefId getTarget() const override { return ESM::RefId(); }
+
+        int getLocalShort(int index) const override { return mShorts[index]; }
+
+        int getLocalLong(int index) const override { return mLongs[index]; }
+
+        float getLocalFloat(int index) const override { return mFloats[index]; }
+
+        void setLocalShort(int index, int value) override { mShorts[index] = value; }
+
+        void setLocalLong(int index, int value) override { mLongs[index] = value; }
+
+        void setLocalFloat(int index, float value) override { mFloats[index] = value; }
+
+        void messageBox(std::string_view /*message*/, const std::vector<std::string>& /*buttons*/) override {}
+
+        void report(const std::string& /*message*/) override {}
+
+        int getGlobalShort(std::string_view /*name*/) const override { return 0; }
+
+        int getGlobalLong(std::string_view /*name*/) const override { return 0; }
+
+        float getGlobalFloat(std::string_view /*name*/) const override { return 0; }
+
+        void setGlobalShort(std::string_view /*name*/, int /*value*/) override {}
+
+        void setGlobalLong(std::string_view /*name*/, int /*value*/) override {}
+
+        void setGlobalFloat(std::string_view /*name*/, float /*value*/) override {}
+
+        std::vector<std::string> getGlobals() const override { return {}; }
+
+        char getGlobalType(std::string_view /*name*/) const override { return ' '; }
+
+        std::string getActionBinding(std::string_view /*action*/) const override { return {}; }
+
+        std::string_view getActorName() const override { return {}; }
+
+        std::string_view getNPCRace() const override { return {}; }
+
+        std::string_view getNPCClass() const override { return {}; }
+
+        std::string_view getNPCFaction() const override { return {}; }
+
+        std::string_view getNPCRank() const override { return {}; }
+
+        std::string_view getPCName() const override { return {}; }
+
+        std::string_view getPCRace() const override { return {}; }
+
+        std::string_view getPCClass() const override { return {}; }
+
+        std::string_view getPCRank() const override { return {}; }
+
+        std::string_view getPCNextRank() const override { return {}; }
+
+        int getPCBounty() const override { return 0; }
+
+        std::string_view getCurrentCellName() const override { return {}; }
+
+        int getMemberShort(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override { return 0; }
+
+        int getMemberLong(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override { return 0; }
+
+        float getMemberFloat(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override
+        {
+            return 0;
+        }
+
+        void setMemberShort(ESM::RefId /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override {}
+
+        void setMemberLong(ESM::RefId /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override {}
+
+        void setMemberFloat(ESM::RefId /*id*/, std::string_view /*name*/, float /*value*/, bool /*global*/) override
+        {
+        }
+
+    private:
+        std::vector<int> mShorts = std::vector<int>(16);
+        std::vector<int> mLongs = std::vector<int>(16);
+        std::vector<float> mFloats = std::vector<float>(16);
+    };
+
+    Interpreter::Program compile(std::string_view text)
+    {
+        CompilerContext context;
+        Compiler::Extensions extensions;
+        context.setExtensions(&extensions);
+        Compiler::StreamErrorHandler errorHandler;
+        Compiler::FileParser parser(errorHandler, context);
+        std::istringstream input{ std::string(text) };
+        Compiler::Scanner scanner(errorHandler, input, &extensions);
+        scanner.scan(parser);
+        if (!errorHandler.isGood())
+            throw std::runtime_error("Failed to compile benchmark script");
+        return parser.getProgram();
+    }
+
+    void runDecoded(benchmark::State& state, std::string_view text)
+    {
+        const Interpreter::Program program = compile(text);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const std::vector<Interpreter::Instruction> instructions = interpreter.decode(program);
+        InterpreterContext context;
+        for (auto _ : state)
+            interpreter.run(program, instructions, context);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Decodes the program on each run like for console commands and dialogue result scripts
+    void runNotDecoded(benchmark::State& state, std::string_view text)
+    {
+        const Interpreter::Program program = compile(text);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        InterpreterContext context;
+        for (auto _ : state)
+            interpreter.run(program, context);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void decode(benchmark::State& state, std::string_view text)
+    {
+        const Interpreter::Program program = compile(text);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(interpreter.decode(program));
+        state.SetItemsProcessed(state.iterations() * program.mInstructions.size());
+    }
+}
+
+BENCHMARK_CAPTURE(runDecoded, loop, loopScript);
+BENCHMARK_CAPTURE(runNotDecoded, loop, loopScript);
+BENCHMARK_CAPTURE(runDecoded, state, stateScript);
+BENCHMARK_CAPTURE(runNotDecoded, state, stateScript);
+BENCHMARK_CAPTURE(decode, loop, loopScript);
+BENCHMARK_CAPTURE(decode, state, stateScript);
+
+BENCHMARK_MAIN();
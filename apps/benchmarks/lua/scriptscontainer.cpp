@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/luascripts.hpp>
+#include <components/lua/configuration.hpp>
+#include <components/lua/luastate.hpp>
+#include <components/lua/scriptscontainer.hpp>
+#include <components/lua/serialization.hpp>
+#include <components/testing/util.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace TestingOpenMW;
+
+    constexpr VFS::Path::NormalizedView scriptPath("bench.lua");
+
+    // Number of different events each script handles
+    constexpr int eventsCount = 16;
+
+    std::string makeEventName(int index)
+    {
+        return "Event" + std::to_string(index);
+    }
+
+    std::string makeScript()
+    {
+        std::string result = "local counter = 0\nreturn {\n    eventHandlers = {\n";
+        for (int i = 0; i < eventsCount; ++i)
+            result += "        " + makeEventName(i) + " = function(data) counter = counter + 1 end,\n";
+        result += "    }\n}\n";
+        return result;
+    }
+
+    VFSTestFile script(makeScript());
+
+    struct Scripts
+    {
+        std::unique_ptr<VFS::Manager> mVFS = createTestVFS({ { scriptPath, &script } });
+        LuaUtil::ScriptsConfiguration mCfg;
+        std::unique_ptr<LuaUtil::LuaState> mLua;
+        std::vector<std::unique_ptr<LuaUtil::ScriptsContainer>> mContainers;
+
+        explicit Scripts(std::size_t count)
+        {
+            ESM::LuaScriptsCfg cfg;
+            LuaUtil::parseOMWScripts(cfg, "CUSTOM: bench.lua\n");
+            mCfg.init(std::move(cfg));
+            mLua = std::make_unique<LuaUtil::LuaState>(mVFS.get(), &mCfg);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mContainers.push_back(std::make_unique<LuaUtil::ScriptsContainer>(mLua.get(), "Bench"));
+                mContainers.back()->addCustomScript(0);
+            }
+        }
+
+        ~Scripts()
+        {
+            for (auto& container : mContainers)
+                container->removeAllScripts();
+        }
+    };
+
+    // Each frame M events are sent to N containers, like local events between scripted objects
+    void receiveEvent(benchmark::State& state)
+    {
+        Scripts scripts(static_cast<std::size_t>(state.range(0)));
+        const std::size_t eventsPerFrame = static_cast<std::size_t>(state.range(1));
+        std::vector<std::string> names;
+        for (int i = 0; i < eventsCount; ++i)
+            names.push_back(makeEventName(i));
+        names.push_back("Unhandled");
+        const std::string data = LuaUtil::serialize(sol::nil);
+        std::size_t event = 0;
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < eventsPerFrame; ++i, ++event)
+                scripts.mContainers[event % scripts.mContainers.size()]->receiveEvent(
+                    names[event % names.size()], data);
+        }
+        state.SetItemsProcessed(state.iterations() * eventsPerFrame);
+    }
+
+    // Each of N containers has M timers, only few of them expire in each frame
+    void processTimers(benchmark::State& state)
+    {
+        using TimerType = LuaUtil::ScriptsContainer::TimerType;
+        Scripts scripts(static_cast<std::size_t>(state.range(0)));
+        const int timersCount = static_cast<int>(state.range(1));
+        constexpr double frameDuration = 1.0 / 60;
+        constexpr double timersPeriod = 10;
+        double time = 0;
+        std::size_t calls = 0;
+        for (auto& container : scripts.mContainers)
+        {
+            LuaUtil::ScriptsContainer* const containerPtr = container.get();
+            sol::main_protected_function callback = sol::make_object(scripts.mLua->unsafeState(), [&, containerPtr] {
+                ++calls;
+                containerPtr->setupSerializableTimer(
+                    TimerType::SIMULATION_TIME, time + timersPeriod, 0, "Rearm", sol::main_object(sol::nil));
+            });
+            container->registerTimerCallback(0, "Rearm", callback);
+            for (int i = 0; i < timersCount; ++i)
+                container->setupSerializableTimer(
+                    TimerType::SIMULATION_TIME, timersPeriod * i / timersCount, 0, "Rearm", sol::main_object(sol::nil));
+        }
+        for (auto _ : state)
+        {
+            time += frameDuration;
+            for (auto& container : scripts.mContainers)
+                container->processTimers(time, time);
+        }
+        state.SetItemsProcessed(state.iterations() * scripts.mContainers.size());
+        state.counters["calls"] = benchmark::Counter(static_cast<double>(calls), benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(receiveEvent)->Args({ 100, 100 })->Args({ 1000, 1000 })->Args({ 1000, 10000 });
+BENCHMARK(processTimers)->Args({ 100, 1 })->Args({ 1000, 1 })->Args({ 1000, 10 })->Args({ 100, 1000 });
+
+BENCHMARK_MAIN();
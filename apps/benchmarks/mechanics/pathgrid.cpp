@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+#include <components/esm3/loadpgrd.hpp>
+
+#include <cstddef>
+#include <random>
+
+namespace
+{
+    constexpr int sPointsDistance = 300;
+
+    // Grid shaped pathgrid similar to autogenerated ones with some missing connections
+    ESM::Pathgrid generatePathgrid(int size, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> jitter(-sPointsDistance / 10, sPointsDistance / 10);
+        std::uniform_int_distribution<int> dropEdge(0, 9);
+
+        ESM::Pathgrid result;
+        result.blank();
+        result.mPoints.reserve(static_cast<std::size_t>(size * size));
+        for (int y = 0; y < size; ++y)
+            for (int x = 0; x < size; ++x)
+                result.mPoints.emplace_back(
+                    x * sPointsDistance + jitter(random), y * sPointsDistance + jitter(random), jitter(random));
+
+        const auto addEdge = [&](std::size_t v0, std::size_t v1) {
+            if (dropEdge(random) == 0)
+                return;
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ v0, v1 });
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ v1, v0 });
+        };
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const std::size_t index = static_cast<std::size_t>(y * size + x);
+                if (x + 1 < size)
+                    addEdge(index, index + 1);
+                if (y + 1 < size)
+                    addEdge(index, index + static_cast<std::size_t>(size));
+            }
+        }
+
+        return result;
+    }
+
+    void aStarSearchCornerToCorner(benchmark::State& state)
+    {
+        std::mt19937 random;
+        const int size = static_cast<int>(state.range(0));
+        const ESM::Pathgrid pathgrid = generatePathgrid(size, random);
+        const MWMechanics::PathgridGraph graph(pathgrid);
+        std::size_t goal = pathgrid.mPoints.size() - 1;
+        while (goal > 0 && !graph.isPointConnected(0, goal))
+            --goal;
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(graph.aStarSearch(0, goal));
+    }
+
+    void aStarSearchRandomPoints(benchmark::State& state)
+    {
+        std::mt19937 random;
+        const int size = static_cast<int>(state.range(0));
+        const ESM::Pathgrid pathgrid = generatePathgrid(size, random);
+        const MWMechanics::PathgridGraph graph(pathgrid);
+        std::uniform_int_distribution<std::size_t> point(0, pathgrid.mPoints.size() - 1);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(graph.aStarSearch(point(random), point(random)));
+    }
+
+    void buildPathgridGraph(benchmark::State& state)
+    {
+        std::mt19937 random;
+        const ESM::Pathgrid pathgrid = generatePathgrid(static_cast<int>(state.range(0)), random);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(MWMechanics::PathgridGraph(pathgrid));
+    }
+}
+
+BENCHMARK(aStarSearchCornerToCorner)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(aStarSearchRandomPoints)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(buildPathgridGraph)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,422 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwphysics/collisiontype.hpp"
+#include "apps/openmw/mwphysics/contacttestwrapper.h"
+#include "apps/openmw/mwphysics/heightfield.hpp"
+#include "apps/openmw/mwphysics/movementsolver.hpp"
+#include "apps/openmw/mwphysics/mtphysics.hpp"
+#include "apps/openmw/mwphysics/physicssystem.hpp"
+
+#include <components/misc/constants.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/hash.hpp>
+#include <components/misc/strings/conversion.hpp>
+#include <components/settings/parser.hpp>
+#include <components/settings/settings.hpp>
+#include <components/settings/values.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+#include <LinearMath/btThreads.h>
+
+#include <osg/Math>
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Replays seeded actor inputs over a synthetic exterior to measure the cost of a physics simulation step.
+//
+// This is not a full PhysicsSystem::applyQueuedMovements run. The step below reproduces what PhysicsTaskScheduler
+// does for one simulation step: serial unstuck, moves spread over the configured number of async physics threads
+// ([Physics] async num threads, clamped the same way as the scheduler does) and serial position and AABB updates.
+// What is not covered:
+// - MWPhysics::Actor and PhysicsSystem need MWWorld::Ptr backed objects and a running MWBase::World, so the
+//   scheduler itself, its locking policies, step count calculation, interpolation and main thread sync are not
+//   measured;
+// - line of sight cache refresh and projectiles are not simulated;
+// - statics are synthetic shapes built like Resource::BulletShapeManager output, not shapes loaded by it from
+//   game data.
+// Changes to those parts have to be measured in game with the physics profiler overlay.
+namespace
+{
+    using namespace MWPhysics;
+
+    constexpr int sCellSize = Constants::CellSizeInUnits;
+    constexpr int sLandVerts = 65;
+    constexpr int sCellsPerSide = 2;
+    constexpr float sPhysicsDt = 1.f / 60.f;
+    constexpr float sWaterLevel = -1000.f;
+    // Number of steps each recorded input is held for
+    constexpr std::size_t sInputPeriod = 30;
+    constexpr std::size_t sInputsPerActor = 16;
+    constexpr std::size_t sSteps = 600;
+    const osg::Vec3f sActorHalfExtents(29.27f, 28.48f, 66.5f);
+
+    float getTerrainHeight(float x, float y)
+    {
+        return 256.f * std::sin(x * 0.0011f) * std::cos(y * 0.0007f) + 64.f * std::sin(x * 0.013f + y * 0.009f);
+    }
+
+    struct Input
+    {
+        osg::Vec3f mMovement;
+        float mYaw;
+    };
+
+    struct ReplayActor
+    {
+        std::unique_ptr<btBoxShape> mShape;
+        std::unique_ptr<btCollisionObject> mCollisionObject;
+        ActorFrameData mFrameData;
+        std::vector<Input> mInputs;
+    };
+
+    class ContactCounter final : public btCollisionWorld::ContactResultCallback
+    {
+    public:
+        explicit ContactCounter(const btCollisionObject& object)
+        {
+            m_collisionFilterGroup = object.getBroadphaseHandle()->m_collisionFilterGroup;
+            m_collisionFilterMask = object.getBroadphaseHandle()->m_collisionFilterMask;
+        }
+
+        btScalar addSingleResult(btManifoldPoint& /*contact*/, const btCollisionObjectWrapper* /*colObj0Wrap*/,
+            int /*partId0*/, int /*index0*/, const btCollisionObjectWrapper* /*colObj1Wrap*/, int /*partId1*/,
+            int /*index1*/) override
+        {
+            ++mCount;
+            return 0;
+        }
+
+        std::size_t mCount = 0;
+    };
+
+    // Mirrors the collision world setup of MWPhysics::PhysicsSystem without depending on MWWorld::Ptr
+    struct Scene
+    {
+        btDefaultCollisionConfiguration mCollisionConfiguration;
+        btCollisionDispatcher mDispatcher{ &mCollisionConfiguration };
+        btDbvtBroadphase mBroadphase;
+        btCollisionWorld mCollisionWorld{ &mDispatcher, &mBroadphase, &mCollisionConfiguration };
+        PhysicsTaskScheduler mTaskScheduler{ sPhysicsDt, &mCollisionWorld, nullptr };
+        std::vector<std::vector<float>> mHeights;
+        std::vector<std::unique_ptr<HeightField>> mHeightFields;
+        std::vector<std::unique_ptr<btTriangleMesh>> mMeshes;
+        std::vector<std::unique_ptr<btCollisionShape>> mShapes;
+        std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+        std::vector<ReplayActor> mActors;
+
+        Scene() { mCollisionWorld.setForceUpdateAllAabbs(false); }
+
+        ~Scene()
+        {
+            for (const ReplayActor& actor : mActors)
+                mTaskScheduler.removeCollisionObject(actor.mCollisionObject.get());
+            for (const auto& object : mObjects)
+                mTaskScheduler.removeCollisionObject(object.get());
+        }
+    };
+
+    void addHeightFields(Scene& scene)
+    {
+        for (int cellX = 0; cellX < sCellsPerSide; ++cellX)
+        {
+            for (int cellY = 0; cellY < sCellsPerSide; ++cellY)
+            {
+                std::vector<float>& heights = scene.mHeights.emplace_back(sLandVerts * sLandVerts);
+                const float step = static_cast<float>(sCellSize) / (sLandVerts - 1);
+                for (int row = 0; row < sLandVerts; ++row)
+                    for (int col = 0; col < sLandVerts; ++col)
+                        heights[row * sLandVerts + col]
+                            = getTerrainHeight(cellX * sCellSize + col * step, cellY * sCellSize + row * step);
+                const auto [minH, maxH] = std::minmax_element(heights.begin(), heights.end());
+                scene.mHeightFields.push_back(std::make_unique<HeightField>(heights.data(), cellX, cellY,
+                    sCellSize, sLandVerts, *minH, *maxH, nullptr, &scene.mTaskScheduler));
+            }
+        }
+    }
+
+    // Collision shapes produced by Resource::BulletShapeManager for NIF meshes are compounds of triangle meshes
+    std::unique_ptr<btCollisionShape> makeRockShape(Scene& scene, float radius, float height)
+    {
+        auto& mesh = scene.mMeshes.emplace_back(std::make_unique<btTriangleMesh>());
+        constexpr int segments = 8;
+        const btVector3 top(0, 0, height);
+        for (int i = 0; i < segments; ++i)
+        {
+            const float a0 = 2 * osg::PIf * i / segments;
+            const float a1 = 2 * osg::PIf * (i + 1) / segments;
+            const btVector3 v0(radius * std::cos(a0), radius * std::sin(a0), -height * 0.25f);
+            const btVector3 v1(radius * std::cos(a1), radius * std::sin(a1), -height * 0.25f);
+            mesh->addTriangle(v0, v1, top);
+        }
+        auto compound = std::make_unique<btCompoundShape>();
+        scene.mShapes.push_back(std::make_unique<btBvhTriangleMeshShape>(mesh.get(), true));
+        compound->addChildShape(btTransform::getIdentity(), scene.mShapes.back().get());
+        return compound;
+    }
+
+    void addStatics(Scene& scene, std::size_t count, std::mt19937& random)
+    {
+        const float worldSize = static_cast<float>(sCellSize * sCellsPerSide);
+        std::uniform_real_distribution<float> position(0, worldSize);
+        std::uniform_real_distribution<float> size(32, 256);
+        std::uniform_real_distribution<float> yaw(0, 2 * osg::PIf);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float x = position(random);
+            const float y = position(random);
+            const float extent = size(random);
+            std::unique_ptr<btCollisionShape> shape;
+            if (i % 2 == 0)
+                shape = std::make_unique<btBoxShape>(btVector3(extent, extent * 0.5f, extent * 0.75f));
+            else
+                shape = makeRockShape(scene, extent, extent * 1.5f);
+            auto object = std::make_unique<btCollisionObject>();
+            object->setCollisionShape(shape.get());
+            object->setWorldTransform(btTransform(btQuaternion(btVector3(0, 0, 1), yaw(random)),
+                btVector3(x, y, getTerrainHeight(x, y))));
+            scene.mTaskScheduler.addCollisionObject(
+                object.get(), CollisionType_World, CollisionType_Actor | CollisionType_HeightMap);
+            scene.mShapes.push_back(std::move(shape));
+            scene.mObjects.push_back(std::move(object));
+        }
+    }
+
+    std::vector<Input> recordInputs(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> speed(-100, 300);
+        std::uniform_real_distribution<float> strafe(-100, 100);
+        std::uniform_real_distribution<float> yaw(-osg::PIf, osg::PIf);
+        std::uniform_int_distribution<int> jump(0, 7);
+        std::vector<Input> result;
+        result.reserve(sInputsPerActor);
+        for (std::size_t i = 0; i < sInputsPerActor; ++i)
+            result.push_back(Input{ osg::Vec3f(strafe(random), speed(random), jump(random) == 0 ? 300.f : 0.f),
+                yaw(random) });
+        return result;
+    }
+
+    void addActors(Scene& scene, std::size_t count, std::mt19937& random)
+    {
+        // Keep actors close to each other and the statics around the world center to get collisions
+        const float center = static_cast<float>(sCellSize * sCellsPerSide) / 2;
+        std::uniform_real_distribution<float> position(center - 2048, center + 2048);
+        scene.mActors.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto shape = std::make_unique<btBoxShape>(Misc::Convert::toBullet(sActorHalfExtents));
+            shape->setMargin(0.001);
+            auto collisionObject = std::make_unique<btCollisionObject>();
+            collisionObject->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
+            collisionObject->setActivationState(DISABLE_DEACTIVATION);
+            collisionObject->setCollisionShape(shape.get());
+
+            const float x = position(random);
+            const float y = position(random);
+            const osg::Vec3f origin(x, y, getTerrainHeight(x, y) + 64);
+            const osg::Vec3f center = origin + osg::Vec3f(0, 0, sActorHalfExtents.z());
+            collisionObject->setWorldTransform(
+                btTransform(btQuaternion::getIdentity(), Misc::Convert::toBullet(center)));
+            scene.mTaskScheduler.addCollisionObject(collisionObject.get(), CollisionType_Actor,
+                CollisionType_World | CollisionType_HeightMap | CollisionType_Actor | CollisionType_Door);
+
+            ActorFrameData frameData(collisionObject.get(), sActorHalfExtents.z(), sWaterLevel, sWaterLevel);
+            frameData.mPosition = origin;
+            scene.mActors.push_back(
+                ReplayActor{ std::move(shape), std::move(collisionObject), frameData, recordInputs(random) });
+        }
+    }
+
+    // Same thread count as PhysicsTaskScheduler gets from its locking policy
+    unsigned getNumThreads()
+    {
+        const int asyncNumThreads = Settings::physics().mAsyncNumThreads;
+        if (asyncNumThreads < 1)
+            return 0;
+        btDbvtBroadphase broadphase;
+        const unsigned maxThreads
+            = std::min<unsigned>(broadphase.m_rayTestStacks.size(), static_cast<unsigned>(BT_MAX_THREAD_COUNT - 1));
+        if (maxThreads <= 1)
+            return 1;
+        return static_cast<unsigned>(std::clamp<int>(asyncNumThreads, 0, static_cast<int>(maxThreads)));
+    }
+
+    // Moves actors on worker threads picking jobs from a shared counter like PhysicsTaskScheduler::doSimulation.
+    // Collision objects are only updated after all moves are done so the result does not depend on thread count.
+    class MoveWorkers
+    {
+    public:
+        MoveWorkers(Scene& scene, const WorldFrameData& worldData, unsigned numThreads)
+            : mScene(scene)
+            , mWorldData(worldData)
+            , mStartBarrier(numThreads + 1)
+            , mDoneBarrier(numThreads + 1)
+        {
+            mThreads.reserve(numThreads);
+            for (unsigned i = 0; i < numThreads; ++i)
+                mThreads.emplace_back([this] { worker(); });
+        }
+
+        ~MoveWorkers()
+        {
+            if (mThreads.empty())
+                return;
+            mStop = true;
+            mStartBarrier.arrive_and_wait();
+            for (std::thread& thread : mThreads)
+                thread.join();
+        }
+
+        std::size_t getNumThreads() const { return mThreads.size(); }
+
+        void run()
+        {
+            mNextJob.store(0, std::memory_order_relaxed);
+            if (mThreads.empty())
+            {
+                moveActors();
+                return;
+            }
+            mStartBarrier.arrive_and_wait();
+            mDoneBarrier.arrive_and_wait();
+        }
+
+    private:
+        Scene& mScene;
+        const WorldFrameData& mWorldData;
+        std::barrier<> mStartBarrier;
+        std::barrier<> mDoneBarrier;
+        std::atomic<std::size_t> mNextJob{ 0 };
+        bool mStop = false;
+        std::vector<std::thread> mThreads;
+
+        void moveActors()
+        {
+            std::size_t job = 0;
+            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mScene.mActors.size())
+                MovementSolver::move(mScene.mActors[job].mFrameData, sPhysicsDt, &mScene.mCollisionWorld, mWorldData);
+        }
+
+        void worker()
+        {
+            while (true)
+            {
+                mStartBarrier.arrive_and_wait();
+                if (mStop)
+                    return;
+                moveActors();
+                mDoneBarrier.arrive_and_wait();
+            }
+        }
+    };
+
+    // Same order of operations as PhysicsTaskScheduler for a single simulation step
+    void step(Scene& scene, std::size_t stepIndex, MoveWorkers& workers)
+    {
+        for (ReplayActor& actor : scene.mActors)
+        {
+            const Input& input = actor.mInputs[(stepIndex / sInputPeriod) % actor.mInputs.size()];
+            actor.mFrameData.mMovement = input.mMovement;
+            actor.mFrameData.mRotation = osg::Vec2f(0, input.mYaw);
+        }
+
+        for (ReplayActor& actor : scene.mActors)
+            MovementSolver::unstuck(actor.mFrameData, &scene.mCollisionWorld);
+
+        workers.run();
+
+        for (ReplayActor& actor : scene.mActors)
+        {
+            btTransform transform = actor.mCollisionObject->getWorldTransform();
+            transform.setOrigin(Misc::Convert::toBullet(
+                actor.mFrameData.mPosition + osg::Vec3f(0, 0, actor.mFrameData.mHalfExtentsZ)));
+            actor.mCollisionObject->setWorldTransform(transform);
+            scene.mCollisionWorld.updateSingleAabb(actor.mCollisionObject.get());
+        }
+    }
+
+    std::size_t hashPositions(const Scene& scene)
+    {
+        std::size_t result = 0;
+        for (const ReplayActor& actor : scene.mActors)
+        {
+            Misc::hashCombine(result, actor.mFrameData.mPosition.x());
+            Misc::hashCombine(result, actor.mFrameData.mPosition.y());
+            Misc::hashCombine(result, actor.mFrameData.mPosition.z());
+        }
+        return result;
+    }
+
+    std::size_t countContacts(Scene& scene)
+    {
+        std::size_t result = 0;
+        for (ReplayActor& actor : scene.mActors)
+        {
+            ContactCounter counter(*actor.mCollisionObject);
+            ContactTestWrapper::contactTest(&scene.mCollisionWorld, actor.mCollisionObject.get(), counter);
+            result += counter.mCount;
+        }
+        return result;
+    }
+
+    void replay(benchmark::State& state)
+    {
+        std::mt19937 random;
+        Scene scene;
+        addHeightFields(scene);
+        addStatics(scene, static_cast<std::size_t>(state.range(1)), random);
+        addActors(scene, static_cast<std::size_t>(state.range(0)), random);
+        const WorldFrameData worldData(false, osg::Vec3f());
+        MoveWorkers workers(scene, worldData, getNumThreads());
+        std::size_t stepIndex = 0;
+
+        for (auto _ : state)
+            step(scene, stepIndex++, workers);
+
+        // Hash is truncated to 32 bits to be represented exactly by the counter
+        state.counters["hash"] = static_cast<double>(hashPositions(scene) & 0xffffffff);
+        state.counters["contacts"] = static_cast<double>(countContacts(scene));
+        state.counters["actors"] = static_cast<double>(scene.mActors.size());
+        state.counters["steps"] = static_cast<double>(stepIndex);
+        state.counters["threads"] = static_cast<double>(workers.getNumThreads());
+    }
+}
+
+BENCHMARK(replay)->Args({ 16, 64 })->Args({ 64, 256 })->Args({ 256, 1024 })->Iterations(sSteps);
+
+int main(int argc, char* argv[])
+{
+    const std::filesystem::path settingsDefaultPath = std::filesystem::path{ OPENMW_PROJECT_SOURCE_DIR } / "files"
+        / Misc::StringUtils::stringToU8String("settings-default.cfg");
+
+    Settings::SettingsFileParser parser;
+    parser.loadSettingsFile(settingsDefaultPath, Settings::Manager::mDefaultSettings);
+
+    Settings::StaticValues::initDefaults();
+
+    Settings::Manager::mUserSettings = Settings::Manager::mDefaultSettings;
+
+    Settings::StaticValues::init();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
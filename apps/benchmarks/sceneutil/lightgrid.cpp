@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/lightgrid.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t sObjectsCount = 2000;
+
+    // Lights and objects bounds in view space of a large interior
+    struct Scene
+    {
+        std::vector<osg::BoundingSphere> mLights;
+        std::vector<osg::BoundingSphere> mObjects;
+
+        explicit Scene(std::size_t lightsCount)
+        {
+            std::mt19937 random;
+            std::uniform_real_distribution<float> x(-4096, 4096);
+            std::uniform_real_distribution<float> y(-2048, 2048);
+            std::uniform_real_distribution<float> z(-8192, 0);
+            std::uniform_real_distribution<float> lightRadius(128, 768);
+            std::uniform_real_distribution<float> objectRadius(16, 256);
+            for (std::size_t i = 0; i < lightsCount; ++i)
+                mLights.emplace_back(osg::Vec3f(x(random), y(random), z(random)), lightRadius(random));
+            for (std::size_t i = 0; i < sObjectsCount; ++i)
+                mObjects.emplace_back(osg::Vec3f(x(random), y(random), z(random)), objectRadius(random));
+        }
+    };
+
+    void buildLightListsTestingEachLight(benchmark::State& state)
+    {
+        const Scene scene(static_cast<std::size_t>(state.range(0)));
+        std::vector<std::size_t> lightList;
+
+        for (auto _ : state)
+        {
+            for (const osg::BoundingSphere& object : scene.mObjects)
+            {
+                lightList.clear();
+                for (std::size_t i = 0; i < scene.mLights.size(); ++i)
+                    if (scene.mLights[i].intersects(object))
+                        lightList.push_back(i);
+                benchmark::DoNotOptimize(lightList.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(scene.mObjects.size()));
+    }
+
+    void buildLightListsWithLightGrid(benchmark::State& state)
+    {
+        const Scene scene(static_cast<std::size_t>(state.range(0)));
+        SceneUtil::LightGrid grid;
+        std::vector<std::size_t> lightList;
+
+        for (auto _ : state)
+        {
+            // Grid is built once per camera per frame
+            grid.clear();
+            for (const osg::BoundingSphere& light : scene.mLights)
+                grid.add(light);
+            grid.build();
+
+            for (const osg::BoundingSphere& object : scene.mObjects)
+            {
+                grid.query(object, lightList);
+                benchmark::DoNotOptimize(lightList.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(scene.mObjects.size()));
+    }
+}
+
+BENCHMARK(buildLightListsTestingEachLight)->Arg(8)->Arg(32)->Arg(64)->Arg(256);
+BENCHMARK(buildLightListsWithLightGrid)->Arg(8)->Arg(32)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
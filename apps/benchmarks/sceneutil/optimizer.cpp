@@ -0,0 +1,199 @@
+#include <benchmark/benchmark.h>
+
+#include <components/files/constrainedfilestream.hpp>
+#include <components/files/conversion.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/bgsmfilemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/optimizer.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Material>
+#include <osg/MatrixTransform>
+#include <osg/Texture2D>
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr unsigned options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+        | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
+
+    osg::ref_ptr<osg::Geometry> makeGeometry(std::size_t vertices, osg::StateSet* stateSet, std::minstd_rand& random)
+    {
+        std::uniform_real_distribution<float> distribution(-100, 100);
+
+        osg::ref_ptr<osg::Vec3Array> positions = new osg::Vec3Array(vertices);
+        osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array(vertices);
+        osg::ref_ptr<osg::Vec2Array> texCoords = new osg::Vec2Array(vertices);
+        for (std::size_t i = 0; i < vertices; ++i)
+        {
+            (*positions)[i] = osg::Vec3f(distribution(random), distribution(random), distribution(random));
+            (*normals)[i] = osg::Vec3f(0, 0, 1);
+            (*texCoords)[i] = osg::Vec2f(distribution(random), distribution(random));
+        }
+
+        osg::ref_ptr<osg::DrawElementsUShort> triangles = new osg::DrawElementsUShort(GL_TRIANGLES);
+        triangles->reserve(vertices * 2);
+        for (std::size_t i = 0; i + 2 < vertices; ++i)
+        {
+            triangles->push_back(static_cast<unsigned short>(i));
+            triangles->push_back(static_cast<unsigned short>(i + 1));
+            triangles->push_back(static_cast<unsigned short>(i + 2));
+        }
+
+        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+        geometry->setVertexArray(positions);
+        geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+        geometry->setTexCoordArray(0, texCoords, osg::Array::BIND_PER_VERTEX);
+        geometry->addPrimitiveSet(triangles);
+        geometry->setStateSet(stateSet);
+        return geometry;
+    }
+
+    // Meshes similar to the ones created by NifLoader for static objects: a few transformed drawables sharing a small
+    // number of state sets between different meshes
+    std::vector<osg::ref_ptr<osg::Node>> makeSyntheticTemplates(std::size_t count)
+    {
+        std::minstd_rand random(42);
+        std::uniform_int_distribution<int> drawablesDistribution(1, 4);
+        std::uniform_int_distribution<std::size_t> verticesDistribution(50, 2000);
+
+        std::vector<osg::ref_ptr<osg::StateSet>> stateSets;
+        for (int i = 0; i < 16; ++i)
+        {
+            osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet;
+            stateSet->setTextureAttributeAndModes(0, new osg::Texture2D, osg::StateAttribute::ON);
+            stateSet->setAttributeAndModes(new osg::Material, osg::StateAttribute::ON);
+            stateSets.push_back(stateSet);
+        }
+        std::uniform_int_distribution<std::size_t> stateSetDistribution(0, stateSets.size() - 1);
+
+        std::vector<osg::ref_ptr<osg::Node>> result;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            osg::ref_ptr<osg::Group> root = new osg::Group;
+            const int drawables = drawablesDistribution(random);
+            for (int j = 0; j < drawables; ++j)
+            {
+                osg::ref_ptr<osg::MatrixTransform> transform
+                    = new osg::MatrixTransform(osg::Matrix::translate(osg::Vec3f(j * 10.f, 0, 0)));
+                transform->setDataVariance(osg::Object::STATIC);
+                transform->addChild(makeGeometry(
+                    verticesDistribution(random), stateSets[stateSetDistribution(random)], random));
+                root->addChild(transform);
+            }
+            result.push_back(root);
+        }
+        return result;
+    }
+
+    // NIF files listed in OPENMW_OPTIMIZER_BENCHMARK_NIFS separated by newlines
+    std::vector<osg::ref_ptr<osg::Node>> loadNifTemplates()
+    {
+        const char* const paths = std::getenv("OPENMW_OPTIMIZER_BENCHMARK_NIFS");
+        if (paths == nullptr)
+            return {};
+
+        VFS::Manager vfs;
+        Resource::ImageManager imageManager(&vfs, 0);
+        Resource::BgsmFileManager materialManager(&vfs, 0);
+
+        std::vector<osg::ref_ptr<osg::Node>> result;
+        std::istringstream stream(paths);
+        for (std::string path; std::getline(stream, path);)
+        {
+            if (path.empty())
+                continue;
+            Nif::NIFFile file(VFS::Path::Normalized(path));
+            Nif::Reader reader(file, nullptr);
+            reader.parse(Files::openConstrainedFileStream(Files::pathFromUnicodeString(path)));
+            result.push_back(NifOsg::Loader::load(file, &imageManager, &materialManager));
+        }
+        return result;
+    }
+
+    // Similar to an object paging chunk: many instances of the templates with own transforms. Nodes and drawables
+    // are copied, arrays are shared with the templates.
+    osg::ref_ptr<osg::Group> makeChunk(const std::vector<osg::ref_ptr<osg::Node>>& templates, std::size_t instances)
+    {
+        std::minstd_rand random(13);
+        std::uniform_int_distribution<std::size_t> templateDistribution(0, templates.size() - 1);
+        std::uniform_real_distribution<float> positionDistribution(-4096, 4096);
+
+        osg::ref_ptr<osg::Group> chunk = new osg::Group;
+        for (std::size_t i = 0; i < instances; ++i)
+        {
+            osg::ref_ptr<osg::MatrixTransform> transform = new osg::MatrixTransform(osg::Matrix::translate(
+                positionDistribution(random), positionDistribution(random), positionDistribution(random)));
+            transform->setDataVariance(osg::Object::STATIC);
+            const osg::Node& node = *templates[templateDistribution(random)];
+            transform->addChild(
+                static_cast<osg::Node*>(node.clone(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES)));
+            chunk->addChild(transform);
+        }
+        return chunk;
+    }
+
+    void optimize(benchmark::State& state, const std::vector<osg::ref_ptr<osg::Node>>& templates)
+    {
+        const std::size_t threads = static_cast<std::size_t>(state.range(0));
+        const std::size_t instances = static_cast<std::size_t>(state.range(1));
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue;
+        if (threads > 0)
+            workQueue = new SceneUtil::WorkQueue(threads);
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            osg::ref_ptr<osg::Group> chunk = makeChunk(templates, instances);
+            state.ResumeTiming();
+
+            SceneUtil::Optimizer optimizer;
+            optimizer.setWorkQueue(workQueue.get(), threads);
+            optimizer.optimize(chunk, options);
+            benchmark::DoNotOptimize(chunk);
+        }
+    }
+
+    void optimizeSyntheticChunk(benchmark::State& state)
+    {
+        static const std::vector<osg::ref_ptr<osg::Node>> templates = makeSyntheticTemplates(64);
+        optimize(state, templates);
+    }
+
+    void optimizeNifChunk(benchmark::State& state)
+    {
+        static const std::vector<osg::ref_ptr<osg::Node>> templates = loadNifTemplates();
+        if (templates.empty())
+        {
+            state.SkipWithError("OPENMW_OPTIMIZER_BENCHMARK_NIFS is not set");
+            return;
+        }
+        optimize(state, templates);
+    }
+
+    void addArgs(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgNames({ "threads", "instances" });
+        for (long threads : { 0, 1, 3 })
+            for (long instances : { 100, 1000 })
+                benchmark->Args({ threads, instances });
+        benchmark->Unit(benchmark::kMillisecond);
+        benchmark->UseRealTime();
+    }
+}
+
+BENCHMARK(optimizeSyntheticChunk)->Apply(addArgs);
+BENCHMARK(optimizeNifChunk)->Apply(addArgs);
+
+BENCHMARK_MAIN();
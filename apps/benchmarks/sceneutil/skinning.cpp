@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t sVerticesPerGroup = 64;
+
+    // Vertices split into groups sharing a skinning matrix the same way as RigGeometry does it
+    struct Rig
+    {
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+        std::vector<osg::Vec4f> mTangents;
+        std::vector<osg::Matrixf> mMatrices;
+        std::vector<std::vector<unsigned short>> mGroups;
+        SceneUtil::SkinningSource mSource;
+
+        explicit Rig(std::size_t vertices)
+        {
+            std::mt19937 random;
+            std::uniform_real_distribution<float> coordinate(-100, 100);
+            std::uniform_real_distribution<float> angle(0, 6.28f);
+
+            const auto makeVec3
+                = [&] { return osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)); };
+
+            for (std::size_t i = 0; i < vertices; ++i)
+            {
+                mPositions.push_back(makeVec3());
+                osg::Vec3f normal = makeVec3();
+                normal.normalize();
+                mNormals.push_back(normal);
+                mTangents.emplace_back(normal ^ osg::Vec3f(0, 0, 1), 1);
+            }
+
+            std::vector<unsigned short> order(vertices);
+            std::iota(order.begin(), order.end(), static_cast<unsigned short>(0));
+            std::shuffle(order.begin(), order.end(), random);
+
+            mSource.mGroupOffsets.push_back(0);
+            for (std::size_t begin = 0; begin < vertices; begin += sVerticesPerGroup)
+            {
+                std::vector<unsigned short>& group = mGroups.emplace_back(
+                    order.begin() + begin, order.begin() + std::min(begin + sVerticesPerGroup, vertices));
+                mMatrices.push_back(osg::Matrixf::rotate(angle(random), makeVec3())
+                    * osg::Matrixf::translate(makeVec3()) * osg::Matrixf::scale(1.1f, 1.1f, 1.1f));
+                for (unsigned short vertex : group)
+                {
+                    mSource.mVertices.push_back(vertex);
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        mSource.mPositions[i].push_back(mPositions[vertex][i]);
+                        mSource.mNormals[i].push_back(mNormals[vertex][i]);
+                        mSource.mTangents[i].push_back(mTangents[vertex][i]);
+                    }
+                }
+                mSource.mGroupOffsets.push_back(mSource.mVertices.size());
+            }
+        }
+    };
+
+    void skinScalar(benchmark::State& state)
+    {
+        const Rig rig(static_cast<std::size_t>(state.range(0)));
+        std::vector<osg::Vec3f> positions(rig.mPositions.size());
+        std::vector<osg::Vec3f> normals(rig.mNormals.size());
+        std::vector<osg::Vec4f> tangents(rig.mTangents.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t group = 0; group < rig.mGroups.size(); ++group)
+            {
+                const osg::Matrixf& matrix = rig.mMatrices[group];
+                for (unsigned short vertex : rig.mGroups[group])
+                {
+                    positions[vertex] = matrix.preMult(rig.mPositions[vertex]);
+                    normals[vertex] = osg::Matrixf::transform3x3(rig.mNormals[vertex], matrix);
+                    const osg::Vec3f tangent = osg::Matrixf::transform3x3(
+                        osg::Vec3f(rig.mTangents[vertex].x(), rig.mTangents[vertex].y(), rig.mTangents[vertex].z()),
+                        matrix);
+                    tangents[vertex] = osg::Vec4f(tangent, rig.mTangents[vertex].w());
+                }
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+            benchmark::DoNotOptimize(tangents.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rig.mPositions.size()));
+    }
+
+    void skinVectorized(benchmark::State& state)
+    {
+        const Rig rig(static_cast<std::size_t>(state.range(0)));
+        const SceneUtil::SkinningSource& source = rig.mSource;
+        std::vector<osg::Vec3f> positions(rig.mPositions.size());
+        std::vector<osg::Vec3f> normals(rig.mNormals.size());
+        std::vector<osg::Vec4f> tangents(rig.mTangents);
+
+        for (auto _ : state)
+        {
+            for (std::size_t group = 0; group < rig.mGroups.size(); ++group)
+            {
+                const osg::Matrixf& matrix = rig.mMatrices[group];
+                const std::size_t begin = source.mGroupOffsets[group];
+                const std::size_t count = source.mGroupOffsets[group + 1] - begin;
+                const unsigned short* const indices = source.mVertices.data() + begin;
+                SceneUtil::transformPoints(matrix, source.mPositions[0].data() + begin,
+                    source.mPositions[1].data() + begin, source.mPositions[2].data() + begin, indices, count,
+                    positions.data());
+                SceneUtil::transformDirections(matrix, source.mNormals[0].data() + begin,
+                    source.mNormals[1].data() + begin, source.mNormals[2].data() + begin, indices, count,
+                    normals.data());
+                SceneUtil::transformDirections(matrix, source.mTangents[0].data() + begin,
+                    source.mTangents[1].data() + begin, source.mTangents[2].data() + begin, indices, count,
+                    tangents.data());
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+            benchmark::DoNotOptimize(tangents.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rig.mPositions.size()));
+    }
+}
+
+BENCHMARK(skinScalar)->Arg(10000)->Arg(25000)->Arg(50000);
+BENCHMARK(skinVectorized)->Arg(10000)->Arg(25000)->Arg(50000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+#include <benchmark/benchmark.h>
+
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/texturetype.hpp>
+#include <components/shader/defineset.hpp>
+#include <components/shader/shadermanager.hpp>
+#include <components/shader/shadervisitor.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <osg/BlendFunc>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Texture2D>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::filesystem::path& getShaderPath()
+    {
+        static const std::filesystem::path path = [] {
+            const std::filesystem::path result
+                = std::filesystem::temp_directory_path() / "openmw_shader_visitor_benchmark";
+            std::filesystem::create_directories(result / "compatibility");
+            for (const char* name : { "objects.vert", "objects.frag" })
+            {
+                std::ofstream stream(result / "compatibility" / name);
+                stream << "#version 120\nvoid main() {}\n";
+            }
+            return result;
+        }();
+        return path;
+    }
+
+    // Texture sets typical for Morrowind meshes: most of the objects have only a base texture, some have dark, detail,
+    // glow, decal or environment maps
+    const std::vector<std::vector<std::string>> sTextureSets = {
+        { "diffuseMap" },
+        { "diffuseMap" },
+        { "diffuseMap" },
+        { "diffuseMap", "darkMap" },
+        { "diffuseMap", "detailMap" },
+        { "diffuseMap", "emissiveMap" },
+        { "diffuseMap", "decalMap" },
+        { "diffuseMap", "envMap" },
+        { "diffuseMap", "darkMap", "emissiveMap" },
+    };
+
+    // Scene graph similar to the one created by NifLoader for a cell: a node per object with a few drawables each
+    // having own state set with textures and sometimes blending
+    osg::ref_ptr<osg::Group> makeScene(std::size_t objects)
+    {
+        std::minstd_rand random(42);
+        std::uniform_int_distribution<std::size_t> textureSetDistribution(0, sTextureSets.size() - 1);
+        std::uniform_int_distribution<int> drawablesDistribution(1, 4);
+        std::bernoulli_distribution blendDistribution(0.2);
+
+        osg::ref_ptr<osg::Group> scene = new osg::Group;
+        for (std::size_t i = 0; i < objects; ++i)
+        {
+            osg::ref_ptr<osg::Group> object = new osg::Group;
+            const int drawables = drawablesDistribution(random);
+            for (int j = 0; j < drawables; ++j)
+            {
+                osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry;
+                osg::StateSet* const stateSet = geometry->getOrCreateStateSet();
+                const std::vector<std::string>& textureSet = sTextureSets[textureSetDistribution(random)];
+                for (unsigned unit = 0; unit < textureSet.size(); ++unit)
+                {
+                    stateSet->setTextureAttributeAndModes(unit, new osg::Texture2D, osg::StateAttribute::ON);
+                    stateSet->setTextureAttribute(unit, new SceneUtil::TextureType(textureSet[unit]));
+                }
+                if (blendDistribution(random))
+                    stateSet->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+                object->addChild(geometry);
+            }
+            scene->addChild(object);
+        }
+        return scene;
+    }
+
+    Shader::ShaderManager::DefineMap makeDefineMap()
+    {
+        Shader::ShaderManager::DefineMap result;
+        for (const char* name : { "diffuseMap", "normalMap", "emissiveMap", "darkMap", "detailMap", "envMap",
+                 "specularMap", "decalMap", "bumpMap", "glossMap" })
+        {
+            result[name] = "0";
+            result[std::string(name) + "UV"] = "0";
+        }
+        result["diffuseMap"] = "1";
+        for (const char* name : { "diffuseParallax", "parallax", "reconstructNormalZ", "additiveBlending",
+                 "alphaToCoverage", "adjustCoverage", "particleOcclusion", "softParticles", "useOVR_multiview" })
+            result[name] = "0";
+        result["alphaFunc"] = "519";
+        result["numViews"] = "1";
+        return result;
+    }
+
+    void applyShaderVisitor(benchmark::State& state)
+    {
+        VFS::Manager vfs;
+        Resource::ImageManager imageManager(&vfs, 0);
+        Shader::ShaderManager shaderManager;
+        shaderManager.setShaderPath(getShaderPath());
+        const osg::ref_ptr<osg::Group> scene = makeScene(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            Shader::ShaderVisitor visitor(shaderManager, imageManager, "objects");
+            visitor.setForceShaders(true);
+            scene->accept(visitor);
+        }
+
+        state.SetItemsProcessed(state.iterations() * scene->getNumChildren());
+    }
+
+    void getProgramByDefineMap(benchmark::State& state)
+    {
+        Shader::ShaderManager shaderManager;
+        shaderManager.setShaderPath(getShaderPath());
+        const Shader::ShaderManager::DefineMap defines = makeDefineMap();
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(shaderManager.getProgram("objects", defines));
+    }
+
+    void getProgramByDefineSet(benchmark::State& state)
+    {
+        Shader::ShaderManager shaderManager;
+        shaderManager.setShaderPath(getShaderPath());
+        const Shader::DefineSet defines(makeDefineMap());
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(shaderManager.getProgram("objects", defines, nullptr));
+    }
+
+    void buildDefineMap(benchmark::State& state)
+    {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(makeDefineMap());
+    }
+
+    void buildDefineSet(benchmark::State& state)
+    {
+        const Shader::DefineSet::DefineMap defineMap = makeDefineMap();
+        std::vector<std::pair<Shader::DefineAtom, Shader::DefineAtom>> values;
+        for (const auto& [name, value] : defineMap)
+            values.emplace_back(Shader::DefineAtom(name), Shader::DefineAtom(value));
+        Shader::DefineSet defines;
+
+        for (auto _ : state)
+        {
+            defines.clear();
+            for (const auto& [name, value] : values)
+                defines.set(name, value);
+            benchmark::DoNotOptimize(defines.getHash());
+        }
+    }
+}
+
+BENCHMARK(applyShaderVisitor)->Arg(100)->Arg(1000);
+BENCHMARK(getProgramByDefineMap);
+BENCHMARK(getProgramByDefineSet);
+BENCHMARK(buildDefineMap);
+BENCHMARK(buildDefineSet);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,219 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwworld/cellreftable.hpp"
+
+#include <components/esm3/cellref.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int sGridSize = 32;
+    constexpr int sRefsPerCell = 100;
+    constexpr int sCellSize = 8192;
+
+    // Exterior cells with a content file written to the disk like a regular plugin
+    struct World
+    {
+        std::filesystem::path mPath;
+        std::vector<ESM::Cell> mCells;
+        std::map<std::pair<int, int>, const ESM::Cell*> mCellsIndex;
+        MWWorld::CellRefTable mTable;
+
+        World()
+            : mPath(std::filesystem::temp_directory_path() / "openmw_cellreftable_benchmark.omwaddon")
+        {
+            writeContentFile();
+            readCells();
+            buildTable();
+        }
+
+        ~World()
+        {
+            std::error_code ec;
+            std::filesystem::remove(mPath, ec);
+        }
+
+        void writeContentFile() const
+        {
+            std::mt19937 random;
+            std::uniform_real_distribution<float> offset(0, sCellSize);
+            std::uniform_real_distribution<float> angle(0, 6.28f);
+            std::uniform_int_distribution<int> model(0, 99);
+
+            std::ofstream stream(mPath, std::ios::binary);
+            ESM::ESMWriter writer;
+            writer.setFormatVersion(ESM::DefaultFormatVersion);
+            writer.save(stream);
+
+            unsigned refIndex = 0;
+            for (int x = 0; x < sGridSize; ++x)
+            {
+                for (int y = 0; y < sGridSize; ++y)
+                {
+                    ESM::Cell cell;
+                    cell.blank();
+                    cell.mData.mX = x;
+                    cell.mData.mY = y;
+                    writer.startRecord(ESM::Cell::sRecordId);
+                    cell.save(writer);
+                    for (int i = 0; i < sRefsPerCell; ++i)
+                    {
+                        ESM::CellRef ref;
+                        ref.blank();
+                        ref.mRefNum = ESM::RefNum{ .mIndex = ++refIndex, .mContentFile = 0 };
+                        ref.mRefID = ESM::RefId::stringRefId("static_" + std::to_string(model(random)));
+                        ref.mPos.pos[0] = x * sCellSize + offset(random);
+                        ref.mPos.pos[1] = y * sCellSize + offset(random);
+                        ref.mPos.rot[2] = angle(random);
+                        ref.save(writer);
+                    }
+                    writer.endRecord(ESM::Cell::sRecordId);
+                }
+            }
+
+            writer.close();
+        }
+
+        void readCells()
+        {
+            ESM::ESMReader reader;
+            reader.setIndex(0);
+            reader.open(mPath);
+            while (reader.hasMoreRecs())
+            {
+                reader.getRecName();
+                reader.getRecHeader();
+                ESM::Cell& cell = mCells.emplace_back();
+                bool deleted = false;
+                cell.load(reader, deleted, true);
+            }
+            for (const ESM::Cell& cell : mCells)
+                mCellsIndex.emplace(std::make_pair(cell.getGridX(), cell.getGridY()), &cell);
+        }
+
+        void buildTable()
+        {
+            ESM::ReadersCache readers;
+            for (const ESM::Cell& cell : mCells)
+            {
+                for (std::size_t i = 0; i < cell.mContextList.size(); ++i)
+                {
+                    const ESM::ReadersCache::BusyItem reader
+                        = readers.get(static_cast<std::size_t>(cell.mContextList[i].index));
+                    cell.restore(*reader, i);
+                    ESM::CellRef ref;
+                    bool deleted = false;
+                    while (ESM::Cell::getNextRef(*reader, ref, deleted))
+                        mTable.add(cell.getGridX(), cell.getGridY(), ref, deleted);
+                }
+            }
+            mTable.finalize();
+        }
+    };
+
+    const World& getWorld()
+    {
+        static const World world;
+        return world;
+    }
+
+    // Mirrors the way chunk references used to be collected: by reading each cell from the content file
+    std::map<ESM::RefNum, osg::Vec3f> collectFromFiles(const World& world, int startX, int startY, int size)
+    {
+        std::map<ESM::RefNum, osg::Vec3f> result;
+        ESM::ReadersCache readers;
+        for (int cellX = startX; cellX < startX + size; ++cellX)
+        {
+            for (int cellY = startY; cellY < startY + size; ++cellY)
+            {
+                const auto it = world.mCellsIndex.find(std::make_pair(cellX, cellY));
+                if (it == world.mCellsIndex.end())
+                    continue;
+                const ESM::Cell& cell = *it->second;
+                for (std::size_t i = 0; i < cell.mContextList.size(); ++i)
+                {
+                    const ESM::ReadersCache::BusyItem reader
+                        = readers.get(static_cast<std::size_t>(cell.mContextList[i].index));
+                    cell.restore(*reader, i);
+                    ESM::CellRef ref;
+                    bool deleted = false;
+                    while (ESM::Cell::getNextRef(*reader, ref, deleted))
+                    {
+                        if (deleted)
+                            result.erase(ref.mRefNum);
+                        else
+                            result.insert_or_assign(ref.mRefNum, ref.mPos.asVec3());
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    std::map<ESM::RefNum, osg::Vec3f> collectFromTable(const World& world, int startX, int startY, int size)
+    {
+        std::map<ESM::RefNum, osg::Vec3f> result;
+        for (int cellX = startX; cellX < startX + size; ++cellX)
+        {
+            for (int cellY = startY; cellY < startY + size; ++cellY)
+            {
+                for (const MWWorld::CellRefTable::Ref& ref : world.mTable.getCell(cellX, cellY))
+                {
+                    if (ref.mDeleted)
+                        result.erase(ref.mRefNum);
+                    else
+                        result.insert_or_assign(ref.mRefNum, ref.mPos.asVec3());
+                }
+            }
+        }
+        return result;
+    }
+
+    template <auto collect>
+    void collectChunkReferences(benchmark::State& state)
+    {
+        const World& world = getWorld();
+        const int size = static_cast<int>(state.range(0));
+        int chunk = 0;
+        std::size_t refs = 0;
+
+        for (auto _ : state)
+        {
+            const int chunksPerRow = sGridSize / size;
+            const int startX = chunk % chunksPerRow * size;
+            const int startY = chunk / chunksPerRow % chunksPerRow * size;
+            const auto result = collect(world, startX, startY, size);
+            refs += result.size();
+            benchmark::DoNotOptimize(result);
+            ++chunk;
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(refs));
+    }
+
+    void collectChunkReferencesFromFiles(benchmark::State& state)
+    {
+        collectChunkReferences<collectFromFiles>(state);
+    }
+
+    void collectChunkReferencesFromTable(benchmark::State& state)
+    {
+        collectChunkReferences<collectFromTable>(state);
+    }
+}
+
+BENCHMARK(collectChunkReferencesFromFiles)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(collectChunkReferencesFromTable)->Arg(1)->Arg(4)->Arg(16);
+
+BENCHMARK_MAIN();
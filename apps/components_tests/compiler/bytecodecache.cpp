@@ -0,0 +1,113 @@
+#include <components/compiler/bytecodecache.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Compiler;
+
+    BytecodeCache::Script makeScript()
+    {
+        BytecodeCache::Script result;
+        result.mProgram.mInstructions = { 0x0c000001, 0x80000000, 0xffffffff };
+        result.mProgram.mIntegers = { 0, -1, 42 };
+        result.mProgram.mFloats = { 0.5f, -13.25f };
+        result.mProgram.mStrings = { "player", "" };
+        result.mLocals.declare('s', "state");
+        result.mLocals.declare('l', "counter");
+        result.mLocals.declare('f', "timer");
+        result.mLocals.declare('f', "distance");
+        return result;
+    }
+
+    void expectEqual(const BytecodeCache::Script& actual, const BytecodeCache::Script& expected)
+    {
+        EXPECT_EQ(actual.mProgram.mInstructions, expected.mProgram.mInstructions);
+        EXPECT_EQ(actual.mProgram.mIntegers, expected.mProgram.mIntegers);
+        EXPECT_EQ(actual.mProgram.mFloats, expected.mProgram.mFloats);
+        EXPECT_EQ(actual.mProgram.mStrings, expected.mProgram.mStrings);
+        for (const char type : { 's', 'l', 'f' })
+            EXPECT_EQ(actual.mLocals.get(type), expected.mLocals.get(type)) << type;
+    }
+
+    struct BytecodeCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePathWithSubDir(
+            std::filesystem::path("bytecodecache") / UnitTest::GetInstance()->current_test_info()->name());
+
+        BytecodeCacheTest() { std::filesystem::remove(mPath); }
+    };
+
+    TEST_F(BytecodeCacheTest, make_key_should_depend_on_text)
+    {
+        EXPECT_EQ(BytecodeCache::makeKey("begin test\nend\n"), BytecodeCache::makeKey("begin test\nend\n"));
+        EXPECT_NE(BytecodeCache::makeKey("begin test\nend\n"), BytecodeCache::makeKey("begin test\nend \n"));
+    }
+
+    TEST_F(BytecodeCacheTest, find_should_return_nullptr_for_absent_key)
+    {
+        const BytecodeCache cache("environment");
+        EXPECT_EQ(cache.find(42), nullptr);
+    }
+
+    TEST_F(BytecodeCacheTest, find_should_return_inserted_script)
+    {
+        BytecodeCache cache("environment");
+        cache.insert(42, makeScript());
+        const BytecodeCache::Script* result = cache.find(42);
+        ASSERT_NE(result, nullptr);
+        expectEqual(*result, makeScript());
+    }
+
+    TEST_F(BytecodeCacheTest, load_should_return_false_for_absent_file)
+    {
+        BytecodeCache cache("environment");
+        EXPECT_FALSE(cache.load(mPath));
+    }
+
+    TEST_F(BytecodeCacheTest, load_should_return_saved_scripts)
+    {
+        {
+            BytecodeCache cache("environment");
+            cache.insert(42, makeScript());
+            cache.insert(13, BytecodeCache::Script{});
+            cache.save(mPath);
+        }
+        BytecodeCache cache("environment");
+        ASSERT_TRUE(cache.load(mPath));
+        EXPECT_EQ(cache.size(), 2);
+        const BytecodeCache::Script* result = cache.find(42);
+        ASSERT_NE(result, nullptr);
+        expectEqual(*result, makeScript());
+        ASSERT_NE(cache.find(13), nullptr);
+    }
+
+    TEST_F(BytecodeCacheTest, load_should_ignore_file_for_other_environment)
+    {
+        {
+            BytecodeCache cache("environment");
+            cache.insert(42, makeScript());
+            cache.save(mPath);
+        }
+        BytecodeCache cache("other environment");
+        cache.insert(13, makeScript());
+        EXPECT_FALSE(cache.load(mPath));
+        EXPECT_EQ(cache.find(42), nullptr);
+        EXPECT_NE(cache.find(13), nullptr);
+    }
+
+    TEST_F(BytecodeCacheTest, load_should_fail_for_truncated_file)
+    {
+        {
+            BytecodeCache cache("environment");
+            cache.insert(42, makeScript());
+            cache.save(mPath);
+        }
+        std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - 1);
+        BytecodeCache cache("environment");
+        EXPECT_FALSE(cache.load(mPath));
+        EXPECT_EQ(cache.size(), 0);
+    }
+}
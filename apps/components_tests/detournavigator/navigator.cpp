@@ -398,6 +398,83 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, path_should_be_around_door_avoid_shape)
+    {
+        CollisionShapeInstance floor(std::make_unique<btBoxShape>(btVector3(400, 400, 5)));
+        const btTransform floorTransform(btMatrix3x3::getIdentity(), btVector3(256, 256, -5));
+
+        osg::ref_ptr<Resource::BulletShape> bulletShape(new Resource::BulletShape);
+        std::unique_ptr<btCompoundShape> doorShape = std::make_unique<btCompoundShape>();
+        doorShape->addChildShape(
+            btTransform(btMatrix3x3::getIdentity(), btVector3(0, 0, 100)), new btBoxShape(btVector3(5, 5, 100)));
+        bulletShape->mCollisionShape.reset(doorShape.release());
+        bulletShape->mAvoidCollisionShape.reset(new btBoxShape(btVector3(60, 60, 50)));
+        osg::ref_ptr<const Resource::BulletShapeInstance> door(new Resource::BulletShapeInstance(bulletShape));
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        mNavigator->addObject(
+            ObjectId(&floor.shape()), ObjectShapes(floor.instance(), mObjectTransform), floorTransform, nullptr);
+        mNavigator->addObject(ObjectId(door->mCollisionShape.get()),
+            DoorShapes(door, mObjectTransform, osg::Vec3f(256, 150, 0), osg::Vec3f(256, 362, 0)), mTransform,
+            nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, osg::Vec3f(100, 256, 1), osg::Vec3f(412, 256, 1), Flag_walk,
+                      mAreaCosts, mEndTolerance, {}, mOut),
+            Status::Success);
+
+        EXPECT_GT(mPath.size(), 2u) << mPath;
+        for (const osg::Vec3f& point : mPath)
+            EXPECT_GT(std::max(std::abs(point.x() - 256), std::abs(point.y() - 256)), 60) << point;
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, door_obstacle_should_not_cover_area_between_compound_children)
+    {
+        CollisionShapeInstance floor(std::make_unique<btBoxShape>(btVector3(400, 400, 5)));
+        const btTransform floorTransform(btMatrix3x3::getIdentity(), btVector3(256, 256, -5));
+
+        CollisionShapeInstance door(std::make_unique<btCompoundShape>());
+        door.shape().addChildShape(
+            btTransform(btMatrix3x3::getIdentity(), btVector3(-150, 0, 100)), new btBoxShape(btVector3(20, 20, 100)));
+        door.shape().addChildShape(
+            btTransform(btMatrix3x3::getIdentity(), btVector3(150, 0, 100)), new btBoxShape(btVector3(20, 20, 100)));
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        mNavigator->addObject(
+            ObjectId(&floor.shape()), ObjectShapes(floor.instance(), mObjectTransform), floorTransform, nullptr);
+        mNavigator->addObject(ObjectId(&door.shape()),
+            DoorShapes(door.instance(), mObjectTransform, osg::Vec3f(106, 150, 0), osg::Vec3f(106, 362, 0)),
+            mTransform, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, osg::Vec3f(256, 60, 1), osg::Vec3f(256, 452, 1), Flag_walk,
+                      mAreaCosts, mEndTolerance, {}, mOut),
+            Status::Success);
+
+        EXPECT_THAT(mPath, ElementsAre(Vec3fEq(256, 60, 0, 5), Vec3fEq(256, 452, 0, 5))) << mPath;
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, lying_door_should_be_walkable)
+    {
+        CollisionShapeInstance trapdoor(std::make_unique<btBoxShape>(btVector3(200, 200, 5)));
+        const btTransform trapdoorTransform(btMatrix3x3::getIdentity(), btVector3(256, 256, -5));
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        mNavigator->addObject(ObjectId(&trapdoor.shape()),
+            DoorShapes(trapdoor.instance(), mObjectTransform, osg::Vec3f(256, 150, 0), osg::Vec3f(256, 150, -100)),
+            trapdoorTransform, nullptr);
+        mNavigator->update(mPlayerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, osg::Vec3f(150, 256, 1), osg::Vec3f(350, 256, 1), Flag_walk,
+                      mAreaCosts, mEndTolerance, {}, mOut),
+            Status::Success);
+
+        EXPECT_THAT(mPath, ElementsAre(Vec3fEq(150, 256, 0, 5), Vec3fEq(350, 256, 0, 5))) << mPath;
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, path_should_be_over_water_ground_lower_than_water_with_only_swim_flag)
     {
         std::array<float, 5 * 5> heightfieldData{ {
@@ -17,32 +17,6 @@
 
 #include <array>
 
-namespace DetourNavigator
-{
-    static inline bool operator==(const Water& lhs, const Water& rhs)
-    {
-        const auto tie = [](const Water& v) { return std::tie(v.mCellSize, v.mLevel); };
-        return tie(lhs) == tie(rhs);
-    }
-
-    static inline bool operator==(const CellWater& lhs, const CellWater& rhs)
-    {
-        const auto tie = [](const CellWater& v) { return std::tie(v.mCellPosition, v.mWater); };
-        return tie(lhs) == tie(rhs);
-    }
-
-    static inline bool operator==(const Heightfield& lhs, const Heightfield& rhs)
-    {
-        return makeTuple(lhs) == makeTuple(rhs);
-    }
-
-    static inline bool operator==(const FlatHeightfield& lhs, const FlatHeightfield& rhs)
-    {
-        const auto tie = [](const FlatHeightfield& v) { return std::tie(v.mCellPosition, v.mCellSize, v.mHeight); };
-        return tie(lhs) == tie(rhs);
-    }
-}
-
 namespace
 {
     using namespace testing;
@@ -561,4 +535,42 @@ namespace
         expected.mMinY = 1;
         EXPECT_EQ(recastMesh->getHeightfields(), std::vector<Heightfield>({ expected }));
     }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_obstacle_should_add_transformed_aabb_corners_without_triangles)
+    {
+        btBoxShape shape(btVector3(1, 1, 2));
+        RecastMeshBuilder builder(mBounds);
+        builder.addObstacle(shape, btTransform(btMatrix3x3::getIdentity(), btVector3(1, 2, 3)));
+        const auto recastMesh = std::move(builder).create(mVersion);
+        EXPECT_EQ(recastMesh->getMesh().getIndices(), std::vector<int>());
+        EXPECT_EQ(recastMesh->getMeshSources().size(), 0);
+        ASSERT_EQ(recastMesh->getObstacles().size(), 1);
+        EXPECT_EQ(recastMesh->getObstacles().front().mCorners,
+            (std::array<osg::Vec3f, 8>{
+                osg::Vec3f(0, 1, 1), // corner 0
+                osg::Vec3f(2, 1, 1), // corner 1
+                osg::Vec3f(0, 3, 1), // corner 2
+                osg::Vec3f(2, 3, 1), // corner 3
+                osg::Vec3f(0, 1, 5), // corner 4
+                osg::Vec3f(2, 1, 5), // corner 5
+                osg::Vec3f(0, 3, 5), // corner 6
+                osg::Vec3f(2, 3, 5), // corner 7
+            }));
+    }
+
+    TEST_F(DetourNavigatorRecastMeshBuilderTest, add_obstacle_for_compound_shape_should_add_aabb_per_child)
+    {
+        btCompoundShape shape;
+        btBoxShape box(btVector3(1, 1, 1));
+        shape.addChildShape(btTransform(btMatrix3x3::getIdentity(), btVector3(-2, 0, 0)), &box);
+        shape.addChildShape(btTransform(btMatrix3x3::getIdentity(), btVector3(2, 0, 0)), &box);
+        RecastMeshBuilder builder(mBounds);
+        builder.addObstacle(shape, btTransform(btMatrix3x3::getIdentity(), btVector3(0, 0, 1)));
+        const auto recastMesh = std::move(builder).create(mVersion);
+        ASSERT_EQ(recastMesh->getObstacles().size(), 2);
+        EXPECT_EQ(recastMesh->getObstacles()[0].mCorners.front(), osg::Vec3f(-3, -1, 0));
+        EXPECT_EQ(recastMesh->getObstacles()[0].mCorners.back(), osg::Vec3f(-1, 1, 2));
+        EXPECT_EQ(recastMesh->getObstacles()[1].mCorners.front(), osg::Vec3f(1, -1, 0));
+        EXPECT_EQ(recastMesh->getObstacles()[1].mCorners.back(), osg::Vec3f(3, 1, 2));
+    }
 }
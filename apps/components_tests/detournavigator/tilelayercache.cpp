@@ -0,0 +1,116 @@
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/stats.hpp>
+#include <components/detournavigator/tilelayercache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    Mesh makeMesh()
+    {
+        std::vector<int> indices{ { 0, 1, 2 } };
+        std::vector<float> vertices{ { 0, 0, 0, 1, 0, 0, 1, 1, 0 } };
+        std::vector<AreaType> areaTypes{ 1, AreaType_ground };
+        return Mesh(std::move(indices), std::move(vertices), std::move(areaTypes));
+    }
+
+    Obstacle makeObstacle(float shift)
+    {
+        Obstacle result;
+        for (std::size_t i = 0; i < result.mCorners.size(); ++i)
+            result.mCorners[i] = osg::Vec3f((i & 1) + shift, ((i & 2) >> 1) + shift, (i & 4) >> 2);
+        return result;
+    }
+
+    struct DetourNavigatorTileLayerCacheTest : Test
+    {
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 1, 2, 3 } };
+        const TilePosition mTilePosition{ 0, 0 };
+        const Version mVersion{ 0, 0 };
+        const Mesh mMesh{ makeMesh() };
+        const std::vector<CellWater> mWater{};
+        const std::vector<Heightfield> mHeightfields{};
+        const std::vector<FlatHeightfield> mFlatHeightfields{};
+        const std::vector<MeshSource> mSources{};
+        const std::shared_ptr<const RecastMesh> mRecastMesh = std::make_shared<const RecastMesh>(
+            mVersion, mMesh, mWater, mHeightfields, mFlatHeightfields, mSources, std::vector{ makeObstacle(0) });
+        const std::vector<std::byte> mLayer{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+        const std::size_t mItemSize = sizeof(RecastMesh) + getSize(*mRecastMesh) + mLayer.size();
+    };
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, get_for_empty_cache_should_return_nullptr)
+    {
+        TileLayerCache cache(mItemSize);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition, *mRecastMesh), nullptr);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, get_should_return_stored_layer)
+    {
+        TileLayerCache cache(mItemSize);
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        const auto result = cache.get(mAgentBounds, mTilePosition, *mRecastMesh);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(*result, mLayer);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, get_should_ignore_obstacles_difference)
+    {
+        TileLayerCache cache(mItemSize);
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        const RecastMesh recastMesh(
+            mVersion, mMesh, mWater, mHeightfields, mFlatHeightfields, mSources, std::vector{ makeObstacle(1) });
+        const auto result = cache.get(mAgentBounds, mTilePosition, recastMesh);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(*result, mLayer);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, get_for_different_geometry_should_return_nullptr)
+    {
+        TileLayerCache cache(mItemSize);
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        const std::vector<CellWater> water(1, CellWater{ osg::Vec2i(), Water{ 1, 0.0f } });
+        const RecastMesh recastMesh(mVersion, mMesh, water, mHeightfields, mFlatHeightfields, mSources);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition, recastMesh), nullptr);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, set_for_not_enough_cache_size_should_not_store_layer)
+    {
+        TileLayerCache cache(mItemSize - 1);
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition, *mRecastMesh), nullptr);
+        EXPECT_EQ(cache.getStats().mItems, 0);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, set_should_remove_least_recently_used_layer)
+    {
+        TileLayerCache cache(2 * mItemSize);
+        const TilePosition tilePosition1{ 1, 0 };
+        const TilePosition tilePosition2{ 2, 0 };
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        cache.set(mAgentBounds, tilePosition1, mRecastMesh, std::vector(mLayer));
+        ASSERT_NE(cache.get(mAgentBounds, mTilePosition, *mRecastMesh), nullptr);
+        cache.set(mAgentBounds, tilePosition2, mRecastMesh, std::vector(mLayer));
+        EXPECT_NE(cache.get(mAgentBounds, mTilePosition, *mRecastMesh), nullptr);
+        EXPECT_EQ(cache.get(mAgentBounds, tilePosition1, *mRecastMesh), nullptr);
+        EXPECT_NE(cache.get(mAgentBounds, tilePosition2, *mRecastMesh), nullptr);
+    }
+
+    TEST_F(DetourNavigatorTileLayerCacheTest, get_should_update_stats)
+    {
+        TileLayerCache cache(mItemSize);
+        cache.get(mAgentBounds, mTilePosition, *mRecastMesh);
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::vector(mLayer));
+        cache.get(mAgentBounds, mTilePosition, *mRecastMesh);
+        const TileLayerCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mGetCount, 2);
+        EXPECT_EQ(stats.mHitCount, 1);
+        EXPECT_EQ(stats.mItems, 1);
+        EXPECT_EQ(stats.mSize, mItemSize);
+    }
+}
@@ -0,0 +1,180 @@
+#include <components/esm/defs.hpp>
+#include <components/esm3/compressedsavedgame.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/esm3/formatversion.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr int cellsCount = 200;
+
+        std::string generateData(std::minstd_rand& random, std::size_t size)
+        {
+            // Limited alphabet to make the data compressible
+            std::uniform_int_distribution<int> distribution('a', 'h');
+            std::string result(size, '\0');
+            std::generate(result.begin(), result.end(), [&] { return static_cast<char>(distribution(random)); });
+            return result;
+        }
+
+        std::string makeSavedGame()
+        {
+            std::minstd_rand random;
+            std::ostringstream stream;
+
+            ESMWriter writer;
+            writer.setFormatVersion(CurrentSaveGameFormatVersion);
+            writer.save(stream);
+
+            writer.startRecord(REC_SAVE);
+            writer.writeHNString("PLNA", "player");
+            writer.endRecord(REC_SAVE);
+
+            for (int i = 0; i < 10; ++i)
+            {
+                writer.startRecord(REC_GLOB);
+                writer.writeHNString("DATA", generateData(random, 100));
+                writer.endRecord(REC_GLOB);
+            }
+
+            for (int i = 0; i < cellsCount; ++i)
+            {
+                writer.startRecord(REC_CSTA);
+                writer.writeCellId(RefId::esm3ExteriorCell(i, -i));
+                writer.writeHNString("DATA", generateData(random, 4000));
+                writer.endRecord(REC_CSTA);
+            }
+
+            writer.startRecord(REC_GSCR);
+            writer.writeHNString("DATA", generateData(random, 100));
+            writer.endRecord(REC_GSCR);
+
+            writer.close();
+            return stream.str();
+        }
+
+        struct Esm3CompressedSavedGameTest : Test
+        {
+            const std::string mRecords = makeSavedGame();
+        };
+
+        TEST_F(Esm3CompressedSavedGameTest, readAllShouldReturnWrittenRecords)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            CompressedSavedGameReader reader(stream);
+            EXPECT_EQ(reader.getSize(), mRecords.size());
+            EXPECT_EQ(reader.readAll(1), mRecords);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, parallelCompressionAndDecompressionShouldProduceSameResult)
+        {
+            std::stringstream serial;
+            writeCompressedSavedGame(mRecords, serial, 1);
+            std::stringstream parallel;
+            writeCompressedSavedGame(mRecords, parallel, 4);
+            EXPECT_EQ(serial.str(), parallel.str());
+            CompressedSavedGameReader reader(parallel);
+            EXPECT_EQ(reader.readAll(4), mRecords);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, compressedSavedGameShouldBeSmaller)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            EXPECT_LT(stream.str().size(), mRecords.size());
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, readProfileShouldReturnOnlyHeaderAndProfile)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            CompressedSavedGameReader reader(stream);
+            const std::string profile = reader.readProfile();
+            ASSERT_LT(profile.size(), mRecords.size());
+            EXPECT_EQ(profile, mRecords.substr(0, profile.size()));
+            EXPECT_EQ(reader.getIndex().mChunks.front().mRecordCount, 2);
+            EXPECT_NE(profile.find("PLNA"), std::string::npos);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, indexShouldSplitRecordsByTypeAndSize)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            CompressedSavedGameReader reader(stream);
+            const SavedGameIndex& index = reader.getIndex();
+
+            ASSERT_GE(index.mChunks.size(), 5);
+            EXPECT_EQ(index.mChunks[1].mRecordType, REC_GLOB);
+            EXPECT_EQ(index.mChunks[1].mRecordCount, 10);
+            EXPECT_EQ(index.mChunks.back().mRecordType, REC_GSCR);
+
+            std::uint32_t cellRecords = 0;
+            for (const SavedGameChunk& chunk : index.mChunks)
+            {
+                EXPECT_LE(chunk.mSize, 256 * 1024);
+                if (chunk.mRecordType == REC_CSTA)
+                    cellRecords += chunk.mRecordCount;
+            }
+            EXPECT_EQ(cellRecords, cellsCount);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, indexShouldMapCellsToChunks)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            CompressedSavedGameReader reader(stream);
+            const SavedGameIndex& index = reader.getIndex();
+
+            ASSERT_EQ(index.mCells.size(), cellsCount);
+            for (int i = 0; i < cellsCount; ++i)
+            {
+                const auto& [cellId, chunk] = index.mCells[i];
+                EXPECT_EQ(cellId, RefId::esm3ExteriorCell(i, -i));
+                ASSERT_LT(chunk, index.mChunks.size());
+                EXPECT_EQ(index.mChunks[chunk].mRecordType, REC_CSTA);
+            }
+            EXPECT_NE(index.mCells.front().second, index.mCells.back().second);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, isCompressedSavedGameShouldDetectFormat)
+        {
+            std::stringstream compressed;
+            writeCompressedSavedGame(mRecords, compressed, 1);
+            EXPECT_TRUE(isCompressedSavedGame(compressed));
+            EXPECT_EQ(compressed.tellg(), 0);
+
+            std::istringstream plain(mRecords);
+            EXPECT_FALSE(isCompressedSavedGame(plain));
+            EXPECT_EQ(plain.tellg(), 0);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, readAllShouldThrowOnTruncatedData)
+        {
+            std::stringstream stream;
+            writeCompressedSavedGame(mRecords, stream, 1);
+            std::string data = stream.str();
+            data.resize(data.size() - 10);
+            std::istringstream truncated(data);
+            CompressedSavedGameReader reader(truncated);
+            EXPECT_THROW(reader.readAll(1), std::runtime_error);
+        }
+
+        TEST_F(Esm3CompressedSavedGameTest, readerShouldThrowOnPlainSavedGame)
+        {
+            std::istringstream stream(mRecords);
+            EXPECT_THROW(CompressedSavedGameReader{ stream }, std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#include <components/esm3/fogstate.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace ESM
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        constexpr std::size_t fogSize = 32 * 32;
+
+        TEST(Esm3FogOfWarTest, packShouldStoreUniformFogInFewBytes)
+        {
+            const std::vector<std::uint8_t> alpha(fogSize, 0);
+            EXPECT_LE(packFogOfWar(alpha).size(), 16);
+        }
+
+        TEST(Esm3FogOfWarTest, unpackShouldRestorePackedValues)
+        {
+            std::minstd_rand random;
+            std::uniform_int_distribution<unsigned> distribution(0, 255);
+            for (std::size_t runLength : { 1, 2, 3, 127, 128, 129, 130, 131, 300 })
+            {
+                std::vector<std::uint8_t> alpha(fogSize);
+                for (std::size_t i = 0; i < alpha.size();)
+                {
+                    const std::uint8_t value = static_cast<std::uint8_t>(distribution(random));
+                    const std::size_t length = std::min(runLength, alpha.size() - i);
+                    std::fill_n(alpha.begin() + i, length, value);
+                    i += length;
+                }
+                const std::vector<char> packed = packFogOfWar(alpha);
+                std::vector<std::uint8_t> result(alpha.size());
+                ASSERT_TRUE(unpackFogOfWar(packed, result)) << runLength;
+                EXPECT_EQ(result, alpha) << runLength;
+            }
+        }
+
+        TEST(Esm3FogOfWarTest, unpackShouldRejectDataForDifferentSize)
+        {
+            const std::vector<char> packed = packFogOfWar(std::vector<std::uint8_t>(fogSize, 0xff));
+            std::vector<std::uint8_t> smaller(fogSize - 1);
+            EXPECT_FALSE(unpackFogOfWar(packed, smaller));
+            std::vector<std::uint8_t> larger(fogSize + 1);
+            EXPECT_FALSE(unpackFogOfWar(packed, larger));
+        }
+
+        TEST(Esm3FogOfWarTest, unpackShouldRejectTruncatedData)
+        {
+            std::vector<std::uint8_t> alpha(fogSize);
+            std::iota(alpha.begin(), alpha.end(), 0);
+            std::vector<char> packed = packFogOfWar(alpha);
+            packed.pop_back();
+            std::vector<std::uint8_t> result(fogSize);
+            EXPECT_FALSE(unpackFogOfWar(packed, result));
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <components/esm3/effectlist.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
+#include <components/esm3/fogstate.hpp>
 #include <components/esm3/loadcont.hpp>
 #include <components/esm3/loaddial.hpp>
 #include <components/esm3/loadinfo.hpp>
@@ -115,6 +116,11 @@ namespace ESM
             record.save(writer, true);
         }
 
+        void save(const FogState& record, ESMWriter& writer)
+        {
+            record.save(writer, true);
+        }
+
         template <NotHasSave T>
         auto save(const T& record, ESMWriter& writer)
         {
@@ -286,6 +292,43 @@ namespace ESM
             EXPECT_EQ(result.mNumShorts, record.mNumShorts);
         }
 
+        TEST_F(Esm3SaveLoadRecordTest, fogStateShouldNotChange)
+        {
+            std::vector<std::uint8_t> alpha(32 * 32, 0xff);
+            std::fill_n(alpha.begin() + 100, 300, 0);
+            generateBytes(alpha.begin() + 400, 50);
+
+            FogState record;
+            record.mNorthMarkerAngle = 1.5f;
+            record.mBounds = { -1024, -2048, 3072, 4096 };
+            record.mCenterX = 42;
+            record.mCenterY = 13;
+            record.mFogTextures.push_back(FogTexture{ 1, 2, packFogOfWar(alpha) });
+            record.mFogTextures.push_back(FogTexture{ 3, 4, {} });
+
+            FogState result;
+            saveAndLoadRecord(record, CurrentSaveGameFormatVersion, result);
+
+            EXPECT_EQ(result.mNorthMarkerAngle, record.mNorthMarkerAngle);
+            EXPECT_EQ(result.mBounds.mMinX, record.mBounds.mMinX);
+            EXPECT_EQ(result.mBounds.mMinY, record.mBounds.mMinY);
+            EXPECT_EQ(result.mBounds.mMaxX, record.mBounds.mMaxX);
+            EXPECT_EQ(result.mBounds.mMaxY, record.mBounds.mMaxY);
+            EXPECT_EQ(result.mCenterX, record.mCenterX);
+            EXPECT_EQ(result.mCenterY, record.mCenterY);
+            ASSERT_EQ(result.mFogTextures.size(), record.mFogTextures.size());
+            for (std::size_t i = 0; i < result.mFogTextures.size(); ++i)
+            {
+                EXPECT_EQ(result.mFogTextures[i].mX, record.mFogTextures[i].mX);
+                EXPECT_EQ(result.mFogTextures[i].mY, record.mFogTextures[i].mY);
+                EXPECT_EQ(result.mFogTextures[i].mImageData, record.mFogTextures[i].mImageData);
+            }
+
+            std::vector<std::uint8_t> unpacked(alpha.size());
+            ASSERT_TRUE(unpackFogOfWar(result.mFogTextures[0].mImageData, unpacked));
+            EXPECT_EQ(unpacked, alpha);
+        }
+
         TEST_P(Esm3SaveLoadRecordTest, playerShouldNotChange)
         {
             // Player state is not saved to vanilla ESM format.
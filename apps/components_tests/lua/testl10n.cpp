@@ -7,6 +7,10 @@
 #include <components/lua/luastate.hpp>
 #include <components/testing/util.hpp>
 
+#include <barrier>
+#include <thread>
+#include <vector>
+
 namespace
 {
     using namespace testing;
@@ -197,4 +201,39 @@ speed: "Speed"
                 "Your Speed has increased to 100");
         });
     }
+
+    TEST_F(LuaL10nTest, L10nInSeveralStatesInParallel)
+    {
+        // Local scripts of different partitions run in parallel and share the manager
+        constexpr std::size_t threadsCount = 4;
+        constexpr int roundsCount = 50;
+        internal::CaptureStdout();
+        L10n::Manager l10nManager(mVFS.get());
+        l10nManager.setPreferredLocales({ "de", "en" });
+        std::barrier roundBarrier(threadsCount, [&]() noexcept { l10nManager.dropCache(); });
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < threadsCount; ++i)
+        {
+            threads.emplace_back([&] {
+                LuaUtil::LuaState lua{ mVFS.get(), &mCfg };
+                lua.protectedCall([&](LuaUtil::LuaView& view) {
+                    sol::state_view& l = view.sol();
+                    l["l10n"] = LuaUtil::initL10nLoader(l, &l10nManager);
+                    for (int round = 0; round < roundsCount; ++round)
+                    {
+                        EXPECT_EQ(get<std::string>(l, "l10n('Test1')('good_morning')"), "Guten Morgen.");
+                        EXPECT_EQ(get<std::string>(l, "l10n('Test2')('you_have_arrows', {count=3})"),
+                            "Arrows count: 3");
+                        EXPECT_EQ(get<std::string>(l, "l10n('Test3', 'de')('Hello {name}!', {name='World'})"),
+                            "Hallo World!");
+                        EXPECT_EQ(get<std::string>(l, "l10n('Test4', 'ru')('speed')"), "Speed");
+                        roundBarrier.arrive_and_wait();
+                    }
+                });
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        internal::GetCapturedStdout();
+    }
 }
@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <fstream>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -84,6 +85,29 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, ReadOnlySectionInSeveralStates)
+    {
+        LuaUtil::LuaState luaState1{ nullptr, nullptr };
+        LuaUtil::LuaState luaState2{ nullptr, nullptr };
+        LuaUtil::LuaStorage storage;
+        storage.setActive(true);
+        luaState1.protectedCall([&](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            lua["mutable"] = storage.getMutableSection(lua, "test");
+            lua["ro"] = storage.getReadOnlySection(lua, "test");
+            lua.safe_script("mutable:set('x', { y = 'abc' })");
+            EXPECT_EQ(get<std::string>(lua, "ro:get('x').y"), "abc");
+        });
+        luaState2.protectedCall([&](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            auto& lua = view.sol();
+            lua["ro"] = storage.getReadOnlySection(lua, "test");
+            EXPECT_EQ(get<std::string>(lua, "ro:get('x').y"), "abc");
+            EXPECT_TRUE(get<bool>(lua, "ro:get('x') == ro:get('x')"));
+        });
+    }
+
     TEST(LuaUtilStorageTest, Saving)
     {
         LuaUtil::LuaState luaState{ nullptr, nullptr };
@@ -100,7 +124,7 @@ namespace
             lua.safe_script("temporary:set('y', 2)");
 
             const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage.bin";
-            storage.save(lua, tmpFile);
+            storage.save(tmpFile);
             EXPECT_EQ(get<int>(lua, "permanent:get('x')"), 1);
             EXPECT_EQ(get<int>(lua, "temporary:get('y')"), 2);
 
@@ -125,4 +149,67 @@ namespace
         });
     }
 
+    TEST(LuaUtilStorageTest, IncrementalSaving)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            LuaUtil::LuaStorage storage;
+            auto& lua = view.sol();
+            storage.setActive(true);
+
+            lua["a"] = storage.getMutableSection(lua, "a");
+            lua["b"] = storage.getMutableSection(lua, "b");
+            lua.safe_script("a:set('x', 1)");
+            lua.safe_script("b:set('y', { z = 'abc' })");
+
+            const auto tmpFile = std::filesystem::temp_directory_path() / "test_incremental_storage.bin";
+            storage.save(tmpFile);
+            const std::uintmax_t initialSize = std::filesystem::file_size(tmpFile);
+            storage.save(tmpFile);
+            EXPECT_EQ(std::filesystem::file_size(tmpFile), initialSize);
+
+            lua.safe_script("a:set('x', 2)");
+            storage.save(tmpFile);
+            EXPECT_GT(std::filesystem::file_size(tmpFile), initialSize);
+
+            lua.safe_script("b:reset()");
+            storage.save(tmpFile);
+
+            LuaUtil::LuaStorage storage2;
+            storage2.setActive(true);
+            storage2.load(lua, tmpFile);
+            lua["a"] = storage2.getMutableSection(lua, "a");
+            lua["b"] = storage2.getMutableSection(lua, "b");
+            EXPECT_EQ(get<int>(lua, "a:get('x')"), 2);
+            EXPECT_TRUE(get<bool>(lua, "b:get('y') == nil"));
+        });
+    }
+
+    TEST(LuaUtilStorageTest, LoadingTruncatedFile)
+    {
+        LuaUtil::LuaState luaState{ nullptr, nullptr };
+        luaState.protectedCall([](LuaUtil::LuaView& view) {
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            LuaUtil::LuaStorage storage;
+            auto& lua = view.sol();
+            storage.setActive(true);
+
+            lua["a"] = storage.getMutableSection(lua, "a");
+            lua.safe_script("a:set('x', 1)");
+            const auto tmpFile = std::filesystem::temp_directory_path() / "test_truncated_storage.bin";
+            storage.save(tmpFile);
+            {
+                std::ofstream stream(tmpFile, std::ios::binary | std::ios::app);
+                stream.write("\x05\x00\x00", 3);
+            }
+
+            LuaUtil::LuaStorage storage2;
+            storage2.setActive(true);
+            storage2.load(lua, tmpFile);
+            lua["a"] = storage2.getMutableSection(lua, "a");
+            EXPECT_EQ(get<int>(lua, "a:get('x')"), 1);
+        });
+    }
+
 }
@@ -0,0 +1,135 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/lua/timerwheel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    std::vector<int> process(LuaUtil::TimerWheel<int>& wheel, double now)
+    {
+        std::vector<int> result;
+        wheel.process(now, [&](int value) { result.push_back(value); });
+        return result;
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldCallExpiredTimersInOrderOfTime)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        wheel.insert(2.5, 3);
+        wheel.insert(0.5, 1);
+        wheel.insert(100, 5);
+        wheel.insert(1.5, 2);
+        wheel.insert(7, 4);
+        EXPECT_THAT(process(wheel, 0), IsEmpty());
+        EXPECT_THAT(process(wheel, 3), ElementsAre(1, 2, 3));
+        EXPECT_EQ(wheel.size(), 2u);
+        EXPECT_THAT(process(wheel, 99), ElementsAre(4));
+        EXPECT_THAT(process(wheel, 100), ElementsAre(5));
+        EXPECT_TRUE(wheel.empty());
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldCallTimersWithSameTimeInOrderOfInsertion)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        for (int i = 0; i < 10; ++i)
+            wheel.insert(i % 2 == 0 ? 10 : 2, i);
+        EXPECT_THAT(process(wheel, 20), ElementsAre(1, 3, 5, 7, 9, 0, 2, 4, 6, 8));
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldCallTimerInsertedInThePast)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        EXPECT_THAT(process(wheel, 50), IsEmpty());
+        wheel.insert(60, 2);
+        wheel.insert(10, 1);
+        EXPECT_FALSE(wheel.advance(5));
+        EXPECT_THAT(process(wheel, 50), ElementsAre(1));
+        EXPECT_THAT(process(wheel, 60), ElementsAre(2));
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldCallExpiredTimersInsertedByCallback)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        wheel.insert(1, 1);
+        wheel.insert(3, 3);
+        std::vector<int> result;
+        wheel.process(5, [&](int value) {
+            result.push_back(value);
+            if (value == 1)
+            {
+                wheel.insert(2, 2);
+                wheel.insert(6, 4);
+            }
+        });
+        EXPECT_THAT(result, ElementsAre(1, 2, 3));
+        EXPECT_EQ(wheel.size(), 1u);
+    }
+
+    TEST(LuaUtilTimerWheelTest, advanceShouldReportOnlyExpiredTimers)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        EXPECT_FALSE(wheel.advance(10));
+        wheel.insert(12.5, 1);
+        EXPECT_FALSE(wheel.advance(12));
+        EXPECT_FALSE(wheel.advance(12.4));
+        EXPECT_TRUE(wheel.advance(12.5));
+        EXPECT_EQ(wheel.size(), 1u);
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldNeverCallTimerWithNaNTime)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        wheel.insert(std::nan(""), 1);
+        wheel.insert(1, 2);
+        EXPECT_THAT(process(wheel, 1e300), ElementsAre(2));
+        EXPECT_EQ(wheel.size(), 1u);
+    }
+
+    TEST(LuaUtilTimerWheelTest, forEachShouldVisitAllTimers)
+    {
+        LuaUtil::TimerWheel<int> wheel(1, 4);
+        wheel.insert(1, 1);
+        wheel.insert(100, 2);
+        std::vector<std::pair<double, int>> timers;
+        wheel.forEach([&](double time, int value) { timers.emplace_back(time, value); });
+        EXPECT_THAT(timers, UnorderedElementsAre(Pair(1, 1), Pair(100, 2)));
+        wheel.clear();
+        EXPECT_TRUE(wheel.empty());
+        EXPECT_THAT(process(wheel, 100), IsEmpty());
+    }
+
+    TEST(LuaUtilTimerWheelTest, shouldMatchSortedOrderForRandomTimes)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<double> distribution(-10, 1000);
+        LuaUtil::TimerWheel<int> wheel(0.5, 16);
+        std::vector<std::pair<double, int>> expected;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const double time = distribution(random);
+            wheel.insert(time, i);
+            expected.emplace_back(time, i);
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const auto& l, const auto& r) { return l.first < r.first; });
+        std::vector<int> result;
+        for (double now = -10; now <= 1000; now += 3.7)
+        {
+            const std::vector<int> processed = process(wheel, now);
+            result.insert(result.end(), processed.begin(), processed.end());
+        }
+        const std::vector<int> processed = process(wheel, 1000);
+        result.insert(result.end(), processed.begin(), processed.end());
+        ASSERT_EQ(result.size(), expected.size());
+        for (std::size_t i = 0; i < result.size(); ++i)
+            EXPECT_EQ(result[i], expected[i].second) << i;
+    }
+}
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <stdexcept>
 
 namespace
 {
@@ -28,4 +29,22 @@ namespace
         const std::vector<std::byte> decompressed = decompress(compressed);
         EXPECT_EQ(decompressed, data);
     }
+
+    TEST(MiscCompressionTest, decompressBlockIsInverseToCompressBlock)
+    {
+        const std::vector<std::byte> data(1024);
+        const std::vector<std::byte> compressed = compressBlock(data);
+        EXPECT_LT(compressed.size(), data.size());
+        std::vector<std::byte> decompressed(data.size());
+        decompressBlock(compressed, decompressed);
+        EXPECT_EQ(decompressed, data);
+    }
+
+    TEST(MiscCompressionTest, decompressBlockShouldThrowWhenBufferSizeDoesNotMatch)
+    {
+        const std::vector<std::byte> data(1024);
+        const std::vector<std::byte> compressed = compressBlock(data);
+        std::vector<std::byte> decompressed(data.size() + 1);
+        EXPECT_THROW(decompressBlock(compressed, decompressed), std::runtime_error);
+    }
 }
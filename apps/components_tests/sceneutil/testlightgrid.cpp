@@ -0,0 +1,97 @@
+#include <components/sceneutil/lightgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        using namespace ::testing;
+
+        std::vector<std::size_t> queryEach(
+            const std::vector<osg::BoundingSphere>& lights, const osg::BoundingSphere& bound)
+        {
+            std::vector<std::size_t> result;
+            for (std::size_t i = 0; i < lights.size(); ++i)
+                if (lights[i].intersects(bound))
+                    result.push_back(i);
+            return result;
+        }
+
+        std::vector<osg::BoundingSphere> generateBounds(std::size_t count, float maxRadius, std::mt19937& random)
+        {
+            std::uniform_real_distribution<float> coordinate(-2048, 2048);
+            std::uniform_real_distribution<float> radius(1, maxRadius);
+            std::vector<osg::BoundingSphere> result;
+            for (std::size_t i = 0; i < count; ++i)
+                result.emplace_back(
+                    osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)), radius(random));
+            return result;
+        }
+
+        TEST(SceneUtilLightGridTest, queryShouldReturnNothingWhenEmpty)
+        {
+            LightGrid grid;
+            grid.build();
+            std::vector<std::size_t> result;
+            grid.query(osg::BoundingSphere(osg::Vec3f(), 1), result);
+            EXPECT_THAT(result, IsEmpty());
+        }
+
+        TEST(SceneUtilLightGridTest, queryShouldReturnIntersectingLightsForFewLights)
+        {
+            LightGrid grid;
+            grid.add(osg::BoundingSphere(osg::Vec3f(0, 0, 0), 10));
+            grid.add(osg::BoundingSphere(osg::Vec3f(100, 0, 0), 10));
+            grid.add(osg::BoundingSphere(osg::Vec3f(15, 0, 0), 10));
+            grid.build();
+            std::vector<std::size_t> result;
+            grid.query(osg::BoundingSphere(osg::Vec3f(5, 0, 0), 1), result);
+            EXPECT_THAT(result, ElementsAre(0, 2));
+        }
+
+        TEST(SceneUtilLightGridTest, queryShouldReturnSameLightsAsTestingEachLight)
+        {
+            std::mt19937 random;
+            const std::vector<osg::BoundingSphere> lights = generateBounds(200, 512, random);
+            LightGrid grid;
+            for (const osg::BoundingSphere& light : lights)
+                grid.add(light);
+            grid.build();
+            std::vector<std::size_t> result;
+            for (const osg::BoundingSphere& object : generateBounds(1000, 256, random))
+            {
+                grid.query(object, result);
+                EXPECT_EQ(result, queryEach(lights, object));
+            }
+        }
+
+        TEST(SceneUtilLightGridTest, queryShouldHandleObjectsOutsideOfLightsBounds)
+        {
+            std::mt19937 random;
+            LightGrid grid;
+            for (const osg::BoundingSphere& light : generateBounds(50, 64, random))
+                grid.add(light);
+            grid.build();
+            std::vector<std::size_t> result;
+            grid.query(osg::BoundingSphere(osg::Vec3f(1e5f, 1e5f, 1e5f), 10), result);
+            EXPECT_THAT(result, IsEmpty());
+        }
+
+        TEST(SceneUtilLightGridTest, queryShouldReturnNothingForInvalidBound)
+        {
+            std::mt19937 random;
+            LightGrid grid;
+            for (const osg::BoundingSphere& light : generateBounds(50, 64, random))
+                grid.add(light);
+            grid.build();
+            std::vector<std::size_t> result;
+            grid.query(osg::BoundingSphere(), result);
+            EXPECT_THAT(result, IsEmpty());
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include <components/shader/defineset.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace Shader;
+
+    TEST(ShaderDefineAtomTest, same_strings_should_be_interned_to_equal_atoms)
+    {
+        const std::string value = "diffuseMap";
+        EXPECT_EQ(DefineAtom("diffuseMap"), DefineAtom(value));
+        EXPECT_EQ(&DefineAtom("diffuseMap").getValue(), &DefineAtom(value).getValue());
+        EXPECT_EQ(DefineAtom("diffuseMap").getValue(), value);
+    }
+
+    TEST(ShaderDefineAtomTest, different_strings_should_be_interned_to_different_atoms)
+    {
+        EXPECT_FALSE(DefineAtom("diffuseMap") == DefineAtom("normalMap"));
+    }
+
+    TEST(ShaderDefineSetTest, get_should_return_set_value)
+    {
+        DefineSet defines;
+        defines.set("parallax", "1");
+        EXPECT_EQ(defines.get(DefineAtom("parallax")), DefineAtom("1"));
+        EXPECT_EQ(defines.get(DefineAtom("absent")), std::nullopt);
+    }
+
+    TEST(ShaderDefineSetTest, set_should_replace_existing_value)
+    {
+        DefineSet defines;
+        defines.set("parallax", "1");
+        defines.set("parallax", "0");
+        EXPECT_EQ(defines.size(), 1);
+        EXPECT_EQ(defines.get(DefineAtom("parallax")), DefineAtom("0"));
+    }
+
+    TEST(ShaderDefineSetTest, sets_with_same_values_should_be_equal_regardless_of_order)
+    {
+        DefineSet lhs;
+        lhs.set("a", "1");
+        lhs.set("b", "2");
+        lhs.set("c", "3");
+        DefineSet rhs;
+        rhs.set("c", "0");
+        rhs.set("b", "2");
+        rhs.set("a", "1");
+        rhs.set("c", "3");
+        EXPECT_EQ(lhs, rhs);
+        EXPECT_EQ(lhs.getHash(), rhs.getHash());
+    }
+
+    TEST(ShaderDefineSetTest, sets_with_different_values_should_not_be_equal)
+    {
+        DefineSet lhs;
+        lhs.set("a", "1");
+        DefineSet rhs;
+        rhs.set("a", "0");
+        EXPECT_FALSE(lhs == rhs);
+        EXPECT_NE(lhs.getHash(), rhs.getHash());
+    }
+
+    TEST(ShaderDefineSetTest, clear_should_remove_values)
+    {
+        DefineSet defines;
+        defines.set("a", "1");
+        defines.clear();
+        EXPECT_EQ(defines, DefineSet());
+    }
+
+    TEST(ShaderDefineSetTest, to_map_should_return_all_values)
+    {
+        const DefineSet::DefineMap map{ { "a", "1" }, { "b", "0" }, { "numViews", "2" } };
+        EXPECT_EQ(DefineSet(map).toMap(), map);
+    }
+}
@@ -0,0 +1,122 @@
+#include <components/shader/shadercache.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+
+namespace
+{
+    using namespace testing;
+    using namespace Shader;
+
+    struct ShaderCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePathWithSubDir(
+            std::filesystem::path("shadercache") / UnitTest::GetInstance()->current_test_info()->name());
+
+        ShaderCacheTest() { std::filesystem::remove_all(mPath); }
+    };
+
+    TEST_F(ShaderCacheTest, get_source_should_return_nullopt_for_absent_key)
+    {
+        const ShaderCache cache(mPath, "driver");
+        EXPECT_EQ(cache.getSource(42), std::nullopt);
+    }
+
+    TEST_F(ShaderCacheTest, get_source_should_return_added_source)
+    {
+        const ShaderCache cache(mPath, "driver");
+        const ShaderCache::Source source{
+            .mSource = "void main() {}\n",
+            .mLinkedShaderTemplateNames = { "lib/a.glsl", "lib/b.glsl" },
+        };
+        cache.addSource(42, source);
+        const std::optional<ShaderCache::Source> result = cache.getSource(42);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mSource, source.mSource);
+        EXPECT_EQ(result->mLinkedShaderTemplateNames, source.mLinkedShaderTemplateNames);
+    }
+
+    TEST_F(ShaderCacheTest, get_program_binary_should_return_added_binary)
+    {
+        const ShaderCache cache(mPath, "driver");
+        const ShaderCache::ProgramBinary binary{ .mFormat = 0x8741, .mData = { 0, 1, 2, 255 } };
+        cache.addProgramBinary(13, binary);
+        const std::optional<ShaderCache::ProgramBinary> result = cache.getProgramBinary(13);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mFormat, binary.mFormat);
+        EXPECT_EQ(result->mData, binary.mData);
+    }
+
+    TEST_F(ShaderCacheTest, previous_variants_should_be_loaded_from_saved_variants)
+    {
+        const ShaderCache::ProgramVariant variant{
+            .mVertexTemplate = "objects.vert",
+            .mVertexDefines = { { "forcePPL", "1" } },
+            .mFragmentTemplate = "objects.frag",
+            .mFragmentDefines = { { "forcePPL", "1" }, { "normalMap", "0" } },
+        };
+        {
+            ShaderCache cache(mPath, "driver");
+            EXPECT_TRUE(cache.getPreviousVariants().empty());
+            cache.addVariant(ShaderCache::ProgramVariant(variant));
+            cache.addVariant(ShaderCache::ProgramVariant(variant));
+            cache.saveVariants();
+        }
+        const ShaderCache cache(mPath, "driver");
+        EXPECT_EQ(cache.getPreviousVariants(), std::vector<ShaderCache::ProgramVariant>{ variant });
+    }
+
+    TEST_F(ShaderCacheTest, program_key_should_depend_on_driver)
+    {
+        const std::vector<std::string_view> sources{ "vertex", "fragment" };
+        EXPECT_NE(ShaderCache(mPath, "a").makeProgramKey(sources), ShaderCache(mPath, "b").makeProgramKey(sources));
+        EXPECT_EQ(ShaderCache(mPath, "a").makeProgramKey(sources), ShaderCache(mPath, "a").makeProgramKey(sources));
+    }
+
+    TEST_F(ShaderCacheTest, source_key_should_depend_on_defines)
+    {
+        const ShaderCache::DefineMap defines{ { "a", "1" } };
+        EXPECT_NE(ShaderCache::makeSourceKey("source", defines, {}), ShaderCache::makeSourceKey("source", {}, defines));
+        EXPECT_NE(ShaderCache::makeSourceKey("source", defines, {}), ShaderCache::makeSourceKey("source", {}, {}));
+        EXPECT_EQ(ShaderCache::makeSourceKey("source", defines, {}), ShaderCache::makeSourceKey("source", defines, {}));
+    }
+
+    TEST_F(ShaderCacheTest, corrupted_file_should_be_ignored)
+    {
+        const ShaderCache cache(mPath, "driver");
+        cache.addSource(1, ShaderCache::Source{ .mSource = "source" });
+        std::filesystem::resize_file(mPath / "sources" / "0000000000000001", 10);
+        EXPECT_EQ(cache.getSource(1), std::nullopt);
+    }
+
+    TEST_F(ShaderCacheTest, removed_program_binary_should_not_be_returned)
+    {
+        const ShaderCache cache(mPath, "driver");
+        cache.addProgramBinary(13, ShaderCache::ProgramBinary{ .mFormat = 0x8741, .mData = { 1 } });
+        cache.removeProgramBinary(13);
+        EXPECT_EQ(cache.getProgramBinary(13), std::nullopt);
+    }
+
+    TEST_F(ShaderCacheTest, prune_should_remove_only_old_unused_files)
+    {
+        const ShaderCache::ProgramBinary binary{ .mFormat = 0x8741, .mData = { 1 } };
+        const auto old = std::filesystem::file_time_type::clock::now() - std::chrono::hours(24 * 365);
+        {
+            const ShaderCache cache(mPath, "driver");
+            cache.addProgramBinary(1, binary);
+            cache.addProgramBinary(2, binary);
+            cache.addProgramBinary(3, binary);
+        }
+        std::filesystem::last_write_time(mPath / "programs" / "0000000000000001", old);
+        std::filesystem::last_write_time(mPath / "programs" / "0000000000000002", old);
+        const ShaderCache cache(mPath, "driver");
+        ASSERT_TRUE(cache.getProgramBinary(2).has_value());
+        cache.prune();
+        EXPECT_FALSE(std::filesystem::exists(mPath / "programs" / "0000000000000001"));
+        EXPECT_TRUE(std::filesystem::exists(mPath / "programs" / "0000000000000002"));
+        EXPECT_TRUE(std::filesystem::exists(mPath / "programs" / "0000000000000003"));
+    }
+}
@@ -231,4 +231,31 @@ namespace
             EXPECT_FALSE(mManager.getShader(Files::pathToUnicodeString(templateName), mDefines));
         });
     }
+
+    TEST_F(ShaderManagerTest, set_same_global_defines_should_keep_program_binaries)
+    {
+        const std::string content
+            = "#version 120\n"
+              "#define FLAG @flag\n"
+              "void main() {}\n";
+
+        withShaderFile(content, [&](const std::filesystem::path& templateName) {
+            ShaderManager::DefineMap defines = mManager.getGlobalDefines();
+            defines["flag"] = "1";
+            mManager.setGlobalDefines(defines);
+
+            const std::string name = Files::pathToUnicodeString(templateName);
+            const auto vertex = mManager.getShader(name, mDefines, osg::Shader::VERTEX);
+            ASSERT_TRUE(vertex);
+            const auto program = mManager.getProgram(vertex, vertex);
+            program->setProgramBinary(new osg::Program::ProgramBinary);
+
+            mManager.setGlobalDefines(defines);
+            EXPECT_NE(program->getProgramBinary(), nullptr);
+
+            defines["flag"] = "0";
+            mManager.setGlobalDefines(defines);
+            EXPECT_EQ(program->getProgramBinary(), nullptr);
+        });
+    }
 }
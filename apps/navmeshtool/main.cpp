@@ -116,6 +116,9 @@ namespace NavMeshTool
             addOption("remove-unused-tiles", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "remove tiles from cache that will not be used with current content profile");
 
+            addOption("max-memory-usage", bpo::value<std::size_t>()->default_value(0),
+                "pause loading cells while process resident memory is above this value in MiB, 0 means no limit");
+
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
@@ -179,6 +182,7 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const std::size_t maxMemoryUsage = variables["max-memory-usage"].as<std::size_t>() * 1024 * 1024;
 
 #ifdef WIN32
             if (writeBinaryLog)
@@ -229,11 +233,11 @@ namespace NavMeshTool
             navigatorSettings.mRecast.mSwimHeightScale
                 = EsmLoader::getGameSetting(esmData.mGameSettings, "fSwimHeightScale").getFloat();
 
-            WorldspaceData cellsData = gatherWorldspaceData(
-                navigatorSettings, readers, vfs, bulletShapeManager, esmData, processInteriorCells, writeBinaryLog);
+            CellLoader cellLoader(readers, vfs, bulletShapeManager, esmData);
 
             const Status status = generateAllNavMeshTiles(agentBounds, navigatorSettings, threadsNumber,
-                removeUnusedTiles, writeBinaryLog, cellsData, std::move(db));
+                removeUnusedTiles, writeBinaryLog, processInteriorCells, maxMemoryUsage, esmData.mCells, cellLoader,
+                std::move(db));
 
             switch (status)
             {
@@ -0,0 +1,69 @@
+#include "memoryusage.hpp"
+
+#ifdef __linux__
+
+#include <fstream>
+
+#include <unistd.h>
+
+namespace NavMeshTool
+{
+    std::optional<std::size_t> getResidentSetSize()
+    {
+        std::ifstream stream("/proc/self/statm");
+        std::size_t size = 0;
+        std::size_t resident = 0;
+        if (!(stream >> size >> resident))
+            return std::nullopt;
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        if (pageSize <= 0)
+            return std::nullopt;
+        return resident * static_cast<std::size_t>(pageSize);
+    }
+}
+
+#elif defined(WIN32)
+
+#include <components/misc/windows.hpp>
+
+#include <psapi.h>
+
+namespace NavMeshTool
+{
+    std::optional<std::size_t> getResidentSetSize()
+    {
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return std::nullopt;
+        return static_cast<std::size_t>(counters.WorkingSetSize);
+    }
+}
+
+#elif defined(__APPLE__)
+
+#include <mach/mach.h>
+
+namespace NavMeshTool
+{
+    std::optional<std::size_t> getResidentSetSize()
+    {
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count)
+            != KERN_SUCCESS)
+            return std::nullopt;
+        return static_cast<std::size_t>(info.resident_size);
+    }
+}
+
+#else
+
+namespace NavMeshTool
+{
+    std::optional<std::size_t> getResidentSetSize()
+    {
+        return std::nullopt;
+    }
+}
+
+#endif
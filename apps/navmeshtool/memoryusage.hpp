@@ -0,0 +1,13 @@
+#ifndef OPENMW_NAVMESHTOOL_MEMORYUSAGE_H
+#define OPENMW_NAVMESHTOOL_MEMORYUSAGE_H
+
+#include <cstddef>
+#include <optional>
+
+namespace NavMeshTool
+{
+    // Returns resident set size of the current process in bytes or nothing if it's not supported by the platform
+    std::optional<std::size_t> getResidentSetSize();
+}
+
+#endif
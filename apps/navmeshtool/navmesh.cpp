@@ -1,5 +1,6 @@
 #include "navmesh.hpp"
 
+#include "memoryusage.hpp"
 #include "worldspacedata.hpp"
 
 #include <components/debug/debugging.hpp>
@@ -13,7 +14,10 @@
 #include <components/detournavigator/recastmeshprovider.hpp>
 #include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/settingsutils.hpp>
 #include <components/detournavigator/tileposition.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadland.hpp>
 #include <components/misc/progressreporter.hpp>
 #include <components/navmeshtool/protocol.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -21,11 +25,18 @@
 
 #include <osg/Vec3f>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <deque>
+#include <limits>
+#include <list>
+#include <map>
 #include <random>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -48,11 +59,26 @@ namespace NavMeshTool
         using DetourNavigator::TileVersion;
         using Sqlite3::Transaction;
 
-        void logGeneratedTiles(std::size_t provided, std::size_t expected)
+        // Objects may cross cell borders so neighbour cells rows are loaded as well to generate tiles
+        constexpr int cellsMargin = 1;
+
+        constexpr std::size_t bytesInMebibyte = 1024 * 1024;
+
+        double getSeconds(std::chrono::steady_clock::duration value)
+        {
+            return std::chrono::duration_cast<std::chrono::duration<double>>(value).count();
+        }
+
+        void logGeneratedTiles(std::size_t provided, std::size_t expected, std::chrono::steady_clock::duration elapsed)
         {
-            Log(Debug::Info) << provided << "/" << expected << " ("
-                             << (static_cast<double>(provided) / static_cast<double>(expected) * 100)
-                             << "%) navmesh tiles are generated";
+            Log log(Debug::Info);
+            log << provided << "/" << expected << " ("
+                << (static_cast<double>(provided) / static_cast<double>(expected) * 100)
+                << "%) navmesh tiles are generated";
+            if (const double seconds = getSeconds(elapsed); seconds > 0)
+                log << ", " << (static_cast<double>(provided) / seconds) << " tiles/s";
+            if (const std::optional<std::size_t> memoryUsage = getResidentSetSize())
+                log << ", memory usage " << (*memoryUsage / bytesInMebibyte) << " MiB";
         }
 
         template <class T>
@@ -70,7 +96,12 @@ namespace NavMeshTool
 
         struct LogGeneratedTiles
         {
-            void operator()(std::size_t provided, std::size_t expected) const { logGeneratedTiles(provided, expected); }
+            std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+
+            void operator()(std::size_t provided, std::size_t expected) const
+            {
+                logGeneratedTiles(provided, expected, std::chrono::steady_clock::now() - mStart);
+            }
         };
 
         class NavMeshTileConsumer final : public DetourNavigator::NavMeshTileConsumer
@@ -128,7 +159,7 @@ namespace NavMeshTool
                     std::lock_guard lock(mMutex);
                     mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
                 }
-                report();
+                report(worldspace, tilePosition);
             }
 
             void identity(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
@@ -139,7 +170,7 @@ namespace NavMeshTool
                     mDeleted += static_cast<std::size_t>(
                         mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
                 }
-                report();
+                report(worldspace, tilePosition);
             }
 
             void insert(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t version,
@@ -155,7 +186,7 @@ namespace NavMeshTool
                     ++mNextTileId;
                 }
                 ++mInserted;
-                report();
+                report(worldspace, tilePosition);
             }
 
             void update(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId,
@@ -170,7 +201,7 @@ namespace NavMeshTool
                     mDb.updateTile(TileId{ tileId }, TileVersion{ version }, serialize(data));
                 }
                 ++mUpdated;
-                report();
+                report(worldspace, tilePosition);
             }
 
             void cancel(std::string_view reason) override
@@ -183,23 +214,60 @@ namespace NavMeshTool
                 mHasTile.notify_one();
             }
 
+            void addPending(ESM::RefId worldspace, int tileRow, std::size_t count)
+            {
+                const std::lock_guard lock(mMutex);
+                mPending[std::make_tuple(worldspace, tileRow)] += count;
+                mExpected += count;
+            }
+
+            // Returns the lowest tile row with not yet generated tiles
+            std::optional<int> getMinPendingRow(ESM::RefId worldspace) const
+            {
+                const std::lock_guard lock(mMutex);
+                const auto it = mPending.lower_bound(std::make_tuple(worldspace, std::numeric_limits<int>::min()));
+                if (it == mPending.end() || std::get<0>(it->first) != worldspace)
+                    return std::nullopt;
+                return std::get<1>(it->first);
+            }
+
+            bool hasPending() const
+            {
+                const std::lock_guard lock(mMutex);
+                return !mPending.empty();
+            }
+
+            Status getStatus() const
+            {
+                const std::lock_guard lock(mMutex);
+                return mStatus;
+            }
+
+            void commitOnInterval()
+            {
+                const std::lock_guard lock(mMutex);
+                commitOnIntervalImpl();
+            }
+
+            // Waits until at least one more tile is generated
+            Status waitForProgress()
+            {
+                std::unique_lock lock(mMutex);
+                const std::size_t provided = mProvided;
+                mHasTile.wait(lock, [&] { return mProvided != provided || mPending.empty() || mStatus != Status::Ok; });
+                commitOnIntervalImpl();
+                return mStatus;
+            }
+
             Status wait()
             {
-                constexpr std::chrono::seconds transactionInterval(1);
                 std::unique_lock lock(mMutex);
-                auto start = std::chrono::steady_clock::now();
                 while (mProvided < mExpected && mStatus == Status::Ok)
                 {
                     mHasTile.wait(lock);
-                    const auto now = std::chrono::steady_clock::now();
-                    if (now - start > transactionInterval)
-                    {
-                        mTransaction.commit();
-                        mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
-                        start = now;
-                    }
+                    commitOnIntervalImpl();
                 }
-                logGeneratedTiles(mProvided, mExpected);
+                logGeneratedTiles(mProvided, mExpected, std::chrono::steady_clock::now() - mStart);
                 if (mWriteBinaryLog)
                     logGeneratedTilesMessage(mProvided);
                 return mStatus;
@@ -242,72 +310,347 @@ namespace NavMeshTool
             Misc::ProgressReporter<LogGeneratedTiles> mReporter;
             ShapeId mNextShapeId;
             std::mutex mReportMutex;
+            const std::chrono::steady_clock::time_point mStart = std::chrono::steady_clock::now();
+            std::chrono::steady_clock::time_point mLastCommit = mStart;
+            std::map<std::tuple<ESM::RefId, int>, std::size_t> mPending;
+
+            void commitOnIntervalImpl()
+            {
+                constexpr std::chrono::seconds transactionInterval(1);
+                const auto now = std::chrono::steady_clock::now();
+                if (now - mLastCommit <= transactionInterval)
+                    return;
+                mTransaction.commit();
+                mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
+                mLastCommit = now;
+            }
 
-            void report()
+            void report(ESM::RefId worldspace, const TilePosition& tilePosition)
             {
-                const std::size_t provided = mProvided.fetch_add(1, std::memory_order_relaxed) + 1;
+                const std::size_t provided = [&] {
+                    const std::lock_guard lock(mMutex);
+                    const auto it = mPending.find(std::make_tuple(worldspace, tilePosition.y()));
+                    if (it != mPending.end() && --it->second == 0)
+                        mPending.erase(it);
+                    return mProvided.fetch_add(1, std::memory_order_relaxed) + 1;
+                }();
                 mReporter(provided, mExpected);
-                mHasTile.notify_one();
+                mHasTile.notify_all();
                 if (mWriteBinaryLog)
                     logGeneratedTilesMessage(provided);
             }
         };
-    }
 
-    Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
-        bool removeUnusedTiles, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
-    {
-        Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
+        std::pair<int, int> getCellRows(const Settings& settings, int tileRow)
+        {
+            const DetourNavigator::TileBounds bounds
+                = DetourNavigator::makeRealTileBoundsWithBorder(settings.mRecast, TilePosition(0, tileRow));
+            const float cellSize = static_cast<float>(ESM::Land::REAL_SIZE);
+            return {
+                static_cast<int>(std::floor(bounds.mMin.y() / cellSize)) - cellsMargin,
+                static_cast<int>(std::floor(bounds.mMax.y() / cellSize)) + cellsMargin,
+            };
+        }
 
-        SceneUtil::WorkQueue workQueue(threadsNumber);
-        auto navMeshTileConsumer
-            = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog);
-        std::size_t tiles = 0;
-        std::mt19937_64 random;
+        struct LoadedWorldspace
+        {
+            std::deque<std::unique_ptr<CellData>> mCells;
+            std::unique_ptr<WorldspaceNavMeshInput> mInput;
+            int mNextTileRow = std::numeric_limits<int>::min();
+            bool mComplete = false;
+        };
 
-        for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
+        // Loads cells by rows, generates tiles for which all required cells are loaded and unloads cells not
+        // required by any pending tile. Only the part of a worldspace around currently processed rows is in memory.
+        class NavMeshTilesGenerator
         {
-            const auto range = DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(input->mAabb.m_min),
-                Misc::Convert::toOsgXY(input->mAabb.m_max), settings.mRecast);
+        public:
+            explicit NavMeshTilesGenerator(const AgentBounds& agentBounds, const Settings& settings,
+                std::size_t threadsNumber, bool removeUnusedTiles, bool writeBinaryLog, std::size_t maxMemoryUsage,
+                CellLoader& cellLoader, NavMeshDb&& db)
+                : mAgentBounds(agentBounds)
+                , mSettings(settings)
+                , mRemoveUnusedTiles(removeUnusedTiles)
+                , mWriteBinaryLog(writeBinaryLog)
+                , mMaxMemoryUsage(maxMemoryUsage)
+                , mCellLoader(cellLoader)
+                , mWorkQueue(threadsNumber)
+                , mConsumer(std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog))
+            {
+            }
 
-            if (removeUnusedTiles)
-                navMeshTileConsumer->removeTilesOutsideRange(input->mWorldspace, range);
+            NavMeshTileConsumer& getConsumer() { return *mConsumer; }
 
-            std::vector<TilePosition> worldspaceTiles;
+            std::size_t getPeakMemoryUsage() const { return mPeakMemoryUsage; }
 
-            DetourNavigator::getTilesPositions(
-                range, [&](const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); });
+            Status run(const std::vector<ESM::Cell>& cells, bool processInteriorCells)
+            {
+                mCellsCount = cells.size();
 
-            tiles += worldspaceTiles.size();
+                if (mWriteBinaryLog)
+                    serializeToStderr(ExpectedCells{ static_cast<std::uint64_t>(cells.size()) });
 
-            if (writeBinaryLog)
-                serializeToStderr(ExpectedTiles{ static_cast<std::uint64_t>(tiles) });
+                std::vector<const ESM::Cell*> exteriorCells;
+                std::vector<const ESM::Cell*> interiorCells;
 
-            navMeshTileConsumer->mExpected = tiles;
+                for (const ESM::Cell& cell : cells)
+                    (cell.isExterior() ? exteriorCells : interiorCells).push_back(&cell);
 
-            std::shuffle(worldspaceTiles.begin(), worldspaceTiles.end(), random);
+                std::sort(exteriorCells.begin(), exteriorCells.end(), [](const ESM::Cell* lhs, const ESM::Cell* rhs) {
+                    return std::tie(lhs->mData.mY, lhs->mData.mX) < std::tie(rhs->mData.mY, rhs->mData.mX);
+                });
 
-            for (const TilePosition& tilePosition : worldspaceTiles)
-                workQueue.addWorkItem(new GenerateNavMeshTile(input->mWorldspace, tilePosition,
-                    RecastMeshProvider(input->mTileCachedRecastMeshManager), agentBounds, settings,
-                    navMeshTileConsumer));
-        }
+                if (!exteriorCells.empty())
+                    processExteriorCells(exteriorCells);
+
+                for (const ESM::Cell* cell : interiorCells)
+                {
+                    if (mConsumer->getStatus() != Status::Ok)
+                        break;
+
+                    if (processInteriorCells)
+                        processInteriorCell(*cell);
+                    else
+                        skipInteriorCell(*cell);
+                }
+
+                return mConsumer->wait();
+            }
+
+        private:
+            const AgentBounds& mAgentBounds;
+            const Settings& mSettings;
+            const bool mRemoveUnusedTiles;
+            const bool mWriteBinaryLog;
+            const std::size_t mMaxMemoryUsage;
+            CellLoader& mCellLoader;
+            std::mt19937_64 mRandom;
+            std::size_t mCellsCount = 0;
+            std::size_t mProcessedCells = 0;
+            std::size_t mPeakMemoryUsage = 0;
+            bool mMemoryUsageWarned = false;
+            std::list<LoadedWorldspace> mWorldspaces;
+            SceneUtil::WorkQueue mWorkQueue;
+            std::shared_ptr<NavMeshTileConsumer> mConsumer;
+
+            LoadedWorldspace& addWorldspace(ESM::RefId worldspace)
+            {
+                LoadedWorldspace& result = mWorldspaces.emplace_back();
+                result.mInput = std::make_unique<WorldspaceNavMeshInput>(worldspace, mSettings.mRecast);
+                result.mInput->mTileCachedRecastMeshManager.setWorldspace(worldspace, nullptr);
+                return result;
+            }
+
+            void processExteriorCells(const std::vector<const ESM::Cell*>& cells)
+            {
+                const auto [minX, maxX] = std::minmax_element(cells.begin(), cells.end(),
+                    [](const ESM::Cell* lhs, const ESM::Cell* rhs) { return lhs->mData.mX < rhs->mData.mX; });
+                const float cellSize = static_cast<float>(ESM::Land::REAL_SIZE);
+                const osg::Vec2f min(static_cast<float>((*minX)->mData.mX) * cellSize,
+                    static_cast<float>(cells.front()->mData.mY) * cellSize);
+                const osg::Vec2f max(static_cast<float>((*maxX)->mData.mX + 1) * cellSize,
+                    static_cast<float>(cells.back()->mData.mY + 1) * cellSize);
+                const TilesPositionsRange range = DetourNavigator::makeTilesPositionsRange(min, max, mSettings.mRecast);
+                const ESM::RefId worldspace = ESM::Cell::sDefaultWorldspaceId;
+
+                if (mRemoveUnusedTiles)
+                    mConsumer->removeTilesOutsideRange(worldspace, range);
+
+                LoadedWorldspace& loaded = addWorldspace(worldspace);
+                auto cell = cells.begin();
+
+                for (int tileRow = range.mBegin.y(); tileRow < range.mEnd.y(); ++tileRow)
+                {
+                    for (const int lastCellRow = getCellRows(mSettings, tileRow).second;
+                         cell != cells.end() && (*cell)->mData.mY <= lastCellRow; ++cell)
+                    {
+                        if (limitMemoryUsage() != Status::Ok)
+                            return;
+                        loadCell(**cell, loaded);
+                    }
+
+                    std::vector<TilePosition> tiles;
+                    for (int tileX = range.mBegin.x(); tileX < range.mEnd.x(); ++tileX)
+                        tiles.emplace_back(tileX, tileRow);
+
+                    generateTiles(loaded, tileRow, std::move(tiles));
+                    loaded.mNextTileRow = tileRow + 1;
+                    unloadUnusedCells();
+                }
+
+                loaded.mComplete = true;
+            }
+
+            void processInteriorCell(const ESM::Cell& cell)
+            {
+                if (limitMemoryUsage() != Status::Ok)
+                    return;
+
+                LoadedWorldspace& loaded = addWorldspace(cell.mId);
+                loadCell(cell, loaded);
+                loaded.mComplete = true;
+
+                const btAABB& aabb = loaded.mInput->mAabb;
+                const TilesPositionsRange range = DetourNavigator::makeTilesPositionsRange(
+                    Misc::Convert::toOsgXY(aabb.m_min), Misc::Convert::toOsgXY(aabb.m_max), mSettings.mRecast);
+
+                if (mRemoveUnusedTiles)
+                    mConsumer->removeTilesOutsideRange(cell.mId, range);
+
+                for (int tileRow = range.mBegin.y(); tileRow < range.mEnd.y(); ++tileRow)
+                {
+                    std::vector<TilePosition> tiles;
+                    for (int tileX = range.mBegin.x(); tileX < range.mEnd.x(); ++tileX)
+                        tiles.emplace_back(tileX, tileRow);
+                    generateTiles(loaded, tileRow, std::move(tiles));
+                }
+
+                unloadUnusedCells();
+            }
+
+            void skipInteriorCell(const ESM::Cell& cell)
+            {
+                ++mProcessedCells;
+                if (mWriteBinaryLog)
+                    serializeToStderr(ProcessedCells{ static_cast<std::uint64_t>(mProcessedCells) });
+                Log(Debug::Info) << "Skipped interior"
+                                 << " cell (" << mProcessedCells << "/" << mCellsCount << ") \""
+                                 << cell.getDescription() << "\"";
+            }
+
+            void loadCell(const ESM::Cell& cell, LoadedWorldspace& loaded)
+            {
+                std::unique_ptr<CellData> data = mCellLoader.load(cell, *loaded.mInput);
+                reportProcessedCell(cell, data->mObjects.size());
+                loaded.mCells.push_back(std::move(data));
+            }
+
+            void reportProcessedCell(const ESM::Cell& cell, std::size_t objects)
+            {
+                ++mProcessedCells;
+                if (mWriteBinaryLog)
+                    serializeToStderr(ProcessedCells{ static_cast<std::uint64_t>(mProcessedCells) });
+                Log(Debug::Info) << "Processed " << (cell.isExterior() ? "exterior" : "interior") << " cell ("
+                                 << mProcessedCells << "/" << mCellsCount << ") \"" << cell.getDescription()
+                                 << "\" with " << objects << " objects";
+            }
+
+            void generateTiles(const LoadedWorldspace& loaded, int tileRow, std::vector<TilePosition>&& tiles)
+            {
+                const ESM::RefId worldspace = loaded.mInput->mWorldspace;
+
+                std::shuffle(tiles.begin(), tiles.end(), mRandom);
+
+                // Tiles have to be pending before they are generated to not to unload their cells
+                mConsumer->addPending(worldspace, tileRow, tiles.size());
+
+                if (mWriteBinaryLog)
+                    serializeToStderr(ExpectedTiles{ static_cast<std::uint64_t>(mConsumer->mExpected.load()) });
+
+                for (const TilePosition& tilePosition : tiles)
+                    mWorkQueue.addWorkItem(new GenerateNavMeshTile(worldspace, tilePosition,
+                        RecastMeshProvider(loaded.mInput->mTileCachedRecastMeshManager), mAgentBounds, mSettings,
+                        mConsumer));
+            }
+
+            void unloadUnusedCells()
+            {
+                for (auto it = mWorldspaces.begin(); it != mWorldspaces.end();)
+                {
+                    const std::optional<int> minPendingRow = mConsumer->getMinPendingRow(it->mInput->mWorldspace);
+
+                    if (it->mComplete && !minPendingRow.has_value())
+                    {
+                        it = mWorldspaces.erase(it);
+                        continue;
+                    }
+
+                    if (!it->mComplete)
+                    {
+                        const int tileRow = std::min(minPendingRow.value_or(it->mNextTileRow), it->mNextTileRow);
+                        const int firstCellRow = getCellRows(mSettings, tileRow).first;
+                        while (!it->mCells.empty() && it->mCells.front()->mCellPosition.y() < firstCellRow)
+                        {
+                            mCellLoader.unload(*it->mCells.front(), *it->mInput);
+                            it->mCells.pop_front();
+                        }
+                    }
+
+                    ++it;
+                }
+            }
+
+            Status limitMemoryUsage()
+            {
+                while (true)
+                {
+                    mConsumer->commitOnInterval();
+
+                    unloadUnusedCells();
+
+                    if (const Status status = mConsumer->getStatus(); status != Status::Ok)
+                        return status;
+
+                    const std::optional<std::size_t> memoryUsage = getResidentSetSize();
+
+                    if (!memoryUsage.has_value())
+                        return Status::Ok;
+
+                    mPeakMemoryUsage = std::max(mPeakMemoryUsage, *memoryUsage);
+
+                    if (mMaxMemoryUsage == 0 || *memoryUsage <= mMaxMemoryUsage)
+                        return Status::Ok;
+
+                    if (!mConsumer->hasPending())
+                    {
+                        if (!mMemoryUsageWarned)
+                            Log(Debug::Warning) << "Memory usage " << (*memoryUsage / bytesInMebibyte)
+                                                << " MiB is above the limit " << (mMaxMemoryUsage / bytesInMebibyte)
+                                                << " MiB while there are no pending tiles, loading cells anyway";
+                        mMemoryUsageWarned = true;
+                        return Status::Ok;
+                    }
+
+                    mConsumer->waitForProgress();
+                }
+            }
+        };
+    }
+
+    Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
+        bool removeUnusedTiles, bool writeBinaryLog, bool processInteriorCells, std::size_t maxMemoryUsage,
+        const std::vector<ESM::Cell>& cells, CellLoader& cellLoader, NavMeshDb&& db)
+    {
+        Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
+
+        if (maxMemoryUsage != 0 && !getResidentSetSize().has_value())
+            Log(Debug::Warning) << "Memory usage is not supported on this platform, the limit is ignored";
+
+        const auto start = std::chrono::steady_clock::now();
+        NavMeshTilesGenerator generator(agentBounds, settings, threadsNumber, removeUnusedTiles, writeBinaryLog,
+            maxMemoryUsage, cellLoader, std::move(db));
+        NavMeshTileConsumer& navMeshTileConsumer = generator.getConsumer();
 
-        const Status status = navMeshTileConsumer->wait();
+        const Status status = generator.run(cells, processInteriorCells);
         if (status == Status::Ok)
-            navMeshTileConsumer->commit();
+            navMeshTileConsumer.commit();
 
-        const auto inserted = navMeshTileConsumer->getInserted();
-        const auto updated = navMeshTileConsumer->getUpdated();
-        const auto deleted = navMeshTileConsumer->getDeleted();
+        const auto inserted = navMeshTileConsumer.getInserted();
+        const auto updated = navMeshTileConsumer.getUpdated();
+        const auto deleted = navMeshTileConsumer.getDeleted();
+        const auto provided = navMeshTileConsumer.getProvided();
+        const double seconds = getSeconds(std::chrono::steady_clock::now() - start);
+        const double throughput = seconds > 0 ? static_cast<double>(provided) / seconds : 0.0;
 
-        Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, " << inserted
-                         << " are inserted, " << updated << " updated and " << deleted << " deleted";
+        Log(Debug::Info) << "Generated navmesh for " << provided << " tiles, " << inserted << " are inserted, "
+                         << updated << " updated and " << deleted << " deleted in " << seconds << " seconds ("
+                         << throughput << " tiles/s), peak memory usage "
+                         << (generator.getPeakMemoryUsage() / bytesInMebibyte) << " MiB";
 
         if (inserted + updated + deleted > 0)
         {
             Log(Debug::Info) << "Vacuuming the database...";
-            navMeshTileConsumer->vacuum();
+            navMeshTileConsumer.vacuum();
         }
 
         return status;
@@ -2,6 +2,12 @@
 #define OPENMW_NAVMESHTOOL_NAVMESH_H
 
 #include <cstddef>
+#include <vector>
+
+namespace ESM
+{
+    struct Cell;
+}
 
 namespace DetourNavigator
 {
@@ -12,7 +18,7 @@ namespace DetourNavigator
 
 namespace NavMeshTool
 {
-    struct WorldspaceData;
+    class CellLoader;
 
     enum class Status
     {
@@ -21,9 +27,12 @@ namespace NavMeshTool
         NotEnoughSpace,
     };
 
+    // Loads cells and generates tiles concurrently keeping in memory only cells required by not generated tiles.
+    // Loading is paused while resident set size is above maxMemoryUsage bytes, 0 means no limit.
     Status generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
         const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles,
-        bool writeBinaryLog, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
+        bool writeBinaryLog, bool processInteriorCells, std::size_t maxMemoryUsage,
+        const std::vector<ESM::Cell>& cells, CellLoader& cellLoader, DetourNavigator::NavMeshDb&& db);
 }
 
 #endif
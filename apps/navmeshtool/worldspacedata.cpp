@@ -1,7 +1,6 @@
 ﻿#include "worldspacedata.hpp"
 
 #include <components/bullethelpers/aabb.hpp>
-#include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/gettilespositions.hpp>
@@ -21,7 +20,6 @@
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
-#include <components/navmeshtool/protocol.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
@@ -59,14 +57,16 @@ namespace NavMeshTool
             ESM::RefId mRefId;
             float mScale;
             ESM::Position mPos;
+            bool mTeleport;
 
-            CellRef(
-                ESM::RecNameInts type, ESM::RefNum refNum, ESM::RefId&& refId, float scale, const ESM::Position& pos)
+            CellRef(ESM::RecNameInts type, ESM::RefNum refNum, ESM::RefId&& refId, float scale,
+                const ESM::Position& pos, bool teleport)
                 : mType(type)
                 , mRefNum(refNum)
                 , mRefId(std::move(refId))
                 , mScale(scale)
                 , mPos(pos)
+                , mTeleport(teleport)
             {
             }
         };
@@ -96,8 +96,8 @@ namespace NavMeshTool
                     const ESM::RecNameInts type = getType(esmData, cellRef.mRefID);
                     if (type == ESM::RecNameInts{})
                         continue;
-                    cellRefs.emplace_back(
-                        deleted, type, cellRef.mRefNum, std::move(cellRef.mRefID), cellRef.mScale, cellRef.mPos);
+                    cellRefs.emplace_back(deleted, type, cellRef.mRefNum, std::move(cellRef.mRefID), cellRef.mScale,
+                        cellRef.mPos, cellRef.mTeleport);
                 }
             }
 
@@ -151,9 +151,11 @@ namespace NavMeshTool
                 {
                     case ESM::REC_ACTI:
                     case ESM::REC_CONT:
-                    case ESM::REC_DOOR:
                     case ESM::REC_STAT:
-                        f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale));
+                        f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale), false);
+                        break;
+                    case ESM::REC_DOOR:
+                        f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale), !cellRef.mTeleport);
                         break;
                     default:
                         break;
@@ -195,34 +197,26 @@ namespace NavMeshTool
             initialized = true;
         }
 
-        std::tuple<HeightfieldShape, float, float> makeHeightfieldShape(const std::optional<ESM::Land>& land,
-            const osg::Vec2i& cellPosition, std::vector<std::vector<float>>& heightfields,
-            std::vector<std::unique_ptr<ESM::Land::LandData>>& landDatas)
+        std::tuple<HeightfieldShape, float, float> makeHeightfieldShape(
+            const std::optional<ESM::Land>& land, const osg::Vec2i& cellPosition, CellData& data)
         {
             if (!land.has_value() || osg::Vec2i(land->mX, land->mY) != cellPosition
                 || (land->mDataTypes & ESM::Land::DATA_VHGT) == 0)
                 return { HeightfieldPlane{ static_cast<float>(ESM::Land::DEFAULT_HEIGHT) },
                     static_cast<float>(ESM::Land::DEFAULT_HEIGHT), static_cast<float>(ESM::Land::DEFAULT_HEIGHT) };
 
-            ESM::Land::LandData& landData = *landDatas.emplace_back(std::make_unique<ESM::Land::LandData>());
+            data.mLandData = std::make_unique<ESM::Land::LandData>();
+            ESM::Land::LandData& landData = *data.mLandData;
             land->loadData(ESM::Land::DATA_VHGT, landData);
-            heightfields.push_back(std::vector<float>(std::begin(landData.mHeights), std::end(landData.mHeights)));
+            data.mHeights.assign(std::begin(landData.mHeights), std::end(landData.mHeights));
             HeightfieldSurface surface;
-            surface.mHeights = heightfields.back().data();
+            surface.mHeights = data.mHeights.data();
             surface.mMinHeight = landData.mMinHeight;
             surface.mMaxHeight = landData.mMaxHeight;
             surface.mSize = static_cast<std::size_t>(ESM::Land::LAND_SIZE);
             return { surface, landData.mMinHeight, landData.mMaxHeight };
         }
 
-        template <class T>
-        void serializeToStderr(const T& value)
-        {
-            const std::vector<std::byte> data = serialize(value);
-            Debug::getRawStderr().write(
-                reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
-        }
-
         std::string makeAddObjectErrorMessage(
             ObjectId objectId, DetourNavigator::AreaType areaType, const CollisionShape& shape)
         {
@@ -243,128 +237,107 @@ namespace NavMeshTool
         mAabb.m_max = btVector3(0, 0, 0);
     }
 
-    WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, ESM::ReadersCache& readers,
-        const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
-        bool processInteriorCells, bool writeBinaryLog)
+    CellLoader::CellLoader(ESM::ReadersCache& readers, const VFS::Manager& vfs,
+        Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData)
+        : mReaders(readers)
+        , mVfs(vfs)
+        , mBulletShapeManager(bulletShapeManager)
+        , mEsmData(esmData)
     {
-        Log(Debug::Info) << "Processing " << esmData.mCells.size() << " cells...";
-
-        std::unordered_map<ESM::RefId, std::unique_ptr<WorldspaceNavMeshInput>> navMeshInputs;
-        WorldspaceData data;
-
-        std::size_t objectsCounter = 0;
+    }
 
-        if (writeBinaryLog)
-            serializeToStderr(ExpectedCells{ static_cast<std::uint64_t>(esmData.mCells.size()) });
+    std::unique_ptr<CellData> CellLoader::load(const ESM::Cell& cell, WorldspaceNavMeshInput& navMeshInput)
+    {
+        const bool exterior = cell.isExterior();
 
-        for (std::size_t i = 0; i < esmData.mCells.size(); ++i)
-        {
-            const ESM::Cell& cell = esmData.mCells[i];
-            const bool exterior = cell.isExterior();
+        Log(Debug::Debug) << "Loading " << (exterior ? "exterior" : "interior") << " cell \""
+                          << cell.getDescription() << "\"";
 
-            if (!exterior && !processInteriorCells)
-            {
-                if (writeBinaryLog)
-                    serializeToStderr(ProcessedCells{ static_cast<std::uint64_t>(i + 1) });
-                Log(Debug::Info) << "Skipped interior"
-                                 << " cell (" << (i + 1) << "/" << esmData.mCells.size() << ") \""
-                                 << cell.getDescription() << "\"";
-                continue;
-            }
+        auto data = std::make_unique<CellData>();
+        data->mCellPosition = osg::Vec2i(cell.mData.mX, cell.mData.mY);
+        data->mExterior = exterior;
 
-            Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
-                              << esmData.mCells.size() << ") \"" << cell.getDescription() << "\"";
+        const osg::Vec2i& cellPosition = data->mCellPosition;
+        const auto guard = navMeshInput.mTileCachedRecastMeshManager.makeUpdateGuard();
 
-            const osg::Vec2i cellPosition(cell.mData.mX, cell.mData.mY);
-            const std::size_t cellObjectsBegin = data.mObjects.size();
-            const ESM::RefId cellWorldspace = cell.isExterior() ? ESM::Cell::sDefaultWorldspaceId : cell.mId;
-            WorldspaceNavMeshInput& navMeshInput = [&]() -> WorldspaceNavMeshInput& {
-                auto it = navMeshInputs.find(cellWorldspace);
-                if (it == navMeshInputs.end())
-                {
-                    it = navMeshInputs
-                             .emplace(cellWorldspace,
-                                 std::make_unique<WorldspaceNavMeshInput>(cellWorldspace, settings.mRecast))
-                             .first;
-                    it->second->mTileCachedRecastMeshManager.setWorldspace(cellWorldspace, nullptr);
-                }
-                return *it->second;
-            }();
+        if (exterior)
+        {
+            const auto it
+                = std::lower_bound(mEsmData.mLands.begin(), mEsmData.mLands.end(), cellPosition, LessByXY{});
+            const auto [heightfieldShape, minHeight, maxHeight] = makeHeightfieldShape(
+                it == mEsmData.mLands.end() ? std::optional<ESM::Land>() : *it, cellPosition, *data);
 
-            const auto guard = navMeshInput.mTileCachedRecastMeshManager.makeUpdateGuard();
+            mergeOrAssign(getAabb(cellPosition, minHeight, maxHeight), data->mAabb, data->mAabbInitialized);
 
-            if (exterior)
-            {
-                const auto it
-                    = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(), cellPosition, LessByXY{});
-                const auto [heightfieldShape, minHeight, maxHeight]
-                    = makeHeightfieldShape(it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it, cellPosition,
-                        data.mHeightfields, data.mLandData);
+            navMeshInput.mTileCachedRecastMeshManager.addHeightfield(
+                cellPosition, ESM::Land::REAL_SIZE, heightfieldShape, guard.get());
 
-                mergeOrAssign(
-                    getAabb(cellPosition, minHeight, maxHeight), navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+            navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1, guard.get());
+        }
+        else
+        {
+            if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
+                navMeshInput.mTileCachedRecastMeshManager.addWater(
+                    cellPosition, std::numeric_limits<int>::max(), cell.mWater, guard.get());
+        }
 
-                navMeshInput.mTileCachedRecastMeshManager.addHeightfield(
-                    cellPosition, ESM::Land::REAL_SIZE, heightfieldShape, guard.get());
+        forEachObject(cell, mEsmData, mVfs, mBulletShapeManager, mReaders, [&](BulletObject object, bool door) {
+            if (object.getShapeInstance()->mVisualCollisionType != Resource::VisualCollisionType::None)
+                return;
 
-                navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1, guard.get());
-            }
-            else
-            {
-                if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
-                    navMeshInput.mTileCachedRecastMeshManager.addWater(
-                        cellPosition, std::numeric_limits<int>::max(), cell.mWater, guard.get());
-            }
+            const btTransform& transform = object.getCollisionObject().getWorldTransform();
+            const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
+            mergeOrAssign(aabb, data->mAabb, data->mAabbInitialized);
+            if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                data->mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
 
-            forEachObject(cell, esmData, vfs, bulletShapeManager, readers, [&](BulletObject object) {
-                if (object.getShapeInstance()->mVisualCollisionType != Resource::VisualCollisionType::None)
-                    return;
+            const ObjectId objectId(++mObjectsCounter);
+            const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(),
+                object.getObjectTransform());
 
-                const btTransform& transform = object.getCollisionObject().getWorldTransform();
-                const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
-                mergeOrAssign(aabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
-                if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                    navMeshInput.mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
+            // Non teleport doors are obstacles in the game so tiles have to be generated the same way
+            const bool added = door
+                ? navMeshInput.mTileCachedRecastMeshManager.addObstacle(objectId, shape, transform, guard.get())
+                : navMeshInput.mTileCachedRecastMeshManager.addObject(
+                    objectId, shape, transform, DetourNavigator::AreaType_ground, guard.get());
+            if (!added)
+                throw std::logic_error(makeAddObjectErrorMessage(objectId, DetourNavigator::AreaType_ground, shape));
 
-                const ObjectId objectId(++objectsCounter);
-                const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(),
-                    object.getObjectTransform());
+            data->mObjectIds.push_back(objectId);
 
+            if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+            {
+                const ObjectId avoidObjectId(++mObjectsCounter);
+                const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
                 if (!navMeshInput.mTileCachedRecastMeshManager.addObject(
-                        objectId, shape, transform, DetourNavigator::AreaType_ground, guard.get()))
+                        avoidObjectId, avoidShape, transform, DetourNavigator::AreaType_null, guard.get()))
                     throw std::logic_error(
-                        makeAddObjectErrorMessage(objectId, DetourNavigator::AreaType_ground, shape));
+                        makeAddObjectErrorMessage(avoidObjectId, DetourNavigator::AreaType_null, avoidShape));
+                data->mObjectIds.push_back(avoidObjectId);
+            }
 
-                if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                {
-                    const ObjectId avoidObjectId(++objectsCounter);
-                    const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
-                    if (!navMeshInput.mTileCachedRecastMeshManager.addObject(
-                            avoidObjectId, avoidShape, transform, DetourNavigator::AreaType_null, guard.get()))
-                        throw std::logic_error(
-                            makeAddObjectErrorMessage(avoidObjectId, DetourNavigator::AreaType_null, avoidShape));
-                }
+            data->mObjects.emplace_back(std::move(object));
+        });
 
-                data.mObjects.emplace_back(std::move(object));
-            });
+        if (data->mAabbInitialized)
+            mergeOrAssign(data->mAabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
 
-            const auto cellDescription = cell.getDescription();
+        Log(Debug::Debug) << "Loaded " << (exterior ? "exterior" : "interior") << " cell \""
+                          << cell.getDescription() << "\" with " << data->mObjects.size() << " objects";
 
-            if (writeBinaryLog)
-                serializeToStderr(ProcessedCells{ static_cast<std::uint64_t>(i + 1) });
+        return data;
+    }
 
-            Log(Debug::Info) << "Processed " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
-                             << esmData.mCells.size() << ") " << cellDescription << " with "
-                             << (data.mObjects.size() - cellObjectsBegin) << " objects";
-        }
+    void CellLoader::unload(const CellData& data, WorldspaceNavMeshInput& navMeshInput)
+    {
+        const auto guard = navMeshInput.mTileCachedRecastMeshManager.makeUpdateGuard();
 
-        data.mNavMeshInputs.reserve(navMeshInputs.size());
-        std::transform(navMeshInputs.begin(), navMeshInputs.end(), std::back_inserter(data.mNavMeshInputs),
-            [](auto& v) { return std::move(v.second); });
+        for (const ObjectId objectId : data.mObjectIds)
+            navMeshInput.mTileCachedRecastMeshManager.removeObject(objectId, guard.get());
 
-        Log(Debug::Info) << "Processed " << esmData.mCells.size() << " cells, added " << data.mObjects.size()
-                         << " objects and " << data.mHeightfields.size() << " height fields";
+        if (data.mExterior)
+            navMeshInput.mTileCachedRecastMeshManager.removeHeightfield(data.mCellPosition, guard.get());
 
-        return data;
+        navMeshInput.mTileCachedRecastMeshManager.removeWater(data.mCellPosition, guard.get());
     }
 }
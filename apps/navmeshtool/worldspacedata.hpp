@@ -2,6 +2,7 @@
 #define OPENMW_NAVMESHTOOL_WORLDSPACEDATA_H
 
 #include <components/bullethelpers/collisionobject.hpp>
+#include <components/detournavigator/objectid.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/misc/convert.hpp>
@@ -11,6 +12,9 @@
 #include <BulletCollision/Gimpact/btBoxCollision.h>
 #include <LinearMath/btVector3.h>
 
+#include <osg/Vec2i>
+
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,6 +23,7 @@ namespace ESM
 {
     class ESMReader;
     class ReadersCache;
+    struct Cell;
 }
 
 namespace VFS
@@ -36,11 +41,6 @@ namespace EsmLoader
     struct EsmData;
 }
 
-namespace DetourNavigator
-{
-    struct Settings;
-}
-
 namespace NavMeshTool
 {
     using DetourNavigator::ObjectTransform;
@@ -80,17 +80,36 @@ namespace NavMeshTool
         std::unique_ptr<btCollisionObject> mCollisionObject;
     };
 
-    struct WorldspaceData
+    // Geometry of a single cell added to the recast mesh manager. Must be kept alive until the cell is unloaded.
+    struct CellData
     {
-        std::vector<std::unique_ptr<WorldspaceNavMeshInput>> mNavMeshInputs;
+        osg::Vec2i mCellPosition;
+        bool mExterior = false;
+        std::vector<DetourNavigator::ObjectId> mObjectIds;
         std::vector<BulletObject> mObjects;
-        std::vector<std::unique_ptr<ESM::Land::LandData>> mLandData;
-        std::vector<std::vector<float>> mHeightfields;
+        std::unique_ptr<ESM::Land::LandData> mLandData;
+        std::vector<float> mHeights;
+        btAABB mAabb;
+        bool mAabbInitialized = false;
     };
 
-    WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, ESM::ReadersCache& readers,
-        const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
-        bool processInteriorCells, bool writeBinaryLog);
+    class CellLoader
+    {
+    public:
+        explicit CellLoader(ESM::ReadersCache& readers, const VFS::Manager& vfs,
+            Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData);
+
+        std::unique_ptr<CellData> load(const ESM::Cell& cell, WorldspaceNavMeshInput& navMeshInput);
+
+        void unload(const CellData& data, WorldspaceNavMeshInput& navMeshInput);
+
+    private:
+        ESM::ReadersCache& mReaders;
+        const VFS::Manager& mVfs;
+        Resource::BulletShapeManager& mBulletShapeManager;
+        const EsmLoader::EsmData& mEsmData;
+        std::size_t mObjectsCounter = 0;
+    };
 }
 
 #endif
@@ -2,7 +2,9 @@
 
 #include <cerrno>
 #include <chrono>
+#include <filesystem>
 #include <future>
+#include <sstream>
 #include <system_error>
 
 #include <osgDB/ReaderWriter>
@@ -27,14 +29,19 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
 
+#include <components/shader/shadermanager.hpp>
+
+#include <components/compiler/bytecodecache.hpp>
 #include <components/compiler/extensions0.hpp>
 
 #include <components/stereo/stereomanager.hpp>
 
 #include <components/sceneutil/glextensions.hpp>
+#include <components/sceneutil/skinning.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
 #include <components/files/configurationmanager.hpp>
+#include <components/files/conversion.hpp>
 
 #include <components/version/version.hpp>
 
@@ -153,6 +160,12 @@ namespace
             Log(Debug::Info) << "OpenGL Renderer: " << glGetString(GL_RENDERER);
             Log(Debug::Info) << "OpenGL Version: " << glGetString(GL_VERSION);
             glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &mMaxTextureImageUnits);
+            for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+            {
+                if (const GLubyte* value = glGetString(name))
+                    mDriver += reinterpret_cast<const char*>(value);
+                mDriver += '\n';
+            }
         }
 
         int getMaxTextureImageUnits() const
@@ -162,8 +175,11 @@ namespace
             return mMaxTextureImageUnits;
         }
 
+        const std::string& getDriver() const { return mDriver; }
+
     private:
         int mMaxTextureImageUnits = 0;
+        std::string mDriver;
     };
 
     void reportStats(unsigned frameNumber, osgViewer::Viewer& viewer, std::ostream& stream)
@@ -174,18 +190,37 @@ namespace
         for (osg::Camera* camera : cameras)
             camera->getStats()->report(stream, frameNumber);
     }
+
+    // Compiled scripts depend on the engine and records of all content files, content files are identified by path,
+    // size and modification time to avoid reading them
+    std::string makeScriptCacheEnvironment(
+        const Files::Collections& collections, const std::vector<std::string>& contentFiles)
+    {
+        std::ostringstream result;
+        result << Version::getVersion() << ' ' << Version::getCommitHash() << '\n';
+        for (const std::string& file : contentFiles)
+        {
+            const std::filesystem::path path = collections.getPath(file);
+            std::error_code ec;
+            result << Files::pathToUnicodeString(path) << ' ' << std::filesystem::file_size(path, ec) << ' '
+                   << std::filesystem::last_write_time(path, ec).time_since_epoch().count() << '\n';
+        }
+        return result.str();
+    }
 }
 
 void OMW::Engine::executeLocalScripts()
 {
     MWWorld::LocalScripts& localScripts = mWorld->getLocalScripts();
 
-    localScripts.startIteration();
+    localScripts.startIteration(mWorld->getPlayerPtr());
     std::pair<ESM::RefId, MWWorld::Ptr> script;
     while (localScripts.getNext(script))
     {
         MWScript::InterpreterContext interpreterContext(&script.second.getRefData().getLocals(), script.second);
-        mScriptManager->run(script.first, interpreterContext);
+        bool sideEffects = false;
+        mScriptManager->run(script.first, interpreterContext, sideEffects);
+        localScripts.finishCurrent(sideEffects);
     }
 }
 
@@ -332,9 +367,14 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
         stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
         stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
+        const SceneUtil::SkinningStats skinningStats = SceneUtil::takeSkinningStats();
+        stats->setAttribute(frameNumber, "Skinning Rigs", skinningStats.mSkinned);
+        stats->setAttribute(frameNumber, "Skinning Shared", skinningStats.mShared);
+
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        mSoundManager->reportStats(frameNumber, *stats);
     }
 
     mStereoManager->updateSettings(Settings::camera().mNearClip, Settings::camera().mViewingDistance);
@@ -419,6 +459,8 @@ OMW::Engine::~Engine()
 
     mUnrefQueue = nullptr;
     mWorkQueue = nullptr;
+    SceneUtil::setSkinningWorkQueue(nullptr);
+    SceneUtil::getSharedSkinning().clear();
 
     mViewer = nullptr;
 
@@ -686,6 +728,7 @@ void OMW::Engine::createWindow()
 
     mViewer->realize();
     mGlMaxTextureImageUnits = identifyOp->getMaxTextureImageUnits();
+    mGlDriver = identifyOp->getDriver();
 
     mViewer->getEventQueue()->getCurrentEventState()->setWindowRectangle(
         0, 0, graphicsWindow->getTraits()->width, graphicsWindow->getTraits()->height);
@@ -737,6 +780,9 @@ void OMW::Engine::prepareEngine()
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
+    if (Settings::shaders().mShaderCache)
+        mResourceSystem->getSceneManager()->getShaderManager().setCachePath(
+            mCfgMgr.getCachePath() / "shaders", mGlDriver);
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
@@ -746,6 +792,9 @@ void OMW::Engine::prepareEngine()
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
+    if (const int skinningThreads = Settings::models().mSkinningThreads; skinningThreads > 0)
+        SceneUtil::setSkinningWorkQueue(new SceneUtil::WorkQueue(skinningThreads));
+
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
         new SceneUtil::WriteScreenshotToFileOperation(mCfgMgr.getScreenshotPath(),
             Settings::general().mScreenshotFormat,
@@ -915,6 +964,21 @@ void OMW::Engine::prepareEngine()
             Log(Debug::Info) << "compiled " << result.second << " of " << result.first << " scripts ("
                              << 100 * static_cast<double>(result.second) / result.first << "%)";
     }
+    if (Settings::game().mPrecompileScripts)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const std::filesystem::path cachePath = mCfgMgr.getCachePath() / "scripts" / "bytecode.bin";
+        Compiler::BytecodeCache cache(makeScriptCacheEnvironment(mFileCollections, mContentFiles));
+        const bool loaded = cache.load(cachePath);
+        const std::size_t cached = cache.size();
+        const auto [count, success] = mScriptManager->compileAll(
+            mWorkQueue.get(), static_cast<std::size_t>(Settings::cells().mPreloadNumThreads), &cache, false);
+        if (!loaded || cache.size() != cached)
+            cache.save(cachePath);
+        Log(Debug::Info) << "Precompiled " << success << " of " << count << " scripts in "
+                         << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                         << "ms";
+    }
     if (mCompileAllDialogue)
     {
         std::pair<int, int> result = MWDialogue::ScriptTest::compileAll(&mExtensions, mWarningsMode);
@@ -1071,12 +1135,39 @@ void OMW::Engine::go()
 
     mLuaWorker->join();
 
+    // Settings refer to the character of the last saved game
+    mStateManager->waitForPendingSave();
+
+    saveShaderCache();
+
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
     Settings::ShaderManager::get().save();
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath());
 }
 
+void OMW::Engine::saveShaderCache()
+{
+    if (!Settings::shaders().mShaderCache)
+        return;
+
+    Shader::ShaderManager& shaderManager = mResourceSystem->getSceneManager()->getShaderManager();
+
+    // Program binaries can be retrieved only with a current context
+    mViewer->stopThreading();
+    osgViewer::Viewer::Contexts contexts;
+    mViewer->getContexts(contexts);
+    for (osg::GraphicsContext* context : contexts)
+    {
+        if (!context->makeCurrent())
+            continue;
+        shaderManager.saveProgramBinaries(*context->getState());
+        context->releaseContext();
+    }
+
+    shaderManager.saveCache();
+}
+
 void OMW::Engine::setCompileAll(bool all)
 {
     mCompileAll = all;
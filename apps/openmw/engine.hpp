@@ -185,6 +185,7 @@ namespace OMW
 
         Files::ConfigurationManager& mCfgMgr;
         int mGlMaxTextureImageUnits;
+        std::string mGlDriver;
 
         // not implemented
         Engine(const Engine&);
@@ -200,6 +201,8 @@ namespace OMW
         void createWindow();
         void setWindowIcon();
 
+        void saveShaderCache();
+
     public:
         Engine(Files::ConfigurationManager& configurationManager);
         virtual ~Engine();
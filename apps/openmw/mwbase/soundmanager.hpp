@@ -207,6 +207,9 @@ namespace MWBase
         virtual void stopSound(const MWWorld::CellStore* cell) = 0;
         ///< Stop all sounds for the given cell.
 
+        virtual void preloadActorSounds(MWWorld::CellStore& cell) = 0;
+        ///< Start decoding in background the sounds actors in the given cell are likely to play.
+
         virtual void fadeOutSound3D(const MWWorld::ConstPtr& reference, const ESM::RefId& soundId, float duration) = 0;
         ///< Fade out given sound (that is already playing) of given object
         ///< @param reference Reference to object, whose sound is faded out
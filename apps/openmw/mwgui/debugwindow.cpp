@@ -10,6 +10,8 @@
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/luamanager.hpp"
+#include "../mwbase/world.hpp"
+#include "../mwworld/localscripts.hpp"
 
 #include <mutex>
 
@@ -115,6 +117,12 @@ namespace MWGui
             "LogEdit", MyGUI::FloatCoord(0, 0, 1, 1), MyGUI::Align::Stretch);
         mLuaProfiler->setEditReadOnly(true);
 
+        MyGUI::TabItem* itemScriptProfiler = mTabControl->addItem("Script Profiler");
+        itemScriptProfiler->setCaptionWithReplacing(" #{OMWEngine:ScriptProfiler} ");
+        mScriptProfiler = itemScriptProfiler->createWidgetReal<MyGUI::EditBox>(
+            "LogEdit", MyGUI::FloatCoord(0, 0, 1, 1), MyGUI::Align::Stretch);
+        mScriptProfiler->setEditReadOnly(true);
+
 #ifndef BT_NO_PROFILE
         MyGUI::TabItem* item = mTabControl->addItem("Physics Profiler");
         item->setCaptionWithReplacing(" #{OMWEngine:PhysicsProfiler} ");
@@ -232,6 +240,16 @@ namespace MWGui
         mLuaProfiler->setVScrollPosition(std::min(previousPos, mLuaProfiler->getVScrollRange() - 1));
     }
 
+    void DebugWindow::updateScriptProfile()
+    {
+        if (mScriptProfiler->isTextSelection())
+            return;
+
+        size_t previousPos = mScriptProfiler->getVScrollPosition();
+        mScriptProfiler->setCaption(MWBase::Environment::get().getWorld()->getLocalScripts().formatStats());
+        mScriptProfiler->setVScrollPosition(std::min(previousPos, mScriptProfiler->getVScrollRange() - 1));
+    }
+
     void DebugWindow::updateBulletProfile()
     {
 #ifndef BT_NO_PROFILE
@@ -264,6 +282,9 @@ namespace MWGui
                 updateLuaProfile();
                 break;
             case 2:
+                updateScriptProfile();
+                break;
+            case 3:
                 updateBulletProfile();
                 break;
             default:;
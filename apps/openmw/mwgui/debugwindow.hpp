@@ -18,11 +18,13 @@ namespace MWGui
     private:
         void updateLogView();
         void updateLuaProfile();
+        void updateScriptProfile();
         void updateBulletProfile();
 
         MyGUI::TabControl* mTabControl;
         MyGUI::EditBox* mLogView;
         MyGUI::EditBox* mLuaProfiler;
+        MyGUI::EditBox* mScriptProfiler;
         MyGUI::EditBox* mBulletProfilerEdit;
     };
 
@@ -759,7 +759,7 @@ namespace MWGui
 
     // ------------------------------------------------------------------------------------------
     MapWindow::MapWindow(CustomMarkerCollection& customMarkers, DragAndDrop* drag, MWRender::LocalMap* localMapRender,
-        SceneUtil::WorkQueue* workQueue)
+        SceneUtil::WorkQueue* workQueue, const std::filesystem::path& globalMapCachePath)
 #ifdef USE_OPENXR
         : WindowPinnableBase("openmw_map_window_vr.layout")
 #else
@@ -772,7 +772,8 @@ namespace MWGui
         , mGlobalMapOverlay(nullptr)
         , mEventBoxGlobal(nullptr)
         , mEventBoxLocal(nullptr)
-        , mGlobalMapRender(std::make_unique<MWRender::GlobalMap>(localMapRender->getRoot(), workQueue))
+        , mGlobalMapRender(
+              std::make_unique<MWRender::GlobalMap>(localMapRender->getRoot(), workQueue, globalMapCachePath))
         , mEditNoteDialog()
     {
         [[maybe_unused]] static const bool registered = [] {
@@ -1131,10 +1132,15 @@ namespace MWGui
 
     void MapWindow::cellExplored(int x, int y)
     {
-        mGlobalMapRender->cleanupCameras();
         mGlobalMapRender->exploreCell(x, y, mLocalMapRender->getMapTexture(x, y));
     }
 
+    void MapWindow::updateExploredCells()
+    {
+        mGlobalMapRender->cleanupCameras();
+        mGlobalMapRender->flushOverlayUpdates();
+    }
+
     void MapWindow::onFrame(float dt)
     {
         LocalMapBase::onFrame(dt);
@@ -2,6 +2,7 @@
 #define MWGUI_MAPWINDOW_H
 
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 
 #include <osg/Vec2f>
@@ -232,7 +233,7 @@ namespace MWGui
     {
     public:
         MapWindow(CustomMarkerCollection& customMarkers, DragAndDrop* drag, MWRender::LocalMap* localMapRender,
-            SceneUtil::WorkQueue* workQueue);
+            SceneUtil::WorkQueue* workQueue, const std::filesystem::path& globalMapCachePath);
         virtual ~MapWindow();
 
         void setCellName(const std::string& cellName);
@@ -249,6 +250,9 @@ namespace MWGui
         // reveals this cell's map on the global map
         void cellExplored(int x, int y);
 
+        /// Render cells explored since the last call onto the global map, should be called every frame
+        void updateExploredCells();
+
         void setGlobalMapPlayerPosition(float worldX, float worldY);
         void setGlobalMapPlayerDir(const float x, const float y);
 
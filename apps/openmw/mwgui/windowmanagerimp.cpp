@@ -26,6 +26,8 @@
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 
+#include <components/files/configurationmanager.hpp>
+
 #include <components/fontloader/fontloader.hpp>
 
 #include <components/resource/imagemanager.hpp>
@@ -328,7 +330,8 @@ namespace MWGui
         mWindows.push_back(std::move(menu));
 
         mLocalMapRender = std::make_unique<MWRender::LocalMap>(mViewer->getSceneData()->asGroup());
-        auto map = std::make_unique<MapWindow>(mCustomMarkers, mDragAndDrop.get(), mLocalMapRender.get(), mWorkQueue);
+        auto map = std::make_unique<MapWindow>(mCustomMarkers, mDragAndDrop.get(), mLocalMapRender.get(), mWorkQueue,
+            mCfgMgr.getCachePath() / "globalmap");
         mMap = map.get();
         mWindows.push_back(std::move(map));
         mMap->renderGlobalMap();
@@ -1043,6 +1046,9 @@ namespace MWGui
         if (mLocalMapRender)
             mLocalMapRender->cleanupCameras();
 
+        if (mMap)
+            mMap->updateExploredCells();
+
         mDebugWindow->onFrame(frameDuration);
 
         if (isConsoleMode())
@@ -19,6 +19,7 @@
 #include "../mwworld/worldmodel.hpp"
 
 #include "context.hpp"
+#include "luamanagerimp.hpp"
 #include "object.hpp"
 
 namespace
@@ -55,10 +56,13 @@ namespace
         else if (cellOrId.is<MWLua::LCell>())
             cell = cellOrId.as<MWLua::LCell>().mStore->getCell();
         else if (cellOrId.is<std::string_view>() && !cellOrId.as<std::string_view>().empty())
+        {
+            const auto lock = MWLua::LuaManager::lockObjectData();
             cell = MWBase::Environment::get()
                        .getWorldModel()
                        ->getCell(ESM::RefId::deserializeText(cellOrId.as<std::string_view>()))
                        .getCell();
+        }
         if (cell == nullptr)
             throw std::runtime_error("Invalid cell");
         else if (!cell->isExterior())
@@ -16,6 +16,7 @@
 #include "../mwworld/ptr.hpp"
 
 #include "context.hpp"
+#include "luamanagerimp.hpp"
 
 namespace sol
 {
@@ -133,6 +134,7 @@ namespace MWLua
 
         selfAPI["_isFleeing"] = [](SelfObject& self) -> bool {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             if (ai.isEmpty())
                 return false;
@@ -141,6 +143,7 @@ namespace MWLua
         };
         selfAPI["_getActiveAiPackage"] = [](SelfObject& self) -> sol::optional<std::shared_ptr<AiPackage>> {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             if (ai.isEmpty())
                 return sol::nullopt;
@@ -149,6 +152,7 @@ namespace MWLua
         };
         selfAPI["_iterateAndFilterAiSequence"] = [](SelfObject& self, sol::function callback) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
 
             ai.erasePackagesIf([&](auto& entry) {
@@ -158,17 +162,20 @@ namespace MWLua
         };
         selfAPI["_startAiCombat"] = [](SelfObject& self, const LObject& target, bool cancelOther) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             ai.stack(MWMechanics::AiCombat(target.ptr()), ptr, cancelOther);
         };
         selfAPI["_startAiPursue"] = [](SelfObject& self, const LObject& target, bool cancelOther) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             ai.stack(MWMechanics::AiPursue(target.ptr()), ptr, cancelOther);
         };
         selfAPI["_startAiFollow"] = [](SelfObject& self, const LObject& target, sol::optional<LCell> cell,
                                         float duration, const osg::Vec3f& dest, bool repeat, bool cancelOther) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             if (cell)
             {
@@ -186,6 +193,7 @@ namespace MWLua
         selfAPI["_startAiEscort"] = [](SelfObject& self, const LObject& target, LCell cell, float duration,
                                         const osg::Vec3f& dest, bool repeat, bool cancelOther) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             // TODO: change AiEscort implementation to accept ptr instead of a non-unique refId.
             const ESM::RefId& refId = target.ptr().getCellRef().getRefId();
@@ -202,6 +210,7 @@ namespace MWLua
         selfAPI["_startAiWander"]
             = [](SelfObject& self, int distance, int duration, sol::table luaIdle, bool repeat, bool cancelOther) {
                   const MWWorld::Ptr& ptr = self.ptr();
+                  const auto lock = LuaManager::lockObjectData();
                   MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
                   std::vector<unsigned char> idle;
                   // Lua index starts at 1
@@ -211,6 +220,7 @@ namespace MWLua
               };
         selfAPI["_startAiTravel"] = [](SelfObject& self, const osg::Vec3f& target, bool repeat, bool cancelOther) {
             const MWWorld::Ptr& ptr = self.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::AiSequence& ai = ptr.getClass().getCreatureStats(ptr).getAiSequence();
             ai.stack(MWMechanics::AiTravel(target.x(), target.y(), target.z(), repeat), ptr, cancelOther);
         };
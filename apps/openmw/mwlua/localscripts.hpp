@@ -68,6 +68,11 @@ namespace MWLua
 
         void setActive(bool active, bool callHandlers = true);
         bool isActive() const override { return mData.mIsActive; }
+
+        // Index of the group of local scripts that share a Lua state, see LuaManager.
+        std::size_t getPartition() const { return mPartition; }
+        void setPartition(std::size_t partition) { mPartition = partition; }
+
         void onConsume(const LObject& consumable) { callEngineHandlers(mOnConsumeHandlers, consumable); }
         void onActivated(const LObject& actor) { callEngineHandlers(mOnActivatedHandlers, actor); }
         void onTeleported() { callEngineHandlers(mOnTeleportedHandlers); }
@@ -108,6 +113,7 @@ namespace MWLua
         SelfObject mData;
 
     private:
+        std::size_t mPartition = 0;
         EngineHandlerList mOnActiveHandlers{ "onActive" };
         EngineHandlerList mOnInactiveHandlers{ "onInactive" };
         EngineHandlerList mOnConsumeHandlers{ "onConsume" };
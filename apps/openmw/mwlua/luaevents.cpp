@@ -27,6 +27,18 @@ namespace MWLua
         mMenuEvents.clear();
     }
 
+    void LuaEvents::moveNewEvents(LuaEvents& other)
+    {
+        auto append = [](auto& to, auto& from) {
+            for (auto& event : from)
+                to.push_back(std::move(event));
+            from.clear();
+        };
+        append(mNewGlobalEventBatch, other.mNewGlobalEventBatch);
+        append(mNewLocalEventBatch, other.mNewLocalEventBatch);
+        append(mMenuEvents, other.mMenuEvents);
+    }
+
     void LuaEvents::finalizeEventBatch()
     {
         mNewGlobalEventBatch.swap(mGlobalEventBatch);
@@ -51,6 +51,8 @@ namespace MWLua
         void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
 
         void clear();
+        // Appends events that were added to `other` and are not finalized yet to the events added to this.
+        void moveNewEvents(LuaEvents& other);
         void finalizeEventBatch();
         void callEventHandlers();
         void callMenuEventHandlers();
@@ -22,12 +22,15 @@
 #include <components/lua_ui/registerscriptsettings.hpp>
 #include <components/lua_ui/util.hpp>
 
+#include <components/misc/hash.hpp>
+
 #include "../mwbase/windowmanager.hpp"
 #include "../mwbase/world.hpp"
 
 #include "../mwrender/bonegroup.hpp"
 #include "../mwrender/postprocessor.hpp"
 
+#include "../mwworld/cellstore.hpp"
 #include "../mwworld/datetimemanager.hpp"
 #include "../mwworld/esmstore.hpp"
 #include "../mwworld/player.hpp"
@@ -55,8 +58,32 @@ namespace MWLua
 
             ~BoolScopeGuard() { mValue = false; }
         };
+
+        template <class T>
+        struct PointerScopeGuard
+        {
+            T*& mValue;
+            PointerScopeGuard(T*& value, T* newValue)
+                : mValue(value)
+            {
+                mValue = newValue;
+            }
+
+            ~PointerScopeGuard() { mValue = nullptr; }
+        };
+
+        std::recursive_mutex sObjectDataMutex;
+
+        // Floor division, so that the blocks of exterior cells have the same size on both sides of 0
+        int getCellBlock(int gridPosition)
+        {
+            constexpr int blockSize = 4;
+            return (gridPosition >= 0 ? gridPosition : gridPosition - blockSize + 1) / blockSize;
+        }
     }
 
+    thread_local LuaManager::Partition* LuaManager::sCurrentPartition = nullptr;
+
     static LuaUtil::LuaStateSettings createLuaStateSettings()
     {
         if (!Settings::lua().mLuaProfiler)
@@ -67,8 +94,17 @@ namespace MWLua
             .mLogMemoryUsage = Settings::lua().mLogMemoryUsage };
     }
 
+    LuaManager::Partition::Partition(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+        LuaUtil::LuaStateSettings settings, GlobalScripts& globalScripts, MenuScripts& menuScripts)
+        : mLua(vfs, conf, std::move(settings))
+        , mLuaEvents(globalScripts, menuScripts)
+    {
+    }
+
     LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
-        : mLua(vfs, &mConfiguration, createLuaStateSettings())
+        : mVFS(vfs)
+        , mLibsDir(libsDir)
+        , mLua(vfs, &mConfiguration, createLuaStateSettings())
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
@@ -98,6 +134,18 @@ namespace MWLua
 
     void LuaManager::init()
     {
+        for (int i = 1; i < Settings::lua().mLocalScriptPartitions; ++i)
+        {
+            mPartitions.push_back(std::make_unique<Partition>(
+                mVFS, &mConfiguration, createLuaStateSettings(), mGlobalScripts, mMenuScripts));
+            initPartition(*mPartitions.back());
+        }
+        if (!mPartitions.empty())
+        {
+            Log(Debug::Info) << "Local Lua scripts are distributed among " << mPartitions.size() + 1 << " states";
+            mPartitionsWorkQueue = new SceneUtil::WorkQueue(mPartitions.size());
+        }
+
         mLua.protectedCall([&](LuaUtil::LuaView& view) {
             Context globalContext;
             globalContext.mType = Context::Global;
@@ -143,6 +191,91 @@ namespace MWLua
         });
     }
 
+    void LuaManager::initPartition(Partition& partition)
+    {
+        partition.mLua.addInternalLibSearchPath(mLibsDir);
+        partition.mLua.protectedCall([&](LuaUtil::LuaView& view) {
+            Context context;
+            context.mType = Context::Local;
+            context.mLuaManager = this;
+            context.mLua = &partition.mLua;
+            context.mObjectLists = &mObjectLists;
+            context.mLuaEvents = &partition.mLuaEvents;
+            context.mSerializer = mLocalSerializer.get();
+
+            for (const auto& [name, package] : initCommonPackages(context))
+                partition.mLua.addCommonPackage(name, package);
+            partition.mLocalPackages = initLocalPackages(context);
+
+            LuaUtil::LuaStorage::initLuaBindings(view);
+            partition.mLocalPackages["openmw.storage"] = LuaUtil::LuaStorage::initLocalPackage(view, &mGlobalStorage);
+        });
+    }
+
+    std::size_t LuaManager::selectPartition(const MWWorld::Ptr& ptr) const
+    {
+        if (mPartitions.empty() || !ptr.isInCell())
+            return 0;
+        // Objects in the same cell interact more often, and only serialized events can be sent to another partition.
+        // Neighbouring exterior cells are grouped by blocks.
+        const MWWorld::Cell& cell = *ptr.getCell()->getCell();
+        std::size_t hash = std::hash<ESM::RefId>{}(cell.getWorldSpace());
+        if (cell.isExterior())
+        {
+            Misc::hashCombine(hash, getCellBlock(cell.getGridX()));
+            Misc::hashCombine(hash, getCellBlock(cell.getGridY()));
+        }
+        return hash % (mPartitions.size() + 1);
+    }
+
+    void LuaManager::runLocalScripts(const std::function<void(LocalScripts&)>& fn)
+    {
+        mMainPartitionScripts.clear();
+        for (const auto& partition : mPartitions)
+            partition->mActiveLocalScripts.clear();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            if (scripts->getPartition() == 0)
+                mMainPartitionScripts.push_back(scripts);
+            else
+                mPartitions[scripts->getPartition() - 1]->mActiveLocalScripts.push_back(scripts);
+        }
+
+        SceneUtil::parallelFor(
+            mPartitionsWorkQueue.get(), mPartitions.size(), mPartitions.size() + 1, [&](std::size_t index) {
+                if (index == 0)
+                {
+                    mLua.protectedCall([&](LuaUtil::LuaView&) {
+                        for (LocalScripts* scripts : mMainPartitionScripts)
+                            fn(*scripts);
+                    });
+                    return;
+                }
+                Partition& partition = *mPartitions[index - 1];
+                PointerScopeGuard partitionGuard(sCurrentPartition, &partition);
+                partition.mLua.protectedCall([&](LuaUtil::LuaView&) {
+                    for (LocalScripts* scripts : partition.mActiveLocalScripts)
+                        fn(*scripts);
+                });
+            });
+
+        for (const auto& partition : mPartitions)
+        {
+            for (DelayedAction& action : partition->mActionQueue)
+                mActionQueue.push_back(std::move(action));
+            partition->mActionQueue.clear();
+            for (CallbackWithData& callback : partition->mQueuedCallbacks)
+                mQueuedCallbacks.push_back(std::move(callback));
+            partition->mQueuedCallbacks.clear();
+        }
+    }
+
+    void LuaManager::moveNewPartitionEvents()
+    {
+        for (const auto& partition : mPartitions)
+            mLuaEvents.moveNewEvents(partition->mLuaEvents);
+    }
+
     void LuaManager::loadPermanentStorage(const std::filesystem::path& userConfigPath)
     {
         mPlayerStorage.setActive(true);
@@ -160,11 +293,9 @@ namespace MWLua
 
     void LuaManager::savePermanentStorage(const std::filesystem::path& userConfigPath)
     {
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
-            if (mGlobalScriptsStarted)
-                mGlobalStorage.save(view.sol(), userConfigPath / "global_storage.bin");
-            mPlayerStorage.save(view.sol(), userConfigPath / "player_storage.bin");
-        });
+        if (mGlobalScriptsStarted)
+            mGlobalStorage.save(userConfigPath / "global_storage.bin");
+        mPlayerStorage.save(userConfigPath / "player_storage.bin");
     }
 
     void LuaManager::sendLocalEvent(
@@ -181,7 +312,11 @@ namespace MWLua
     void LuaManager::update()
     {
         if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
+        {
             lua_gc(mLua.unsafeState(), LUA_GCSTEP, steps);
+            for (const auto& partition : mPartitions)
+                lua_gc(partition->mLua.unsafeState(), LUA_GCSTEP, steps);
+        }
 
         if (mPlayer.isEmpty())
             return; // The game is not started yet.
@@ -208,6 +343,7 @@ namespace MWLua
         for (LocalScripts* scripts : mActiveLocalScripts)
             scripts->statsNextFrame();
 
+        moveNewPartitionEvents();
         mLuaEvents.finalizeEventBatch();
 
         MWWorld::DateTimeManager& timeManager = *MWBase::Environment::get().getWorld()->getTimeManager();
@@ -215,14 +351,15 @@ namespace MWLua
         {
             mMenuScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
             mGlobalScripts.processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(timeManager.getSimulationTime(), timeManager.getGameTime());
+            const double simulationTime = timeManager.getSimulationTime();
+            const double gameTime = timeManager.getGameTime();
+            runLocalScripts([&](LocalScripts& scripts) { scripts.processTimers(simulationTime, gameTime); });
         }
 
         // Run event handlers for events that were sent before `finalizeEventBatch`.
         mLuaEvents.callEventHandlers();
 
-        mLua.protectedCall([&](LuaUtil::LuaView& lua) {
+        mLua.protectedCall([&](LuaUtil::LuaView&) {
             // Run queued callbacks
             for (CallbackWithData& c : mQueuedCallbacks)
                 c.mCallback.tryCall(c.mArg);
@@ -230,15 +367,18 @@ namespace MWLua
 
             // Run engine handlers
             mEngineEvents.callEngineHandlers();
-            bool isPaused = timeManager.isPaused();
+        });
 
-            float frameDuration = MWBase::Environment::get().getFrameDuration();
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(isPaused ? 0 : frameDuration);
-            mGlobalScripts.update(isPaused ? 0 : frameDuration);
+        const float frameDuration = timeManager.isPaused() ? 0 : MWBase::Environment::get().getFrameDuration();
+        runLocalScripts([&](LocalScripts& scripts) { scripts.update(frameDuration); });
 
+        mLua.protectedCall([&](LuaUtil::LuaView& lua) {
+            mGlobalScripts.update(frameDuration);
             mScriptTracker.unloadInactiveScripts(lua);
         });
+        for (const auto& partition : mPartitions)
+            partition->mLua.protectedCall(
+                [&](LuaUtil::LuaView& lua) { partition->mScriptTracker.unloadInactiveScripts(lua); });
     }
 
     void LuaManager::objectTeleported(const MWWorld::Ptr& ptr)
@@ -351,6 +491,8 @@ namespace MWLua
         MWBase::Environment::get().getWorld()->getPostProcessor()->disableDynamicShaders();
         mActiveLocalScripts.clear();
         mLuaEvents.clear();
+        for (const auto& partition : mPartitions)
+            partition->mLuaEvents.clear();
         mEngineEvents.clear();
         mInputEvents.clear();
         mMenuInputEvents.clear();
@@ -373,7 +515,11 @@ namespace MWLua
         mInputTriggers.clear();
         mQueuedAutoStartedScripts.clear();
         for (int i = 0; i < 5; ++i)
+        {
             lua_gc(mLua.unsafeState(), LUA_GCCOLLECT, 0);
+            for (const auto& partition : mPartitions)
+                lua_gc(partition->mLua.unsafeState(), LUA_GCCOLLECT, 0);
+        }
     }
 
     void LuaManager::setupPlayer(const MWWorld::Ptr& ptr)
@@ -641,11 +787,21 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)), &mScriptTracker);
+            const std::map<std::string, sol::object>* packages = &mLocalPackages;
+            const std::size_t partition = selectPartition(ptr);
+            if (partition == 0)
+                scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)), &mScriptTracker);
+            else
+            {
+                Partition& p = *mPartitions[partition - 1];
+                scripts = std::make_shared<LocalScripts>(&p.mLua, LObject(getId(ptr)), &p.mScriptTracker);
+                scripts->setPartition(partition);
+                packages = &p.mLocalPackages;
+            }
             if (!autoStartConf.has_value())
                 autoStartConf = mConfiguration.getLocalConf(type, ptr.getCellRef().getRefId(), getId(ptr));
             scripts->setAutoStartConf(std::move(*autoStartConf));
-            for (const auto& [name, package] : mLocalPackages)
+            for (const auto& [name, package] : *packages)
                 scripts->addPackage(name, package);
         }
         scripts->setSerializer(mLocalSerializer.get());
@@ -664,6 +820,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
+        moveNewPartitionEvents();
         mLuaEvents.save(writer);
 
         writer.endRecord(ESM::REC_LUAM);
@@ -733,6 +890,8 @@ namespace MWLua
         MWBase::Environment::get().getL10nManager()->dropCache();
         mUiResourceManager.clear();
         mLua.dropScriptCache();
+        for (const auto& partition : mPartitions)
+            partition->mLua.dropScriptCache();
         mInputActions.clear(true);
         mInputTriggers.clear(true);
         initConfiguration();
@@ -833,7 +992,17 @@ namespace MWLua
     {
         if (mApplyingDelayedActions)
             throw std::runtime_error("DelayedAction is not allowed to create another DelayedAction");
-        mActionQueue.emplace_back(&mLua, std::move(action), name);
+        if (sCurrentPartition != nullptr)
+            sCurrentPartition->mActionQueue.emplace_back(&sCurrentPartition->mLua, std::move(action), name);
+        else
+            mActionQueue.emplace_back(&mLua, std::move(action), name);
+    }
+
+    void LuaManager::queueCallback(LuaUtil::Callback callback, sol::main_object arg)
+    {
+        std::vector<CallbackWithData>& queue
+            = sCurrentPartition != nullptr ? sCurrentPartition->mQueuedCallbacks : mQueuedCallbacks;
+        queue.push_back({ std::move(callback), std::move(arg) });
     }
 
     void LuaManager::addTeleportPlayerAction(std::function<void()> action)
@@ -841,9 +1010,17 @@ namespace MWLua
         mTeleportPlayerAction = DelayedAction(&mLua, std::move(action), "TeleportPlayer");
     }
 
+    std::unique_lock<std::recursive_mutex> LuaManager::lockObjectData()
+    {
+        return std::unique_lock(sObjectDataMutex);
+    }
+
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        stats.setAttribute(frameNumber, "Lua UsedMemory", mLua.getTotalMemoryUsage());
+        uint64_t usedMemory = mLua.getTotalMemoryUsage();
+        for (const auto& partition : mPartitions)
+            usedMemory += partition->mLua.getTotalMemoryUsage();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", usedMemory);
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -869,19 +1046,31 @@ namespace MWLua
                 out << (bytes / (1024 * 1024 * 1024)) << " GB";
         };
 
+        // Local scripts can be distributed among several Lua states
+        auto sumOverStates = [&](auto&& getValue) {
+            int64_t result = getValue(mLua);
+            for (const auto& partition : mPartitions)
+                result += getValue(partition->mLua);
+            return result;
+        };
+        const int64_t totalMemoryUsage
+            = sumOverStates([](const LuaUtil::LuaState& lua) { return lua.getTotalMemoryUsage(); });
+        const int64_t smallAllocMemoryUsage
+            = sumOverStates([](const LuaUtil::LuaState& lua) { return lua.getSmallAllocMemoryUsage(); });
+
         const uint64_t smallAllocSize = Settings::lua().mSmallAllocMaxSize;
         out << "Total memory usage:";
-        outMemSize(mLua.getTotalMemoryUsage());
+        outMemSize(totalMemoryUsage);
         out << "\n";
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
         out << "Smaller values give more information for the profiler, but increase performance overhead.\n";
         out << "  Memory allocations <= " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getSmallAllocMemoryUsage());
+        outMemSize(smallAllocMemoryUsage);
         out << " (not tracked)\n";
         out << "  Memory allocations >  " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getTotalMemoryUsage() - mLua.getSmallAllocMemoryUsage());
+        outMemSize(totalMemoryUsage - smallAllocMemoryUsage);
         out << " (see the table below)\n\n";
 
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
@@ -942,7 +1131,9 @@ namespace MWLua
             out << std::right;
             out << std::setw(valueW) << static_cast<int64_t>(activeStats[i].mAvgInstructionCount);
             outMemSize(activeStats[i].mMemoryUsage);
-            outMemSize(mLua.getMemoryUsageByScriptIndex(i) - activeStats[i].mMemoryUsage);
+            const int64_t memoryUsage
+                = sumOverStates([i](const LuaUtil::LuaState& lua) { return lua.getMemoryUsageByScriptIndex(i); });
+            outMemSize(memoryUsage - activeStats[i].mMemoryUsage);
 
             if (isGlobal)
                 out << std::setw(valueW * 2) << "NA (global script)";
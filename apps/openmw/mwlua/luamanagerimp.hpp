@@ -2,10 +2,15 @@
 #define MWLUA_LUAMANAGERIMP_H
 
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 
 #include <osg/Stats>
+#include <osg/ref_ptr>
 
 #include <components/lua/inputactions.hpp>
 #include <components/lua/luastate.hpp>
@@ -13,6 +18,7 @@
 #include <components/lua/storage.hpp>
 #include <components/lua_ui/resources.hpp>
 #include <components/misc/color.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwbase/luamanager.hpp"
 #include "../mwbase/windowmanager.hpp"
@@ -128,6 +134,11 @@ namespace MWLua
         void addAction(std::function<void()> action, std::string_view name = {});
         void addTeleportPlayerAction(std::function<void()> action);
 
+        // Object data like stats, spells, container stores and cell stores is initialized on first access. Local
+        // scripts of different partitions may access the same object in parallel, so bindings reading such data or
+        // modifying their own object immediately should hold this lock.
+        static std::unique_lock<std::recursive_mutex> lockObjectData();
+
         // Saving
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) override;
         void saveLocalScripts(const MWWorld::Ptr& ptr, ESM::LuaScripts& data) override;
@@ -145,10 +156,7 @@ namespace MWLua
             const std::string& consoleMode, const std::string& command, const MWWorld::Ptr& selectedPtr) override;
 
         // Used to call Lua callbacks from C++
-        void queueCallback(LuaUtil::Callback callback, sol::main_object arg)
-        {
-            mQueuedCallbacks.push_back({ std::move(callback), std::move(arg) });
-        }
+        void queueCallback(LuaUtil::Callback callback, sol::main_object arg);
 
         // Wraps Lua callback into an std::function.
         // NOTE: Resulted function is not thread safe. Can not be used while LuaManager::update() or
@@ -157,7 +165,7 @@ namespace MWLua
         std::function<void(Arg)> wrapLuaCallback(const LuaUtil::Callback& c)
         {
             return [this, c](Arg arg) {
-                this->queueCallback(c, sol::main_object(this->mLua.unsafeState(), sol::in_place, arg));
+                this->queueCallback(c, sol::main_object(c.mFunc.lua_state(), sol::in_place, arg));
             };
         }
 
@@ -177,7 +185,14 @@ namespace MWLua
         bool isSynchronizedUpdateRunning() const { return mRunningSynchronizedUpdates; }
 
     private:
+        struct Partition;
+
         void initConfiguration();
+        void initPartition(Partition& partition);
+        std::size_t selectPartition(const MWWorld::Ptr& ptr) const;
+        // Calls `fn` for every active local script from a Lua context, the partitions are processed in parallel.
+        void runLocalScripts(const std::function<void(LocalScripts&)>& fn);
+        void moveNewPartitionEvents();
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
@@ -191,7 +206,12 @@ namespace MWLua
         bool mReloadAllScriptsRequested = false;
         bool mRunningSynchronizedUpdates = false;
         LuaUtil::ScriptsConfiguration mConfiguration;
+        const VFS::Manager* mVFS;
+        std::filesystem::path mLibsDir;
         LuaUtil::LuaState mLua;
+        // Should be destroyed after everything that can hold references to the Lua states, like the storages
+        std::vector<std::unique_ptr<Partition>> mPartitions;
+        osg::ref_ptr<SceneUtil::WorkQueue> mPartitionsWorkQueue;
         LuaUi::ResourceManager mUiResourceManager;
         std::map<std::string, sol::object> mLocalPackages;
         std::map<std::string, sol::object> mPlayerPackages;
@@ -237,6 +257,28 @@ namespace MWLua
         };
         std::vector<DelayedAction> mActionQueue;
         std::optional<DelayedAction> mTeleportPlayerAction;
+
+        // Local scripts of objects other than the player are distributed among several Lua states if the setting
+        // "local script partitions" is greater than 1. Partition 0 is mLua, the others are stored in mPartitions.
+        // Timers and onUpdate handlers of different partitions run in parallel. Actions and callbacks queued by
+        // a partition are buffered and merged into the main queues in the order of partitions, events are
+        // serialized anyway and are merged before each event batch is finalized.
+        struct Partition
+        {
+            Partition(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+                LuaUtil::LuaStateSettings settings, GlobalScripts& globalScripts, MenuScripts& menuScripts);
+
+            LuaUtil::LuaState mLua;
+            std::map<std::string, sol::object> mLocalPackages;
+            LuaEvents mLuaEvents;
+            LuaUtil::ScriptTracker mScriptTracker;
+            std::vector<LocalScripts*> mActiveLocalScripts;
+            std::vector<DelayedAction> mActionQueue;
+            std::vector<CallbackWithData> mQueuedCallbacks;
+        };
+        // Partition which is currently processed by this thread
+        static thread_local Partition* sCurrentPartition;
+        std::vector<LocalScripts*> mMainPartitionScripts;
         std::vector<std::pair<std::string, MWGui::ShowInDialogueMode>> mUIMessages;
         std::vector<std::pair<std::string, Misc::Color>> mInGameConsoleMessages;
         std::optional<ObjectId> mDelayedUiModeChangedArg;
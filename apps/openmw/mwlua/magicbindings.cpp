@@ -61,6 +61,7 @@ namespace MWLua
         void reset()
         {
             mIndex = 0;
+            const auto lock = LuaManager::lockObjectData();
             auto* store = getStore();
             if (store)
                 mIterator = store->begin();
@@ -97,6 +98,7 @@ namespace MWLua
         if (!isActor())
             return nullptr;
         const MWWorld::Ptr& ptr = mActor.ptr();
+        const auto lock = LuaManager::lockObjectData();
         return &ptr.getClass().getCreatureStats(ptr).getSpells();
     }
 
@@ -106,6 +108,7 @@ namespace MWLua
         if (!isActor())
             return nullptr;
         const MWWorld::Ptr& ptr = mActor.ptr();
+        const auto lock = LuaManager::lockObjectData();
         return &ptr.getClass().getCreatureStats(ptr).getMagicEffects();
     }
 
@@ -115,6 +118,7 @@ namespace MWLua
         if (!isActor())
             return nullptr;
         const MWWorld::Ptr& ptr = mActor.ptr();
+        const auto lock = LuaManager::lockObjectData();
         return &ptr.getClass().getCreatureStats(ptr).getActiveSpells();
     }
 
@@ -722,7 +726,10 @@ namespace MWLua
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
                 spellId = MWBase::Environment::get().getWindowManager()->getSelectedSpell();
             else
+            {
+                const auto lock = LuaManager::lockObjectData();
                 spellId = cls.getCreatureStats(ptr).getSpells().getSelectedSpell();
+            }
             if (spellId.empty())
                 return sol::nullopt;
             else
@@ -798,6 +805,7 @@ namespace MWLua
 
         // #(types.Actor.spells(o))
         spellsT[sol::meta_function::length] = [](const ActorSpells& spells) -> size_t {
+            const auto lock = LuaManager::lockObjectData();
             if (auto* store = spells.getStore())
                 return store->count();
             return 0;
@@ -806,12 +814,14 @@ namespace MWLua
         // types.Actor.spells(o)[i]
         spellsT[sol::meta_function::index] = sol::overload(
             [](const ActorSpells& spells, size_t index) -> const ESM::Spell* {
+                const auto lock = LuaManager::lockObjectData();
                 if (auto* store = spells.getStore())
                     if (index <= store->count() && index > 0)
                         return store->at(LuaUtil::fromLuaIndex(index));
                 return nullptr;
             },
             [spellStore](const ActorSpells& spells, std::string_view spellId) -> const ESM::Spell* {
+                const auto lock = LuaManager::lockObjectData();
                 if (auto* store = spells.getStore())
                 {
                     const ESM::Spell* spell = spellStore->search(ESM::RefId::deserializeText(spellId));
@@ -865,6 +875,7 @@ namespace MWLua
             if (spells.mActor.isLObject())
                 throw std::runtime_error("Local scripts can modify only spells of the actor they are attached to.");
             auto* spell = toSpell(spellOrId);
+            const auto lock = LuaManager::lockObjectData();
             if (auto* store = spells.getStore())
                 return store->canUsePower(spell);
             return false;
@@ -875,6 +886,7 @@ namespace MWLua
             sol::state_view lua(ts);
             self.reset();
             return sol::as_function([lua, self]() mutable -> std::pair<sol::object, sol::object> {
+                const auto lock = LuaManager::lockObjectData();
                 if (!self.isEnd())
                 {
                     auto id = sol::make_object(lua, self.mIterator->getSourceSpellId().serializeText());
@@ -892,6 +904,7 @@ namespace MWLua
         // types.Actor.activeSpells(o):isSpellActive(id)
         activeSpellsT["isSpellActive"]
             = [](const ActorActiveSpells& activeSpells, const sol::object& recordOrId) -> bool {
+            const auto lock = LuaManager::lockObjectData();
             if (auto* store = activeSpells.getStore())
             {
                 auto id = toRecordId(recordOrId);
@@ -925,6 +938,7 @@ namespace MWLua
             if (spells.isLObject())
                 throw std::runtime_error("Local scripts can modify effect only on the actor they are attached to.");
 
+            const auto lock = LuaManager::lockObjectData();
             if (auto* store = spells.getStore())
             {
                 ESM::RefId id = ESM::RefId::deserializeText(options.get<std::string_view>("id"));
@@ -999,6 +1013,7 @@ namespace MWLua
             sol::state_view lua(ts);
             self.reset();
             return sol::as_function([lua, self]() mutable -> std::pair<sol::object, sol::object> {
+                const auto lock = LuaManager::lockObjectData();
                 while (!self.isEnd())
                 {
                     if (self.mIterator->second.getBase() == 0 && self.mIterator->second.getModifier() == 0.f)
@@ -1052,6 +1067,7 @@ namespace MWLua
 
             MWMechanics::EffectKey key = getEffectKey(idStr, argStr);
 
+            const auto lock = LuaManager::lockObjectData();
             if (auto* store = effects.getStore())
                 if (auto effect = store->get(key))
                     return ActiveEffect{ key, effect.value() };
@@ -1089,6 +1105,7 @@ namespace MWLua
                 throw std::runtime_error("Local scripts can modify effect only on the actor they are attached to.");
 
             MWMechanics::EffectKey key = getEffectKey(idStr, argStr);
+            const auto lock = LuaManager::lockObjectData();
             int currentValue = effects.getStore()->getOrDefault(key).getMagnitude();
             effects.getStore()->modifyBase(key, value - currentValue);
         };
@@ -1103,6 +1120,7 @@ namespace MWLua
                 throw std::runtime_error("Local scripts can modify effect only on the actor they are attached to.");
 
             MWMechanics::EffectKey key = getEffectKey(idStr, argStr);
+            const auto lock = LuaManager::lockObjectData();
             effects.getStore()->modifyBase(key, value);
         };
     }
@@ -616,6 +616,7 @@ namespace MWLua
                     throw std::runtime_error(
                         std::string("Incorrect type argument in inventory:getAll: " + LuaUtil::toString(*type)));
 
+                const auto lock = LuaManager::lockObjectData();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 ObjectIdList list = std::make_shared<std::vector<ObjectId>>();
@@ -630,6 +631,7 @@ namespace MWLua
             };
 
             inventoryT["countOf"] = [](const InventoryT& inventory, std::string_view recordId) {
+                const auto lock = LuaManager::lockObjectData();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 return store.count(ESM::RefId::deserializeText(recordId));
@@ -643,6 +645,7 @@ namespace MWLua
                 };
             }
             inventoryT["isResolved"] = [](const InventoryT& inventory) -> bool {
+                const auto lock = LuaManager::lockObjectData();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 // Avoid initializing custom data
                 if (!ptr.getRefData().getCustomData())
@@ -651,6 +654,7 @@ namespace MWLua
                 return store.isResolved();
             };
             inventoryT["find"] = [](const InventoryT& inventory, std::string_view recordId) -> sol::optional<ObjectT> {
+                const auto lock = LuaManager::lockObjectData();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 auto itemId = ESM::RefId::deserializeText(recordId);
@@ -665,6 +669,7 @@ namespace MWLua
                 return sol::nullopt;
             };
             inventoryT["findAll"] = [](const InventoryT& inventory, std::string_view recordId) {
+                const auto lock = LuaManager::lockObjectData();
                 const MWWorld::Ptr& ptr = inventory.mObj.ptr();
                 MWWorld::ContainerStore& store = ptr.getClass().getContainerStore(ptr);
                 auto itemId = ESM::RefId::deserializeText(recordId);
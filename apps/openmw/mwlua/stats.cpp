@@ -56,6 +56,7 @@ namespace
             if (it != self->mStatsCache.end())
                 return it->second;
         }
+        const auto lock = MWLua::LuaManager::lockObjectData();
         return sol::make_object(context.mLua->unsafeState(), getter(obj.ptr()));
     }
 }
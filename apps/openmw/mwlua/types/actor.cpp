@@ -199,16 +199,17 @@ namespace MWLua
 
         actor["getStance"] = [](const Object& o) {
             const MWWorld::Class& cls = o.ptr().getClass();
-            if (cls.isActor())
-                return cls.getCreatureStats(o.ptr()).getDrawState();
-            else
+            if (!cls.isActor())
                 throw std::runtime_error("Actor expected");
+            const auto lock = LuaManager::lockObjectData();
+            return cls.getCreatureStats(o.ptr()).getDrawState();
         };
         actor["stance"] = actor["getStance"]; // for compatibility; should be removed later
         actor["setStance"] = [](const SelfObject& self, int stance) {
             const MWWorld::Class& cls = self.ptr().getClass();
             if (!cls.isActor())
                 throw std::runtime_error("Actor expected");
+            const auto lock = LuaManager::lockObjectData();
             auto& stats = cls.getCreatureStats(self.ptr());
             if (stance != static_cast<int>(MWMechanics::DrawState::Nothing)
                 && stance != static_cast<int>(MWMechanics::DrawState::Weapon)
@@ -250,6 +251,7 @@ namespace MWLua
         };
 
         actor["getSelectedEnchantedItem"] = [](sol::this_state thisState, const Object& o) -> sol::object {
+            const auto lock = LuaManager::lockObjectData();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return sol::nil;
@@ -312,6 +314,7 @@ namespace MWLua
         actor["inventory"] = sol::overload([](const LObject& o) { return Inventory<LObject>{ o }; },
             [](const GObject& o) { return Inventory<GObject>{ o }; });
         auto getAllEquipment = [](sol::this_state thisState, const Object& o) {
+            const auto lock = LuaManager::lockObjectData();
             const MWWorld::Ptr& ptr = o.ptr();
             sol::table equipment(thisState, sol::create);
             if (!ptr.getClass().hasInventoryStore(ptr))
@@ -332,6 +335,7 @@ namespace MWLua
             return equipment;
         };
         auto getEquipmentFromSlot = [](sol::this_state thisState, const Object& o, int slot) -> sol::object {
+            const auto lock = LuaManager::lockObjectData();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return sol::nil;
@@ -348,6 +352,7 @@ namespace MWLua
         actor["getEquipment"] = sol::overload(getAllEquipment, getEquipmentFromSlot);
         actor["equipment"] = actor["getEquipment"]; // for compatibility; should be removed later
         actor["hasEquipped"] = [](const Object& o, const Object& item) {
+            const auto lock = LuaManager::lockObjectData();
             const MWWorld::Ptr& ptr = o.ptr();
             if (!ptr.getClass().hasInventoryStore(ptr))
                 return false;
@@ -403,21 +408,25 @@ namespace MWLua
 
         actor["isDead"] = [](const Object& o) {
             const auto& target = o.ptr();
+            const auto lock = LuaManager::lockObjectData();
             return target.getClass().getCreatureStats(target).isDead();
         };
 
         actor["isDeathFinished"] = [](const Object& o) {
             const auto& target = o.ptr();
+            const auto lock = LuaManager::lockObjectData();
             return target.getClass().getCreatureStats(target).isDeathAnimationFinished();
         };
 
         actor["getEncumbrance"] = [](const Object& object) -> float {
             const MWWorld::Ptr ptr = object.ptr();
+            const auto lock = LuaManager::lockObjectData();
             return ptr.getClass().getEncumbrance(ptr);
         };
 
         actor["getCapacity"] = [](const Object& object) -> float {
             const MWWorld::Ptr ptr = object.ptr();
+            const auto lock = LuaManager::lockObjectData();
             return ptr.getClass().getCapacity(ptr);
         };
 
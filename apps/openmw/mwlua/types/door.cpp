@@ -3,6 +3,7 @@
 #include "modelproperty.hpp"
 
 #include "../localscripts.hpp"
+#include "../luamanagerimp.hpp"
 
 #include <components/esm3/loaddoor.hpp>
 #include <components/esm4/loaddoor.hpp>
@@ -93,6 +94,7 @@ namespace MWLua
             const MWWorld::CellRef& cellRef = doorPtr(o).getCellRef();
             if (!cellRef.getTeleport())
                 return sol::nil;
+            const auto lock = LuaManager::lockObjectData();
             MWWorld::CellStore& cell = MWBase::Environment::get().getWorldModel()->getCell(cellRef.getDestCell());
             if (dynamic_cast<const GObject*>(&o))
                 return sol::make_object(thisState, GCell{ &cell });
@@ -128,6 +130,7 @@ namespace MWLua
             const MWWorld::CellRef& cellRef = door4Ptr(o).getCellRef();
             if (!cellRef.getTeleport())
                 return sol::nil;
+            const auto lock = LuaManager::lockObjectData();
             MWWorld::CellStore& cell = MWBase::Environment::get().getWorldModel()->getCell(cellRef.getDestCell());
             if (dynamic_cast<const GObject*>(&o))
                 return sol::make_object(lua, GCell{ &cell });
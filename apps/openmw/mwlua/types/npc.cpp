@@ -19,6 +19,7 @@
 
 #include "../classbindings.hpp"
 #include "../localscripts.hpp"
+#include "../luamanagerimp.hpp"
 #include "../racebindings.hpp"
 #include "../stats.hpp"
 
@@ -240,16 +241,17 @@ namespace MWLua
         // This function is game-specific, in future we should replace it with something more universal.
         npc["isWerewolf"] = [](const Object& o) {
             const MWWorld::Class& cls = o.ptr().getClass();
-            if (cls.isNpc())
-                return cls.getNpcStats(o.ptr()).isWerewolf();
-            else
+            if (!cls.isNpc())
                 throw std::runtime_error("NPC or Player expected");
+            const auto lock = LuaManager::lockObjectData();
+            return cls.getNpcStats(o.ptr()).isWerewolf();
         };
 
         npc["getDisposition"] = [](const Object& o, const Object& player) -> int {
             const MWWorld::Class& cls = o.ptr().getClass();
             verifyPlayer(player);
             verifyNpc(cls);
+            const auto lock = LuaManager::lockObjectData();
             return MWBase::Environment::get().getMechanicsManager()->getDerivedDisposition(o.ptr());
         };
 
@@ -257,6 +259,7 @@ namespace MWLua
             const MWWorld::Class& cls = o.ptr().getClass();
             verifyPlayer(player);
             verifyNpc(cls);
+            const auto lock = LuaManager::lockObjectData();
             return cls.getNpcStats(o.ptr()).getBaseDisposition();
         };
 
@@ -267,6 +270,7 @@ namespace MWLua
             const MWWorld::Class& cls = o.ptr().getClass();
             verifyPlayer(player);
             verifyNpc(cls);
+            const auto lock = LuaManager::lockObjectData();
             cls.getNpcStats(o.ptr()).setBaseDisposition(value);
         };
 
@@ -277,6 +281,7 @@ namespace MWLua
             const MWWorld::Class& cls = o.ptr().getClass();
             verifyPlayer(player);
             verifyNpc(cls);
+            const auto lock = LuaManager::lockObjectData();
             auto& stats = cls.getNpcStats(o.ptr());
             stats.setBaseDisposition(stats.getBaseDisposition() + value);
         };
@@ -286,6 +291,7 @@ namespace MWLua
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
 
+            const auto lock = LuaManager::lockObjectData();
             const MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
             {
@@ -327,6 +333,7 @@ namespace MWLua
                     throw std::runtime_error("Only players can modify ranks in non-primary factions");
             }
 
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
             if (!npcStats.isInFaction(factionId))
                 throw std::runtime_error("Target actor is not a member of faction " + factionId.toDebugString());
@@ -351,6 +358,7 @@ namespace MWLua
 
             auto ranksCount = static_cast<int>(getValidRanksCount(factionPtr));
 
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
 
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
@@ -389,6 +397,7 @@ namespace MWLua
 
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
             {
+                const auto lock = LuaManager::lockObjectData();
                 MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
                 int currentRank = npcStats.getFactionRank(factionId);
                 if (currentRank < 0)
@@ -408,6 +417,7 @@ namespace MWLua
 
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
             {
+                const auto lock = LuaManager::lockObjectData();
                 ptr.getClass().getNpcStats(ptr).setFactionRank(factionId, -1);
                 return;
             }
@@ -419,6 +429,7 @@ namespace MWLua
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
 
+            const auto lock = LuaManager::lockObjectData();
             return ptr.getClass().getNpcStats(ptr).getFactionReputation(factionId);
         };
 
@@ -429,6 +440,7 @@ namespace MWLua
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
 
+            const auto lock = LuaManager::lockObjectData();
             ptr.getClass().getNpcStats(ptr).setFactionReputation(factionId, value);
         };
 
@@ -439,6 +451,7 @@ namespace MWLua
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
 
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
             int existingReputation = npcStats.getFactionReputation(factionId);
             npcStats.setFactionReputation(factionId, existingReputation + value);
@@ -450,6 +463,7 @@ namespace MWLua
 
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
+            const auto lock = LuaManager::lockObjectData();
             ptr.getClass().getNpcStats(ptr).expell(factionId, false);
         };
         npc["clearExpelled"] = [](Object& actor, std::string_view faction) {
@@ -458,15 +472,18 @@ namespace MWLua
 
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
+            const auto lock = LuaManager::lockObjectData();
             ptr.getClass().getNpcStats(ptr).clearExpelled(factionId);
         };
         npc["isExpelled"] = [](const Object& actor, std::string_view faction) {
             const MWWorld::Ptr ptr = actor.ptr();
             ESM::RefId factionId = parseFactionId(faction);
+            const auto lock = LuaManager::lockObjectData();
             return ptr.getClass().getNpcStats(ptr).getExpelled(factionId);
         };
         npc["getFactions"] = [](sol::this_state thisState, const Object& actor) {
             const MWWorld::Ptr ptr = actor.ptr();
+            const auto lock = LuaManager::lockObjectData();
             MWMechanics::NpcStats& npcStats = ptr.getClass().getNpcStats(ptr);
             sol::table res(thisState, sol::create);
             if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
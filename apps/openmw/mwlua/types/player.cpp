@@ -425,6 +425,7 @@ namespace MWLua
 
         player["getCrimeLevel"] = [](const Object& o) -> int {
             const MWWorld::Class& cls = o.ptr().getClass();
+            const auto lock = LuaManager::lockObjectData();
             return cls.getNpcStats(o.ptr()).getBounty();
         };
         player["setCrimeLevel"] = [](const Object& o, int amount) {
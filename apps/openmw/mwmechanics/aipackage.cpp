@@ -16,6 +16,7 @@
 #include "../mwworld/class.hpp"
 #include "../mwworld/containerstore.hpp"
 #include "../mwworld/esmstore.hpp"
+#include "../mwworld/scene.hpp"
 
 #include "../mwphysics/raycasting.hpp"
 
@@ -356,12 +357,7 @@ const MWMechanics::PathgridGraph& MWMechanics::AiPackage::getPathGridGraph(const
 {
     if (!pathgrid || pathgrid->mPoints.empty())
         return PathgridGraph::sEmpty;
-    // static cache is OK for now, pathgrids can never change during runtime
-    static std::map<const ESM::Pathgrid*, std::unique_ptr<MWMechanics::PathgridGraph>> cache;
-    auto found = cache.find(pathgrid);
-    if (found == cache.end())
-        found = cache.emplace(pathgrid, std::make_unique<MWMechanics::PathgridGraph>(*pathgrid)).first;
-    return *found->second.get();
+    return MWBase::Environment::get().getWorldScene()->getPathgridGraphs().get(*pathgrid);
 }
 
 bool MWMechanics::AiPackage::shortcutPath(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
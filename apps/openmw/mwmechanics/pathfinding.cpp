@@ -1,5 +1,6 @@
 #include "pathfinding.hpp"
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
 
@@ -142,6 +143,45 @@ namespace MWMechanics
         return (std::abs(from.z() - h) <= PATHFIND_Z_REACH);
     }
 
+    const std::vector<std::size_t>& PathFinder::findPathgridPath(
+        const PathgridGraph& pathgridGraph, std::size_t start, std::size_t end)
+    {
+        std::vector<std::size_t>& points = mPathgridPath.mPoints;
+        if (mPathgridPath.mPathgrid == pathgridGraph.getPathgrid() && !points.empty())
+        {
+            // The actor moved along the path or stepped back to a point next to its beginning
+            const auto first = std::find(points.begin(), points.end(), start);
+            if (first != points.end())
+                points.erase(points.begin(), first);
+            else if (pathgridGraph.hasEdge(start, points.front()))
+                points.insert(points.begin(), start);
+            else
+                points.clear();
+
+            if (!points.empty())
+            {
+                if (points.back() == end)
+                    return points;
+                // The destination moved to a point on the path
+                const auto last = std::find(points.begin(), points.end(), end);
+                if (last != points.end())
+                {
+                    points.erase(std::next(last), points.end());
+                    return points;
+                }
+                // The destination moved to a point next to the end of the path
+                if (pathgridGraph.hasEdge(points.back(), end))
+                {
+                    points.push_back(end);
+                    return points;
+                }
+            }
+        }
+        mPathgridPath.mPathgrid = pathgridGraph.getPathgrid();
+        pathgridGraph.aStarSearch(start, end, points);
+        return points;
+    }
+
     /*
      * NOTE: This method may fail to find a path.  The caller must check the
      * result before using it.  If there is no path the AI routies need to
@@ -228,7 +268,9 @@ namespace MWMechanics
         }
         else
         {
-            auto path = pathgridGraph.aStarSearch(startNode, endNode.first);
+            std::deque<ESM::Pathgrid::Point> path;
+            for (const std::size_t point : findPathgridPath(pathgridGraph, startNode, endNode.first))
+                path.push_back(pathgrid->mPoints[point]);
 
             // If nearest path node is in opposite direction from second, remove it from path.
             // Especially useful for wandering actors, if the nearest node is blocked for some reason.
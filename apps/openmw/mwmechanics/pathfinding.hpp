@@ -5,6 +5,7 @@
 #include <deque>
 #include <iterator>
 #include <span>
+#include <vector>
 
 #include <osg/Vec3f>
 
@@ -12,6 +13,11 @@
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/status.hpp>
 
+namespace ESM
+{
+    struct Pathgrid;
+}
+
 namespace MWWorld
 {
     class CellStore;
@@ -144,9 +150,22 @@ namespace MWMechanics
         }
 
     private:
+        // Pathgrid point indexes of the last pathgrid search
+        struct PathgridPath
+        {
+            const ESM::Pathgrid* mPathgrid = nullptr;
+            std::vector<std::size_t> mPoints;
+        };
+
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        PathgridPath mPathgridPath;
+
+        // Reuses the last pathgrid path when the actor or the destination moved to a point on it or next to its ends
+        // instead of searching again
+        const std::vector<std::size_t>& findPathgridPath(
+            const PathgridGraph& pathgridGraph, std::size_t start, std::size_t end);
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
@@ -1,8 +1,6 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
 
 namespace
 {
@@ -45,6 +43,54 @@ namespace
     }
 
     constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+    enum class PointState : unsigned char
+    {
+        Unvisited,
+        Open,
+        Closed,
+    };
+
+    struct OpenPoint
+    {
+        float mFScore;
+        std::size_t mOrder; // keeps points with equal cost in insertion order
+        size_t mIndex;
+    };
+
+    struct GreaterOpenPoint
+    {
+        bool operator()(const OpenPoint& lhs, const OpenPoint& rhs) const
+        {
+            if (lhs.mFScore != rhs.mFScore)
+                return lhs.mFScore > rhs.mFScore;
+            return lhs.mOrder > rhs.mOrder;
+        }
+    };
+
+    // Per thread buffers reused by all searches to avoid allocations for each call
+    struct SearchBuffers
+    {
+        std::vector<float> mGScore;
+        std::vector<size_t> mParent;
+        std::vector<PointState> mState;
+        std::vector<OpenPoint> mOpenSet;
+        std::vector<size_t> mPath;
+
+        void reset(std::size_t size)
+        {
+            mGScore.assign(size, -1);
+            mParent.assign(size, NoIndex);
+            mState.assign(size, PointState::Unvisited);
+            mOpenSet.clear();
+        }
+    };
+
+    SearchBuffers& getSearchBuffers()
+    {
+        static thread_local SearchBuffers buffers;
+        return buffers;
+    }
 }
 
 namespace MWMechanics
@@ -58,6 +104,7 @@ namespace MWMechanics
         int mSCCId = 0;
         size_t mSCCIndex = 0;
         std::vector<size_t> mSCCStack;
+        std::vector<bool> mOnSCCStack;
         std::vector<std::pair<size_t, size_t>> mSCCPoint; // first is index, second is lowlink
 
         // v is the pathgrid point index (some call them vertices)
@@ -67,6 +114,7 @@ namespace MWMechanics
             mSCCPoint[v].second = mSCCIndex; // lowlink
             mSCCIndex++;
             mSCCStack.push_back(v);
+            mOnSCCStack[v] = true;
             size_t w;
 
             for (const auto& edge : mGraph[v].edges)
@@ -77,7 +125,7 @@ namespace MWMechanics
                     recursiveStrongConnect(w); // recurse
                     mSCCPoint[v].second = std::min(mSCCPoint[v].second, mSCCPoint[w].second);
                 }
-                else if (std::find(mSCCStack.begin(), mSCCStack.end(), w) != mSCCStack.end())
+                else if (mOnSCCStack[w])
                     mSCCPoint[v].second = std::min(mSCCPoint[v].second, mSCCPoint[w].first);
             }
 
@@ -87,6 +135,7 @@ namespace MWMechanics
                 {
                     w = mSCCStack.back();
                     mSCCStack.pop_back();
+                    mOnSCCStack[w] = false;
                     mGraph[w].componentId = mSCCId;
                 } while (w != v);
                 mSCCId++;
@@ -126,6 +175,7 @@ namespace MWMechanics
             size_t pointsSize = graph.mPathgrid->mPoints.size();
             mSCCPoint.resize(pointsSize, std::pair<size_t, size_t>(NoIndex, NoIndex));
             mSCCStack.reserve(pointsSize);
+            mOnSCCStack.resize(pointsSize, false);
 
             for (size_t v = 0; v < pointsSize; ++v)
             {
@@ -214,101 +264,130 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
+     * MT safe as long as the graph is not modified, search state is kept in
+     * thread local buffers which are reused between calls.
      *
-     * Returns path which may be empty.  path contains pathgrid points in local
-     * cell coordinates (indoors) or world coordinates (external).
+     * Fills path which may be empty.  path contains pathgrid point indexes
+     * starting with start and ending with goal.
      *
      * Input params:
      *   start, goal - pathgrid point indexes (for this cell)
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
-     *   closedset - point indexes already traversed
+     *   openSet - binary heap of point indexes to be traversed, lowest fScore
+     *             at the front. A point may be pushed again when a cheaper path
+     *             to it is found, stale entries are skipped once it's closed.
+     *   state - whether point index is not visited, in openSet or traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
      *
-     * TODO: An interesting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * Paths are cached and repaired per actor by PathFinder.
      */
-    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
+    void PathgridGraph::aStarSearch(const size_t start, const size_t goal, std::vector<size_t>& path) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
+        path.clear();
         if (!isPointConnected(start, goal))
         {
-            return path; // there is no path, return an empty path
+            return; // there is no path, return an empty path
         }
 
-        size_t graphSize = mGraph.size();
-        std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
-        std::vector<size_t> graphParent(graphSize, NoIndex);
+        SearchBuffers& buffers = getSearchBuffers();
+        buffers.reset(mGraph.size());
+        std::vector<float>& gScore = buffers.mGScore;
+        std::vector<size_t>& graphParent = buffers.mParent;
+        std::vector<PointState>& state = buffers.mState;
+        std::vector<OpenPoint>& openSet = buffers.mOpenSet;
+        std::size_t order = 0;
 
-        // gScore & fScore keep costs for each pathgrid point in mPoints
+        // gScore keeps costs for each pathgrid point in mPoints
         gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
-
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        state[start] = PointState::Open;
+        openSet.push_back(OpenPoint{ costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), order++, start });
 
         size_t current = start;
 
-        while (!openset.empty())
+        while (!openSet.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            std::pop_heap(openSet.begin(), openSet.end(), GreaterOpenPoint{}); // front has the lowest cost
+            const size_t next = openSet.back().mIndex;
+            openSet.pop_back();
+
+            if (state[next] == PointState::Closed)
+                continue; // stale entry, the point was reached with a lower cost before
+
+            current = next;
 
             if (current == goal)
                 break;
 
-            closedset.insert(current); // remember we've been here
+            state[current] = PointState::Closed; // remember we've been here
 
             // check all edges for the current point index
             for (const auto& edge : mGraph[current].edges)
             {
-                if (!closedset.contains(edge.index))
+                const size_t dest = edge.index;
+                // if traversed this edge destination already, try the next edge
+                if (state[dest] == PointState::Closed)
+                    continue;
+
+                const float tentativeG = gScore[current] + edge.cost;
+                if (state[dest] == PointState::Unvisited || tentativeG < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentativeG = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentativeG < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentativeG;
-                        fScore[dest] = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentativeG;
+                    state[dest] = PointState::Open;
+                    const float fScore = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
+                    openSet.push_back(OpenPoint{ fScore, order++, dest });
+                    std::push_heap(openSet.begin(), openSet.end(), GreaterOpenPoint{});
+                }
             }
         }
 
         if (current != goal)
-            return path; // for some reason couldn't build a path
+            return; // for some reason couldn't build a path
 
-        // reconstruct path to return, using local coordinates
-        while (graphParent[current] != NoIndex)
-        {
-            path.push_front(mPathgrid->mPoints[current]);
-            current = graphParent[current];
-        }
+        // reconstruct path to return, start point is the only one without a parent
+        for (; current != NoIndex; current = graphParent[current])
+            path.push_back(current);
+        std::reverse(path.begin(), path.end());
+    }
 
-        // add first node to path explicitly
-        path.push_front(mPathgrid->mPoints[start]);
+    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
+    {
+        std::deque<ESM::Pathgrid::Point> path;
+        std::vector<size_t>& points = getSearchBuffers().mPath;
+        aStarSearch(start, goal, points);
+        for (const size_t point : points)
+            path.push_back(mPathgrid->mPoints[point]);
         return path;
     }
+
+    bool PathgridGraph::hasEdge(const size_t from, const size_t to) const
+    {
+        const std::vector<ConnectedPoint>& edges = mGraph[from].edges;
+        return std::any_of(edges.begin(), edges.end(), [&](const ConnectedPoint& edge) { return edge.index == to; });
+    }
+
+    void PathgridGraphCache::add(const ESM::Pathgrid& pathgrid)
+    {
+        if (pathgrid.mPoints.empty())
+            return;
+        auto& graph = mGraphs[&pathgrid];
+        if (graph == nullptr)
+            graph = std::make_unique<PathgridGraph>(pathgrid);
+    }
+
+    void PathgridGraphCache::remove(const ESM::Pathgrid& pathgrid)
+    {
+        mGraphs.erase(&pathgrid);
+    }
+
+    const PathgridGraph& PathgridGraphCache::get(const ESM::Pathgrid& pathgrid)
+    {
+        if (pathgrid.mPoints.empty())
+            return PathgridGraph::sEmpty;
+        auto& graph = mGraphs[&pathgrid];
+        if (graph == nullptr)
+            graph = std::make_unique<PathgridGraph>(pathgrid);
+        return *graph;
+    }
 }
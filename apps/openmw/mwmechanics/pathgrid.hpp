@@ -2,6 +2,9 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -33,6 +36,12 @@ namespace MWMechanics
         // NOTE: if start equals end an empty path is returned
         std::deque<ESM::Pathgrid::Point> aStarSearch(const size_t start, const size_t end) const;
 
+        // same as above but the output are pathgrid point indexes starting with start, path is cleared first
+        void aStarSearch(const size_t start, const size_t end, std::vector<size_t>& path) const;
+
+        // returns true if there is an edge from one pathgrid point to another
+        bool hasEdge(const size_t from, const size_t to) const;
+
         static const PathgridGraph sEmpty;
 
     private:
@@ -63,6 +72,22 @@ namespace MWMechanics
         //
         std::vector<Node> mGraph;
     };
+
+    // Graphs of the pathgrids of loaded cells. They are built when a cell is loaded, so AI packages don't build them
+    // while updating actors, and dropped when the cell is unloaded.
+    class PathgridGraphCache
+    {
+    public:
+        void add(const ESM::Pathgrid& pathgrid);
+
+        void remove(const ESM::Pathgrid& pathgrid);
+
+        // builds the graph if the pathgrid was not added, it's kept until remove is called
+        const PathgridGraph& get(const ESM::Pathgrid& pathgrid);
+
+    private:
+        std::map<const ESM::Pathgrid*, std::unique_ptr<PathgridGraph>> mGraphs;
+    };
 }
 
 #endif
@@ -909,6 +909,32 @@ namespace MWPhysics
     {
     }
 
+    ActorFrameData::ActorFrameData(
+        btCollisionObject* collisionObject, float halfExtentsZ, float swimLevel, float waterlevel)
+        : mPosition()
+        , mStandingOn(nullptr)
+        , mIsOnGround(false)
+        , mIsOnSlope(false)
+        , mWalkingOnWater(false)
+        , mInert(false)
+        , mCollisionObject(collisionObject)
+        , mSwimLevel(swimLevel)
+        , mSlowFall(1.f)
+        , mRotation()
+        , mMovement()
+        , mWaterlevel(waterlevel)
+        , mHalfExtentsZ(halfExtentsZ)
+        , mOldHeight(0)
+        , mStuckFrames(0)
+        , mFlying(false)
+        , mWasOnGround(false)
+        , mIsAquatic(false)
+        , mWaterCollision(false)
+        , mSkipCollisionDetection(false)
+        , mIsPlayer(false)
+    {
+    }
+
     ProjectileFrameData::ProjectileFrameData(Projectile& projectile)
         : mPosition(projectile.getPosition())
         , mMovement(projectile.velocity())
@@ -924,6 +950,12 @@ namespace MWPhysics
     {
     }
 
+    WorldFrameData::WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection)
+        : mIsInStorm(isInStorm)
+        , mStormDirection(stormDirection)
+    {
+    }
+
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
         : mResult(false)
         , mStale(false)
@@ -81,6 +81,8 @@ namespace MWPhysics
     struct ActorFrameData
     {
         ActorFrameData(Actor& actor, bool inert, bool waterCollision, float slowFall, float waterlevel, bool isPlayer);
+        /// Frame data for a collision object that is not backed by a MWWorld::Ptr (used by benchmarks).
+        ActorFrameData(btCollisionObject* collisionObject, float halfExtentsZ, float swimLevel, float waterlevel);
         osg::Vec3f mPosition;
         osg::Vec3f mInertia;
         const btCollisionObject* mStandingOn;
@@ -119,6 +121,7 @@ namespace MWPhysics
     struct WorldFrameData
     {
         WorldFrameData();
+        WorldFrameData(bool isInStorm, const osg::Vec3f& stormDirection);
         bool mIsInStorm;
         osg::Vec3f mStormDirection;
     };
@@ -8,6 +8,8 @@
 
 #include <osgDB/WriteFile>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 #include <components/files/memorystream.hpp>
 #include <components/settings/values.hpp>
 
@@ -26,21 +28,25 @@
 
 #include "vismask.hpp"
 
+#include <array>
+#include <cstring>
+#include <fstream>
+
 namespace
 {
 
-    // Create a screen-aligned quad with given texture coordinates.
+    // Create a quad covering given normalized device coordinates with given texture coordinates.
     // Assumes a top-left origin of the sampled image.
-    osg::ref_ptr<osg::Geometry> createTexturedQuad(
-        float leftTexCoord, float topTexCoord, float rightTexCoord, float bottomTexCoord)
+    osg::ref_ptr<osg::Geometry> createTexturedQuad(float leftTexCoord, float topTexCoord, float rightTexCoord,
+        float bottomTexCoord, float left, float top, float right, float bottom)
     {
         osg::ref_ptr<osg::Geometry> geom = new osg::Geometry;
 
         osg::ref_ptr<osg::Vec3Array> verts = new osg::Vec3Array;
-        verts->push_back(osg::Vec3f(-1, -1, 0));
-        verts->push_back(osg::Vec3f(-1, 1, 0));
-        verts->push_back(osg::Vec3f(1, 1, 0));
-        verts->push_back(osg::Vec3f(1, -1, 0));
+        verts->push_back(osg::Vec3f(left, bottom, 0));
+        verts->push_back(osg::Vec3f(left, top, 0));
+        verts->push_back(osg::Vec3f(right, top, 0));
+        verts->push_back(osg::Vec3f(right, bottom, 0));
 
         geom->setVertexArray(verts);
 
@@ -118,136 +124,247 @@ namespace
 namespace MWRender
 {
 
-    class CreateMapWorkItem : public SceneUtil::WorkItem
+    namespace
+    {
+        // Base map is generated and cached in tiles aligned to the cell grid, so a tile doesn't depend on the world
+        // bounds and is regenerated only when land of its cells changes
+        constexpr int sTileSize = 16;
+        constexpr std::array<char, 8> sTileMagic = { 'O', 'M', 'W', 'G', 'M', 'A', 'P', 'T' };
+        constexpr std::uint32_t sTileVersion = 1;
+
+        using TileHash = std::array<std::uint64_t, 2>;
+
+        int getTileIndex(int cell)
+        {
+            return cell >= 0 ? cell / sTileSize : (cell + 1) / sTileSize - 1;
+        }
+
+        void getTexel(const ESM::Land* land, int vertexX, int vertexY, unsigned char* color, unsigned char& alpha)
+        {
+            float y2 = 0;
+            if (land && (land->mDataTypes & ESM::Land::DATA_WNAM))
+                y2 = land->mWnam[vertexY * 9 + vertexX] / 128.f;
+            else
+                y2 = SCHAR_MIN / 128.f;
+            if (y2 < 0)
+            {
+                color[0] = static_cast<unsigned char>(14 * y2 + 38);
+                color[1] = static_cast<unsigned char>(20 * y2 + 56);
+                color[2] = static_cast<unsigned char>(18 * y2 + 51);
+            }
+            else if (y2 < 0.3f)
+            {
+                if (y2 < 0.1f)
+                    y2 *= 8.f;
+                else
+                {
+                    y2 -= 0.1f;
+                    y2 += 0.8f;
+                }
+                color[0] = static_cast<unsigned char>(66 - 32 * y2);
+                color[1] = static_cast<unsigned char>(48 - 23 * y2);
+                color[2] = static_cast<unsigned char>(33 - 16 * y2);
+            }
+            else
+            {
+                y2 -= 0.3f;
+                y2 *= 1.428f;
+                color[0] = static_cast<unsigned char>(34 - 29 * y2);
+                color[1] = static_cast<unsigned char>(25 - 20 * y2);
+                color[2] = static_cast<unsigned char>(17 - 12 * y2);
+            }
+
+            alpha = (y2 < 0) ? static_cast<unsigned char>(0) : static_cast<unsigned char>(255);
+        }
+
+        struct MapTile
+        {
+            // RGB, rows of texels bottom to top
+            std::vector<unsigned char> mColors;
+            std::vector<unsigned char> mAlpha;
+        };
+
+        bool readTile(const std::filesystem::path& path, const TileHash& hash, std::size_t texels, MapTile& tile)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                return false;
+
+            std::array<char, sTileMagic.size()> magic;
+            std::uint32_t version = 0;
+            TileHash storedHash;
+            stream.read(magic.data(), magic.size());
+            stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+            stream.read(reinterpret_cast<char*>(storedHash.data()), sizeof(storedHash));
+            if (!stream || magic != sTileMagic || version != sTileVersion || storedHash != hash)
+                return false;
+
+            tile.mColors.resize(texels * 3);
+            tile.mAlpha.resize(texels);
+            stream.read(reinterpret_cast<char*>(tile.mColors.data()), tile.mColors.size());
+            stream.read(reinterpret_cast<char*>(tile.mAlpha.data()), tile.mAlpha.size());
+            return static_cast<bool>(stream);
+        }
+
+        void writeTile(const std::filesystem::path& path, const TileHash& hash, const MapTile& tile)
+        {
+            try
+            {
+                std::filesystem::create_directories(path.parent_path());
+                // Never leave a partially written tile in case of a crash
+                std::filesystem::path temporary = path;
+                temporary += ".tmp";
+                {
+                    std::ofstream stream(temporary, std::ios::binary);
+                    stream.exceptions(std::ios::failbit | std::ios::badbit);
+                    stream.write(sTileMagic.data(), sTileMagic.size());
+                    stream.write(reinterpret_cast<const char*>(&sTileVersion), sizeof(sTileVersion));
+                    stream.write(reinterpret_cast<const char*>(hash.data()), sizeof(hash));
+                    stream.write(reinterpret_cast<const char*>(tile.mColors.data()), tile.mColors.size());
+                    stream.write(reinterpret_cast<const char*>(tile.mAlpha.data()), tile.mAlpha.size());
+                }
+                std::filesystem::rename(temporary, path);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write global map tile " << path << ": " << e.what();
+            }
+        }
+    }
+
+    class CreateMapTileWorkItem : public SceneUtil::WorkItem
     {
     public:
-        CreateMapWorkItem(int width, int height, int minX, int minY, int maxX, int maxY, int cellSize,
-            const MWWorld::Store<ESM::Land>& landStore)
-            : mWidth(width)
-            , mHeight(height)
+        CreateMapTileWorkItem(int tileX, int tileY, int minX, int minY, int maxX, int maxY, int cellSize,
+            const MWWorld::Store<ESM::Land>& landStore, const std::filesystem::path& cachePath,
+            osg::ref_ptr<osg::Image> image, osg::ref_ptr<osg::Image> alphaImage, osg::ref_ptr<osg::Image> overlayImage)
+            : mTileX(tileX)
+            , mTileY(tileY)
             , mMinX(minX)
             , mMinY(minY)
             , mMaxX(maxX)
             , mMaxY(maxY)
             , mCellSize(cellSize)
             , mLandStore(landStore)
+            , mCachePath(cachePath)
+            , mImage(std::move(image))
+            , mAlphaImage(std::move(alphaImage))
+            , mOverlayImage(std::move(overlayImage))
         {
         }
 
         void doWork() override
         {
-            osg::ref_ptr<osg::Image> image = new osg::Image;
-            image->allocateImage(mWidth, mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE);
-            unsigned char* data = image->data();
+            const std::size_t texels = static_cast<std::size_t>(sTileSize * mCellSize) * (sTileSize * mCellSize);
+            MapTile tile;
 
-            osg::ref_ptr<osg::Image> alphaImage = new osg::Image;
-            alphaImage->allocateImage(mWidth, mHeight, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
-            unsigned char* alphaData = alphaImage->data();
+            if (mCachePath.empty())
+                generate(tile);
+            else
+            {
+                const TileHash hash = getLandHash();
+                const std::filesystem::path path
+                    = mCachePath / (std::to_string(mTileX) + "_" + std::to_string(mTileY));
+                if (!readTile(path, hash, texels, tile))
+                {
+                    generate(tile);
+                    writeTile(path, hash, tile);
+                }
+            }
+
+            copy(tile);
+        }
 
-            for (int x = mMinX; x <= mMaxX; ++x)
+    private:
+        int mTileX, mTileY;
+        int mMinX, mMinY, mMaxX, mMaxY;
+        int mCellSize;
+        const MWWorld::Store<ESM::Land>& mLandStore;
+        std::filesystem::path mCachePath;
+        osg::ref_ptr<osg::Image> mImage;
+        osg::ref_ptr<osg::Image> mAlphaImage;
+        osg::ref_ptr<osg::Image> mOverlayImage;
+
+        TileHash getLandHash() const
+        {
+            std::vector<std::int8_t> data;
+            data.reserve(sTileSize * sTileSize * (ESM::Land::sGlobalMapLodSize + 1) + 8);
+            for (const std::uint32_t value : { sTileVersion, static_cast<std::uint32_t>(mCellSize) })
+                for (int i = 0; i < 4; ++i)
+                    data.push_back(static_cast<std::int8_t>(value >> (i * 8)));
+
+            for (int y = mTileY * sTileSize; y < (mTileY + 1) * sTileSize; ++y)
             {
-                for (int y = mMinY; y <= mMaxY; ++y)
+                for (int x = mTileX * sTileSize; x < (mTileX + 1) * sTileSize; ++x)
                 {
                     const ESM::Land* land = mLandStore.search(x, y);
+                    const bool hasData = land != nullptr && (land->mDataTypes & ESM::Land::DATA_WNAM);
+                    data.push_back(hasData ? 1 : 0);
+                    if (hasData)
+                        data.insert(data.end(), land->mWnam.begin(), land->mWnam.end());
+                }
+            }
+
+            TileHash result{ 0, 0 };
+            const TileHash seed{ 0, 0 };
+            MurmurHash3_x64_128(data.data(), static_cast<int>(data.size()), seed.data(), result.data());
+            return result;
+        }
+
+        void generate(MapTile& tile) const
+        {
+            const int width = sTileSize * mCellSize;
+            tile.mColors.resize(static_cast<std::size_t>(width) * width * 3);
+            tile.mAlpha.resize(static_cast<std::size_t>(width) * width);
+
+            for (int tileCellY = 0; tileCellY < sTileSize; ++tileCellY)
+            {
+                for (int tileCellX = 0; tileCellX < sTileSize; ++tileCellX)
+                {
+                    const ESM::Land* land
+                        = mLandStore.search(mTileX * sTileSize + tileCellX, mTileY * sTileSize + tileCellY);
 
                     for (int cellY = 0; cellY < mCellSize; ++cellY)
                     {
                         for (int cellX = 0; cellX < mCellSize; ++cellX)
                         {
-                            int vertexX = static_cast<int>(float(cellX) / float(mCellSize) * 9);
-                            int vertexY = static_cast<int>(float(cellY) / float(mCellSize) * 9);
-
-                            int texelX = (x - mMinX) * mCellSize + cellX;
-                            int texelY = (y - mMinY) * mCellSize + cellY;
-
-                            unsigned char r, g, b;
-
-                            float y2 = 0;
-                            if (land && (land->mDataTypes & ESM::Land::DATA_WNAM))
-                                y2 = land->mWnam[vertexY * 9 + vertexX] / 128.f;
-                            else
-                                y2 = SCHAR_MIN / 128.f;
-                            if (y2 < 0)
-                            {
-                                r = static_cast<unsigned char>(14 * y2 + 38);
-                                g = static_cast<unsigned char>(20 * y2 + 56);
-                                b = static_cast<unsigned char>(18 * y2 + 51);
-                            }
-                            else if (y2 < 0.3f)
-                            {
-                                if (y2 < 0.1f)
-                                    y2 *= 8.f;
-                                else
-                                {
-                                    y2 -= 0.1f;
-                                    y2 += 0.8f;
-                                }
-                                r = static_cast<unsigned char>(66 - 32 * y2);
-                                g = static_cast<unsigned char>(48 - 23 * y2);
-                                b = static_cast<unsigned char>(33 - 16 * y2);
-                            }
-                            else
-                            {
-                                y2 -= 0.3f;
-                                y2 *= 1.428f;
-                                r = static_cast<unsigned char>(34 - 29 * y2);
-                                g = static_cast<unsigned char>(25 - 20 * y2);
-                                b = static_cast<unsigned char>(17 - 12 * y2);
-                            }
-
-                            data[texelY * mWidth * 3 + texelX * 3] = r;
-                            data[texelY * mWidth * 3 + texelX * 3 + 1] = g;
-                            data[texelY * mWidth * 3 + texelX * 3 + 2] = b;
-
-                            alphaData[texelY * mWidth + texelX]
-                                = (y2 < 0) ? static_cast<unsigned char>(0) : static_cast<unsigned char>(255);
+                            const int vertexX = static_cast<int>(float(cellX) / float(mCellSize) * 9);
+                            const int vertexY = static_cast<int>(float(cellY) / float(mCellSize) * 9);
+                            const std::size_t texel = static_cast<std::size_t>(tileCellY * mCellSize + cellY) * width
+                                + tileCellX * mCellSize + cellX;
+                            getTexel(land, vertexX, vertexY, &tile.mColors[texel * 3], tile.mAlpha[texel]);
                         }
                     }
                 }
             }
-
-            mBaseTexture = new osg::Texture2D;
-            mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setImage(image);
-            mBaseTexture->setResizeNonPowerOfTwoHint(false);
-
-            mAlphaTexture = new osg::Texture2D;
-            mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setImage(alphaImage);
-            mAlphaTexture->setResizeNonPowerOfTwoHint(false);
-
-            mOverlayImage = new osg::Image;
-            mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
-            assert(mOverlayImage->isDataContiguous());
-
-            memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
-
-            mOverlayTexture = new osg::Texture2D;
-            mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setResizeNonPowerOfTwoHint(false);
-            mOverlayTexture->setInternalFormat(GL_RGBA);
-            mOverlayTexture->setTextureSize(mWidth, mHeight);
         }
 
-        int mWidth, mHeight;
-        int mMinX, mMinY, mMaxX, mMaxY;
-        int mCellSize;
-        const MWWorld::Store<ESM::Land>& mLandStore;
+        // Tiles are processed in parallel, each writes only its own region of the map
+        void copy(const MapTile& tile) const
+        {
+            const int firstX = std::max(mTileX * sTileSize, mMinX);
+            const int lastX = std::min((mTileX + 1) * sTileSize - 1, mMaxX);
+            const int firstY = std::max(mTileY * sTileSize, mMinY);
+            const int lastY = std::min((mTileY + 1) * sTileSize - 1, mMaxY);
+            if (firstX > lastX || firstY > lastY)
+                return;
 
-        osg::ref_ptr<osg::Texture2D> mBaseTexture;
-        osg::ref_ptr<osg::Texture2D> mAlphaTexture;
+            const int tileWidth = sTileSize * mCellSize;
+            const int mapWidth = mImage->s();
+            const std::size_t rowTexels = static_cast<std::size_t>(lastX - firstX + 1) * mCellSize;
+            const int srcX = (firstX - mTileX * sTileSize) * mCellSize;
+            const int dstX = (firstX - mMinX) * mCellSize;
 
-        osg::ref_ptr<osg::Image> mOverlayImage;
-        osg::ref_ptr<osg::Texture2D> mOverlayTexture;
+            for (int row = (firstY - mMinY) * mCellSize; row < (lastY - mMinY + 1) * mCellSize; ++row)
+            {
+                const int srcRow = row + (mMinY - mTileY * sTileSize) * mCellSize;
+                const std::size_t src = static_cast<std::size_t>(srcRow) * tileWidth + srcX;
+                const std::size_t dst = static_cast<std::size_t>(row) * mapWidth + dstX;
+                std::memcpy(mImage->data() + dst * 3, tile.mColors.data() + src * 3, rowTexels * 3);
+                std::memcpy(mAlphaImage->data() + dst, tile.mAlpha.data() + src, rowTexels);
+                std::memset(mOverlayImage->data() + dst * 4, 0, rowTexels * 4);
+            }
+        }
     };
 
     struct GlobalMap::WritePng final : public SceneUtil::WorkItem
@@ -263,9 +380,10 @@ namespace MWRender
         void doWork() override { mImageData = writePng(*mOverlayImage); }
     };
 
-    GlobalMap::GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue)
+    GlobalMap::GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, const std::filesystem::path& cachePath)
         : mRoot(root)
         , mWorkQueue(workQueue)
+        , mCachePath(cachePath)
         , mWidth(0)
         , mHeight(0)
         , mMinX(0)
@@ -282,8 +400,8 @@ namespace MWRender
         for (auto& camera : mActiveCameras)
             removeCamera(camera);
 
-        if (mWorkItem)
-            mWorkItem->waitTillDone();
+        for (const osg::ref_ptr<CreateMapTileWorkItem>& workItem : mWorkItems)
+            workItem->waitTillDone();
     }
 
     void GlobalMap::render()
@@ -309,9 +427,52 @@ namespace MWRender
         mWidth = cellSize * (mMaxX - mMinX + 1);
         mHeight = cellSize * (mMaxY - mMinY + 1);
 
-        mWorkItem
-            = new CreateMapWorkItem(mWidth, mHeight, mMinX, mMinY, mMaxX, mMaxY, cellSize, esmStore.get<ESM::Land>());
-        mWorkQueue->addWorkItem(mWorkItem);
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(mWidth, mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE);
+
+        osg::ref_ptr<osg::Image> alphaImage = new osg::Image;
+        alphaImage->allocateImage(mWidth, mHeight, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+
+        mOverlayImage = new osg::Image;
+        mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        assert(mOverlayImage->isDataContiguous());
+
+        mBaseTexture = new osg::Texture2D;
+        mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mBaseTexture->setImage(image);
+        mBaseTexture->setResizeNonPowerOfTwoHint(false);
+
+        mAlphaTexture = new osg::Texture2D;
+        mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mAlphaTexture->setImage(alphaImage);
+        mAlphaTexture->setResizeNonPowerOfTwoHint(false);
+
+        mOverlayTexture = new osg::Texture2D;
+        mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mOverlayTexture->setResizeNonPowerOfTwoHint(false);
+        mOverlayTexture->setInternalFormat(GL_RGBA);
+        mOverlayTexture->setTextureSize(mWidth, mHeight);
+
+        // Images are filled by the work items and must not be used until ensureLoaded
+        for (int tileY = getTileIndex(mMinY); tileY <= getTileIndex(mMaxY); ++tileY)
+        {
+            for (int tileX = getTileIndex(mMinX); tileX <= getTileIndex(mMaxX); ++tileX)
+            {
+                osg::ref_ptr<CreateMapTileWorkItem> workItem = new CreateMapTileWorkItem(tileX, tileY, mMinX, mMinY,
+                    mMaxX, mMaxY, cellSize, esmStore.get<ESM::Land>(), mCachePath, image, alphaImage, mOverlayImage);
+                mWorkQueue->addWorkItem(workItem);
+                mWorkItems.push_back(std::move(workItem));
+            }
+        }
     }
 
     void GlobalMap::worldPosToImageSpace(float x, float z, float& imageX, float& imageY)
@@ -324,6 +485,21 @@ namespace MWRender
     void GlobalMap::requestOverlayTextureUpdate(int x, int y, int width, int height,
         osg::ref_ptr<osg::Texture2D> texture, bool clear, bool cpuCopy, float srcLeft, float srcTop, float srcRight,
         float srcBottom)
+    {
+        osg::ref_ptr<osg::Camera> camera = createOverlayCamera(x, y, width, height, clear, cpuCopy);
+
+        // Create a quad rendering the updated texture
+        if (texture)
+        {
+            const osg::Viewport& viewport = *camera->getViewport();
+            camera->addChild(createOverlayQuad(viewport, static_cast<int>(viewport.x()),
+                static_cast<int>(viewport.y()), width, height, std::move(texture), srcLeft, srcTop, srcRight,
+                srcBottom));
+        }
+    }
+
+    osg::ref_ptr<osg::Camera> GlobalMap::createOverlayCamera(
+        int x, int y, int width, int height, bool clear, bool cpuCopy)
     {
         osg::ref_ptr<osg::Camera> camera(new osg::Camera);
         camera->setNodeMask(Mask_RenderToTexture);
@@ -366,45 +542,56 @@ namespace MWRender
             mPendingImageDest[camera] = std::move(imageDest);
         }
 
-        // Create a quad rendering the updated texture
-        if (texture)
-        {
-            osg::ref_ptr<osg::Geometry> geom = createTexturedQuad(srcLeft, srcTop, srcRight, srcBottom);
-            osg::ref_ptr<osg::Depth> depth = new SceneUtil::AutoDepth;
-            depth->setWriteMask(false);
-            osg::StateSet* stateset = geom->getOrCreateStateSet();
-            stateset->setAttribute(depth);
-            stateset->setTextureAttributeAndModes(0, texture, osg::StateAttribute::ON);
-            stateset->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
-            stateset->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+        mRoot->addChild(camera);
 
-            if (mAlphaTexture)
-            {
-                osg::ref_ptr<osg::Vec2Array> texcoords = new osg::Vec2Array;
-
-                float x1 = x / static_cast<float>(mWidth);
-                float x2 = (x + width) / static_cast<float>(mWidth);
-                float y1 = y / static_cast<float>(mHeight);
-                float y2 = (y + height) / static_cast<float>(mHeight);
-                texcoords->push_back(osg::Vec2f(x1, y1));
-                texcoords->push_back(osg::Vec2f(x1, y2));
-                texcoords->push_back(osg::Vec2f(x2, y2));
-                texcoords->push_back(osg::Vec2f(x2, y1));
-                geom->setTexCoordArray(1, texcoords, osg::Array::BIND_PER_VERTEX);
-
-                stateset->setTextureAttributeAndModes(1, mAlphaTexture, osg::StateAttribute::ON);
-                osg::ref_ptr<osg::TexEnvCombine> texEnvCombine = new osg::TexEnvCombine;
-                texEnvCombine->setCombine_RGB(osg::TexEnvCombine::REPLACE);
-                texEnvCombine->setSource0_RGB(osg::TexEnvCombine::PREVIOUS);
-                stateset->setTextureAttributeAndModes(1, texEnvCombine);
-            }
+        mActiveCameras.push_back(camera);
 
-            camera->addChild(geom);
-        }
+        return camera;
+    }
 
-        mRoot->addChild(camera);
+    osg::ref_ptr<osg::Geometry> GlobalMap::createOverlayQuad(const osg::Viewport& viewport, int x, int y, int width,
+        int height, osg::ref_ptr<osg::Texture2D> texture, float srcLeft, float srcTop, float srcRight, float srcBottom)
+    {
+        const float left = 2.f * (x - static_cast<float>(viewport.x())) / static_cast<float>(viewport.width()) - 1.f;
+        const float right
+            = 2.f * (x + width - static_cast<float>(viewport.x())) / static_cast<float>(viewport.width()) - 1.f;
+        const float bottom
+            = 2.f * (y - static_cast<float>(viewport.y())) / static_cast<float>(viewport.height()) - 1.f;
+        const float top
+            = 2.f * (y + height - static_cast<float>(viewport.y())) / static_cast<float>(viewport.height()) - 1.f;
+
+        osg::ref_ptr<osg::Geometry> geom
+            = createTexturedQuad(srcLeft, srcTop, srcRight, srcBottom, left, top, right, bottom);
+        osg::ref_ptr<osg::Depth> depth = new SceneUtil::AutoDepth;
+        depth->setWriteMask(false);
+        osg::StateSet* stateset = geom->getOrCreateStateSet();
+        stateset->setAttribute(depth);
+        stateset->setTextureAttributeAndModes(0, texture, osg::StateAttribute::ON);
+        stateset->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+        stateset->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+
+        if (mAlphaTexture)
+        {
+            osg::ref_ptr<osg::Vec2Array> texcoords = new osg::Vec2Array;
+
+            float x1 = x / static_cast<float>(mWidth);
+            float x2 = (x + width) / static_cast<float>(mWidth);
+            float y1 = y / static_cast<float>(mHeight);
+            float y2 = (y + height) / static_cast<float>(mHeight);
+            texcoords->push_back(osg::Vec2f(x1, y1));
+            texcoords->push_back(osg::Vec2f(x1, y2));
+            texcoords->push_back(osg::Vec2f(x2, y2));
+            texcoords->push_back(osg::Vec2f(x2, y1));
+            geom->setTexCoordArray(1, texcoords, osg::Array::BIND_PER_VERTEX);
+
+            stateset->setTextureAttributeAndModes(1, mAlphaTexture, osg::StateAttribute::ON);
+            osg::ref_ptr<osg::TexEnvCombine> texEnvCombine = new osg::TexEnvCombine;
+            texEnvCombine->setCombine_RGB(osg::TexEnvCombine::REPLACE);
+            texEnvCombine->setSource0_RGB(osg::TexEnvCombine::PREVIOUS);
+            stateset->setTextureAttributeAndModes(1, texEnvCombine);
+        }
 
-        mActiveCameras.push_back(camera);
+        return geom;
     }
 
     void GlobalMap::exploreCell(int cellX, int cellY, osg::ref_ptr<osg::Texture2D> localMapTexture)
@@ -422,8 +609,39 @@ namespace MWRender
         if (cellX > mMaxX || cellX < mMinX || cellY > mMaxY || cellY < mMinY)
             return;
 
-        requestOverlayTextureUpdate(
-            originX, mHeight - originY, cellSize, cellSize, std::move(localMapTexture), false, true);
+        mPendingOverlayUpdates.push_back(OverlayUpdate{ .mX = originX,
+            .mY = mHeight - originY,
+            .mWidth = cellSize,
+            .mHeight = cellSize,
+            .mTexture = std::move(localMapTexture) });
+    }
+
+    void GlobalMap::flushOverlayUpdates()
+    {
+        if (mPendingOverlayUpdates.empty())
+            return;
+
+        int left = mWidth;
+        int top = mHeight;
+        int right = 0;
+        int bottom = 0;
+        for (const OverlayUpdate& update : mPendingOverlayUpdates)
+        {
+            left = std::min(left, update.mX);
+            top = std::min(top, update.mY);
+            right = std::max(right, update.mX + update.mWidth);
+            bottom = std::max(bottom, update.mY + update.mHeight);
+        }
+
+        // Cells explored together are usually adjacent, so a single camera covering all of them with one quad per
+        // cell reads back only a bit more than separate cameras would
+        osg::ref_ptr<osg::Camera> camera = createOverlayCamera(left, top, right - left, bottom - top, false, true);
+        const osg::Viewport& viewport = *camera->getViewport();
+        for (OverlayUpdate& update : mPendingOverlayUpdates)
+            camera->addChild(createOverlayQuad(viewport, update.mX, mHeight - update.mY - update.mHeight,
+                update.mWidth, update.mHeight, std::move(update.mTexture), 0.f, 0.f, 1.f, 1.f));
+
+        mPendingOverlayUpdates.clear();
     }
 
     void GlobalMap::clear()
@@ -433,6 +651,7 @@ namespace MWRender
         memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
 
         mPendingImageDest.clear();
+        mPendingOverlayUpdates.clear();
 
         // just push a Camera to clear the FBO, instead of setImage()/dirty()
         // easier, since we don't need to worry about synchronizing access :)
@@ -583,18 +802,14 @@ namespace MWRender
 
     void GlobalMap::ensureLoaded()
     {
-        if (mWorkItem)
+        if (!mWorkItems.empty())
         {
-            mWorkItem->waitTillDone();
+            for (const osg::ref_ptr<CreateMapTileWorkItem>& workItem : mWorkItems)
+                workItem->waitTillDone();
 
-            mOverlayImage = mWorkItem->mOverlayImage;
-            mBaseTexture = mWorkItem->mBaseTexture;
-            mAlphaTexture = mWorkItem->mAlphaTexture;
-            mOverlayTexture = mWorkItem->mOverlayTexture;
+            mWorkItems.clear();
 
             requestOverlayTextureUpdate(0, 0, mWidth, mHeight, osg::ref_ptr<osg::Texture2D>(), true, false);
-
-            mWorkItem = nullptr;
         }
     }
 
@@ -649,7 +864,8 @@ namespace MWRender
 
     void GlobalMap::asyncWritePng()
     {
-        if (mOverlayImage == nullptr)
+        // Overlay image is being initialized by the work items
+        if (mOverlayImage == nullptr || !mWorkItems.empty())
             return;
         // Use deep copy to avoid any sychronization
         mWritePng = new WritePng(new osg::Image(*mOverlayImage, osg::CopyOp::DEEP_COPY_ALL));
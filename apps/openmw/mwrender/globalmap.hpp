@@ -1,6 +1,7 @@
 #ifndef GAME_RENDER_GLOBALMAP_H
 #define GAME_RENDER_GLOBALMAP_H
 
+#include <filesystem>
 #include <map>
 #include <string>
 #include <vector>
@@ -13,6 +14,8 @@ namespace osg
     class Image;
     class Group;
     class Camera;
+    class Geometry;
+    class Viewport;
 }
 
 namespace ESM
@@ -28,12 +31,13 @@ namespace SceneUtil
 namespace MWRender
 {
 
-    class CreateMapWorkItem;
+    class CreateMapTileWorkItem;
 
     class GlobalMap
     {
     public:
-        GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue);
+        /// @param cachePath Directory to store generated map tiles, they are regenerated only when land changes.
+        GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, const std::filesystem::path& cachePath);
         ~GlobalMap();
 
         void render();
@@ -43,8 +47,12 @@ namespace MWRender
 
         void worldPosToImageSpace(float x, float z, float& imageX, float& imageY);
 
+        /// Request rendering the local map onto the overlay. Requests are batched until flushOverlayUpdates.
         void exploreCell(int cellX, int cellY, osg::ref_ptr<osg::Texture2D> localMapTexture);
 
+        /// Render all requested overlay updates with a single camera.
+        void flushOverlayUpdates();
+
         /// Clears the overlay
         void clear();
 
@@ -86,6 +94,15 @@ namespace MWRender
             bool clear, bool cpuCopy, float srcLeft = 0.f, float srcTop = 0.f, float srcRight = 1.f,
             float srcBottom = 1.f);
 
+        /// Create a camera rendering onto the given region of mOverlayTexture (top-left coordinate origin).
+        osg::ref_ptr<osg::Camera> createOverlayCamera(int x, int y, int width, int height, bool clear, bool cpuCopy);
+
+        /// Create a quad rendering the texture onto the given region of the camera viewport (bottom-left coordinate
+        /// origin).
+        osg::ref_ptr<osg::Geometry> createOverlayQuad(const osg::Viewport& viewport, int x, int y, int width,
+            int height, osg::ref_ptr<osg::Texture2D> texture, float srcLeft, float srcTop, float srcRight,
+            float srcBottom);
+
         osg::ref_ptr<osg::Group> mRoot;
 
         typedef std::vector<osg::ref_ptr<osg::Camera>> CameraVector;
@@ -121,8 +138,17 @@ namespace MWRender
         // CPU copy of overlay
         osg::ref_ptr<osg::Image> mOverlayImage;
 
+        struct OverlayUpdate
+        {
+            int mX, mY, mWidth, mHeight;
+            osg::ref_ptr<osg::Texture2D> mTexture;
+        };
+
+        std::vector<OverlayUpdate> mPendingOverlayUpdates;
+
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
-        osg::ref_ptr<CreateMapWorkItem> mWorkItem;
+        std::vector<osg::ref_ptr<CreateMapTileWorkItem>> mWorkItems;
+        std::filesystem::path mCachePath;
         osg::ref_ptr<WritePng> mWritePng;
 
         int mWidth;
@@ -1,7 +1,7 @@
 #ifndef OPENMW_MWRENDER_GROUNDCOVER_H
 #define OPENMW_MWRENDER_GROUNDCOVER_H
 
-#include <components/esm3/loadcell.hpp>
+#include <components/esm/position.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -39,9 +39,9 @@ namespace MWRender
             ESM::Position mPos;
             float mScale;
 
-            GroundcoverEntry(const ESM::CellRef& ref)
-                : mPos(ref.mPos)
-                , mScale(ref.mScale)
+            GroundcoverEntry(const ESM::Position& pos, float scale)
+                : mPos(pos)
+                , mScale(scale)
             {
             }
         };
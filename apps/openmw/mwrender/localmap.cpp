@@ -1,6 +1,8 @@
 #include "localmap.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 
 #include <osg/ComputeBoundsVisitor>
 #include <osg/Fog>
@@ -9,12 +11,9 @@
 #include <osg/PolygonMode>
 #include <osg/Texture2D>
 
-#include <osgDB/ReadFile>
-
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/fogstate.hpp>
 #include <components/esm3/loadcell.hpp>
-#include <components/files/memorystream.hpp>
 #include <components/misc/constants.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
@@ -116,7 +115,7 @@ namespace MWRender
             const MapSegment& segment
                 = mExteriorSegments[std::make_pair(cell->getCell()->getGridX(), cell->getCell()->getGridY())];
 
-            if (segment.mFogOfWarImage && segment.mHasFogState)
+            if (segment.mFogOfWarLoaded && segment.mHasFogState)
             {
                 auto fog = std::make_unique<ESM::FogState>();
                 fog->mFogTextures.emplace_back();
@@ -228,10 +227,10 @@ namespace MWRender
     {
         auto& segments(mInterior ? mInteriorSegments : mExteriorSegments);
         SegmentMap::iterator found = segments.find(std::make_pair(x, y));
-        if (found == segments.end())
+        if (found == segments.end() || !found->second.mFogOfWarLoaded)
             return osg::ref_ptr<osg::Texture2D>();
-        else
-            return found->second.mFogOfWarTexture;
+        found->second.unpackFogOfWar();
+        return found->second.mFogOfWarTexture;
     }
 
     void LocalMap::cleanupCameras()
@@ -263,7 +262,7 @@ namespace MWRender
         setupRenderToTexture(x, y, x * mMapWorldSize + mMapWorldSize / 2.f, y * mMapWorldSize + mMapWorldSize / 2.f,
             osg::Vec3d(0, 1, 0), zmin, zmax);
 
-        if (segment.mFogOfWarImage != nullptr)
+        if (segment.mFogOfWarLoaded)
             return;
 
         if (cell->getFog() && !cell->getFog()->mFogTextures.empty())
@@ -400,7 +399,7 @@ namespace MWRender
 
                 auto coords = std::make_pair(x, y);
                 MapSegment& segment = mInteriorSegments[coords];
-                if (!segment.mFogOfWarImage)
+                if (!segment.mFogOfWarLoaded)
                 {
                     bool loaded = false;
                     if (const ESM::FogState* fog = cell->getFog())
@@ -447,9 +446,10 @@ namespace MWRender
     bool LocalMap::isPositionExplored(float nX, float nY, int x, int y)
     {
         auto& segments(mInterior ? mInteriorSegments : mExteriorSegments);
-        const MapSegment& segment = segments[std::make_pair(x, y)];
-        if (!segment.mFogOfWarImage)
+        MapSegment& segment = segments[std::make_pair(x, y)];
+        if (!segment.mFogOfWarLoaded)
             return false;
+        segment.unpackFogOfWar();
 
         nX = std::clamp(nX, 0.f, 1.f);
         nY = std::clamp(nY, 0.f, 1.f);
@@ -493,6 +493,12 @@ namespace MWRender
             v = 1.0f - std::abs((pos.y() - (mMapWorldSize * y)) / mMapWorldSize);
         }
 
+        if (std::make_pair(x, y) != mLastPlayerSegment)
+        {
+            mLastPlayerSegment = std::make_pair(x, y);
+            packUnusedFogOfWar(x, y);
+        }
+
         // explore radius (squared)
         const float exploreRadius = 0.17f * (sFogOfWarResolution - 1); // explore radius from 0 to sFogOfWarResolution-1
         const float sqrExploreRadius = square(exploreRadius);
@@ -523,8 +529,9 @@ namespace MWRender
                 auto& segments(mInterior ? mInteriorSegments : mExteriorSegments);
                 MapSegment& segment = segments[std::make_pair(texX, texY)];
 
-                if (!segment.mFogOfWarImage || !segment.mMapTexture)
+                if (!segment.mFogOfWarLoaded || !segment.mMapTexture)
                     continue;
+                segment.unpackFogOfWar();
 
                 std::uint32_t* data = reinterpret_cast<std::uint32_t*>(segment.mFogOfWarImage->data());
                 bool changed = false;
@@ -576,6 +583,19 @@ namespace MWRender
         return result;
     }
 
+    void LocalMap::packUnusedFogOfWar(int x, int y)
+    {
+        auto& segments(mInterior ? mInteriorSegments : mExteriorSegments);
+        for (auto& [position, segment] : segments)
+        {
+            if (std::abs(position.first - x) <= mCellDistance && std::abs(position.second - y) <= mCellDistance)
+                continue;
+            // The texture is referenced only by the segment when the map window doesn't show it
+            if (segment.mFogOfWarTexture != nullptr && segment.mFogOfWarTexture->referenceCount() == 1)
+                segment.packFogOfWar();
+        }
+    }
+
     MyGUI::IntRect LocalMap::getInteriorGrid() const
     {
         auto segments = divideIntoSegments(mBounds, mMapWorldSize);
@@ -599,78 +619,69 @@ namespace MWRender
 
     void LocalMap::MapSegment::initFogOfWar()
     {
-        mFogOfWarImage = new osg::Image;
-        // Assign a PixelBufferObject for asynchronous transfer of data to the GPU
-        mFogOfWarImage->setPixelBufferObject(new osg::PixelBufferObject);
-        mFogOfWarImage->allocateImage(sFogOfWarResolution, sFogOfWarResolution, 1, GL_RGBA, GL_UNSIGNED_BYTE);
-        assert(mFogOfWarImage->isDataContiguous());
-        std::vector<uint32_t> data;
-        data.resize(sFogOfWarResolution * sFogOfWarResolution, 0xff000000);
-
-        memcpy(mFogOfWarImage->data(), data.data(), data.size() * 4);
-
-        createFogOfWarTexture();
+        mPackedFogOfWar.clear();
+        mFogOfWarLoaded = true;
     }
 
     void LocalMap::MapSegment::loadFogOfWar(const ESM::FogTexture& esm)
     {
-        const std::vector<char>& data = esm.mImageData;
-        if (data.empty())
-        {
-            initFogOfWar();
-            return;
-        }
+        mPackedFogOfWar = esm.mImageData;
+        mFogOfWarLoaded = true;
+        mHasFogState = !mPackedFogOfWar.empty();
+    }
 
-        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-        if (!readerwriter)
-        {
-            Log(Debug::Error) << "Error: Unable to load fog, can't find a png ReaderWriter";
+    void LocalMap::MapSegment::unpackFogOfWar()
+    {
+        if (mFogOfWarImage)
             return;
-        }
-
-        Files::IMemStream in(data.data(), data.size());
 
-        osgDB::ReaderWriter::ReadResult result = readerwriter->readImage(in);
-        if (!result.success())
+        std::vector<std::uint8_t> alpha(sFogOfWarResolution * sFogOfWarResolution, 0xff);
+        if (!mPackedFogOfWar.empty() && !ESM::unpackFogOfWar(mPackedFogOfWar, alpha))
         {
-            Log(Debug::Error) << "Error: Failed to read fog: " << result.message() << " code " << result.status();
-            return;
+            Log(Debug::Error) << "Error: Failed to unpack fog";
+            std::fill(alpha.begin(), alpha.end(), 0xff);
         }
+        mPackedFogOfWar = std::vector<char>();
 
-        mFogOfWarImage = result.getImage();
-        mFogOfWarImage->flipVertical();
-        mFogOfWarImage->dirty();
+        mFogOfWarImage = new osg::Image;
+        // Assign a PixelBufferObject for asynchronous transfer of data to the GPU
+        mFogOfWarImage->setPixelBufferObject(new osg::PixelBufferObject);
+        mFogOfWarImage->allocateImage(sFogOfWarResolution, sFogOfWarResolution, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        assert(mFogOfWarImage->isDataContiguous());
+
+        std::uint32_t* data = reinterpret_cast<std::uint32_t*>(mFogOfWarImage->data());
+        for (const std::uint8_t value : alpha)
+            *data++ = static_cast<std::uint32_t>(value) << 24;
 
         createFogOfWarTexture();
-        mHasFogState = true;
     }
 
-    void LocalMap::MapSegment::saveFogOfWar(ESM::FogTexture& fog) const
+    void LocalMap::MapSegment::packFogOfWar()
     {
         if (!mFogOfWarImage)
             return;
 
-        std::ostringstream ostream;
+        ESM::FogTexture fog;
+        saveFogOfWar(fog);
+        mPackedFogOfWar = std::move(fog.mImageData);
+        mFogOfWarImage = nullptr;
+        mFogOfWarTexture = nullptr;
+    }
 
-        osgDB::ReaderWriter* readerwriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-        if (!readerwriter)
+    void LocalMap::MapSegment::saveFogOfWar(ESM::FogTexture& fog) const
+    {
+        if (!mFogOfWarImage)
         {
-            Log(Debug::Error) << "Error: Unable to write fog, can't find a png ReaderWriter";
+            fog.mImageData = mPackedFogOfWar;
             return;
         }
 
-        // extra flips are unfortunate, but required for compatibility with older versions
-        mFogOfWarImage->flipVertical();
-        osgDB::ReaderWriter::WriteResult result = readerwriter->writeImage(*mFogOfWarImage, ostream);
-        if (!result.success())
-        {
-            Log(Debug::Error) << "Error: Unable to write fog: " << result.message() << " code " << result.status();
-            return;
-        }
-        mFogOfWarImage->flipVertical();
+        const std::uint32_t* data = reinterpret_cast<const std::uint32_t*>(mFogOfWarImage->data());
+        std::vector<std::uint8_t> alpha(sFogOfWarResolution * sFogOfWarResolution);
+        for (std::uint8_t& value : alpha)
+            value = static_cast<std::uint8_t>(*data++ >> 24);
 
-        std::string data = ostream.str();
-        fog.mImageData = std::vector<char>(data.begin(), data.end());
+        fog.mImageData = ESM::packFogOfWar(alpha);
     }
 
     LocalMapRenderToTexture::LocalMapRenderToTexture(osg::Node* sceneRoot, int res, int mapWorldSize, float x, float y,
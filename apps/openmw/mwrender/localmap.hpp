@@ -4,8 +4,11 @@
 #include <cstdint>
 #include <map>
 #include <set>
+#include <utility>
 #include <vector>
 
+#include <components/esm3/fogstate.hpp>
+
 #include <MyGUI_Types.h>
 #include <osg/BoundingBox>
 #include <osg/Quat>
@@ -16,11 +19,6 @@ namespace MWWorld
     class CellStore;
 }
 
-namespace ESM
-{
-    struct FogTexture;
-}
-
 namespace osg
 {
     class Texture2D;
@@ -125,10 +123,18 @@ namespace MWRender
             void initFogOfWar();
             void loadFogOfWar(const ESM::FogTexture& fog);
             void saveFogOfWar(ESM::FogTexture& fog) const;
+            // Create the fog of war image and texture from the packed state when the segment is first shown or
+            // explored
+            void unpackFogOfWar();
+            // Release the image and the texture keeping only the packed state
+            void packFogOfWar();
             void createFogOfWarTexture();
 
             std::uint8_t mLastRenderNeighbourFlags = 0;
             bool mHasFogState = false;
+            bool mFogOfWarLoaded = false;
+            // Packed fog of war alpha while there is no image, empty means unexplored
+            std::vector<char> mPackedFogOfWar;
             osg::ref_ptr<osg::Texture2D> mMapTexture;
             osg::ref_ptr<osg::Texture2D> mFogOfWarTexture;
             osg::ref_ptr<osg::Image> mFogOfWarImage;
@@ -141,13 +147,17 @@ namespace MWRender
         int mMapResolution;
 
         // the dynamic texture is a bottleneck, so don't set this too high
-        static const int sFogOfWarResolution = 32;
+        // saved games store the fog of war at this resolution
+        static const int sFogOfWarResolution = ESM::FogTexture::sResolution;
 
         // size of a map segment (for exteriors, 1 cell)
         float mMapWorldSize;
 
         int mCellDistance;
 
+        // Segment the player was in when unused fog of war images were last packed
+        std::pair<int, int> mLastPlayerSegment{ 0, 0 };
+
         float mAngle;
         const osg::Vec2f rotatePoint(const osg::Vec2f& point, const osg::Vec2f& center, const float angle);
 
@@ -162,6 +172,9 @@ namespace MWRender
         bool mInterior;
 
         std::uint8_t getExteriorNeighbourFlags(int cellX, int cellY) const;
+
+        // Pack fog of war of segments outside of the explored grid when the map window doesn't use their textures
+        void packUnusedFogOfWar(int x, int y);
     };
 
 }
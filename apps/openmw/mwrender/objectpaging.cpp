@@ -26,6 +26,7 @@
 #include <components/esm4/loadfurn.hpp>
 #include <components/esm4/loadstat.hpp>
 #include <components/esm4/loadtree.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
@@ -37,6 +38,7 @@
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
 #include <components/sceneutil/util.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -491,9 +493,161 @@ namespace MWRender
                 node.getOrCreateUserDataContainer()->addUserObject(marker);
             }
         };
+
+        struct MergeInstance
+        {
+            ESM::RefNum mRefNum;
+            osg::Matrixf mMatrix;
+            float mScale;
+        };
+
+        struct MergeTemplate
+        {
+            osg::ref_ptr<const osg::Node> mNode;
+            const AnalyzeVisitor::Result* mAnalyzeResult;
+            std::vector<MergeInstance> mInstances;
+        };
+
+        struct MergeBatch
+        {
+            std::vector<MergeTemplate> mTemplates;
+            MergeBatchKey mKey;
+            osg::ref_ptr<osg::Node> mResult;
+        };
+
+        struct MergeSettings
+        {
+            bool mActiveGrid;
+            osg::Node::NodeMask mCopyMask;
+            float mSize;
+            LODRange mDistances;
+            osg::Vec3f mRelativeViewPoint;
+            bool mDebugBatches;
+            SceneUtil::WorkQueue* mWorkQueue;
+            std::size_t mMaxHelpers;
+        };
+
+        // Geometry can be merged only when it shares state, so templates without common state sets are merged
+        // independently of each other. Uses the same state sets as AnalyzeVisitor to estimate merge benefit.
+        std::vector<MergeBatch> makeMergeBatches(std::vector<MergeTemplate>&& templates, float size, bool activeGrid)
+        {
+            std::vector<std::size_t> parents(templates.size());
+            for (std::size_t i = 0; i < parents.size(); ++i)
+                parents[i] = i;
+
+            const auto find = [&](std::size_t i) {
+                while (parents[i] != i)
+                    i = parents[i] = parents[parents[i]];
+                return i;
+            };
+
+            std::unordered_map<const osg::StateSet*, std::size_t> owners;
+            for (std::size_t i = 0; i < templates.size(); ++i)
+            {
+                for (const auto& [stateSet, count] : templates[i].mAnalyzeResult->mStateSetCounter)
+                {
+                    const auto [it, inserted] = owners.emplace(stateSet, i);
+                    if (!inserted)
+                        parents[find(i)] = find(it->second);
+                }
+            }
+
+            std::vector<MergeBatch> result;
+            std::unordered_map<std::size_t, std::size_t> batches;
+            for (std::size_t i = 0; i < templates.size(); ++i)
+            {
+                const auto [it, inserted] = batches.emplace(find(i), result.size());
+                if (inserted)
+                    result.emplace_back();
+                result[it->second].mTemplates.push_back(std::move(templates[i]));
+            }
+
+            for (MergeBatch& batch : result)
+            {
+                batch.mKey.mSize = size;
+                batch.mKey.mActiveGrid = activeGrid;
+                for (const MergeTemplate& mergeTemplate : batch.mTemplates)
+                    for (const MergeInstance& instance : mergeTemplate.mInstances)
+                        batch.mKey.mInstances.push_back(MergeBatchKey::Instance{
+                            .mTemplate = mergeTemplate.mNode.get(),
+                            .mRefNum = instance.mRefNum,
+                            .mMatrix = instance.mMatrix,
+                        });
+            }
+
+            return result;
+        }
+
+        osg::ref_ptr<osg::Node> mergeBatch(const MergeBatch& batch, const MergeSettings& settings)
+        {
+            osg::ref_ptr<osg::Group> group = new osg::Group;
+            osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
+            CopyOp copyop(settings.mActiveGrid, settings.mCopyMask);
+
+            for (const MergeTemplate& mergeTemplate : batch.mTemplates)
+            {
+                for (const MergeInstance& instance : mergeTemplate.mInstances)
+                {
+                    // Optimizer currently supports only MatrixTransforms.
+                    osg::ref_ptr<osg::MatrixTransform> trans = new osg::MatrixTransform(instance.mMatrix);
+                    trans->setDataVariance(osg::Object::STATIC);
+
+                    // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays
+                    // is generally unsafe. In this specific case the operation is safe under the following two
+                    // assumptions:
+                    // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place
+                    // must outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
+                    // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
+                    // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
+                    copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES);
+                    copyop.mOptimizeBillboards = (settings.mSize > 1 / 4.f);
+                    copyop.mNodePath.push_back(trans);
+                    copyop.mDistances = settings.mDistances / instance.mScale;
+                    copyop.mViewVector = settings.mRelativeViewPoint;
+                    copyop.copy(mergeTemplate.mNode, trans);
+                    copyop.mNodePath.pop_back();
+
+                    if (settings.mActiveGrid)
+                    {
+                        AddRefnumMarkerVisitor visitor(instance.mRefNum);
+                        trans->accept(visitor);
+                    }
+
+                    group->addChild(trans);
+                }
+
+                templateRefs->addRef(mergeTemplate.mNode);
+            }
+
+            SceneUtil::Optimizer optimizer;
+            if (settings.mSize > 1 / 8.f)
+            {
+                optimizer.setViewPoint(settings.mRelativeViewPoint);
+                optimizer.setMergeAlphaBlending(true);
+            }
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+            // A single large batch is split further between the merge threads
+            optimizer.setWorkQueue(settings.mWorkQueue, settings.mMaxHelpers);
+            const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+                | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
+
+            optimizer.optimize(group, options);
+
+            if (settings.mDebugBatches)
+            {
+                DebugVisitor dv;
+                group->accept(dv);
+            }
+
+            // Merged geometry may be reused by other chunks after this one is gone
+            group->getOrCreateUserDataContainer()->addUserObject(templateRefs);
+
+            return group;
+        }
     }
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace)
+    ObjectPaging::ObjectPaging(
+        Resource::SceneManager* sceneManager, ESM::RefId worldspace, const MWWorld::CellRefTable& cellRefs)
         : GenericResourceManager<ChunkId>(nullptr, Settings::cells().mCacheExpiryDelay)
         , Terrain::QuadTreeWorld::ChunkManager(worldspace)
         , mSceneManager(sceneManager)
@@ -504,7 +658,66 @@ namespace MWRender
         , mMinSizeMergeFactor(Settings::terrain().mObjectPagingMinSizeMergeFactor)
         , mMinSizeCostMultiplier(Settings::terrain().mObjectPagingMinSizeCostMultiplier)
         , mRefTrackerLocked(false)
+        , mMergeBatchCache(new Resource::GenericObjectCache<MergeBatchKey>)
+        , mMergeThreads(static_cast<std::size_t>(Settings::terrain().mObjectPagingMergeThreads))
+        , mCellRefs(cellRefs)
+    {
+        if (mMergeThreads > 0)
+            mMergeWorkQueue = new SceneUtil::WorkQueue(mMergeThreads);
+    }
+
+    ObjectPaging::~ObjectPaging() = default;
+
+    void loadPagedReferences(const MWWorld::ESMStore& store, MWWorld::CellRefTable& table, Loading::Listener* listener)
     {
+        ESM::ReadersCache readers;
+        const MWWorld::Store<ESM::Cell>& cells = store.get<ESM::Cell>();
+        if (listener != nullptr)
+            listener->setProgressRange(cells.getExtSize());
+        for (auto it = cells.extBegin(); it != cells.extEnd(); ++it)
+        {
+            if (listener != nullptr)
+                listener->increaseProgress();
+            const ESM::Cell* cell = &*it;
+            for (size_t i = 0; i < cell->mContextList.size(); ++i)
+            {
+                try
+                {
+                    const std::size_t index = static_cast<std::size_t>(cell->mContextList[i].index);
+                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                    cell->restore(*reader, i);
+                    ESM::CellRef ref;
+                    ESM::MovedCellRef cMRef;
+                    bool deleted = false;
+                    bool moved = false;
+                    while (ESM::Cell::getNextRef(
+                        *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
+                    {
+                        if (moved)
+                            continue;
+
+                        if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum)
+                            != cell->mMovedRefs.end())
+                            continue;
+
+                        // Far chunks use a stricter filter so it's applied on collecting
+                        if (!typeFilter(store.findStatic(ref.mRefID), false))
+                            continue;
+
+                        table.add(cell->getGridX(), cell->getGridY(), ref, deleted);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to collect references from cell \"" << cell->getDescription()
+                                        << "\": " << e.what();
+                    continue;
+                }
+            }
+        }
+        table.finalize();
+        Log(Debug::Info) << "Loaded " << table.getRefsCount() << " paged references in "
+                         << table.getCellsCount() << " cells";
     }
 
     namespace
@@ -540,57 +753,40 @@ namespace MWRender
             };
         }
 
-        std::map<ESM::RefNum, PagedCellRef> collectESM3References(
-            float size, const osg::Vec2i& startCell, const MWWorld::ESMStore& store)
+        PagedCellRef makePagedCellRef(const MWWorld::CellRefTable::Ref& value)
+        {
+            return PagedCellRef{
+                .mRefId = value.mRefId,
+                .mRefNum = value.mRefNum,
+                .mPosition = value.mPos.asVec3(),
+                .mRotation = value.mPos.asRotationVec3(),
+                .mScale = value.mScale,
+            };
+        }
+
+        std::map<ESM::RefNum, PagedCellRef> collectESM3References(float size, const osg::Vec2i& startCell,
+            const MWWorld::ESMStore& store, const MWWorld::CellRefTable& table)
         {
             std::map<ESM::RefNum, PagedCellRef> refs;
-            ESM::ReadersCache readers;
             for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
             {
                 for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
                 {
-                    const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
-                    if (!cell)
-                        continue;
-                    for (size_t i = 0; i < cell->mContextList.size(); ++i)
+                    for (const MWWorld::CellRefTable::Ref& ref : table.getCell(cellX, cellY))
                     {
-                        try
-                        {
-                            const std::size_t index = static_cast<std::size_t>(cell->mContextList[i].index);
-                            const ESM::ReadersCache::BusyItem reader = readers.get(index);
-                            cell->restore(*reader, i);
-                            ESM::CellRef ref;
-                            ESM::MovedCellRef cMRef;
-                            bool deleted = false;
-                            bool moved = false;
-                            while (ESM::Cell::getNextRef(
-                                *reader, ref, deleted, cMRef, moved, ESM::Cell::GetNextRefMode::LoadOnlyNotMoved))
-                            {
-                                if (moved)
-                                    continue;
-
-                                if (std::find(cell->mMovedRefs.begin(), cell->mMovedRefs.end(), ref.mRefNum)
-                                    != cell->mMovedRefs.end())
-                                    continue;
-
-                                int type = store.findStatic(ref.mRefID);
-                                if (!typeFilter(type, size >= 2))
-                                    continue;
-                                if (deleted)
-                                {
-                                    refs.erase(ref.mRefNum);
-                                    continue;
-                                }
-                                refs.insert_or_assign(ref.mRefNum, makePagedCellRef(ref));
-                            }
-                        }
-                        catch (const std::exception& e)
+                        int type = store.findStatic(ref.mRefId);
+                        if (!typeFilter(type, size >= 2))
+                            continue;
+                        if (ref.mDeleted)
                         {
-                            Log(Debug::Warning) << "Failed to collect references from cell \"" << cell->getDescription()
-                                                << "\": " << e.what();
+                            refs.erase(ref.mRefNum);
                             continue;
                         }
+                        refs.insert_or_assign(ref.mRefNum, makePagedCellRef(ref));
                     }
+                    const ESM::Cell* cell = store.get<ESM::Cell>().searchStatic(cellX, cellY);
+                    if (!cell)
+                        continue;
                     for (const auto& [ref, deleted] : cell->mLeasedRefs)
                     {
                         if (deleted)
@@ -659,7 +855,7 @@ namespace MWRender
 
         if (mWorldspace == ESM::Cell::sDefaultWorldspaceId)
         {
-            refs = collectESM3References(size, startCell, store);
+            refs = collectESM3References(size, startCell, store, mCellRefs);
         }
         else
         {
@@ -809,11 +1005,12 @@ namespace MWRender
         }
 
         const osg::Vec3f worldCenter = osg::Vec3f(center.x(), center.y(), 0) * getCellSize(mWorldspace);
+        const osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
         osg::ref_ptr<osg::Group> group = new osg::Group;
-        osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
         osg::ref_ptr<Resource::TemplateMultiRef> templateRefs = new Resource::TemplateMultiRef;
         osgUtil::StateToCompile stateToCompile(0, nullptr);
         CopyOp copyop(activeGrid, copyMask);
+        std::vector<MergeTemplate> mergeTemplates;
         for (const auto& pair : nodes)
         {
             const osg::Node* cnode = pair.first;
@@ -829,6 +1026,9 @@ namespace MWRender
             const float minSizeMergeFactor2 = (1 - factor2) * mMinSizeMergeFactor + factor2;
             const float minSizeMerged = minSizeMergeFactor2 > 0 ? mMinSize * minSizeMergeFactor2 : mMinSize;
 
+            if (merge)
+                mergeTemplates.push_back(MergeTemplate{ .mNode = cnode, .mAnalyzeResult = &analyzeResult });
+
             unsigned int numinstances = 0;
             for (const PagedCellRef* refPtr : pair.second.mInstances)
             {
@@ -845,61 +1045,43 @@ namespace MWRender
                     * osg::Quat(ref.mRotation.x(), osg::Vec3f(-1, 0, 0));
                 const osg::Vec3f nodeScale(ref.mScale, ref.mScale, ref.mScale);
 
-                osg::ref_ptr<osg::Group> trans;
+                ++numinstances;
+
                 if (merge)
                 {
-                    // Optimizer currently supports only MatrixTransforms.
                     osg::Matrixf matrix;
                     matrix.preMultTranslate(nodePos);
                     matrix.preMultRotate(nodeAttitude);
                     matrix.preMultScale(nodeScale);
-                    trans = new osg::MatrixTransform(matrix);
-                    trans->setDataVariance(osg::Object::STATIC);
-                }
-                else
-                {
-                    trans = new SceneUtil::PositionAttitudeTransform;
-                    SceneUtil::PositionAttitudeTransform* pat
-                        = static_cast<SceneUtil::PositionAttitudeTransform*>(trans.get());
-                    pat->setPosition(nodePos);
-                    pat->setScale(nodeScale);
-                    pat->setAttitude(nodeAttitude);
+                    mergeTemplates.back().mInstances.push_back(
+                        MergeInstance{ .mRefNum = ref.mRefNum, .mMatrix = matrix, .mScale = ref.mScale });
+                    continue;
                 }
 
-                // DO NOT COPY AND PASTE THIS CODE. Cloning osg::Geometry without also cloning its contained Arrays is
-                // generally unsafe. In this specific case the operation is safe under the following two assumptions:
-                // - When Arrays are removed or replaced in the cloned geometry, the original Arrays in their place must
-                // outlive the cloned geometry regardless. (ensured by TemplateMultiRef)
-                // - Arrays that we add or replace in the cloned geometry must be explicitely forbidden from reusing
-                // BufferObjects of the original geometry. (ensured by needvbo() in optimizer.cpp)
-                copyop.setCopyFlags(merge ? osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES
-                                          : osg::CopyOp::DEEP_COPY_NODES);
+                osg::ref_ptr<SceneUtil::PositionAttitudeTransform> trans = new SceneUtil::PositionAttitudeTransform;
+                trans->setPosition(nodePos);
+                trans->setScale(nodeScale);
+                trans->setAttitude(nodeAttitude);
+
+                copyop.setCopyFlags(osg::CopyOp::DEEP_COPY_NODES);
                 copyop.mOptimizeBillboards = (size > 1 / 4.f);
                 copyop.mNodePath.push_back(trans);
                 copyop.mDistances = LODRange{ smallestDistanceToChunk, higherDistanceToChunk } / ref.mScale;
-                copyop.mViewVector = (viewPoint - worldCenter);
+                copyop.mViewVector = relativeViewPoint;
                 copyop.copy(cnode, trans);
                 copyop.mNodePath.pop_back();
 
                 if (activeGrid)
                 {
-                    if (merge)
-                    {
-                        AddRefnumMarkerVisitor visitor(ref.mRefNum);
-                        trans->accept(visitor);
-                    }
-                    else
-                    {
-                        osg::ref_ptr<RefnumMarker> marker = new RefnumMarker;
-                        marker->mRefnum = ref.mRefNum;
-                        trans->getOrCreateUserDataContainer()->addUserObject(marker);
-                    }
+                    osg::ref_ptr<RefnumMarker> marker = new RefnumMarker;
+                    marker->mRefnum = ref.mRefNum;
+                    trans->getOrCreateUserDataContainer()->addUserObject(marker);
                 }
 
-                osg::Group* const attachTo = merge ? mergeGroup : group;
-                attachTo->addChild(trans);
-                ++numinstances;
+                group->addChild(trans);
             }
+            if (merge && mergeTemplates.back().mInstances.empty())
+                mergeTemplates.pop_back();
             if (numinstances > 0)
             {
                 // add a ref to the original template to help verify the safety of shallow cloning operations
@@ -917,29 +1099,44 @@ namespace MWRender
             }
         }
 
-        const osg::Vec3f relativeViewPoint = viewPoint - worldCenter;
-
-        if (mergeGroup->getNumChildren())
+        if (!mergeTemplates.empty())
         {
-            SceneUtil::Optimizer optimizer;
-            if (size > 1 / 8.f)
+            std::vector<MergeBatch> batches = makeMergeBatches(std::move(mergeTemplates), size, activeGrid);
+
+            std::vector<std::size_t> missing;
+            for (std::size_t i = 0; i < batches.size(); ++i)
             {
-                optimizer.setViewPoint(relativeViewPoint);
-                optimizer.setMergeAlphaBlending(true);
+                if (osg::ref_ptr<osg::Object> cached = mMergeBatchCache->getRefFromObjectCache(batches[i].mKey))
+                    batches[i].mResult = static_cast<osg::Node*>(cached.get());
+                else
+                    missing.push_back(i);
             }
-            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
-            const unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
-                | SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES | SceneUtil::Optimizer::MERGE_GEOMETRY;
 
-            optimizer.optimize(mergeGroup, options);
+            const MergeSettings mergeSettings{
+                .mActiveGrid = activeGrid,
+                .mCopyMask = copyMask,
+                .mSize = size,
+                .mDistances = LODRange{ smallestDistanceToChunk, higherDistanceToChunk },
+                .mRelativeViewPoint = relativeViewPoint,
+                .mDebugBatches = mDebugBatches,
+                .mWorkQueue = mMergeWorkQueue.get(),
+                .mMaxHelpers = mMergeThreads,
+            };
+
+            SceneUtil::parallelFor(mMergeWorkQueue.get(), mMergeThreads, missing.size(), [&](std::size_t index) {
+                MergeBatch& batch = batches[missing[index]];
+                batch.mResult = mergeBatch(batch, mergeSettings);
+            });
+
+            for (std::size_t i : missing)
+                mMergeBatchCache->addEntryToObjectCache(std::move(batches[i].mKey), batches[i].mResult);
+
+            osg::ref_ptr<osg::Group> mergeGroup = new osg::Group;
+            for (const MergeBatch& batch : batches)
+                mergeGroup->addChild(batch.mResult);
 
             group->addChild(mergeGroup);
 
-            if (mDebugBatches)
-            {
-                DebugVisitor dv;
-                mergeGroup->accept(dv);
-            }
             if (compile)
             {
                 stateToCompile._mode = osgUtil::GLObjectsVisitor::COMPILE_DISPLAY_LISTS;
@@ -1131,9 +1328,28 @@ namespace MWRender
         out.erase(std::unique(out.begin(), out.end()), out.end());
     }
 
+    void ObjectPaging::updateCache(double referenceTime)
+    {
+        GenericResourceManager::updateCache(referenceTime);
+        mMergeBatchCache->update(referenceTime, mExpiryDelay);
+    }
+
+    void ObjectPaging::clearCache()
+    {
+        GenericResourceManager::clearCache();
+        mMergeBatchCache->clear();
+    }
+
+    void ObjectPaging::releaseGLObjects(osg::State* state)
+    {
+        GenericResourceManager::releaseGLObjects(state);
+        mMergeBatchCache->releaseGLObjects(state);
+    }
+
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         Resource::reportStats("Object Chunk", frameNumber, mCache->getStats(), *stats);
+        Resource::reportStats("Object Batch", frameNumber, mMergeBatchCache->getStats(), *stats);
     }
 
 }
@@ -5,23 +5,70 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 
+#include <osg/Matrixf>
+
 #include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "../mwworld/cellreftable.hpp"
 
 namespace Resource
 {
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Loading
+{
+    class Listener;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+}
+
 namespace MWRender
 {
 
     typedef std::tuple<osg::Vec2f, float, bool> ChunkId; // Center, Size, ActiveGrid
 
+    /// Identifies merged geometry of a set of template instances sharing state within a chunk.
+    struct MergeBatchKey
+    {
+        struct Instance
+        {
+            const osg::Node* mTemplate;
+            ESM::RefNum mRefNum;
+            osg::Matrixf mMatrix;
+
+            friend bool operator<(const Instance& l, const Instance& r)
+            {
+                return std::tie(l.mTemplate, l.mRefNum, l.mMatrix) < std::tie(r.mTemplate, r.mRefNum, r.mMatrix);
+            }
+        };
+
+        float mSize;
+        bool mActiveGrid;
+        std::vector<Instance> mInstances;
+
+        friend bool operator<(const MergeBatchKey& l, const MergeBatchKey& r)
+        {
+            return std::tie(l.mSize, l.mActiveGrid, l.mInstances) < std::tie(r.mSize, r.mActiveGrid, r.mInstances);
+        }
+    };
+
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager, ESM::RefId worldspace);
-        ~ObjectPaging() = default;
+        ObjectPaging(
+            Resource::SceneManager* sceneManager, ESM::RefId worldspace, const MWWorld::CellRefTable& cellRefs);
+        ~ObjectPaging();
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags,
             bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
@@ -43,6 +90,12 @@ namespace MWRender
         /// @return true if view needs rebuild
         bool unlockCache();
 
+        void updateCache(double referenceTime) override;
+
+        void clearCache() override;
+
+        void releaseGLObjects(osg::State* state) override;
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
         void getPagedRefnums(const osg::Vec4i& activeGrid, std::vector<ESM::RefNum>& out);
@@ -77,12 +130,23 @@ namespace MWRender
         typedef std::map<ESM::RefNum, float> SizeCache;
         SizeCache mSizeCache;
 
+        osg::ref_ptr<Resource::GenericObjectCache<MergeBatchKey>> mMergeBatchCache;
+        osg::ref_ptr<SceneUtil::WorkQueue> mMergeWorkQueue;
+        std::size_t mMergeThreads;
+
+        const MWWorld::CellRefTable& mCellRefs;
+
         std::mutex mLODNameCacheMutex;
         typedef std::pair<std::string, unsigned char> LODNameCacheKey; // Key: mesh name, lod level
         using LODNameCache = std::map<LODNameCacheKey, VFS::Path::Normalized>; // Cache: key, mesh name to use
         LODNameCache mLODNameCache;
     };
 
+    /// Reads the references of all exterior cells of the default worldspace that may be paged. Called once while
+    /// loading content, chunk creation only reads the resulting table.
+    void loadPagedReferences(
+        const MWWorld::ESMStore& store, MWWorld::CellRefTable& table, Loading::Listener* listener = nullptr);
+
     class RefnumMarker : public osg::Object
     {
     public:
@@ -307,7 +307,7 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-        SceneUtil::UnrefQueue& unrefQueue)
+        const MWWorld::CellRefTable& pagedCellRefs, SceneUtil::UnrefQueue& unrefQueue)
         : mSkyBlending(Settings::fog().mSkyBlending)
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -324,6 +324,7 @@ namespace MWRender
         , mFieldOfView(Settings::camera().mFieldOfView)
         , mFirstPersonFieldOfView(Settings::camera().mFirstPersonFieldOfView)
         , mGroundCoverStore(groundcoverStore)
+        , mPagedCellRefs(pagedCellRefs)
     {
         bool reverseZ = SceneUtil::AutoDepth::isReversed();
         const SceneUtil::LightingMethod lightingMethod = Settings::shaders().mLightingMethod;
@@ -515,6 +516,9 @@ namespace MWRender
         resourceSystem->getSceneManager()->setSupportsNormalsRT(mPostProcessor->getSupportsNormalsRT());
         resourceSystem->getSceneManager()->setWeatherParticleOcclusion(Settings::shaders().mWeatherParticleOcclusion);
 
+        // Post processor sets the last global defines, changing them would drop binaries of prewarmed programs
+        prewarmShaders();
+
         // water goes after terrain for correct waterculling order
         mWater = std::make_unique<Water>(
             sceneRoot->getParent(0), sceneRoot, mResourceSystem, mViewer->getIncrementalCompileOperation());
@@ -619,6 +623,26 @@ namespace MWRender
         return mViewer->getIncrementalCompileOperation();
     }
 
+    void RenderingManager::prewarmShaders()
+    {
+        const std::vector<osg::ref_ptr<osg::Program>> programs
+            = mResourceSystem->getSceneManager()->getShaderManager().prewarm();
+
+        osgUtil::IncrementalCompileOperation* const ico = getIncrementalCompileOperation();
+        if (programs.empty() || ico == nullptr)
+            return;
+
+        // Compile programs in the background like the objects of preloaded cells
+        osg::ref_ptr<osg::Group> node = new osg::Group;
+        for (const osg::ref_ptr<osg::Program>& program : programs)
+        {
+            osg::ref_ptr<osg::Node> child = new osg::Node;
+            child->getOrCreateStateSet()->setAttributeAndModes(program, osg::StateAttribute::ON);
+            node->addChild(child);
+        }
+        ico->add(node);
+    }
+
     MWRender::Objects& RenderingManager::getObjects()
     {
         return *mObjects.get();
@@ -1473,7 +1497,7 @@ namespace MWRender
             if (Settings::terrain().mObjectPaging)
             {
                 newChunkMgr.mObjectPaging
-                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace);
+                    = std::make_unique<ObjectPaging>(mResourceSystem->getSceneManager(), worldspace, mPagedCellRefs);
                 quadTreeWorld->addChunkManager(newChunkMgr.mObjectPaging.get());
                 mResourceSystem->addResourceManager(newChunkMgr.mObjectPaging.get());
             }
@@ -75,6 +75,7 @@ namespace DetourNavigator
 namespace MWWorld
 {
     class GroundcoverStore;
+    class CellRefTable;
     class Cell;
 }
 
@@ -113,7 +114,7 @@ namespace MWRender
         RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
             Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
             DetourNavigator::Navigator& navigator, const MWWorld::GroundcoverStore& groundcoverStore,
-            SceneUtil::UnrefQueue& unrefQueue);
+            const MWWorld::CellRefTable& pagedCellRefs, SceneUtil::UnrefQueue& unrefQueue);
         ~RenderingManager();
 
         osgUtil::IncrementalCompileOperation* getIncrementalCompileOperation();
@@ -281,6 +282,8 @@ namespace MWRender
         void updateAmbient();
         void setFogColor(const osg::Vec4f& color);
 
+        void prewarmShaders();
+
         struct WorldspaceChunkMgr
         {
             std::unique_ptr<Terrain::World> mTerrain;
@@ -352,6 +355,7 @@ namespace MWRender
         bool mUpdateProjectionMatrix = false;
         bool mNight = false;
         const MWWorld::GroundcoverStore& mGroundCoverStore;
+        const MWWorld::CellRefTable& mPagedCellRefs;
 
         void operator=(const RenderingManager&);
         RenderingManager(const RenderingManager&);
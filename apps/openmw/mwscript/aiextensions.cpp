@@ -426,6 +426,8 @@ namespace MWScript
         class OpGetDetected : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr observer = R()(runtime, false); // required=false
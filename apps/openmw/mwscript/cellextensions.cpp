@@ -159,6 +159,8 @@ namespace MWScript
         class OpGetPCCell : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 std::string_view name = runtime.getStringLiteral(runtime[0].mInteger);
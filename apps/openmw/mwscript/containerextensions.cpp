@@ -187,6 +187,8 @@ namespace MWScript
         class OpGetItemCount : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime, false);
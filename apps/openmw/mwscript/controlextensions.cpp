@@ -46,6 +46,8 @@ namespace MWScript
             std::string_view mControl;
 
         public:
+            static constexpr bool sHasSideEffects = false;
+
             OpGetDisabled(std::string_view control)
                 : mControl(control)
             {
@@ -71,6 +71,8 @@ namespace MWScript
         class OpGetJournalIndex : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 ESM::RefId quest = ESM::RefId::stringRefId(runtime.getStringLiteral(runtime[0].mInteger));
@@ -155,6 +155,8 @@ namespace MWScript
         class OpMenuMode : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 runtime.push(MWBase::Environment::get().getWindowManager()->isGuiMode());
@@ -201,6 +203,8 @@ namespace MWScript
         class OpScriptRunning : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 const ESM::RefId& name = ESM::RefId::stringRefId(runtime.getStringLiteral(runtime[0].mInteger));
@@ -231,6 +235,8 @@ namespace MWScript
         class OpGetSecondsPassed : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 runtime.push(MWBase::Environment::get().getFrameDuration());
@@ -282,6 +288,8 @@ namespace MWScript
         class OpGetDisabled : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -342,11 +350,18 @@ namespace MWScript
         class OpOnActivate : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
 
-                runtime.push(ptr.getRefData().onActivate());
+                const bool activated = ptr.getRefData().onActivate();
+                // Consumes the activation
+                if (activated)
+                    runtime.markSideEffects();
+
+                runtime.push(activated);
             }
         };
 
@@ -588,6 +603,8 @@ namespace MWScript
         class OpGetLocked : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -892,6 +909,8 @@ namespace MWScript
         class OpGetCurrentTime : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 runtime.push(MWBase::Environment::get().getWorld()->getTimeStamp().getHour());
@@ -943,6 +962,8 @@ namespace MWScript
         class OpGetStandingPc : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -3,7 +3,10 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
 
@@ -12,10 +15,14 @@
 
 #include <components/misc/strings/lower.hpp>
 
+#include <components/compiler/bytecodecache.hpp>
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
 #include <components/compiler/scanner.hpp>
+#include <components/compiler/tokenloc.hpp>
+
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwworld/esmstore.hpp"
 
@@ -24,10 +31,75 @@
 
 namespace MWScript
 {
+    namespace
+    {
+        // Collects warnings in the format of Compiler::StreamErrorHandler to log them only when the script is compiled
+        // successfully. Errors are not reported, a script failed to compile in advance is compiled again on the first
+        // execution and reports them then.
+        class WarningsErrorHandler final : public Compiler::ErrorHandler
+        {
+        public:
+            explicit WarningsErrorHandler(const std::string& context)
+                : mContext(context)
+            {
+            }
+
+            const std::vector<std::string>& getWarnings() const { return mWarnings; }
+
+        private:
+            const std::string& mContext;
+            std::vector<std::string> mWarnings;
+
+            void report(const std::string& message, const Compiler::TokenLoc& loc, Type type) override
+            {
+                if (type == ErrorMessage)
+                    return;
+                std::ostringstream text;
+                text << "Warning: " << mContext << " line " << loc.mLine + 1 << ", column " << loc.mColumn + 1 << " ("
+                     << loc.mLiteral << "): " << message;
+                mWarnings.push_back(text.str());
+            }
+
+            void report(const std::string& message, Type type) override
+            {
+                if (type == ErrorMessage)
+                    return;
+                mWarnings.push_back("Warning: " + mContext + " file: " + message);
+            }
+        };
+
+        // Uses only the given parser and error handler, so can be called from multiple threads
+        bool compileScript(const ESM::Script& script, Compiler::ErrorHandler& errorHandler,
+            Compiler::FileParser& parser, const Compiler::Context& context)
+        {
+            try
+            {
+                std::istringstream input(script.mScriptText);
+
+                Compiler::Scanner scanner(errorHandler, input, context.getExtensions());
+
+                scanner.scan(parser);
+
+                return errorHandler.isGood();
+            }
+            catch (const Compiler::SourceException&)
+            {
+                // error has already been reported via error handler
+                return false;
+            }
+            catch (const std::exception& error)
+            {
+                Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
+                return false;
+            }
+        }
+    }
+
     ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode)
         : mErrorHandler()
         , mStore(store)
         , mCompilerContext(compilerContext)
+        , mWarningsMode(warningsMode)
         , mParser(mErrorHandler, mCompilerContext)
         , mGlobalScripts(store)
     {
@@ -45,28 +117,7 @@ namespace MWScript
         {
             mErrorHandler.setContext(script->mId.getRefIdString());
 
-            bool success = true;
-            try
-            {
-                std::istringstream input(script->mScriptText);
-
-                Compiler::Scanner scanner(mErrorHandler, input, mCompilerContext.getExtensions());
-
-                scanner.scan(mParser);
-
-                if (!mErrorHandler.isGood())
-                    success = false;
-            }
-            catch (const Compiler::SourceException&)
-            {
-                // error has already been reported via error handler
-                success = false;
-            }
-            catch (const std::exception& error)
-            {
-                Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
-                success = false;
-            }
+            const bool success = compileScript(*script, mErrorHandler, mParser, mCompilerContext);
 
             if (!success)
             {
@@ -75,7 +126,10 @@ namespace MWScript
 
             if (success)
             {
-                mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
+                Interpreter::Program program = mParser.getProgram();
+                std::vector<Interpreter::Instruction> instructions = mInterpreter.decode(program);
+                mScripts.emplace(
+                    name, CompiledScript(std::move(program), std::move(instructions), mParser.getLocals()));
 
                 return true;
             }
@@ -86,6 +140,14 @@ namespace MWScript
 
     bool ScriptManager::run(const ESM::RefId& name, Interpreter::Context& interpreterContext)
     {
+        bool sideEffects = false;
+        return run(name, interpreterContext, sideEffects);
+    }
+
+    bool ScriptManager::run(const ESM::RefId& name, Interpreter::Context& interpreterContext, bool& sideEffects)
+    {
+        sideEffects = false;
+
         // compile script
         auto iter = mScripts.find(name);
 
@@ -94,7 +156,7 @@ namespace MWScript
             if (!compile(name))
             {
                 // failed -> ignore script from now on.
-                mScripts.emplace(name, CompiledScript({}, Compiler::Locals()));
+                mScripts.emplace(name, CompiledScript({}, {}, Compiler::Locals()));
                 return false;
             }
 
@@ -109,15 +171,17 @@ namespace MWScript
         {
             try
             {
-                mInterpreter.run(iter->second.mProgram, interpreterContext);
+                sideEffects = mInterpreter.run(iter->second.mProgram, iter->second.mInstructions, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
             {
+                sideEffects = true;
                 Log(Debug::Error) << "Execution of script " << name << " failed: " << e.what();
             }
             catch (const std::exception& e)
             {
+                sideEffects = true;
                 Log(Debug::Error) << "Execution of script " << name << " failed: " << e.what();
 
                 iter->second.mInactive.insert(target); // don't execute again.
@@ -137,23 +201,98 @@ namespace MWScript
     }
 
     std::pair<int, int> ScriptManager::compileAll()
+    {
+        return compileAll(nullptr, 0, nullptr, true);
+    }
+
+    std::pair<int, int> ScriptManager::compileAll(
+        SceneUtil::WorkQueue* workQueue, std::size_t maxHelpers, Compiler::BytecodeCache* cache, bool report)
     {
         int count = 0;
         int success = 0;
 
-        for (auto& script : mStore.get<ESM::Script>())
+        std::vector<const ESM::Script*> scripts;
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
         {
             ++count;
 
-            if (compile(script.mId))
+            const auto iter = mScripts.find(script.mId);
+            if (iter == mScripts.end())
+                scripts.push_back(&script);
+            else if (!iter->second.mProgram.mInstructions.empty())
                 ++success;
         }
 
+        std::vector<std::uint64_t> keys(scripts.size());
+        std::vector<const Compiler::BytecodeCache::Script*> cached(scripts.size());
+        std::vector<std::optional<Compiler::BytecodeCache::Script>> compiled(scripts.size());
+
+        // mScripts is not modified until all scripts are compiled, getLocals called by the compiler context for other
+        // scripts is synchronized
+        SceneUtil::parallelFor(workQueue, maxHelpers, scripts.size(), [&](std::size_t index) {
+            const ESM::Script& script = *scripts[index];
+
+            keys[index] = Compiler::BytecodeCache::makeKey(script.mScriptText);
+            if (cache != nullptr)
+            {
+                cached[index] = cache->find(keys[index]);
+                if (cached[index] != nullptr)
+                    return;
+            }
+
+            const std::string context = script.mId.getRefIdString();
+            Compiler::StreamErrorHandler streamErrorHandler;
+            WarningsErrorHandler warningsErrorHandler(context);
+            Compiler::ErrorHandler& errorHandler
+                = report ? static_cast<Compiler::ErrorHandler&>(streamErrorHandler) : warningsErrorHandler;
+            errorHandler.setWarningsMode(mWarningsMode);
+            streamErrorHandler.setContext(context);
+
+            Compiler::FileParser parser(errorHandler, mCompilerContext);
+
+            if (compileScript(script, errorHandler, parser, mCompilerContext))
+            {
+                // Warnings are reported before the script is added to the cache, it won't be compiled again
+                for (const std::string& warning : warningsErrorHandler.getWarnings())
+                    Log(Debug::Info) << warning;
+                compiled[index] = Compiler::BytecodeCache::Script{ parser.getProgram(), parser.getLocals() };
+            }
+            else if (report)
+                Log(Debug::Error) << "Error: script compiling failed: " << script.mId;
+        });
+
+        for (std::size_t i = 0; i < scripts.size(); ++i)
+        {
+            if (cached[i] == nullptr && !compiled[i].has_value())
+                continue;
+
+            ++success;
+
+            if (cached[i] != nullptr)
+            {
+                Interpreter::Program program = cached[i]->mProgram;
+                std::vector<Interpreter::Instruction> instructions = mInterpreter.decode(program);
+                mScripts.emplace(
+                    scripts[i]->mId, CompiledScript(std::move(program), std::move(instructions), cached[i]->mLocals));
+                continue;
+            }
+
+            std::vector<Interpreter::Instruction> instructions = mInterpreter.decode(compiled[i]->mProgram);
+            mScripts.emplace(scripts[i]->mId,
+                CompiledScript(Interpreter::Program(compiled[i]->mProgram), std::move(instructions),
+                    compiled[i]->mLocals));
+
+            if (cache != nullptr)
+                cache->insert(keys[i], std::move(*compiled[i]));
+        }
+
         return std::make_pair(count, success);
     }
 
     const Compiler::Locals& ScriptManager::getLocals(const ESM::RefId& name)
     {
+        const std::lock_guard lock(mLocalsMutex);
+
         {
             auto iter = mScripts.find(name);
 
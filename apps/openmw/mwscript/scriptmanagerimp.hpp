@@ -2,8 +2,10 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <components/compiler/fileparser.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
@@ -24,6 +26,7 @@ namespace MWWorld
 
 namespace Compiler
 {
+    class BytecodeCache;
     class Context;
 }
 
@@ -33,6 +36,11 @@ namespace Interpreter
     class Interpreter;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWScript
 {
     class ScriptManager : public MWBase::ScriptManager
@@ -40,17 +48,22 @@ namespace MWScript
         Compiler::StreamErrorHandler mErrorHandler;
         const MWWorld::ESMStore& mStore;
         Compiler::Context& mCompilerContext;
+        int mWarningsMode;
         Compiler::FileParser mParser;
         Interpreter::Interpreter mInterpreter;
 
         struct CompiledScript
         {
             Interpreter::Program mProgram;
+            // Decoded once by mInterpreter, so running the script doesn't look up opcodes
+            std::vector<Interpreter::Instruction> mInstructions;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
 
-            explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
+            explicit CompiledScript(Interpreter::Program&& program,
+                std::vector<Interpreter::Instruction>&& instructions, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
+                , mInstructions(std::move(instructions))
                 , mLocals(locals)
             {
             }
@@ -58,6 +71,8 @@ namespace MWScript
 
         std::unordered_map<ESM::RefId, CompiledScript> mScripts;
         GlobalScripts mGlobalScripts;
+        // Guards mOtherLocals and mErrorHandler used by getLocals which is called by compiler from multiple threads
+        std::mutex mLocalsMutex;
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
 
     public:
@@ -68,6 +83,10 @@ namespace MWScript
         bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext) override;
         ///< Run the script with the given name (compile first, if not compiled yet)
 
+        bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext, bool& sideEffects);
+        ///< Same as run, \a sideEffects is set when the script might have changed the game state. A script that was
+        /// not executed has no side effects.
+
         bool compile(const ESM::RefId& name) override;
         ///< Compile script with the given namen
         /// \return Success?
@@ -76,6 +95,14 @@ namespace MWScript
         ///< Compile all scripts
         /// \return count, success
 
+        std::pair<int, int> compileAll(
+            SceneUtil::WorkQueue* workQueue, std::size_t maxHelpers, Compiler::BytecodeCache* cache, bool report);
+        ///< Compile all scripts not compiled yet on the calling thread and up to \a maxHelpers items of the work
+        /// queue. Compiled code is taken from \a cache when it is present there and the newly compiled code is added
+        /// to it. Warnings are always logged, errors only when \a report is set, scripts that failed to compile are
+        /// compiled again on the first execution.
+        /// \return count, success
+
         const Compiler::Locals& getLocals(const ESM::RefId& name) override;
         ///< Return locals for script \a name.
 
@@ -115,6 +115,8 @@ namespace MWScript
             ESM::RefId mIndex;
 
         public:
+            static constexpr bool sHasSideEffects = false;
+
             OpGetAttribute(ESM::RefId index)
                 : mIndex(index)
             {
@@ -192,6 +194,8 @@ namespace MWScript
             int mIndex;
 
         public:
+            static constexpr bool sHasSideEffects = false;
+
             OpGetDynamic(int index)
                 : mIndex(index)
             {
@@ -375,6 +379,8 @@ namespace MWScript
             ESM::RefId mId;
 
         public:
+            static constexpr bool sHasSideEffects = false;
+
             OpGetSkill(ESM::RefId id)
                 : mId(id)
             {
@@ -776,6 +782,8 @@ namespace MWScript
         class OpGetDisposition : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -790,6 +798,8 @@ namespace MWScript
         class OpGetDeadCount : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 ESM::RefId id = ESM::RefId::stringRefId(runtime.getStringLiteral(runtime[0].mInteger));
@@ -45,6 +45,8 @@ namespace MWScript
         class OpGetDistance : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr from = R()(runtime, !R::implicit);
@@ -225,6 +227,8 @@ namespace MWScript
         class OpGetAngle : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -256,6 +260,8 @@ namespace MWScript
         class OpGetPos : public Interpreter::Opcode0
         {
         public:
+            static constexpr bool sHasSideEffects = false;
+
             void execute(Interpreter::Runtime& runtime) override
             {
                 MWWorld::Ptr ptr = R()(runtime);
@@ -1029,32 +1029,37 @@ namespace MWSound
         return ret;
     }
 
-    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    DecodedSound OpenALOutput::decodeSound(VFS::Path::NormalizedView fname)
     {
-        getALError();
-
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
+        DecodedSound result;
 
         try
         {
             DecoderPtr decoder = mManager.getDecoder();
             decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
+            decoder->getInfo(&result.mSampleRate, &result.mChannelConfig, &result.mSampleType);
+            decoder->readAll(result.mData);
         }
         catch (std::exception& e)
         {
             Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+            result.mData.clear();
         }
 
-        if (data.empty())
+        return result;
+    }
+
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(DecodedSound&& sound)
+    {
+        getALError();
+
+        std::vector<char> data = std::move(sound.mData);
+        int srate = sound.mSampleRate;
+        ALenum format = AL_NONE;
+        if (!data.empty())
+            format = getALFormat(sound.mChannelConfig, sound.mSampleType);
+
+        if (data.empty() || !format)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
@@ -1106,6 +1111,25 @@ namespace MWSound
         return size;
     }
 
+    float OpenALOutput::getSoundDuration(Sound_Handle data)
+    {
+        ALuint buffer = GET_PTRID(data);
+        if (!buffer)
+            return 0;
+
+        ALint size = 0;
+        ALint frequency = 0;
+        ALint channels = 0;
+        ALint bits = 0;
+        alGetBufferi(buffer, AL_SIZE, &size);
+        alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+        alGetBufferi(buffer, AL_CHANNELS, &channels);
+        alGetBufferi(buffer, AL_BITS, &bits);
+        if (getALError() != AL_NO_ERROR || frequency <= 0 || channels <= 0 || bits <= 0)
+            return 0;
+        return static_cast<float>(size) * 8 / (channels * bits) / frequency;
+    }
+
     void OpenALOutput::initCommon2D(
         ALuint source, const osg::Vec3f& pos, ALfloat gain, ALfloat pitch, bool loop, bool useenv)
     {
@@ -1309,6 +1333,19 @@ namespace MWSound
         return state == AL_PLAYING || state == AL_PAUSED;
     }
 
+    float OpenALOutput::getSoundOffset(Sound* sound)
+    {
+        if (!sound->mHandle)
+            return 0;
+        ALuint source = GET_PTRID(sound->mHandle);
+        ALfloat offset = 0;
+
+        alGetSourcef(source, AL_SEC_OFFSET, &offset);
+        getALError();
+
+        return offset;
+    }
+
     void OpenALOutput::updateSound(Sound* sound)
     {
         if (!sound->mHandle)
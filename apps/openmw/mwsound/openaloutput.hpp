@@ -88,13 +88,16 @@ namespace MWSound
 
         std::vector<std::string> enumerateHrtf() override;
 
-        std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
+        DecodedSound decodeSound(VFS::Path::NormalizedView fname) override;
+        std::pair<Sound_Handle, size_t> loadSound(DecodedSound&& sound) override;
         size_t unloadSound(Sound_Handle data) override;
+        float getSoundDuration(Sound_Handle data) override;
 
         bool playSound(Sound* sound, Sound_Handle data, float offset) override;
         bool playSound3D(Sound* sound, Sound_Handle data, float offset) override;
         void finishSound(Sound* sound) override;
         bool isSoundPlaying(Sound* sound) override;
+        float getSoundOffset(Sound* sound) override;
         void updateSound(Sound* sound) override;
 
         bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) override;
@@ -2,6 +2,7 @@
 #define GAME_SOUND_SOUND_H
 
 #include <algorithm>
+#include <cmath>
 
 #include "soundoutput.hpp"
 
@@ -166,6 +167,7 @@ namespace MWSound
         bool getIsLooping() const { return mParams.mFlags & MWSound::PlayMode::Loop; }
         bool getDistanceCull() const { return mParams.mFlags & MWSound::PlayMode::RemoveAtDistance; }
         bool getIs3D() const { return mParams.mFlags & Play_3D; }
+        bool getIsTimeScaled() const { return !(mParams.mFlags & MWSound::PlayMode::NoScaling); }
         bool getInFade() const { return mParams.mFlags & Play_InFade; }
 
         void init(const SoundParams& params)
@@ -183,7 +185,42 @@ namespace MWSound
         Sound(const Sound&) = delete;
         Sound(Sound&&) = delete;
 
+        // A virtual sound is playing without an output source, only its playback position is tracked
+        bool mVirtual = false;
+        float mVirtualOffset = 0.0f;
+
     public:
+        bool getIsVirtual() const { return mVirtual; }
+        // Neither played by the output nor virtual, the sound is going to be removed on the next update
+        bool getIsStopped() const { return !mVirtual && mHandle == nullptr; }
+        float getVirtualOffset() const { return mVirtualOffset; }
+
+        void setVirtual(bool value, float offset = 0.0f)
+        {
+            mVirtual = value;
+            mVirtualOffset = offset;
+        }
+
+        /// Advances the playback position of a virtual sound.
+        ///
+        /// \return false if the sound has reached its end.
+        bool updateVirtual(float dt, float duration)
+        {
+            mVirtualOffset += dt;
+            if (mVirtualOffset < duration)
+                return true;
+            if (!getIsLooping())
+                return false;
+            mVirtualOffset = duration > 0.0f ? std::fmod(mVirtualOffset, duration) : 0.0f;
+            return true;
+        }
+
+        void init(const SoundParams& params)
+        {
+            SoundBase::init(params);
+            setVirtual(false);
+        }
+
         Sound() = default;
     };
 
@@ -9,11 +9,14 @@
 #include <components/esm4/loadsoun.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <utility>
 
 namespace MWSound
 {
@@ -38,11 +41,39 @@ namespace MWSound
         }
     }
 
+    class DecodeSoundWorkItem final : public SceneUtil::WorkItem
+    {
+    public:
+        DecodeSoundWorkItem(SoundOutput& output, const VFS::Path::Normalized& path)
+            : mOutput(output)
+            , mPath(path)
+        {
+        }
+
+        void doWork() override
+        {
+            if (claim())
+                mResult = mOutput.decodeSound(mPath);
+        }
+
+        // Returns false if the decoding is already started by another thread
+        bool claim() { return !mClaimed.exchange(true); }
+
+        DecodedSound& getResult() { return mResult; }
+
+    private:
+        SoundOutput& mOutput;
+        const VFS::Path::Normalized mPath;
+        std::atomic_bool mClaimed{ false };
+        DecodedSound mResult;
+    };
+
     SoundBufferPool::SoundBufferPool(SoundOutput& output)
         : mOutput(&output)
         , mBufferCacheMax(Settings::sound().mBufferCacheMax * 1024 * 1024)
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
+        , mDecodeQueue(new SceneUtil::WorkQueue(1))
     {
     }
 
@@ -80,11 +111,37 @@ namespace MWSound
         if (sfx->getHandle() != nullptr)
             return sfx;
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+        const auto start = std::chrono::steady_clock::now();
+        DecodedSound sound;
+        const auto it = mDecodings.find(sfx);
+        if (it == mDecodings.end())
+            sound = mOutput->decodeSound(sfx->getResourceName());
+        else
+        {
+            // Don't wait for the queued decodings of other sounds
+            const osg::ref_ptr<DecodeSoundWorkItem> item = std::move(it->second);
+            mDecodings.erase(it);
+            if (item->claim())
+                sound = mOutput->decodeSound(sfx->getResourceName());
+            else
+            {
+                item->waitTillDone();
+                sound = std::move(item->getResult());
+            }
+        }
+        mDecodeWait += std::chrono::steady_clock::now() - start;
+
+        return finishLoading(*sfx, std::move(sound));
+    }
+
+    SoundBuffer* SoundBufferPool::finishLoading(SoundBuffer& sfx, DecodedSound&& sound)
+    {
+        auto [handle, size] = mOutput->loadSound(std::move(sound));
         if (handle == nullptr)
             return {};
 
-        sfx->mHandle = handle;
+        sfx.mHandle = handle;
+        sfx.mDuration = mOutput->getSoundDuration(handle);
 
         mBufferCacheSize += size;
         if (mBufferCacheSize > mBufferCacheMax)
@@ -93,12 +150,13 @@ namespace MWSound
             if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
                 Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
         }
-        mUnusedBuffers.push_front(sfx);
+        if (sfx.mUses == 0)
+            addUnused(sfx);
 
-        return sfx;
+        return &sfx;
     }
 
-    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    SoundBuffer* SoundBufferPool::find(const ESM::RefId& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -111,19 +169,53 @@ namespace MWSound
                 insertSound(sound.mId, sound);
         }
 
-        SoundBuffer* sfx;
         const auto it = mBufferNameMap.find(soundId);
         if (it != mBufferNameMap.end())
-            sfx = it->second;
-        else
+            return it->second;
+
+        const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return {};
+        return insertSound(soundId, *sound);
+    }
+
+    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    {
+        SoundBuffer* sfx = find(soundId);
+        if (sfx == nullptr)
+            return {};
+
+        return loadSfx(sfx);
+    }
+
+    SoundBuffer* SoundBufferPool::loadAsync(const ESM::RefId& soundId)
+    {
+        SoundBuffer* sfx = find(soundId);
+        if (sfx == nullptr || sfx->getHandle() != nullptr || mDecodings.contains(sfx))
+            return sfx;
+
+        osg::ref_ptr<DecodeSoundWorkItem> item(new DecodeSoundWorkItem(*mOutput, sfx->getResourceName()));
+        mDecodeQueue->addWorkItem(item);
+        mDecodings.emplace(sfx, std::move(item));
+        return sfx;
+    }
+
+    void SoundBufferPool::update()
+    {
+        for (auto it = mDecodings.begin(); it != mDecodings.end();)
         {
-            const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
-            if (sound == nullptr)
-                return {};
-            sfx = insertSound(soundId, *sound);
+            if (!it->second->isDone())
+            {
+                ++it;
+                continue;
+            }
+            finishLoading(*it->first, std::move(it->second->getResult()));
+            it = mDecodings.erase(it);
         }
 
-        return loadSfx(sfx);
+        mStats.mDecoding = mDecodings.size();
+        mStats.mCacheSize = mBufferCacheSize;
+        mStats.mDecodeWait = std::exchange(mDecodeWait, {});
     }
 
     SoundBuffer* SoundBufferPool::load(std::string_view fileName)
@@ -142,16 +234,23 @@ namespace MWSound
 
     void SoundBufferPool::clear()
     {
+        for (auto& [sfx, item] : mDecodings)
+            if (!item->claim())
+                item->waitTillDone();
+        mDecodings.clear();
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
+            sfx.mUnused = false;
         }
 
         mBufferFileNameMap.clear();
         mBufferNameMap.clear();
         mUnusedBuffers.clear();
+        mBufferCacheSize = 0;
     }
 
     SoundBuffer* SoundBufferPool::insertSound(std::string_view fileName)
@@ -228,6 +327,7 @@ namespace MWSound
 
             mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
             unused->mHandle = nullptr;
+            unused->mUnused = false;
 
             mUnusedBuffers.pop_back();
         }
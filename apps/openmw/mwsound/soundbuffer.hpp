@@ -1,11 +1,14 @@
 #ifndef GAME_SOUND_SOUNDBUFFER_H
 #define GAME_SOUND_SOUNDBUFFER_H
 
-#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <list>
 #include <string>
 #include <unordered_map>
 
+#include <osg/ref_ptr>
+
 #include <components/esm/refid.hpp>
 
 #include "soundoutput.hpp"
@@ -26,9 +29,15 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
+    class DecodeSoundWorkItem;
 
     class SoundBuffer
     {
@@ -52,17 +61,31 @@ namespace MWSound
 
         float getMaxDist() const noexcept { return mMaxDist; }
 
+        // Playback duration in seconds at normal pitch, valid only when the buffer is loaded
+        float getDuration() const noexcept { return mDuration; }
+
     private:
         VFS::Path::Normalized mResourceName;
         float mVolume;
         float mMinDist;
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
+        float mDuration = 0;
         std::size_t mUses = 0;
+        bool mUnused = false;
+        std::list<SoundBuffer*>::iterator mUnusedPosition;
 
         friend class SoundBufferPool;
     };
 
+    struct SoundBufferStats
+    {
+        std::size_t mDecoding = 0;
+        std::size_t mCacheSize = 0;
+        // Time spent in the last frame waiting for sounds to be decoded
+        std::chrono::steady_clock::duration mDecodeWait{};
+    };
+
     class SoundBufferPool
     {
     public:
@@ -87,27 +110,44 @@ namespace MWSound
         // Lookup for a sound by file name, and ensure it's ready for use.
         SoundBuffer* load(std::string_view fileName);
 
+        /// Lookup a soundId and start decoding it in background if it's not loaded yet. The returned buffer can be
+        /// played once it has a handle, load() finishes a pending decoding without waiting for other ones.
+        SoundBuffer* loadAsync(const ESM::RefId& soundId);
+
+        /// Load buffers for the finished background decodings, call once per frame.
+        void update();
+
         void use(SoundBuffer& sfx)
         {
-            if (sfx.mUses++ == 0)
+            if (sfx.mUses++ == 0 && sfx.mUnused)
             {
-                const auto it = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), &sfx);
-                if (it != mUnusedBuffers.end())
-                    mUnusedBuffers.erase(it);
+                mUnusedBuffers.erase(sfx.mUnusedPosition);
+                sfx.mUnused = false;
             }
         }
 
         void release(SoundBuffer& sfx)
         {
             if (--sfx.mUses == 0)
-                mUnusedBuffers.push_front(&sfx);
+                addUnused(sfx);
         }
 
         void clear();
 
+        const SoundBufferStats& getStats() const { return mStats; }
+
     private:
         SoundBuffer* loadSfx(SoundBuffer* sfx);
 
+        SoundBuffer* finishLoading(SoundBuffer& sfx, DecodedSound&& sound);
+
+        void addUnused(SoundBuffer& sfx)
+        {
+            mUnusedBuffers.push_front(&sfx);
+            sfx.mUnusedPosition = mUnusedBuffers.begin();
+            sfx.mUnused = true;
+        }
+
         SoundOutput* mOutput;
         std::deque<SoundBuffer> mSoundBuffers;
         std::unordered_map<ESM::RefId, SoundBuffer*> mBufferNameMap;
@@ -116,7 +156,13 @@ namespace MWSound
         std::size_t mBufferCacheMin;
         std::size_t mBufferCacheSize = 0;
         // NOTE: unused buffers are stored in front-newest order.
-        std::deque<SoundBuffer*> mUnusedBuffers;
+        std::list<SoundBuffer*> mUnusedBuffers;
+        osg::ref_ptr<SceneUtil::WorkQueue> mDecodeQueue;
+        std::unordered_map<SoundBuffer*, osg::ref_ptr<DecodeSoundWorkItem>> mDecodings;
+        std::chrono::steady_clock::duration mDecodeWait{};
+        SoundBufferStats mStats;
+
+        SoundBuffer* find(const ESM::RefId& soundId);
 
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM::Sound& sound);
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::Sound& sound);
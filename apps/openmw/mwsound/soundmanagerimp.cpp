@@ -4,10 +4,14 @@
 #include <map>
 #include <numeric>
 #include <sstream>
+#include <unordered_set>
 
 #include <osg/Matrixf>
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
+#include <components/esm3/loadcrea.hpp>
+#include <components/esm3/loadsndg.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/settings/values.hpp>
@@ -41,6 +45,32 @@ namespace MWSound
         constexpr float sSfxFadeInDuration = 1.0f;
         constexpr float sSfxFadeOutDuration = 1.0f;
         constexpr float sSoundCullDistance = 2000.f;
+        // Sounds of objects further than sSoundCullDistance are updated less often
+        constexpr float sFarUpdateInterval = 0.1f;
+        // Sounds of objects further than their max distance are inaudible and updated even less often
+        constexpr float sInaudibleUpdateInterval = 0.5f;
+        // Sounds playing on the output get a higher priority to not switch between sounds with similar audibility
+        constexpr float sRealVoicePriorityFactor = 1.25f;
+
+        // Sounds played by most NPCs while moving and fighting
+        constexpr std::string_view sNpcSounds[] = {
+            "FootBareLeft",
+            "FootBareRight",
+            "footLightLeft",
+            "footLightRight",
+            "FootMedLeft",
+            "FootMedRight",
+            "footHeavyLeft",
+            "footHeavyRight",
+            "Health Damage",
+            "Weapon Swish",
+            "Hand To Hand Hit",
+            "Hand To Hand Hit 2",
+            "Light Armor Hit",
+            "Medium Armor Hit",
+            "Heavy Armor Hit",
+            "critical damage",
+        };
 
         WaterSoundUpdaterSettings makeWaterSoundUpdaterSettings()
         {
@@ -75,6 +105,25 @@ namespace MWSound
             return 1.0;
         }
 
+        float getUpdateInterval(float squaredDist, float maxDist)
+        {
+            if (squaredDist > maxDist * maxDist)
+                return sInaudibleUpdateInterval;
+            if (squaredDist > sSoundCullDistance * sSoundCullDistance)
+                return sFarUpdateInterval;
+            return 0.0f;
+        }
+
+        // Approximates the gain at the listener position using the distance model of the output
+        float getAudibility(const SoundBase& sound, const osg::Vec3f& listenerPos)
+        {
+            const float distance = (sound.getPosition() - listenerPos).length();
+            if (distance > sound.getMaxDistance())
+                return 0.0f;
+            const float minDistance = sound.getMinDistance();
+            return sound.getRealVolume() * minDistance / std::max(distance, minDistance);
+        }
+
         // Gets the combined volume settings for the given sound type
         float volumeFromType(Type type)
         {
@@ -330,7 +379,7 @@ namespace MWSound
         if (!sound)
             return;
 
-        mSaySoundsQueue.emplace(ptr.mRef, SaySound{ ptr.mCell, std::move(sound) });
+        mSaySoundsQueue.emplace(ptr.mRef, SaySound{ ptr.mCell, std::move(sound), 0.0f });
     }
 
     float SoundManager::getSaySoundLoudness(const MWWorld::ConstPtr& ptr) const
@@ -359,7 +408,7 @@ namespace MWSound
         if (!sound)
             return;
 
-        mActiveSaySounds.emplace(nullptr, SaySound{ nullptr, std::move(sound) });
+        mActiveSaySounds.emplace(nullptr, SaySound{ nullptr, std::move(sound), 0.0f });
     }
 
     bool SoundManager::sayDone(const MWWorld::ConstPtr& ptr) const
@@ -556,7 +605,13 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             }());
+            // Keep playing without a source when all of them are used, voices are rebalanced on the next update
             played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
+            if (!played && offset < sfx->getDuration())
+            {
+                sound->setVirtual(true, offset);
+                played = true;
+            }
         }
         if (!played)
             return nullptr;
@@ -564,7 +619,7 @@ namespace MWSound
         Sound* result = sound.get();
         auto it = mActiveSounds.find(ptr.mRef);
         if (it == mActiveSounds.end())
-            it = mActiveSounds.emplace(ptr.mRef, ActiveSound{ ptr.mCell, {} }).first;
+            it = mActiveSounds.emplace(ptr.mRef, ActiveSound{ ptr.mCell, {}, 0.0f }).first;
         it->second.mList.emplace_back(std::move(sound), sfx);
         mSoundBuffers.use(*sfx);
         return result;
@@ -629,7 +684,11 @@ namespace MWSound
             return params;
         }());
         if (!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
-            return nullptr;
+        {
+            if (offset >= sfx->getDuration())
+                return nullptr;
+            sound->setVirtual(true, offset);
+        }
 
         Sound* result = sound.get();
         mActiveSounds[nullptr].mList.emplace_back(std::move(sound), sfx);
@@ -640,9 +699,22 @@ namespace MWSound
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
+            finishSound(sound);
+    }
+
+    void SoundManager::finishSound(Sound* sound)
+    {
+        if (sound->getIsVirtual())
+            sound->setVirtual(false);
+        else
             mOutput->finishSound(sound);
     }
 
+    bool SoundManager::isSoundPlaying(Sound* sound) const
+    {
+        return sound->getIsVirtual() || mOutput->isSoundPlaying(sound);
+    }
+
     void SoundManager::stopSound(SoundBuffer* sfx, const MWWorld::ConstPtr& ptr)
     {
         SoundMap::iterator snditer = mActiveSounds.find(ptr.mRef);
@@ -651,7 +723,7 @@ namespace MWSound
             for (SoundBufferRefPair& snd : snditer->second.mList)
             {
                 if (snd.second == sfx)
-                    mOutput->finishSound(snd.first.get());
+                    finishSound(snd.first.get());
             }
         }
     }
@@ -687,7 +759,7 @@ namespace MWSound
         if (snditer != mActiveSounds.end())
         {
             for (SoundBufferRefPair& snd : snditer->second.mList)
-                mOutput->finishSound(snd.first.get());
+                finishSound(snd.first.get());
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr.mRef);
         if (sayiter != mSaySoundsQueue.end())
@@ -704,7 +776,7 @@ namespace MWSound
             if (ref != nullptr && ref != MWMechanics::getPlayer().mRef && sound.mCell == cell)
             {
                 for (SoundBufferRefPair& sndbuf : sound.mList)
-                    mOutput->finishSound(sndbuf.first.get());
+                    finishSound(sndbuf.first.get());
             }
         }
 
@@ -721,6 +793,37 @@ namespace MWSound
         }
     }
 
+    void SoundManager::preloadActorSounds(MWWorld::CellStore& cell)
+    {
+        if (!mOutput->isInitialized())
+            return;
+
+        std::unordered_set<ESM::RefId> creatures;
+        cell.forEachType<ESM::Creature>([&](const MWWorld::Ptr& ptr) {
+            const ESM::Creature& creature = *ptr.get<ESM::Creature>()->mBase;
+            creatures.insert(creature.mOriginal.empty() ? ptr.getCellRef().getRefId() : creature.mOriginal);
+            return true;
+        });
+
+        bool hasNpcs = false;
+        cell.forEachType<ESM::NPC>([&](const MWWorld::Ptr&) {
+            hasNpcs = true;
+            return false;
+        });
+
+        if (!creatures.empty())
+        {
+            const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+            for (const ESM::SoundGenerator& sound : store.get<ESM::SoundGenerator>())
+                if (creatures.contains(sound.mCreature))
+                    mSoundBuffers.loadAsync(sound.mSound);
+        }
+
+        if (hasNpcs)
+            for (std::string_view sound : sNpcSounds)
+                mSoundBuffers.loadAsync(ESM::RefId::stringRefId(sound));
+    }
+
     void SoundManager::fadeOutSound3D(const MWWorld::ConstPtr& ptr, const ESM::RefId& soundId, float duration)
     {
         SoundMap::iterator snditer = mActiveSounds.find(ptr.mRef);
@@ -750,7 +853,7 @@ namespace MWSound
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx && isSoundPlaying(snd.first.get());
                        })
                 != snditer->second.mList.cend();
         }
@@ -768,7 +871,7 @@ namespace MWSound
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx && isSoundPlaying(snd.first.get());
                        })
                 != snditer->second.mList.cend();
         }
@@ -830,7 +933,7 @@ namespace MWSound
 
         if (!cell->isExterior() && !cell->isQuasiExterior())
             return;
-        if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
+        if (mCurrentRegionSound && isSoundPlaying(mCurrentRegionSound))
             return;
 
         ESM::RefId next = mRegionSoundSelector.getNextRandom(duration, cell->getRegion());
@@ -863,7 +966,7 @@ namespace MWSound
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -930,6 +1033,65 @@ namespace MWSound
         }
     }
 
+    bool SoundManager::updateVirtualSound(Sound& sound, const SoundBuffer& sfx, float duration, int pausedTypes) const
+    {
+        if (pausedTypes & sound.getPlayType())
+            return true;
+        float pitch = sound.getPitch();
+        if (sound.getIsTimeScaled())
+            pitch *= getSimulationTimeScale();
+        return sound.updateVirtual(duration * pitch, sfx.getDuration());
+    }
+
+    int SoundManager::getPausedSoundTypes() const
+    {
+        int result = 0;
+        for (int types : mPausedSoundTypes)
+            result |= types;
+        return result;
+    }
+
+    void SoundManager::updateVoices(int pausedTypes)
+    {
+        for (Voice& voice : mVoices)
+        {
+            voice.mPriority = getAudibility(*voice.mSound, mListenerPos);
+            if (!voice.mSound->getIsVirtual())
+                voice.mPriority *= sRealVoicePriorityFactor;
+        }
+
+        const std::size_t maxRealVoices = static_cast<std::size_t>(Settings::sound().mMaxRealVoices.get());
+        const auto lastReal = mVoices.begin() + std::min(maxRealVoices, mVoices.size());
+        std::nth_element(mVoices.begin(), lastReal, mVoices.end(),
+            [](const Voice& l, const Voice& r) { return l.mPriority > r.mPriority; });
+
+        // Release the sources first to reuse them for the more audible sounds
+        for (auto it = lastReal; it != mVoices.end(); ++it)
+        {
+            Sound* sound = it->mSound;
+            if (sound->getIsVirtual() || !mOutput->isSoundPlaying(sound))
+                continue;
+            const float offset = mOutput->getSoundOffset(sound);
+            mOutput->finishSound(sound);
+            sound->setVirtual(true, offset);
+        }
+
+        for (auto it = mVoices.begin(); it != lastReal; ++it)
+        {
+            Sound* sound = it->mSound;
+            if (!sound->getIsVirtual() || it->mPriority <= 0.0f || (pausedTypes & sound->getPlayType()))
+                continue;
+            // No more free sources, try again on the next update
+            if (!mOutput->playSound3D(sound, it->mBuffer->getHandle(), sound->getVirtualOffset()))
+                break;
+            sound->setVirtual(false);
+        }
+
+        mVirtualVoices = static_cast<std::size_t>(std::count_if(
+            mVoices.begin(), mVoices.end(), [](const Voice& voice) { return voice.mSound->getIsVirtual(); }));
+        mRealVoices = mVoices.size() - mVirtualVoices;
+    }
+
     void SoundManager::updateSounds(float duration)
     {
         // We update active say sounds map for specific actors here
@@ -956,7 +1118,7 @@ namespace MWSound
             env = Env_Underwater;
         else if (mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -965,13 +1127,36 @@ namespace MWSound
 
         updateMusic(duration);
 
+        MWBase::World* world = MWBase::Environment::get().getWorld();
+        const int pausedTypes = getPausedSoundTypes();
+
         // Check if any sounds are finished playing, and trash them
+        mVoices.clear();
         SoundMap::iterator snditer = mActiveSounds.begin();
         while (snditer != mActiveSounds.end())
         {
             MWWorld::ConstPtr ptr = snditer->first;
-            SoundBufferRefPairList::iterator sndidx = snditer->second.mList.begin();
-            while (sndidx != snditer->second.mList.end())
+            ActiveSound& activeSound = snditer->second;
+            activeSound.mPendingDuration += duration;
+            if (!ptr.isEmpty())
+            {
+                float maxDist = 0.0f;
+                for (const SoundBufferRefPair& snd : activeSound.mList)
+                    maxDist = std::max(maxDist, snd.first->getMaxDistance());
+                const float squaredDist = (mListenerPos - ptr.getRefData().getPosition().asVec3()).length2();
+                if (activeSound.mPendingDuration < getUpdateInterval(squaredDist, maxDist))
+                {
+                    for (const SoundBufferRefPair& snd : activeSound.mList)
+                        if (snd.first->getIs3D() && !snd.first->getIsStopped())
+                            mVoices.push_back(Voice{ snd.first.get(), snd.second, 0.0f });
+                    ++snditer;
+                    continue;
+                }
+            }
+            const float elapsed = std::exchange(activeSound.mPendingDuration, 0.0f);
+
+            SoundBufferRefPairList::iterator sndidx = activeSound.mList.begin();
+            while (sndidx != activeSound.mList.end())
             {
                 Sound* sound = sndidx->first.get();
 
@@ -979,58 +1164,77 @@ namespace MWSound
                 {
                     if (!ptr.isEmpty())
                     {
+                        // The position of a distant object has changed during the skipped updates
+                        const float dt = elapsed > duration ? elapsed : world->getPhysicsFrameRateDt();
                         sound->setLastPosition(sound->getPosition());
                         sound->setPosition(ptr.getRefData().getPosition().asVec3());
-                        MWBase::World* world = MWBase::Environment::get().getWorld();
-                        sound->setVelocity(
-                            (sound->getPosition() - sound->getLastPosition()) / world->getPhysicsFrameRateDt());
+                        sound->setVelocity((sound->getPosition() - sound->getLastPosition()) / dt);
                     }
 
                     cull3DSound(sound);
                 }
 
-                if (!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
+                const bool playing = sound->getIsVirtual()
+                    ? updateVirtualSound(*sound, *sndidx->second, elapsed, pausedTypes)
+                    : mOutput->isSoundPlaying(sound);
+                if (!sound->updateFade(elapsed) || !playing)
                 {
-                    mOutput->finishSound(sound);
+                    finishSound(sound);
                     if (sound == mUnderwaterSound)
                         mUnderwaterSound = nullptr;
                     if (sound == mNearWaterSound)
                         mNearWaterSound = nullptr;
                     mSoundBuffers.release(*sndidx->second);
-                    sndidx = snditer->second.mList.erase(sndidx);
+                    sndidx = activeSound.mList.erase(sndidx);
                 }
                 else
                 {
                     mOutput->updateSound(sound);
+                    if (sound->getIs3D())
+                        mVoices.push_back(Voice{ sound, sndidx->second, 0.0f });
                     ++sndidx;
                 }
             }
-            if (snditer->second.mList.empty())
+            if (activeSound.mList.empty())
                 snditer = mActiveSounds.erase(snditer);
             else
                 ++snditer;
         }
 
+        updateVoices(pausedTypes);
+
         SaySoundMap::iterator sayiter = mActiveSaySounds.begin();
         while (sayiter != mActiveSaySounds.end())
         {
             MWWorld::ConstPtr ptr = sayiter->first;
-            Stream* sound = sayiter->second.mStream.get();
+            SaySound& saySound = sayiter->second;
+            Stream* sound = saySound.mStream.get();
+            saySound.mPendingDuration += duration;
+            if (!ptr.isEmpty() && sound->getIs3D())
+            {
+                const float squaredDist = (mListenerPos - sound->getPosition()).length2();
+                if (saySound.mPendingDuration < getUpdateInterval(squaredDist, sound->getMaxDistance()))
+                {
+                    ++sayiter;
+                    continue;
+                }
+            }
+            const float elapsed = std::exchange(saySound.mPendingDuration, 0.0f);
+
             if (sound->getIs3D())
             {
                 if (!ptr.isEmpty())
                 {
+                    const float dt = elapsed > duration ? elapsed : world->getPhysicsFrameRateDt();
                     sound->setLastPosition(sound->getPosition());
-                    MWBase::World* world = MWBase::Environment::get().getWorld();
                     sound->setPosition(world->getActorHeadTransform(ptr).getTrans());
-                    sound->setVelocity(
-                        (sound->getPosition() - sound->getLastPosition()) / world->getPhysicsFrameRateDt());
+                    sound->setVelocity((sound->getPosition() - sound->getLastPosition()) / dt);
                 }
 
                 cull3DSound(sound);
             }
 
-            if (!sound->updateFade(duration) || !mOutput->isStreamPlaying(sound))
+            if (!sound->updateFade(elapsed) || !mOutput->isStreamPlaying(sound))
             {
                 mOutput->finishStream(sound);
                 sayiter = mActiveSaySounds.erase(sayiter);
@@ -1094,6 +1298,8 @@ namespace MWSound
         if (!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
+
         MWBase::StateManager::State state = MWBase::Environment::get().getStateManager()->getState();
         bool isMainMenu = MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_MainMenu)
             && state == MWBase::StateManager::State_NoGame;
@@ -1112,6 +1318,17 @@ namespace MWSound
         }
     }
 
+    void SoundManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        const SoundBufferStats& bufferStats = mSoundBuffers.getStats();
+        stats.setAttribute(frameNumber, "SoundBuffer Decoding", bufferStats.mDecoding);
+        stats.setAttribute(frameNumber, "SoundBuffer CacheSize", bufferStats.mCacheSize);
+        stats.setAttribute(frameNumber, "SoundBuffer DecodeWait",
+            std::chrono::duration<double, std::milli>(bufferStats.mDecodeWait).count());
+        stats.setAttribute(frameNumber, "Sound RealVoices", mRealVoices);
+        stats.setAttribute(frameNumber, "Sound VirtualVoices", mVirtualVoices);
+    }
+
     void SoundManager::processChangedSettings(const Settings::CategorySettingVector& settings)
     {
         if (!mOutput->isInitialized())
@@ -1278,7 +1495,7 @@ namespace MWSound
         {
             for (SoundBufferRefPair& sndbuf : snd.second.mList)
             {
-                mOutput->finishSound(sndbuf.first.get());
+                finishSound(sndbuf.first.get());
                 mSoundBuffers.release(*sndbuf.second);
             }
         }
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/fallback/fallback.hpp>
 #include <components/misc/objectpool.hpp>
@@ -35,6 +36,11 @@ namespace MWWorld
     class Cell;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWSound
 {
     class SoundOutput;
@@ -67,6 +73,8 @@ namespace MWSound
         {
             const MWWorld::CellStore* mCell = nullptr;
             SoundBufferRefPairList mList;
+            // Time passed since the last update of the sounds
+            float mPendingDuration = 0.0f;
         };
 
         typedef std::map<const MWWorld::LiveCellRefBase*, ActiveSound> SoundMap;
@@ -76,6 +84,7 @@ namespace MWSound
         {
             const MWWorld::CellStore* mCell;
             StreamPtr mStream;
+            float mPendingDuration;
         };
 
         typedef std::map<const MWWorld::LiveCellRefBase*, SaySound> SaySoundMap;
@@ -85,6 +94,18 @@ namespace MWSound
         typedef std::vector<StreamPtr> TrackList;
         TrackList mActiveTracks;
 
+        struct Voice
+        {
+            Sound* mSound;
+            SoundBuffer* mBuffer;
+            float mPriority;
+        };
+
+        // 3D sounds competing for the output sources, collected on each update
+        std::vector<Voice> mVoices;
+        std::size_t mRealVoices = 0;
+        std::size_t mVirtualVoices = 0;
+
         StreamPtr mMusic;
         MusicType mMusicType;
 
@@ -132,7 +153,13 @@ namespace MWSound
         Sound* playSound3D(const MWWorld::ConstPtr& ptr, SoundBuffer* sfx, float volume, float pitch, Type type,
             PlayMode mode, float offset);
 
+        void finishSound(Sound* sound);
+        bool isSoundPlaying(Sound* sound) const;
+        bool updateVirtualSound(Sound& sound, const SoundBuffer& sfx, float duration, int pausedTypes) const;
+        int getPausedSoundTypes() const;
+
         void updateSounds(float duration);
+        void updateVoices(int pausedTypes);
         void updateRegionSound(float duration);
         void updateWaterSound();
         void updateMusic(float duration);
@@ -258,6 +285,9 @@ namespace MWSound
         void stopSound(const MWWorld::CellStore* cell) override;
         ///< Stop all sounds for the given cell.
 
+        void preloadActorSounds(MWWorld::CellStore& cell) override;
+        ///< Start decoding in background the sounds actors in the given cell are likely to play.
+
         void fadeOutSound3D(const MWWorld::ConstPtr& reference, const ESM::RefId& soundId, float duration) override;
         ///< Fade out given sound (that is already playing) of given object
         ///< @param reference Reference to object, whose sound is faded out
@@ -281,6 +311,8 @@ namespace MWSound
 
         void update(float duration);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void setListenerPosDir(
             const osg::Vec3f& pos, const osg::Vec3f& dir, const osg::Vec3f& up, bool underwater) override;
 
@@ -10,6 +10,8 @@
 
 #include "../mwbase/soundmanager.hpp"
 
+#include "sounddecoder.hpp"
+
 namespace MWSound
 {
     class SoundManager;
@@ -30,6 +32,15 @@ namespace MWSound
 
     using HrtfMode = Settings::HrtfMode;
 
+    // Audio data of a whole file, decoded but not yet loaded into a buffer
+    struct DecodedSound
+    {
+        std::vector<char> mData;
+        int mSampleRate = 0;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+    };
+
     class SoundOutput
     {
         SoundManager& mManager;
@@ -40,13 +51,17 @@ namespace MWSound
 
         virtual std::vector<std::string> enumerateHrtf() = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) = 0;
+        // Thread safe, doesn't use the device. Returns empty data on failure.
+        virtual DecodedSound decodeSound(VFS::Path::NormalizedView fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(DecodedSound&& sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
+        virtual float getSoundDuration(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
         virtual bool playSound3D(Sound* sound, Sound_Handle data, float offset) = 0;
         virtual void finishSound(Sound* sound) = 0;
         virtual bool isSoundPlaying(Sound* sound) = 0;
+        virtual float getSoundOffset(Sound* sound) = 0;
         virtual void updateSound(Sound* sound) = 0;
 
         virtual bool streamSound(DecoderPtr decoder, Stream* sound, bool getLoudnessData = false) = 0;
@@ -9,6 +9,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/defs.hpp>
+#include <components/esm3/compressedsavedgame.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/utf8stream.hpp>
@@ -46,7 +47,7 @@ void MWState::Character::addSlot(const std::filesystem::path& path, const std::s
     slot.mTimeStamp = std::filesystem::last_write_time(path);
 
     ESM::ESMReader reader;
-    reader.open(slot.mPath);
+    ESM::openSavedGameProfile(reader, slot.mPath);
 
     if (reader.getRecName() != ESM::REC_SAVE)
         return; // invalid save file -> ignore
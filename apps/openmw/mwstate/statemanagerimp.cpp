@@ -1,11 +1,17 @@
 #include "statemanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <thread>
 
 #include <SDL_clipboard.h>
 
 #include <components/debug/debuglog.hpp>
 
+#include <components/esm3/compressedsavedgame.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadcell.hpp>
@@ -49,8 +55,56 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    std::size_t getSavedGameThreads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Write to a temporary file first and replace the saved game only when it's complete, so a failed or interrupted
+    // write doesn't trash the existing save file. Returns the buffer so it can be reused.
+    std::string writeSaveFile(std::string data, const std::filesystem::path& path, bool compress)
+    {
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+
+        try
+        {
+            std::ofstream filestream(temporary, std::ios::binary);
+            if (compress)
+                ESM::writeCompressedSavedGame(data, filestream, getSavedGameThreads());
+            else
+                filestream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            filestream.close();
+
+            if (filestream.fail())
+                throw std::runtime_error(
+                    "Write operation failed (file stream): " + std::generic_category().message(errno));
+
+            std::filesystem::rename(temporary, path);
+        }
+        catch (...)
+        {
+            std::error_code ec;
+            std::filesystem::remove(temporary, ec);
+            throw;
+        }
+
+        data.clear();
+        return data;
+    }
+
+    float getDurationMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point finish)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count();
+    }
+}
+
 void MWState::StateManager::cleanup(bool force)
 {
+    finishPendingSave(true);
+
     if (mState != State_NoGame || force)
     {
         MWBase::Environment::get().getSoundManager()->clear();
@@ -107,6 +161,22 @@ MWState::StateManager::StateManager(const std::filesystem::path& saves, const st
 {
 }
 
+MWState::StateManager::~StateManager()
+{
+    if (!mPendingSave.has_value())
+        return;
+
+    // Window manager may be already destroyed, only log the failure
+    try
+    {
+        mPendingSave->mResult.get();
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Error) << "Failed to save game: " << e.what();
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
     mQuitRequest = true;
@@ -213,6 +283,9 @@ void MWState::StateManager::resumeGame()
 
 void MWState::StateManager::saveGame(std::string_view description, const Slot* slot)
 {
+    // Slot paths are chosen by existence of files, the previous save has to be on disk first
+    finishPendingSave(true);
+
     MWBase::Environment::get().getLuaManager()->applyDelayedActions();
 
     MWState::Character* character = getCurrentCharacter();
@@ -272,9 +345,10 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
 
         Log(Debug::Info) << "Writing saved game '" << description << "' for character '" << profile.mPlayerName << "'";
 
-        // Write to a memory stream first. If there is an exception during the save process, we don't want to trash the
-        // existing save file we are overwriting.
-        std::stringstream stream;
+        // Serialize to a memory buffer on the main thread, the file is written in background. The buffer of the
+        // previous save is reused, so its memory is already allocated.
+        mSaveBuffer.clear();
+        std::stringstream stream(std::move(mSaveBuffer));
 
         ESM::ESMWriter writer;
 
@@ -335,40 +409,70 @@ void MWState::StateManager::saveGame(std::string_view description, const Slot* s
             throw std::runtime_error(
                 "Write operation failed (memory stream): " + std::generic_category().message(errno));
 
-        // All good, write to file
-        std::ofstream filestream(slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream): " + std::generic_category().message(errno));
+        const auto snapshot = std::chrono::steady_clock::now();
 
-        Settings::saves().mCharacter.set(Files::pathToUnicodeString(slot->mPath.parent_path().filename()));
-        mLastSavegame = slot->mPath;
+        Log(Debug::Info) << '\'' << description << "' is serialized in " << getDurationMs(start, snapshot) << "ms";
 
-        const auto finish = std::chrono::steady_clock::now();
-
-        Log(Debug::Info) << '\'' << description << "' is saved in "
-                         << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count()
-                         << "ms";
+        mPendingSave = PendingSave{
+            .mResult = std::async(std::launch::async, writeSaveFile, std::move(stream).str(), slot->mPath,
+                Settings::saves().mCompress.get()),
+            .mCharacter = character,
+            .mSlot = slot,
+            .mDescription = std::string(description),
+            .mStart = start,
+        };
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
+        reportSaveError(e, character, slot);
+    }
+}
 
-        Log(Debug::Error) << error.str();
+void MWState::StateManager::reportSaveError(const std::exception& e, Character* character, const Slot* slot)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << e.what();
 
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{Interface:OK}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+    Log(Debug::Error) << error.str();
 
-        // If no file was written, clean up the slot
-        if (character && slot && !std::filesystem::exists(slot->mPath))
-        {
-            character->deleteSlot(slot);
-            character->cleanup();
-        }
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{Interface:OK}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+    // If no file was written, clean up the slot
+    if (character && slot && !std::filesystem::exists(slot->mPath))
+    {
+        character->deleteSlot(slot);
+        character->cleanup();
+    }
+}
+
+void MWState::StateManager::finishPendingSave(bool wait)
+{
+    if (!mPendingSave.has_value())
+        return;
+
+    if (!wait && mPendingSave->mResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    PendingSave save = std::move(*mPendingSave);
+    mPendingSave.reset();
+
+    try
+    {
+        mSaveBuffer = save.mResult.get();
     }
+    catch (const std::exception& e)
+    {
+        reportSaveError(e, save.mCharacter, save.mSlot);
+        return;
+    }
+
+    Settings::saves().mCharacter.set(Files::pathToUnicodeString(save.mSlot->mPath.parent_path().filename()));
+    mLastSavegame = save.mSlot->mPath;
+
+    Log(Debug::Info) << '\'' << save.mDescription << "' is saved in "
+                     << getDurationMs(save.mStart, std::chrono::steady_clock::now()) << "ms";
 }
 
 void MWState::StateManager::quickSave(std::string name)
@@ -460,7 +564,7 @@ void MWState::StateManager::loadGame(const Character* character, const std::file
         Log(Debug::Info) << "Reading save file " << filepath.filename();
 
         ESM::ESMReader reader;
-        reader.open(filepath);
+        ESM::openSavedGame(reader, filepath, getSavedGameThreads());
 
         ESM::FormatVersion version = reader.getFormatVersion();
         if (version > ESM::CurrentSaveGameFormatVersion)
@@ -706,6 +810,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character* character, const MWState::Slot* slot)
 {
+    finishPendingSave(true);
+
     const std::filesystem::path savePath = slot->mPath;
     mCharacterManager.deleteSlot(slot, character);
     if (mLastSavegame == savePath)
@@ -736,6 +842,8 @@ void MWState::StateManager::update(float duration)
 {
     mTimePlayed += duration;
 
+    finishPendingSave(false);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -1,8 +1,13 @@
 #ifndef GAME_STATE_STATEMANAGER_H
 #define GAME_STATE_STATEMANAGER_H
 
+#include <chrono>
+#include <exception>
 #include <filesystem>
+#include <future>
 #include <map>
+#include <optional>
+#include <string>
 
 #include "../mwbase/statemanager.hpp"
 
@@ -21,6 +26,19 @@ namespace MWState
         double mTimePlayed;
         std::filesystem::path mLastSavegame;
 
+        struct PendingSave
+        {
+            std::future<std::string> mResult;
+            Character* mCharacter;
+            const Slot* mSlot;
+            std::string mDescription;
+            std::chrono::steady_clock::time_point mStart;
+        };
+
+        std::optional<PendingSave> mPendingSave;
+        // Reused between saves to avoid growing a new buffer for each one
+        std::string mSaveBuffer;
+
     private:
         void cleanup(bool force = false);
 
@@ -32,9 +50,18 @@ namespace MWState
 
         std::map<int, int> buildContentFileIndexMap(const ESM::ESMReader& reader) const;
 
+        void reportSaveError(const std::exception& e, Character* character, const Slot* slot);
+
+        void finishPendingSave(bool wait);
+        ///< Handle the result of a saved game written in background.
+        ///
+        /// \param wait Block until the file is written, otherwise return if it's not done yet.
+
     public:
         StateManager(const std::filesystem::path& saves, const std::vector<std::string>& contentFiles);
 
+        ~StateManager() override;
+
         void requestQuit() override;
 
         bool hasQuitRequest() const override;
@@ -91,6 +118,9 @@ namespace MWState
         CharacterIterator characterEnd() override;
 
         void update(float duration);
+
+        void waitForPendingSave() { finishPendingSave(true); }
+        ///< Block until a saved game being written in background is on disk.
     };
 }
 
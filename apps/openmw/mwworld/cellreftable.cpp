@@ -0,0 +1,67 @@
+#include "cellreftable.hpp"
+
+#include <components/esm3/cellref.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace MWWorld
+{
+    void CellRefTable::add(int cellX, int cellY, const ESM::CellRef& ref, bool deleted)
+    {
+        mPending.push_back(PendingRef{
+            .mX = cellX,
+            .mY = cellY,
+            .mRef = Ref{
+                .mRefNum = ref.mRefNum,
+                .mRefId = ref.mRefID,
+                .mPos = ref.mPos,
+                .mScale = ref.mScale,
+                .mDeleted = deleted,
+            },
+        });
+    }
+
+    void CellRefTable::finalize()
+    {
+        std::stable_sort(mPending.begin(), mPending.end(), [](const PendingRef& l, const PendingRef& r) {
+            return std::tie(l.mX, l.mY) < std::tie(r.mX, r.mY);
+        });
+
+        mRefs.reserve(mPending.size());
+
+        for (const PendingRef& pending : mPending)
+        {
+            if (mCells.empty() || mCells.back().mX != pending.mX || mCells.back().mY != pending.mY)
+                mCells.push_back(Cell{ .mX = pending.mX, .mY = pending.mY, .mBegin = mRefs.size(), .mEnd = 0 });
+            mRefs.push_back(pending.mRef);
+            mCells.back().mEnd = mRefs.size();
+        }
+
+        mPending.clear();
+        mPending.shrink_to_fit();
+    }
+
+    std::span<const CellRefTable::Ref> CellRefTable::getCell(int cellX, int cellY) const
+    {
+        const auto it = lowerBound(cellX, cellY);
+        if (it == mCells.end() || it->mX != cellX || it->mY != cellY)
+            return {};
+        return getRefs(*it);
+    }
+
+    void CellRefTable::clear()
+    {
+        mPending.clear();
+        mCells.clear();
+        mRefs.clear();
+    }
+
+    std::vector<CellRefTable::Cell>::const_iterator CellRefTable::lowerBound(int cellX, int cellY) const
+    {
+        return std::lower_bound(mCells.begin(), mCells.end(), std::make_pair(cellX, cellY),
+            [](const Cell& cell, const std::pair<int, int>& position) {
+                return std::tie(cell.mX, cell.mY) < std::tie(position.first, position.second);
+            });
+    }
+}
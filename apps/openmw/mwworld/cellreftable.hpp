@@ -0,0 +1,79 @@
+#ifndef GAME_MWWORLD_CELLREFTABLE_H
+#define GAME_MWWORLD_CELLREFTABLE_H
+
+#include <components/esm/position.hpp>
+#include <components/esm/refid.hpp>
+#include <components/esm3/refnum.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ESM
+{
+    struct CellRef;
+}
+
+namespace MWWorld
+{
+    /// \brief Immutable in-memory copy of the references stored in content files for exterior cells.
+    ///
+    /// References are grouped by cell and kept in the order they appear in content files, including deleted ones, so
+    /// a reader can replay them exactly as if they were read from disk. Cells are sorted by position and references of
+    /// all cells are stored in a single array.
+    class CellRefTable
+    {
+    public:
+        struct Ref
+        {
+            ESM::RefNum mRefNum;
+            ESM::RefId mRefId;
+            ESM::Position mPos;
+            float mScale;
+            bool mDeleted;
+        };
+
+        /// Appends reference to the end of the cell list. Must not be called after finalize.
+        void add(int cellX, int cellY, const ESM::CellRef& ref, bool deleted);
+
+        /// Builds cell index. Relative order of references within each cell is preserved.
+        void finalize();
+
+        std::span<const Ref> getCell(int cellX, int cellY) const;
+
+        std::size_t getCellsCount() const { return mCells.size(); }
+
+        std::size_t getRefsCount() const { return mRefs.size(); }
+
+        void clear();
+
+    private:
+        struct Cell
+        {
+            int mX;
+            int mY;
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        struct PendingRef
+        {
+            int mX;
+            int mY;
+            Ref mRef;
+        };
+
+        std::vector<PendingRef> mPending;
+        std::vector<Cell> mCells;
+        std::vector<Ref> mRefs;
+
+        std::vector<Cell>::const_iterator lowerBound(int cellX, int cellY) const;
+
+        std::span<const Ref> getRefs(const Cell& cell) const
+        {
+            return std::span<const Ref>(mRefs.data() + cell.mBegin, cell.mEnd - cell.mBegin);
+        }
+    };
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "groundcoverstore.hpp"
 
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/esm3/loadstat.hpp>
 #include <components/esm3/readerscache.hpp>
@@ -41,21 +43,33 @@ namespace MWWorld
             mMeshCache[stat.mId] = Misc::ResourceHelpers::correctMeshPath(model);
         }
 
-        for (ESM::Cell& cell : content.mCells)
+        for (const ESM::Cell& cell : content.mCells)
         {
             if (!cell.isExterior())
                 continue;
-            auto cellIndex = std::make_pair(cell.getGridX(), cell.getGridY());
-            mCellContexts[cellIndex] = std::move(cell.mContextList);
+            for (std::size_t i = 0; i < cell.mContextList.size(); ++i)
+            {
+                try
+                {
+                    const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
+                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                    cell.restore(*reader, i);
+                    ESM::CellRef ref;
+                    bool deleted = false;
+                    while (ESM::Cell::getNextRef(*reader, ref, deleted))
+                        mCellRefs.add(cell.getGridX(), cell.getGridY(), ref, deleted);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to load groundcover references from cell \""
+                                        << cell.getDescription() << "\": " << e.what();
+                }
+            }
         }
-    }
 
-    void GroundcoverStore::initCell(ESM::Cell& cell, int cellX, int cellY) const
-    {
-        cell.blank();
+        mCellRefs.finalize();
 
-        auto searchCell = mCellContexts.find(std::make_pair(cellX, cellY));
-        if (searchCell != mCellContexts.end())
-            cell.mContextList = searchCell->second;
+        Log(Debug::Info) << "Loaded " << mCellRefs.getRefsCount() << " groundcover references in "
+                         << mCellRefs.getCellsCount() << " cells";
     }
 }
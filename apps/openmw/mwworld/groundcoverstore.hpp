@@ -5,14 +5,15 @@
 #include <components/vfs/pathutil.hpp>
 
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "cellreftable.hpp"
+
 namespace ESM
 {
-    struct ESM_Context;
     struct Static;
-    struct Cell;
 }
 
 namespace Loading
@@ -39,7 +40,7 @@ namespace MWWorld
     {
     private:
         std::map<ESM::RefId, VFS::Path::Normalized> mMeshCache;
-        std::map<std::pair<int, int>, std::vector<ESM::ESM_Context>> mCellContexts;
+        CellRefTable mCellRefs;
 
     public:
         void init(const Store<ESM::Static>& statics, const Files::Collections& fileCollections,
@@ -54,7 +55,11 @@ namespace MWWorld
             return it->second;
         }
 
-        void initCell(ESM::Cell& cell, int cellX, int cellY) const;
+        /// @return references of the exterior cell in the order they are stored in groundcover files
+        std::span<const CellRefTable::Ref> getCellRefs(int cellX, int cellY) const
+        {
+            return mCellRefs.getCell(cellX, cellY);
+        }
     };
 }
 
@@ -1,10 +1,18 @@
 #include "localscripts.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcont.hpp>
 #include <components/esm3/loadcrea.hpp>
 #include <components/esm3/loadnpc.hpp>
 #include <components/esm3/loadscpt.hpp>
+#include <components/settings/values.hpp>
 
 #include "cellstore.hpp"
 #include "class.hpp"
@@ -13,6 +21,8 @@
 
 namespace
 {
+    // Number of consecutive runs without side effects after which a script is considered to be idle
+    constexpr unsigned sMinQuiescentRuns = 10;
 
     struct AddScriptsVisitor
     {
@@ -72,22 +82,101 @@ MWWorld::LocalScripts::LocalScripts(const MWWorld::ESMStore& store)
     : mStore(store)
 {
     mIter = mScripts.end();
+    mCurrent = mScripts.end();
+}
+
+void MWWorld::LocalScripts::erase(std::list<Script>::iterator iter)
+{
+    if (iter == mIter)
+        ++mIter;
+    if (iter == mCurrent)
+        mCurrent = mScripts.end();
+    mScripts.erase(iter);
 }
 
-void MWWorld::LocalScripts::startIteration()
+void MWWorld::LocalScripts::startIteration(const Ptr& player)
 {
     mIter = mScripts.begin();
+    mCurrent = mScripts.end();
+    mRunningDeferred = false;
+    mHasDeferred = false;
+    mIterationStart = Clock::now();
+    ++mFrames;
+    mFrameRuns = 0;
+    mFrameSkips = 0;
+
+    if (!Settings::game().mLocalScriptsScheduling)
+    {
+        for (Script& script : mScripts)
+            script.mDeferred = false;
+        return;
+    }
+
+    const CellStore* const playerCell = player.isInCell() ? player.getCell() : nullptr;
+    const osg::Vec3f playerPosition = player.getRefData().getPosition().asVec3();
+    const float distance = Settings::game().mLocalScriptsSchedulingDistance;
+    mBudget = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float, std::milli>(Settings::game().mLocalScriptsFrameBudget));
+    const unsigned maxSkippedFrames = static_cast<unsigned>(Settings::game().mLocalScriptsMaxSkippedFrames.get());
+
+    for (Script& script : mScripts)
+    {
+        // Scripts of the objects in the player's cell are always executed to keep vanilla behaviour
+        script.mDeferred = script.mQuiescentRuns >= sMinQuiescentRuns && script.mSkippedFrames < maxSkippedFrames
+            && script.mPtr.isInCell() && script.mPtr.getCell() != playerCell
+            && (script.mPtr.getRefData().getPosition().asVec3() - playerPosition).length2() > distance * distance;
+        mHasDeferred = mHasDeferred || script.mDeferred;
+    }
 }
 
 bool MWWorld::LocalScripts::getNext(std::pair<ESM::RefId, Ptr>& script)
 {
-    if (mIter != mScripts.end())
+    while (true)
     {
+        if (mIter == mScripts.end())
+        {
+            // Deferred scripts are executed after all others
+            if (mRunningDeferred || !mHasDeferred)
+                return false;
+            mRunningDeferred = true;
+            mIter = mScripts.begin();
+            continue;
+        }
+
         auto iter = mIter++;
-        script = *iter;
+        if (iter->mDeferred != mRunningDeferred)
+            continue;
+
+        if (mRunningDeferred && Clock::now() - mIterationStart > mBudget)
+        {
+            ++iter->mSkippedFrames;
+            ++mStats[iter->mId].mSkips;
+            ++mFrameSkips;
+            continue;
+        }
+
+        iter->mSkippedFrames = 0;
+        mCurrent = iter;
+        mCurrentId = iter->mId;
+        mCurrentStart = Clock::now();
+        script = { iter->mId, iter->mPtr };
         return true;
     }
-    return false;
+}
+
+void MWWorld::LocalScripts::finishCurrent(bool sideEffects)
+{
+    ScriptStats& stats = mStats[mCurrentId];
+    stats.mTime += Clock::now() - mCurrentStart;
+    ++stats.mRuns;
+    if (!sideEffects)
+        ++stats.mQuiescentRuns;
+    ++mFrameRuns;
+
+    // The script could remove its own object
+    if (mCurrent != mScripts.end())
+        mCurrent->mQuiescentRuns = sideEffects ? 0 : mCurrent->mQuiescentRuns + 1;
+    mCurrent = mScripts.end();
 }
 
 void MWWorld::LocalScripts::add(const ESM::RefId& scriptName, const Ptr& ptr)
@@ -99,14 +188,14 @@ void MWWorld::LocalScripts::add(const ESM::RefId& scriptName, const Ptr& ptr)
             ptr.getRefData().setLocals(*script);
 
             for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-                if (iter->second == ptr)
+                if (iter->mPtr == ptr)
                 {
                     Log(Debug::Warning) << "Error: tried to add local script twice for " << ptr.getCellRef().getRefId();
                     remove(ptr);
                     break;
                 }
 
-            mScripts.emplace_back(scriptName, ptr);
+            mScripts.push_back(Script{ .mId = scriptName, .mPtr = ptr });
         }
         catch (const std::exception& exception)
         {
@@ -132,6 +221,8 @@ void MWWorld::LocalScripts::addCell(CellStore* cell)
 void MWWorld::LocalScripts::clear()
 {
     mScripts.clear();
+    mIter = mScripts.end();
+    mCurrent = mScripts.end();
 }
 
 void MWWorld::LocalScripts::clearCell(CellStore* cell)
@@ -140,13 +231,8 @@ void MWWorld::LocalScripts::clearCell(CellStore* cell)
 
     while (iter != mScripts.end())
     {
-        if (iter->second.mCell == cell)
-        {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter++);
-        }
+        if (iter->mPtr.mCell == cell)
+            erase(iter++);
         else
             ++iter;
     }
@@ -155,12 +241,9 @@ void MWWorld::LocalScripts::clearCell(CellStore* cell)
 void MWWorld::LocalScripts::remove(const MWWorld::CellRef* ref)
 {
     for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (&(iter->second.getCellRef()) == ref)
+        if (&(iter->mPtr.getCellRef()) == ref)
         {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter);
+            erase(iter);
             break;
         }
 }
@@ -168,17 +251,80 @@ void MWWorld::LocalScripts::remove(const MWWorld::CellRef* ref)
 void MWWorld::LocalScripts::remove(const Ptr& ptr)
 {
     for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
-        if (iter->second == ptr)
+        if (iter->mPtr == ptr)
         {
-            if (iter == mIter)
-                ++mIter;
-
-            mScripts.erase(iter);
+            erase(iter);
             break;
         }
 }
 
 bool MWWorld::LocalScripts::isRunning(const ESM::RefId& scriptName, const Ptr& ptr) const
 {
-    return std::ranges::find(mScripts, std::pair(scriptName, ptr)) != mScripts.end();
+    return std::ranges::any_of(
+        mScripts, [&](const Script& script) { return script.mId == scriptName && script.mPtr == ptr; });
+}
+
+void MWWorld::LocalScripts::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+{
+    stats.setAttribute(frameNumber, "LocalScripts Count", mScripts.size());
+    stats.setAttribute(frameNumber, "LocalScripts Run", mFrameRuns);
+    stats.setAttribute(frameNumber, "LocalScripts Skipped", mFrameSkips);
+}
+
+std::string MWWorld::LocalScripts::formatStats() const
+{
+    std::ostringstream out;
+
+    constexpr int nameW = 40;
+    constexpr int valueW = 12;
+
+    std::unordered_map<ESM::RefId, std::size_t> instances;
+    for (const Script& script : mScripts)
+        ++instances[script.mId];
+
+    std::vector<std::pair<ESM::RefId, const ScriptStats*>> sorted;
+    sorted.reserve(mStats.size());
+    for (const auto& [id, stats] : mStats)
+        sorted.emplace_back(id, &stats);
+    std::ranges::sort(sorted, std::ranges::greater(), [](const auto& v) { return v.second->mTime; });
+
+    const double frames = static_cast<double>(std::max<std::size_t>(mFrames, 1));
+
+    out << "Active local scripts: " << mScripts.size() << "\n";
+    out << "Scheduling: " << (Settings::game().mLocalScriptsScheduling ? "enabled" : "disabled")
+        << " (section [Game] in settings.cfg)\n";
+    out << "\n";
+
+    out << "Legend\n";
+    out << "  instances:  Number of currently active objects with the script;\n";
+    out << "  time:       Averaged execution time in microseconds per frame over all instances;\n";
+    out << "  runs:       Averaged number of executions per frame;\n";
+    out << "  skips:      Averaged number of executions per frame deferred to later frames;\n";
+    out << "  idle:       Share of executions that didn't change the game state;\n";
+    out << "\n";
+
+    out << std::left << " " << std::setw(nameW) << "*** Local scripts" << std::right;
+    out << std::setw(valueW) << "instances";
+    out << std::setw(valueW) << "time";
+    out << std::setw(valueW) << "runs";
+    out << std::setw(valueW) << "skips";
+    out << std::setw(valueW) << "idle";
+    out << "\n";
+
+    out << std::fixed << std::setprecision(2);
+    for (const auto& [id, stats] : sorted)
+    {
+        const auto it = instances.find(id);
+        const double time = std::chrono::duration<double, std::micro>(stats->mTime).count();
+        out << std::left << " " << std::setw(nameW) << id.toDebugString() << std::right;
+        out << std::setw(valueW) << (it == instances.end() ? 0 : it->second);
+        out << std::setw(valueW) << time / frames;
+        out << std::setw(valueW) << static_cast<double>(stats->mRuns) / frames;
+        out << std::setw(valueW) << static_cast<double>(stats->mSkips) / frames;
+        out << std::setw(valueW - 1)
+            << (stats->mRuns == 0 ? 0.0 : 100.0 * static_cast<double>(stats->mQuiescentRuns) / stats->mRuns) << "%";
+        out << "\n";
+    }
+
+    return out.str();
 }
@@ -1,11 +1,19 @@
 #ifndef GAME_MWWORLD_LOCALSCRIPTS_H
 #define GAME_MWWORLD_LOCALSCRIPTS_H
 
+#include <chrono>
+#include <cstddef>
 #include <list>
 #include <string>
+#include <unordered_map>
 
 #include "ptr.hpp"
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     class ESMStore;
@@ -13,22 +21,61 @@ namespace MWWorld
     class RefData;
 
     /// \brief List of active local scripts
+    ///
+    /// Scripts of distant objects which didn't change the game state during their last runs can be deferred: they are
+    /// executed after all other scripts while the frame budget is not exceeded.
     class LocalScripts
     {
-        std::list<std::pair<ESM::RefId, Ptr>> mScripts;
-        std::list<std::pair<ESM::RefId, Ptr>>::iterator mIter;
+        using Clock = std::chrono::steady_clock;
+
+        struct Script
+        {
+            ESM::RefId mId;
+            Ptr mPtr;
+            unsigned mQuiescentRuns = 0;
+            unsigned mSkippedFrames = 0;
+            bool mDeferred = false;
+        };
+
+        struct ScriptStats
+        {
+            std::size_t mRuns = 0;
+            std::size_t mQuiescentRuns = 0;
+            std::size_t mSkips = 0;
+            Clock::duration mTime{};
+        };
+
+        std::list<Script> mScripts;
+        std::list<Script>::iterator mIter;
+        std::list<Script>::iterator mCurrent;
         const MWWorld::ESMStore& mStore;
+        bool mRunningDeferred = false;
+        bool mHasDeferred = false;
+        ESM::RefId mCurrentId;
+        Clock::duration mBudget{};
+        Clock::time_point mIterationStart;
+        Clock::time_point mCurrentStart;
+        std::size_t mFrames = 0;
+        std::size_t mFrameRuns = 0;
+        std::size_t mFrameSkips = 0;
+        std::unordered_map<ESM::RefId, ScriptStats> mStats;
+
+        void erase(std::list<Script>::iterator iter);
 
     public:
         LocalScripts(const MWWorld::ESMStore& store);
 
-        void startIteration();
-        ///< Set the iterator to the begin of the script list.
+        void startIteration(const Ptr& player);
+        ///< Set the iterator to the begin of the script list and decide which scripts can be deferred this frame.
 
         bool getNext(std::pair<ESM::RefId, Ptr>& script);
         ///< Get next local script
         /// @return Did we get a script?
 
+        void finishCurrent(bool sideEffects);
+        ///< Report that the script returned by the last getNext call has been executed.
+        /// \param sideEffects Whether the script might have changed the game state.
+
         void add(const ESM::RefId& scriptName, const Ptr& ptr);
         ///< Add script to collection of active local scripts.
 
@@ -48,6 +95,11 @@ namespace MWWorld
 
         bool isRunning(const ESM::RefId&, const Ptr&) const;
         ///< Is the local script running?.
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        std::string formatStats() const;
+        ///< Execution cost of each script since the start of the session.
     };
 }
 
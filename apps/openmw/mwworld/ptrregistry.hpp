@@ -5,16 +5,25 @@
 
 #include "components/esm3/cellref.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace MWWorld
 {
+    // Local Lua scripts of different partitions may register and look up objects concurrently, so all operations
+    // except iteration are synchronized. Iteration is allowed only when no scripts are running.
     class PtrRegistry
     {
     public:
-        std::size_t getRevision() const { return mRevision; }
+        std::size_t getRevision() const { return mRevision.load(std::memory_order_acquire); }
 
-        ESM::RefNum getLastGenerated() const { return mLastGenerated; }
+        ESM::RefNum getLastGenerated() const
+        {
+            const std::shared_lock lock(mMutex);
+            return mLastGenerated;
+        }
 
         auto begin() const { return mIndex.cbegin(); }
 
@@ -22,29 +31,39 @@ namespace MWWorld
 
         Ptr getOrEmpty(ESM::RefNum refNum) const
         {
+            const std::shared_lock lock(mMutex);
             const auto it = mIndex.find(refNum);
             if (it != mIndex.end())
                 return it->second;
             return Ptr();
         }
 
-        void setLastGenerated(ESM::RefNum v) { mLastGenerated = v; }
+        void setLastGenerated(ESM::RefNum v)
+        {
+            const std::unique_lock lock(mMutex);
+            mLastGenerated = v;
+        }
 
         void clear()
         {
+            const std::unique_lock lock(mMutex);
             mIndex.clear();
             mLastGenerated = ESM::RefNum{};
-            ++mRevision;
+            mRevision.fetch_add(1, std::memory_order_release);
         }
 
-        void insert(const Ptr& ptr)
+        void insert(const Ptr& ptr, WorldModel* worldModel)
         {
+            const std::unique_lock lock(mMutex);
             mIndex[ptr.getCellRef().getOrAssignRefNum(mLastGenerated)] = ptr;
-            ++mRevision;
+            ptr.mRef->mWorldModel = worldModel;
+            mRevision.fetch_add(1, std::memory_order_release);
         }
 
-        void remove(const LiveCellRefBase& ref) noexcept
+        void remove(LiveCellRefBase& ref) noexcept
         {
+            const std::unique_lock lock(mMutex);
+            ref.mWorldModel = nullptr;
             ESM::RefNum refNum = ref.mRef.getRefNum();
             if (!refNum.isSet())
                 return;
@@ -52,7 +71,7 @@ namespace MWWorld
             if (it != mIndex.end() && it->second.mRef == &ref)
             {
                 mIndex.erase(it);
-                ++mRevision;
+                mRevision.fetch_add(1, std::memory_order_release);
             }
         }
 
@@ -61,6 +80,7 @@ namespace MWWorld
         {
             if (!ref.mRefNum.isSet())
             {
+                const std::unique_lock lock(mMutex);
                 CellRef temp(ref);
                 temp.getOrAssignRefNum(mLastGenerated);
                 ref.mRefNum = temp.getRefNum();
@@ -68,7 +88,8 @@ namespace MWWorld
         }
 
     private:
-        std::size_t mRevision = 0;
+        mutable std::shared_mutex mMutex;
+        std::atomic_size_t mRevision{ 0 };
         std::unordered_map<ESM::RefNum, Ptr> mIndex;
         ESM::RefNum mLastGenerated;
     };
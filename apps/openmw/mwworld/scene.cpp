@@ -32,6 +32,8 @@
 #include "../mwbase/windowmanager.hpp"
 #include "../mwbase/world.hpp"
 
+#include "../mwmechanics/pathgrid.hpp"
+
 #include "../mwrender/landmanager.hpp"
 #include "../mwrender/postprocessor.hpp"
 #include "../mwrender/renderingmanager.hpp"
@@ -403,7 +405,10 @@ namespace MWWorld
         ESM::visit(ESM::VisitOverload{
                        [&](const ESM::Cell& c) {
                            if (const auto pathgrid = mWorld.getStore().get<ESM::Pathgrid>().search(c))
+                           {
                                mNavigator.removePathgrid(*pathgrid);
+                               mPathgridGraphs->remove(*pathgrid);
+                           }
                        },
                        [&](const ESM4::Cell& /*c*/) {},
                    },
@@ -484,7 +489,10 @@ namespace MWWorld
         ESM::visit(ESM::VisitOverload{
                        [&](const ESM::Cell& c) {
                            if (const auto pathgrid = mWorld.getStore().get<ESM::Pathgrid>().search(c))
+                           {
                                mNavigator.addPathgrid(c, *pathgrid);
+                               mPathgridGraphs->add(*pathgrid);
+                           }
                        },
                        [&](const ESM4::Cell& /*c*/) {},
                    },
@@ -499,6 +507,8 @@ namespace MWWorld
 
         insertCell(cell, loadingListener, navigatorUpdateGuard);
 
+        MWBase::Environment::get().getSoundManager()->preloadActorSounds(cell);
+
         mRendering.addCell(&cell);
 
         MWBase::Environment::get().getWindowManager()->addCell(&cell);
@@ -892,6 +902,7 @@ namespace MWWorld
         , mPhysics(physics)
         , mRendering(rendering)
         , mNavigator(navigator)
+        , mPathgridGraphs(std::make_unique<MWMechanics::PathgridGraphCache>())
         , mCellLoadingThreshold(1024.f)
         , mPreloadDistance(Settings::cells().mPreloadDistance)
         , mPreloadEnabled(Settings::cells().mPreloadEnabled)
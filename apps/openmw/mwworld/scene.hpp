@@ -54,6 +54,11 @@ namespace MWPhysics
     class PhysicsSystem;
 }
 
+namespace MWMechanics
+{
+    class PathgridGraphCache;
+}
+
 namespace SceneUtil
 {
     class WorkItem;
@@ -94,6 +99,7 @@ namespace MWWorld
         MWRender::RenderingManager& mRendering;
         DetourNavigator::Navigator& mNavigator;
         std::unique_ptr<CellPreloader> mPreloader;
+        std::unique_ptr<MWMechanics::PathgridGraphCache> mPathgridGraphs;
         float mCellLoadingThreshold;
         float mPreloadDistance;
         bool mPreloadEnabled;
@@ -197,6 +203,8 @@ namespace MWWorld
 
         bool isCellActive(const CellStore& cell);
 
+        MWMechanics::PathgridGraphCache& getPathgridGraphs() { return *mPathgridGraphs; }
+
         Ptr searchPtrViaActorId(int actorId);
 
         void preload(const std::string& mesh, bool useAnim = false);
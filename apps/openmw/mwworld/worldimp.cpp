@@ -78,6 +78,7 @@
 #include "../mwrender/animation.hpp"
 #include "../mwrender/camera.hpp"
 #include "../mwrender/npcanimation.hpp"
+#include "../mwrender/objectpaging.hpp"
 #include "../mwrender/postprocessor.hpp"
 #include "../mwrender/renderingmanager.hpp"
 #include "../mwrender/vismask.hpp"
@@ -288,6 +289,8 @@ namespace MWWorld
         mStore.validateRecords(mReaders);
         mStore.movePlayerRecord();
 
+        loadPagedReferences(listener);
+
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
     }
 
@@ -308,7 +311,7 @@ namespace MWWorld
         }
 
         mRendering = std::make_unique<MWRender::RenderingManager>(
-            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, unrefQueue);
+            viewer, rootNode, mResourceSystem, workQueue, *mNavigator, mGroundcoverStore, mPagedCellRefs, unrefQueue);
         mProjectileManager = std::make_unique<ProjectileManager>(
             mRendering->getLightRoot()->asGroup(), mResourceSystem, mRendering.get(), mPhysics.get());
         mRendering->preloadCommonAssets();
@@ -2914,6 +2917,15 @@ namespace MWWorld
         mGroundcoverStore.init(mStore.get<ESM::Static>(), fileCollections, groundcoverFiles, encoder, listener);
     }
 
+    void World::loadPagedReferences(Loading::Listener* listener)
+    {
+        if (!Settings::terrain().mObjectPaging
+            || (!Settings::terrain().mDistantTerrain && !Settings::groundcover().mEnabled))
+            return;
+
+        MWRender::loadPagedReferences(mStore, mPagedCellRefs, listener);
+    }
+
     MWWorld::SpellCastState World::startSpellCast(const Ptr& actor)
     {
         MWMechanics::CreatureStats& stats = actor.getClass().getCreatureStats(actor);
@@ -3871,6 +3883,7 @@ namespace MWWorld
         DetourNavigator::reportStats(mNavigator->getStats(), frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
         mWorldScene->reportStats(frameNumber, stats);
+        mLocalScripts.reportStats(frameNumber, stats);
     }
 
     std::vector<MWWorld::Ptr> World::getAll(const ESM::RefId& id)
@@ -13,6 +13,7 @@
 #include "../mwbase/world.hpp"
 
 #include "contentloader.hpp"
+#include "cellreftable.hpp"
 #include "esmstore.hpp"
 #include "globals.hpp"
 #include "groundcoverstore.hpp"
@@ -90,6 +91,7 @@ namespace MWWorld
         ESM::ReadersCache mReaders;
         MWWorld::ESMStore mStore;
         GroundcoverStore mGroundcoverStore;
+        CellRefTable mPagedCellRefs;
         LocalScripts mLocalScripts;
         MWWorld::Globals mGlobalVariables;
         Misc::Rng::Generator mPrng;
@@ -180,6 +182,8 @@ namespace MWWorld
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
             Loading::Listener* listener);
 
+        void loadPagedReferences(Loading::Listener* listener);
+
         float feetToGameUnits(float feet);
         float getActivationDistancePlusTelekinesis();
 
@@ -345,14 +345,12 @@ namespace MWWorld
     {
         if (ptr.mRef == nullptr)
             throw std::logic_error("Ptr with nullptr mRef is not allowed to be registered");
-        mPtrRegistry.insert(ptr);
-        ptr.mRef->mWorldModel = this;
+        mPtrRegistry.insert(ptr, this);
     }
 
     void WorldModel::deregisterLiveCellRef(LiveCellRefBase& ref) noexcept
     {
         mPtrRegistry.remove(ref);
-        ref.mWorldModel = nullptr;
     }
 }
 
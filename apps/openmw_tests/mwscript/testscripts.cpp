@@ -2,6 +2,9 @@
 
 #include <array>
 #include <sstream>
+#include <stdexcept>
+
+#include <components/compiler/generator.hpp>
 
 #include "testutils.hpp"
 
@@ -55,9 +58,14 @@ namespace
             mCompilerContext.setExtensions(&mExtensions);
         }
 
-        void run(const CompiledScript& script, TestInterpreterContext& context)
+        bool run(const CompiledScript& script, TestInterpreterContext& context)
+        {
+            return mInterpreter.run(script.mProgram, context);
+        }
+
+        bool run(const Interpreter::Program& program, TestInterpreterContext& context)
         {
-            mInterpreter.run(script.mProgram, context);
+            return mInterpreter.run(program, mInterpreter.decode(program), context);
         }
 
         template <typename T, typename... TArgs>
@@ -98,6 +106,22 @@ while ( one < two )
     set one to ( one + 1 )
 endwhile
 
+End)mwscript";
+
+    const std::string sScriptSideEffects = R"mwscript(Begin side_effects
+
+short state
+float timer
+
+if ( state == 0 )
+    set timer to 0
+    set state to 0
+elseif ( state == 1 )
+    set timer to timer + 1
+elseif ( state == 2 )
+    MessageBox "side effect"
+endif
+
 End)mwscript";
 
     const std::string sScript2 = R"mwscript(Begin addtopic
@@ -1006,4 +1030,41 @@ End)mwscript";
         registerExtensions();
         EXPECT_FALSE(!compile(sIssue6807));
     }
+
+    TEST_F(MWScriptTest, run_should_report_side_effects_only_when_state_is_changed)
+    {
+        const auto script = compile(sScriptSideEffects);
+        ASSERT_TRUE(script.has_value());
+        TestInterpreterContext context;
+        EXPECT_FALSE(run(*script, context));
+
+        context.setLocalShort(0, 1);
+        EXPECT_TRUE(run(*script, context));
+        EXPECT_FLOAT_EQ(context.getLocalFloat(0), 1);
+
+        context.setLocalShort(0, 2);
+        EXPECT_TRUE(run(*script, context));
+        EXPECT_EQ(context.getMessages().size(), 1);
+
+        context.setLocalShort(0, 3);
+        EXPECT_FALSE(run(*script, context));
+    }
+
+    TEST_F(MWScriptTest, unknown_opcode_should_fail_only_when_executed)
+    {
+        Interpreter::Program program;
+        program.mInstructions = { Compiler::Generator::segment0(1, 2), Compiler::Generator::segment5(0x3ffffff) };
+        TestInterpreterContext context;
+        EXPECT_NO_THROW(run(program, context));
+        program.mInstructions.erase(program.mInstructions.begin());
+        try
+        {
+            run(program, context);
+            FAIL();
+        }
+        catch (const std::runtime_error& e)
+        {
+            EXPECT_STREQ(e.what(), "unknown opcode 67108863 in segment 5");
+        }
+    }
 }
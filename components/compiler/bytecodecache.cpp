@@ -0,0 +1,211 @@
+#include "bytecodecache.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <array>
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace Compiler
+{
+    namespace
+    {
+        constexpr std::array<char, 8> sMagic = { 'O', 'M', 'W', 'S', 'C', 'R', 'B', 'C' };
+        constexpr std::uint32_t sVersion = 1;
+        // Increment when the compiler generates different code for the same script or opcodes are changed
+        constexpr std::uint32_t sCompilerVersion = 1;
+        constexpr std::array<char, 3> sLocalTypes = { 's', 'l', 'f' };
+
+        void writeUint(std::ostream& stream, std::uint32_t value)
+        {
+            std::array<char, 4> buffer;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+                buffer[i] = static_cast<char>(value >> (i * 8));
+            stream.write(buffer.data(), buffer.size());
+        }
+
+        std::uint32_t readUint(std::istream& stream)
+        {
+            std::array<unsigned char, 4> buffer;
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+                throw std::runtime_error("unexpected end of file");
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+                result |= static_cast<std::uint32_t>(buffer[i]) << (i * 8);
+            return result;
+        }
+
+        void writeUint64(std::ostream& stream, std::uint64_t value)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(value));
+            writeUint(stream, static_cast<std::uint32_t>(value >> 32));
+        }
+
+        std::uint64_t readUint64(std::istream& stream)
+        {
+            const std::uint64_t low = readUint(stream);
+            return low | static_cast<std::uint64_t>(readUint(stream)) << 32;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string result(readUint(stream), '\0');
+            if (!stream.read(result.data(), result.size()))
+                throw std::runtime_error("unexpected end of file");
+            return result;
+        }
+
+        template <class T, class Write>
+        void writeVector(std::ostream& stream, const std::vector<T>& values, Write&& write)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(values.size()));
+            for (const T& value : values)
+                write(stream, value);
+        }
+
+        template <class T, class Read>
+        std::vector<T> readVector(std::istream& stream, Read&& read)
+        {
+            std::vector<T> result(readUint(stream));
+            for (T& value : result)
+                value = read(stream);
+            return result;
+        }
+
+        void writeScript(std::ostream& stream, const BytecodeCache::Script& script)
+        {
+            const Interpreter::Program& program = script.mProgram;
+            writeVector(stream, program.mInstructions, writeUint);
+            writeVector(stream, program.mIntegers,
+                [](std::ostream& stream, Interpreter::Type_Integer value) {
+                    writeUint(stream, static_cast<std::uint32_t>(value));
+                });
+            writeVector(stream, program.mFloats, [](std::ostream& stream, Interpreter::Type_Float value) {
+                writeUint(stream, std::bit_cast<std::uint32_t>(value));
+            });
+            writeVector(stream, program.mStrings, writeString);
+            for (const char type : sLocalTypes)
+                writeVector(stream, script.mLocals.get(type), writeString);
+        }
+
+        BytecodeCache::Script readScript(std::istream& stream)
+        {
+            BytecodeCache::Script result;
+            Interpreter::Program& program = result.mProgram;
+            program.mInstructions = readVector<Interpreter::Type_Code>(stream, readUint);
+            program.mIntegers = readVector<Interpreter::Type_Integer>(
+                stream, [](std::istream& stream) { return static_cast<Interpreter::Type_Integer>(readUint(stream)); });
+            program.mFloats = readVector<Interpreter::Type_Float>(
+                stream, [](std::istream& stream) { return std::bit_cast<Interpreter::Type_Float>(readUint(stream)); });
+            program.mStrings = readVector<std::string>(stream, readString);
+            for (const char type : sLocalTypes)
+                for (const std::string& name : readVector<std::string>(stream, readString))
+                    result.mLocals.declare(type, name);
+            return result;
+        }
+    }
+
+    BytecodeCache::BytecodeCache(std::string environment)
+        : mEnvironment(std::move(environment))
+    {
+    }
+
+    std::uint64_t BytecodeCache::makeKey(std::string_view text)
+    {
+        // FNV-1a, keys are stored in the file so the hash has to be the same across runs and platforms
+        std::uint64_t result = 14695981039346656037ull;
+        for (const char c : text)
+        {
+            result ^= static_cast<unsigned char>(c);
+            result *= 1099511628211ull;
+        }
+        return result;
+    }
+
+    const BytecodeCache::Script* BytecodeCache::find(std::uint64_t key) const
+    {
+        const auto it = mScripts.find(key);
+        if (it == mScripts.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    void BytecodeCache::insert(std::uint64_t key, Script&& script)
+    {
+        mScripts.insert_or_assign(key, std::move(script));
+    }
+
+    bool BytecodeCache::load(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            return false;
+        try
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                throw std::runtime_error("failed to open");
+            std::array<char, sMagic.size()> magic;
+            if (!stream.read(magic.data(), magic.size()) || magic != sMagic)
+                throw std::runtime_error("invalid file signature");
+            if (readUint(stream) != sVersion)
+                throw std::runtime_error("unsupported version");
+            // Content files or the engine are changed, not an error
+            if (readUint(stream) != sCompilerVersion || readString(stream) != mEnvironment)
+                return false;
+            const std::uint32_t count = readUint(stream);
+            std::unordered_map<std::uint64_t, Script> scripts;
+            scripts.reserve(count);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const std::uint64_t key = readUint64(stream);
+                scripts.insert_or_assign(key, readScript(stream));
+            }
+            mScripts = std::move(scripts);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read script bytecode cache file " << path << ": " << e.what();
+            return false;
+        }
+    }
+
+    void BytecodeCache::save(const std::filesystem::path& path) const
+    {
+        // Multiple processes may use the same cache, never leave a partially written file
+        try
+        {
+            std::filesystem::create_directories(path.parent_path());
+            std::filesystem::path temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream stream(temporary, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                stream.write(sMagic.data(), sMagic.size());
+                writeUint(stream, sVersion);
+                writeUint(stream, sCompilerVersion);
+                writeString(stream, mEnvironment);
+                writeUint(stream, static_cast<std::uint32_t>(mScripts.size()));
+                for (const auto& [key, script] : mScripts)
+                {
+                    writeUint64(stream, key);
+                    writeScript(stream, script);
+                }
+            }
+            std::filesystem::rename(temporary, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write script bytecode cache file " << path << ": " << e.what();
+        }
+    }
+}
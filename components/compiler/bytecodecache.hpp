@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_COMPILER_BYTECODECACHE_H
+#define OPENMW_COMPONENTS_COMPILER_BYTECODECACHE_H
+
+#include "locals.hpp"
+
+#include <components/interpreter/program.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Compiler
+{
+    /// @brief Persistent storage for compiled scripts reused between sessions.
+    /// @par Scripts are found by a hash of their text. Compiled code depends also on the compiler, the opcodes and the
+    /// loaded content (global variables, ids, local variables of other scripts), this is described by the environment.
+    /// A file stored for another environment or compiler version is ignored.
+    class BytecodeCache
+    {
+    public:
+        struct Script
+        {
+            Interpreter::Program mProgram;
+            Locals mLocals;
+        };
+
+        explicit BytecodeCache(std::string environment);
+
+        static std::uint64_t makeKey(std::string_view text);
+
+        /// @note Thread safe as long as there are no concurrent modifications.
+        const Script* find(std::uint64_t key) const;
+
+        void insert(std::uint64_t key, Script&& script);
+
+        std::size_t size() const { return mScripts.size(); }
+
+        /// Replace content by the scripts stored in the file. Returns false when the file doesn't exist or can't be
+        /// used, the content is not changed in this case.
+        bool load(const std::filesystem::path& path);
+
+        /// Failures are reported to the log but not thrown.
+        void save(const std::filesystem::path& path) const;
+
+    private:
+        std::string mEnvironment;
+        std::unordered_map<std::uint64_t, Script> mScripts;
+    };
+}
+
+#endif
@@ -29,6 +29,8 @@ namespace DetourNavigator
 {
     namespace
     {
+        constexpr std::size_t maxTileLayerCacheSize = 16 * 1024 * 1024;
+
         int getManhattanDistance(const TilePosition& lhs, const TilePosition& rhs)
         {
             return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
@@ -65,6 +67,13 @@ namespace DetourNavigator
                 settings.mRecast, settings.mWriteToNavMeshDb);
         }
 
+        // Writes are cache updates, so under pressure older ones are dropped instead of keeping generated data in
+        // memory indefinitely
+        constexpr std::size_t maxDbWritingJobs = 1024;
+
+        // Each transaction commit syncs the file, writing queued tiles together avoids doing it per tile
+        constexpr std::size_t maxDbWritingJobsPerTransaction = 64;
+
         std::size_t getNextJobId()
         {
             static std::atomic_size_t nextJobId{ 1 };
@@ -279,6 +288,7 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mTileLayerCache(maxTileLayerCacheSize)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -442,6 +452,7 @@ namespace DetourNavigator
         if (mDbWorker != nullptr)
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
+        result.mLayerCache = mTileLayerCache.getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
         return result;
     }
@@ -577,8 +588,8 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(recastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, mTileLayerCache);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -629,8 +640,8 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(job.mRecastMesh, job.mWorldspace, job.mChangedTile,
+                job.mAgentBounds, mSettings.get().mRecast, mTileLayerCache);
             generatedNavMeshData = true;
         }
 
@@ -798,14 +809,23 @@ namespace DetourNavigator
         mJobs.erase(job);
     }
 
-    void DbJobQueue::push(JobIt job)
+    std::optional<JobIt> DbJobQueue::push(JobIt job)
     {
         const std::lock_guard lock(mMutex);
+        std::optional<JobIt> dropped;
         if (isWritingDbJob(*job))
+        {
+            if (mWriting.size() >= maxDbWritingJobs)
+            {
+                dropped = mWriting.front();
+                mWriting.pop_front();
+            }
             mWriting.push_back(job);
+        }
         else
             mReading.push(job);
         mHasJob.notify_all();
+        return dropped;
     }
 
     std::optional<JobIt> DbJobQueue::pop()
@@ -876,15 +896,21 @@ namespace DetourNavigator
     void DbWorker::enqueueJob(JobIt job)
     {
         Log(Debug::Debug) << "Enqueueing db job " << job->mId << " by thread=" << std::this_thread::get_id();
-        mQueue.push(job);
+        if (const std::optional<JobIt> dropped = mQueue.push(job))
+        {
+            Log(Debug::Debug) << "Dropped db write job " << (*dropped)->mId << ": too many queued writes";
+            mUpdater.removeJob(*dropped);
+        }
     }
 
     DbWorkerStats DbWorker::getStats() const
     {
-        return DbWorkerStats{
+        DbWorkerStats result{
             .mJobs = mQueue.getStats(),
             .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed),
         };
+        result.mJobs.mWritingJobs += mPendingWritingJobs.load(std::memory_order_relaxed);
+        return result;
     }
 
     void DbWorker::stop()
@@ -903,70 +929,139 @@ namespace DetourNavigator
             {
                 if (const auto job = mQueue.pop())
                     processJob(*job);
+                if (!mWritingJobs.empty()
+                    && (mWritingJobs.size() >= maxDbWritingJobsPerTransaction
+                        || mQueue.getStats().mWritingJobs == 0))
+                    flushWritingJobs();
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception: " << e.what();
             }
         }
+
+        // Writing jobs are already taken from the queue and postponed only to be batched, don't lose them on stop
+        try
+        {
+            if (!mWritingJobs.empty())
+                flushWritingJobs();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker exception: " << e.what();
+        }
     }
 
     void DbWorker::processJob(JobIt job)
     {
-        const auto process = [&](auto f) {
+        if (isWritingDbJob(*job))
+        {
+            mWritingJobs.push_back(job);
+            mPendingWritingJobs = mWritingJobs.size();
+            return;
+        }
+
+        // Make sure reading jobs can find tiles written by previous jobs
+        if (!mWritingJobs.empty())
+            flushWritingJobs();
+
+        try
+        {
+            processReadingJob(job);
+        }
+        catch (const std::exception& e)
+        {
+            handleJobException(job, e);
+        }
+        job->mState = JobState::WithDbResult;
+        mUpdater.enqueueJob(job);
+    }
+
+    void DbWorker::handleJobException(JobIt job, const std::exception& e)
+    {
+        Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
+        if (!mWriteToDb)
+            return;
+        const std::string_view message(e.what());
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+        else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
+        {
+            Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
+                                   "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
+                                << mNextTileId;
             try
             {
-                f(job);
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+                Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
+            }
+            catch (const std::exception& exception)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
+                                    << exception.what();
+            }
+        }
+    }
+
+    void DbWorker::flushWritingJobs()
+    {
+        if (mWriteToDb && mWritingJobs.size() > 1)
+        {
+            const TileId nextTileId = mNextTileId;
+            const ShapeId nextShapeId = mNextShapeId;
+            try
+            {
+                Sqlite3::Transaction transaction = mDb->startTransaction();
+                for (const JobIt job : mWritingJobs)
+                    processWritingJob(job);
+                transaction.commit();
+                Log(Debug::Debug) << "Written " << mWritingJobs.size() << " db jobs in a single transaction";
+                for (const JobIt job : mWritingJobs)
+                    mUpdater.removeJob(job);
+                mWritingJobs.clear();
+                mPendingWritingJobs = 0;
+                return;
             }
             catch (const std::exception& e)
             {
-                Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                    else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
-                    {
-                        Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
-                                               "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
-                                            << mNextTileId;
-                        try
-                        {
-                            mNextTileId = TileId(mDb->getMaxTileId() + 1);
-                            Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
-                        }
-                        catch (const std::exception& exception)
-                        {
-                            mWriteToDb = false;
-                            Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
-                                                << exception.what();
-                        }
-                    }
-                }
+                // Transaction is rolled back, write each tile separately to keep as many of them as possible and to
+                // find the failing one
+                Log(Debug::Debug) << "Failed to write " << mWritingJobs.size()
+                                  << " db jobs in a single transaction, falling back to separate writes: " << e.what();
             }
-        };
+            // Shapes inserted within the transaction are gone, so serialized inputs may refer to missing shape ids
+            // and have to be resolved again
+            for (const JobIt job : mWritingJobs)
+                job->mInput.clear();
+            mNextTileId = nextTileId;
+            mNextShapeId = nextShapeId;
+        }
 
-        if (isWritingDbJob(*job))
+        for (const JobIt job : mWritingJobs)
         {
-            process([&](JobIt it) { processWritingJob(it); });
+            try
+            {
+                processWritingJob(job);
+            }
+            catch (const std::exception& e)
+            {
+                handleJobException(job, e);
+            }
             mUpdater.removeJob(job);
-            return;
         }
-
-        process([&](JobIt it) { processReadingJob(it); });
-        job->mState = JobState::WithDbResult;
-        mUpdater.enqueueJob(job);
+        mWritingJobs.clear();
+        mPendingWritingJobs = 0;
     }
 
     void DbWorker::processReadingJob(JobIt job)
@@ -11,6 +11,7 @@
 #include "sharednavmeshcacheitem.hpp"
 #include "stats.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
+#include "tilelayercache.hpp"
 #include "tileposition.hpp"
 #include "waitconditiontype.hpp"
 
@@ -29,6 +30,7 @@
 #include <set>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -132,7 +134,8 @@ namespace DetourNavigator
     class DbJobQueue
     {
     public:
-        void push(JobIt job);
+        // Returns a writing job dropped to keep the writing queue bounded
+        std::optional<JobIt> push(JobIt job);
 
         std::optional<JobIt> pop();
 
@@ -178,8 +181,10 @@ namespace DetourNavigator
         TileId mNextTileId;
         ShapeId mNextShapeId;
         DbJobQueue mQueue;
+        std::vector<JobIt> mWritingJobs;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
+        std::atomic_size_t mPendingWritingJobs{ 0 };
         std::thread mThread;
 
         inline void run() noexcept;
@@ -189,6 +194,10 @@ namespace DetourNavigator
         inline void processReadingJob(JobIt job);
 
         inline void processWritingJob(JobIt job);
+
+        inline void handleJobException(JobIt job, const std::exception& e);
+
+        inline void flushWritingJobs();
     };
 
     class AsyncNavMeshUpdater
@@ -226,6 +235,7 @@ namespace DetourNavigator
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        TileLayerCache mTileLayerCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
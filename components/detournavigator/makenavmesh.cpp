@@ -5,14 +5,17 @@
 #include "navmeshdata.hpp"
 #include "offmeshconnection.hpp"
 #include "preparednavmeshdata.hpp"
+#include "recast.hpp"
 #include "recastcontext.hpp"
 #include "recastmesh.hpp"
 #include "recastmeshbuilder.hpp"
 #include "recastparams.hpp"
 #include "settings.hpp"
 #include "settingsutils.hpp"
+#include "tilelayercache.hpp"
 
 #include "components/debug/debuglog.hpp"
+#include "components/misc/compression.hpp"
 
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
@@ -20,6 +23,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
+#include <limits>
 
 namespace DetourNavigator
 {
@@ -441,15 +446,9 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool fillPolyMesh(RecastContext& context, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid, rcPolyMesh& polyMesh, rcPolyMeshDetail& polyMeshDetail)
+            const RecastParams& params, rcCompactHeightfield& compact, rcPolyMesh& polyMesh,
+            rcPolyMeshDetail& polyMeshDetail)
         {
-            rcCompactHeightfield compact;
-            if (!buildCompactHeightfield(context, params.mWalkableHeight, params.mWalkableClimb, solid, compact))
-                return false;
-
-            if (!erodeWalkableArea(context, params.mWalkableRadius, compact))
-                return false;
-
             if (!buildDistanceField(context, compact))
                 return false;
 
@@ -514,6 +513,242 @@ namespace DetourNavigator
 
             return { minZ, maxZ };
         }
+
+        [[nodiscard]] bool buildTileLayer(RecastContext& context, const RecastMesh& recastMesh,
+            const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+            const RecastParams& params, rcCompactHeightfield& compact)
+        {
+            const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+
+            rcHeightfield solid;
+            if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
+                    toNavMeshCoordinates(settings, maxZ), settings, solid))
+                return false;
+
+            if (!rasterizeTriangles(
+                    context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+                return false;
+
+            rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
+            rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
+            rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+
+            if (!buildCompactHeightfield(context, params.mWalkableHeight, params.mWalkableClimb, solid, compact))
+                return false;
+
+            return erodeWalkableArea(context, params.mWalkableRadius, compact);
+        }
+
+        float cross(const osg::Vec2f& origin, const osg::Vec2f& a, const osg::Vec2f& b)
+        {
+            return (a.x() - origin.x()) * (b.y() - origin.y()) - (a.y() - origin.y()) * (b.x() - origin.x());
+        }
+
+        // Andrew's monotone chain, returns hull in counter-clockwise order
+        std::vector<osg::Vec2f> makeConvexHull(std::vector<osg::Vec2f>&& points)
+        {
+            std::sort(points.begin(), points.end());
+            points.erase(std::unique(points.begin(), points.end()), points.end());
+
+            if (points.size() < 3)
+                return std::move(points);
+
+            std::vector<osg::Vec2f> result(points.size() * 2);
+            std::size_t size = 0;
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                while (size >= 2 && cross(result[size - 2], result[size - 1], points[i]) <= 0)
+                    --size;
+                result[size++] = points[i];
+            }
+
+            for (std::size_t i = points.size() - 1, lower = size + 1; i > 0; --i)
+            {
+                while (size >= lower && cross(result[size - 2], result[size - 1], points[i - 1]) <= 0)
+                    --size;
+                result[size++] = points[i - 1];
+            }
+
+            result.resize(size - 1);
+
+            return result;
+        }
+
+        void markObstacles(RecastContext& context, const std::vector<Obstacle>& obstacles,
+            const RecastSettings& settings, const AgentBounds& agentBounds, rcCompactHeightfield& compact)
+        {
+            // Walkable area is already eroded so obstacle is inflated by agent radius to keep the same distance
+            const float radius = getRadius(settings, agentBounds);
+            const float height = getHeight(settings, agentBounds);
+            const std::array offsets{
+                osg::Vec2f(-radius, -radius),
+                osg::Vec2f(-radius, radius),
+                osg::Vec2f(radius, -radius),
+                osg::Vec2f(radius, radius),
+            };
+
+            std::vector<osg::Vec2f> points;
+            std::vector<float> vertices;
+
+            for (const Obstacle& obstacle : obstacles)
+            {
+                float minY = std::numeric_limits<float>::max();
+                float maxY = -std::numeric_limits<float>::max();
+
+                points.clear();
+
+                for (const osg::Vec3f& corner : obstacle.mCorners)
+                {
+                    const osg::Vec3f position = toNavMeshCoordinates(settings, corner);
+                    minY = std::min(minY, position.y());
+                    maxY = std::max(maxY, position.y());
+                    for (const osg::Vec2f& offset : offsets)
+                        points.emplace_back(position.x() + offset.x(), position.z() + offset.y());
+                }
+
+                const std::vector<osg::Vec2f> hull = makeConvexHull(std::move(points));
+
+                if (hull.size() < 3)
+                    continue;
+
+                vertices.clear();
+
+                for (const osg::Vec2f& point : hull)
+                {
+                    vertices.push_back(point.x());
+                    vertices.push_back(maxY);
+                    vertices.push_back(point.y());
+                }
+
+                // Spans below the obstacle within agent height are not walkable as well
+                rcMarkConvexPolyArea(&context, vertices.data(), static_cast<int>(hull.size()), minY - height, maxY,
+                    AreaType_null, compact);
+            }
+        }
+
+        struct TileLayerHeader
+        {
+            int mWidth;
+            int mHeight;
+            int mSpanCount;
+            int mWalkableHeight;
+            int mWalkableClimb;
+            int mBorderSize;
+            unsigned short mMaxDistance;
+            unsigned short mMaxRegions;
+            std::array<float, 3> mBmin;
+            std::array<float, 3> mBmax;
+            float mCs;
+            float mCh;
+        };
+
+        template <class T>
+        std::byte* copyTo(std::byte* out, const T* data, std::size_t count)
+        {
+            std::memcpy(out, data, count * sizeof(T));
+            return out + count * sizeof(T);
+        }
+
+        template <class T>
+        const std::byte* copyFrom(const std::byte* in, T* data, std::size_t count)
+        {
+            std::memcpy(data, in, count * sizeof(T));
+            return in + count * sizeof(T);
+        }
+
+        std::size_t getTileLayerSize(const TileLayerHeader& header)
+        {
+            const std::size_t cells = static_cast<std::size_t>(header.mWidth) * header.mHeight;
+            const std::size_t spans = static_cast<std::size_t>(header.mSpanCount);
+            return sizeof(TileLayerHeader) + cells * sizeof(rcCompactCell) + spans * sizeof(rcCompactSpan)
+                + spans * sizeof(unsigned char);
+        }
+
+        // Distance field is not stored because it's built after obstacles are marked
+        std::vector<std::byte> writeTileLayer(const rcCompactHeightfield& compact)
+        {
+            TileLayerHeader header{
+                .mWidth = compact.width,
+                .mHeight = compact.height,
+                .mSpanCount = compact.spanCount,
+                .mWalkableHeight = compact.walkableHeight,
+                .mWalkableClimb = compact.walkableClimb,
+                .mBorderSize = compact.borderSize,
+                .mMaxDistance = compact.maxDistance,
+                .mMaxRegions = compact.maxRegions,
+                .mBmin = {},
+                .mBmax = {},
+                .mCs = compact.cs,
+                .mCh = compact.ch,
+            };
+            std::copy_n(compact.bmin, 3, header.mBmin.begin());
+            std::copy_n(compact.bmax, 3, header.mBmax.begin());
+
+            std::vector<std::byte> result(getTileLayerSize(header));
+            std::byte* out = copyTo(result.data(), &header, 1);
+            out = copyTo(out, compact.cells, static_cast<std::size_t>(compact.width) * compact.height);
+            out = copyTo(out, compact.spans, static_cast<std::size_t>(compact.spanCount));
+            copyTo(out, compact.areas, static_cast<std::size_t>(compact.spanCount));
+
+            return Misc::compress(result);
+        }
+
+        template <class T>
+        const std::byte* readRecastArray(const std::byte* in, T*& values, std::size_t count)
+        {
+            values = static_cast<T*>(permRecastAlloc(count * sizeof(T)));
+            return copyFrom(in, values, count);
+        }
+
+        [[nodiscard]] bool readTileLayer(const std::vector<std::byte>& layer, rcCompactHeightfield& compact)
+        {
+            const std::vector<std::byte> data = Misc::decompress(layer);
+
+            if (data.size() < sizeof(TileLayerHeader))
+                return false;
+
+            TileLayerHeader header;
+            const std::byte* in = copyFrom(data.data(), &header, 1);
+
+            if (header.mWidth < 0 || header.mHeight < 0 || header.mSpanCount < 0
+                || data.size() != getTileLayerSize(header))
+                return false;
+
+            compact.width = header.mWidth;
+            compact.height = header.mHeight;
+            compact.spanCount = header.mSpanCount;
+            compact.walkableHeight = header.mWalkableHeight;
+            compact.walkableClimb = header.mWalkableClimb;
+            compact.borderSize = header.mBorderSize;
+            compact.maxDistance = header.mMaxDistance;
+            compact.maxRegions = header.mMaxRegions;
+            std::copy(header.mBmin.begin(), header.mBmin.end(), compact.bmin);
+            std::copy(header.mBmax.begin(), header.mBmax.end(), compact.bmax);
+            compact.cs = header.mCs;
+            compact.ch = header.mCh;
+
+            // Arrays are owned by compact heightfield so they are freed by its destructor if allocation fails
+            in = readRecastArray(in, compact.cells, static_cast<std::size_t>(header.mWidth) * header.mHeight);
+            in = readRecastArray(in, compact.spans, static_cast<std::size_t>(header.mSpanCount));
+            readRecastArray(in, compact.areas, static_cast<std::size_t>(header.mSpanCount));
+
+            return true;
+        }
+
+        std::unique_ptr<PreparedNavMeshData> makePreparedNavMeshData(RecastContext& context,
+            const RecastSettings& settings, const RecastParams& params, rcCompactHeightfield& compact)
+        {
+            std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
+
+            if (!fillPolyMesh(context, settings, params, compact, result->mPolyMesh, result->mPolyMeshDetail))
+                return nullptr;
+
+            result->mCellSize = settings.mCellSize;
+            result->mCellHeight = settings.mCellHeight;
+
+            return result;
+        }
     }
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
@@ -521,32 +756,42 @@ namespace DetourNavigator
     {
         RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
-        const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+        const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        rcHeightfield solid;
-        if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
-                toNavMeshCoordinates(settings, maxZ), settings, solid))
+        rcCompactHeightfield compact;
+        if (!buildTileLayer(context, recastMesh, tilePosition, agentBounds, settings, params, compact))
             return nullptr;
 
-        const RecastParams params = makeRecastParams(settings, agentBounds);
+        markObstacles(context, recastMesh.getObstacles(), settings, agentBounds, compact);
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
-            return nullptr;
+        return makePreparedNavMeshData(context, settings, params, compact);
+    }
 
-        rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
-        rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
-        rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const std::shared_ptr<const RecastMesh>& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, const AgentBounds& agentBounds,
+        const RecastSettings& settings, TileLayerCache& tileLayerCache)
+    {
+        if (recastMesh->getObstacles().empty())
+            return prepareNavMeshTileData(*recastMesh, worldspace, tilePosition, agentBounds, settings);
 
-        std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
+        RecastContext context(worldspace, tilePosition, agentBounds, recastMesh->getVersion(), settings.mMaxLogLevel);
 
-        if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
-            return nullptr;
+        const RecastParams params = makeRecastParams(settings, agentBounds);
+
+        rcCompactHeightfield compact;
+        const std::shared_ptr<const std::vector<std::byte>> layer
+            = tileLayerCache.get(agentBounds, tilePosition, *recastMesh);
+        if (layer == nullptr || !readTileLayer(*layer, compact))
+        {
+            if (!buildTileLayer(context, *recastMesh, tilePosition, agentBounds, settings, params, compact))
+                return nullptr;
+
+            tileLayerCache.set(agentBounds, tilePosition, recastMesh, writeTileLayer(compact));
+        }
 
-        result->mCellSize = settings.mCellSize;
-        result->mCellHeight = settings.mCellHeight;
+        markObstacles(context, recastMesh->getObstacles(), settings, agentBounds, compact);
 
-        return result;
+        return makePreparedNavMeshData(context, settings, params, compact);
     }
 
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
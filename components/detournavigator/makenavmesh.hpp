@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    class TileLayerCache;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -46,6 +47,11 @@ namespace DetourNavigator
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
 
+    // Reuses rasterized geometry from the cache when only obstacles are changed
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const std::shared_ptr<const RecastMesh>& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, const AgentBounds& agentBounds,
+        const RecastSettings& settings, TileLayerCache& tileLayerCache);
+
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
         const TilePosition& tile, const RecastSettings& settings);
@@ -106,7 +106,8 @@ namespace DetourNavigator
             = 0;
 
         /**
-         * @brief addObject is used to add doors.
+         * @brief addObject is used to add doors. Door geometry is not rasterized, instead its bounding box marks
+         * covered area as not walkable, this makes navmesh update cheaper when door is moving.
          * @param id is used to distinguish different objects.
          * @param shape members must live until object is updated by another shape or removed from Navigator.
          * @param transform allows to setup objects geometry according to its world state.
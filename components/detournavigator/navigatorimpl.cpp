@@ -42,15 +42,16 @@ namespace DetourNavigator
     void NavigatorImpl::addObject(
         const ObjectId id, const ObjectShapes& shapes, const btTransform& transform, const UpdateGuard* guard)
     {
-        addObjectImpl(id, shapes, transform, guard);
+        addObjectImpl(id, shapes, transform, false, guard);
     }
 
-    bool NavigatorImpl::addObjectImpl(
-        const ObjectId id, const ObjectShapes& shapes, const btTransform& transform, const UpdateGuard* guard)
+    bool NavigatorImpl::addObjectImpl(const ObjectId id, const ObjectShapes& shapes, const btTransform& transform,
+        bool obstacle, const UpdateGuard* guard)
     {
         const CollisionShape collisionShape(
             shapes.mShapeInstance, *shapes.mShapeInstance->mCollisionShape, shapes.mTransform);
-        bool result = mNavMeshManager.addObject(id, collisionShape, transform, AreaType_ground, guard);
+        bool result = obstacle ? mNavMeshManager.addObstacle(id, collisionShape, transform, guard)
+                               : mNavMeshManager.addObject(id, collisionShape, transform, AreaType_ground, guard);
         if (const btCollisionShape* const avoidShape = shapes.mShapeInstance->mAvoidCollisionShape.get())
         {
             const ObjectId avoidId(avoidShape);
@@ -67,7 +68,8 @@ namespace DetourNavigator
     void NavigatorImpl::addObject(
         const ObjectId id, const DoorShapes& shapes, const btTransform& transform, const UpdateGuard* guard)
     {
-        if (addObjectImpl(id, static_cast<const ObjectShapes&>(shapes), transform, guard))
+        // Doors are moving so they are not rasterized to rebuild tile faster when door is opened or closed
+        if (addObjectImpl(id, static_cast<const ObjectShapes&>(shapes), transform, true, guard))
         {
             const osg::Vec3f start = toNavMeshCoordinates(mSettings.mRecast, shapes.mConnectionStart);
             const osg::Vec3f end = toNavMeshCoordinates(mSettings.mRecast, shapes.mConnectionEnd);
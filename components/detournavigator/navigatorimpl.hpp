@@ -81,8 +81,8 @@ namespace DetourNavigator
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
         std::unordered_map<ObjectId, ObjectId> mWaterIds;
 
-        inline bool addObjectImpl(
-            const ObjectId id, const ObjectShapes& shapes, const btTransform& transform, const UpdateGuard* guard);
+        inline bool addObjectImpl(const ObjectId id, const ObjectShapes& shapes, const btTransform& transform,
+            bool obstacle, const UpdateGuard* guard);
 
         inline void updateAvoidShapeId(const ObjectId id, const ObjectId avoidId, const UpdateGuard* guard);
 
@@ -115,6 +115,12 @@ namespace DetourNavigator
         return mRecastMeshManager.addObject(id, shape, transform, areaType, guard);
     }
 
+    bool NavMeshManager::addObstacle(
+        const ObjectId id, const CollisionShape& shape, const btTransform& transform, const UpdateGuard* guard)
+    {
+        return mRecastMeshManager.addObstacle(id, shape, transform, guard);
+    }
+
     bool NavMeshManager::updateObject(
         const ObjectId id, const btTransform& transform, const AreaType areaType, const UpdateGuard* guard)
     {
@@ -31,6 +31,9 @@ namespace DetourNavigator
         bool addObject(const ObjectId id, const CollisionShape& shape, const btTransform& transform,
             const AreaType areaType, const UpdateGuard* guard);
 
+        bool addObstacle(
+            const ObjectId id, const CollisionShape& shape, const btTransform& transform, const UpdateGuard* guard);
+
         bool updateObject(ObjectId id, const btTransform& transform, AreaType areaType, const UpdateGuard* guard);
 
         void removeObject(const ObjectId id, const UpdateGuard* guard);
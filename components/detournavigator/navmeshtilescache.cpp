@@ -47,7 +47,7 @@ namespace DetourNavigator
             removeLeastRecentlyUsed();
 
         RecastMeshData key{ recastMesh.getMesh(), recastMesh.getWater(), recastMesh.getHeightfields(),
-            recastMesh.getFlatHeightfields() };
+            recastMesh.getFlatHeightfields(), recastMesh.getObstacles() };
 
         const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize);
         const auto emplaced = mValues.emplace(
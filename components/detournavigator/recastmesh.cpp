@@ -18,17 +18,25 @@ namespace DetourNavigator
 
     RecastMesh::RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
         std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-        std::vector<MeshSource> meshSources)
+        std::vector<MeshSource> meshSources, std::vector<Obstacle> obstacles)
         : mVersion(version)
         , mMesh(std::move(mesh))
         , mWater(std::move(water))
         , mHeightfields(std::move(heightfields))
         , mFlatHeightfields(std::move(flatHeightfields))
         , mMeshSources(std::move(meshSources))
+        , mObstacles(std::move(obstacles))
     {
         mWater.shrink_to_fit();
         mHeightfields.shrink_to_fit();
         for (Heightfield& v : mHeightfields)
             v.mHeights.shrink_to_fit();
     }
+
+    bool hasSameGeometry(const RecastMesh& lhs, const RecastMesh& rhs)
+    {
+        return lhs.getMesh() == rhs.getMesh() && lhs.getWater() == rhs.getWater()
+            && lhs.getHeightfields() == rhs.getHeightfields()
+            && lhs.getFlatHeightfields() == rhs.getFlatHeightfields();
+    }
 }
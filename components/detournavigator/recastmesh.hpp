@@ -10,6 +10,7 @@
 #include <osg/Vec2i>
 #include <osg/Vec3f>
 
+#include <array>
 #include <cstdint>
 #include <numeric>
 #include <tuple>
@@ -39,6 +40,12 @@ namespace DetourNavigator
                 < std::tie(rhs.mIndices, rhs.mVertices, rhs.mAreaTypes);
         }
 
+        friend inline bool operator==(const Mesh& lhs, const Mesh& rhs) noexcept
+        {
+            return std::tie(lhs.mIndices, lhs.mVertices, lhs.mAreaTypes)
+                == std::tie(rhs.mIndices, rhs.mVertices, rhs.mAreaTypes);
+        }
+
         friend inline std::size_t getSize(const Mesh& value) noexcept
         {
             return value.mIndices.size() * sizeof(int) + value.mVertices.size() * sizeof(float)
@@ -58,6 +65,12 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const Water& lhs, const Water& rhs) noexcept
+    {
+        const auto tie = [](const Water& v) { return std::tie(v.mCellSize, v.mLevel); };
+        return tie(lhs) == tie(rhs);
+    }
+
     struct CellWater
     {
         osg::Vec2i mCellPosition;
@@ -70,6 +83,12 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const CellWater& lhs, const CellWater& rhs) noexcept
+    {
+        const auto tie = [](const CellWater& v) { return std::tie(v.mCellPosition, v.mWater); };
+        return tie(lhs) == tie(rhs);
+    }
+
     inline osg::Vec2f getWaterShift2d(const osg::Vec2i& cellPosition, int cellSize)
     {
         return osg::Vec2f((cellPosition.x() + 0.5f) * cellSize, (cellPosition.y() + 0.5f) * cellSize);
@@ -104,6 +123,11 @@ namespace DetourNavigator
         return makeTuple(lhs) < makeTuple(rhs);
     }
 
+    inline bool operator==(const Heightfield& lhs, const Heightfield& rhs) noexcept
+    {
+        return makeTuple(lhs) == makeTuple(rhs);
+    }
+
     struct FlatHeightfield
     {
         osg::Vec2i mCellPosition;
@@ -117,6 +141,24 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const FlatHeightfield& lhs, const FlatHeightfield& rhs) noexcept
+    {
+        const auto tie = [](const FlatHeightfield& v) { return std::tie(v.mCellPosition, v.mCellSize, v.mHeight); };
+        return tie(lhs) == tie(rhs);
+    }
+
+    // Oriented box of a moving object (like a door). Instead of being rasterized it marks covered area as not
+    // walkable so changing it doesn't require to rasterize the rest of the tile again.
+    struct Obstacle
+    {
+        std::array<osg::Vec3f, 8> mCorners;
+    };
+
+    inline bool operator<(const Obstacle& lhs, const Obstacle& rhs) noexcept
+    {
+        return lhs.mCorners < rhs.mCorners;
+    }
+
     struct MeshSource
     {
         osg::ref_ptr<const Resource::BulletShape> mShape;
@@ -129,7 +171,7 @@ namespace DetourNavigator
     public:
         explicit RecastMesh(const Version& version, Mesh mesh, std::vector<CellWater> water,
             std::vector<Heightfield> heightfields, std::vector<FlatHeightfield> flatHeightfields,
-            std::vector<MeshSource> sources);
+            std::vector<MeshSource> sources, std::vector<Obstacle> obstacles = {});
 
         const Version& getVersion() const noexcept { return mVersion; }
 
@@ -143,6 +185,8 @@ namespace DetourNavigator
 
         const std::vector<MeshSource>& getMeshSources() const noexcept { return mMeshSources; }
 
+        const std::vector<Obstacle>& getObstacles() const noexcept { return mObstacles; }
+
     private:
         Version mVersion;
         Mesh mMesh;
@@ -150,6 +194,7 @@ namespace DetourNavigator
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
         std::vector<MeshSource> mMeshSources;
+        std::vector<Obstacle> mObstacles;
 
         friend inline std::size_t getSize(const RecastMesh& value) noexcept
         {
@@ -157,9 +202,13 @@ namespace DetourNavigator
                 + value.mHeightfields.size() * sizeof(Heightfield)
                 + std::accumulate(value.mHeightfields.begin(), value.mHeightfields.end(), std::size_t{ 0 },
                     [](std::size_t r, const Heightfield& v) { return r + v.mHeights.size() * sizeof(float); })
-                + value.mFlatHeightfields.size() * sizeof(FlatHeightfield);
+                + value.mFlatHeightfields.size() * sizeof(FlatHeightfield)
+                + value.mObstacles.size() * sizeof(Obstacle);
         }
     };
+
+    // Returns true if recast meshes have the same rasterized geometry, obstacles are not compared
+    bool hasSameGeometry(const RecastMesh& lhs, const RecastMesh& rhs);
 }
 
 #endif
@@ -216,6 +216,33 @@ namespace DetourNavigator
         }
     }
 
+    void RecastMeshBuilder::addObstacle(const btCollisionShape& shape, const btTransform& transform)
+    {
+        // Each child has own box to not cover the area between rotated or shifted parts
+        if (shape.isCompound())
+        {
+            const btCompoundShape& compound = static_cast<const btCompoundShape&>(shape);
+            for (int i = 0, num = compound.getNumChildShapes(); i < num; ++i)
+                addObstacle(*compound.getChildShape(i), transform * compound.getChildTransform(i));
+            return;
+        }
+
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+
+        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+
+        Obstacle obstacle;
+        for (std::size_t i = 0; i < obstacle.mCorners.size(); ++i)
+        {
+            const btVector3 corner((i & 1) == 0 ? aabbMin.x() : aabbMax.x(), (i & 2) == 0 ? aabbMin.y() : aabbMax.y(),
+                (i & 4) == 0 ? aabbMin.z() : aabbMax.z());
+            obstacle.mCorners[i] = Misc::Convert::toOsg(transform(corner));
+        }
+
+        mObstacles.push_back(obstacle);
+    }
+
     void RecastMeshBuilder::addWater(const osg::Vec2i& cellPosition, const Water& water)
     {
         mWater.push_back(CellWater{ cellPosition, water });
@@ -273,9 +300,10 @@ namespace DetourNavigator
         std::sort(mWater.begin(), mWater.end());
         std::sort(mHeightfields.begin(), mHeightfields.end());
         std::sort(mFlatHeightfields.begin(), mFlatHeightfields.end());
+        std::sort(mObstacles.begin(), mObstacles.end());
         Mesh mesh = makeMesh(std::move(mTriangles));
         return std::make_shared<RecastMesh>(version, std::move(mesh), std::move(mWater), std::move(mHeightfields),
-            std::move(mFlatHeightfields), std::move(mSources));
+            std::move(mFlatHeightfields), std::move(mSources), std::move(mObstacles));
     }
 
     void RecastMeshBuilder::addObject(
@@ -108,6 +108,12 @@ namespace DetourNavigator
                 visitor(*this, value.mHeight);
             }
 
+            template <class Visitor>
+            void operator()(Visitor&& visitor, const Obstacle& value) const
+            {
+                visitor(*this, value.mCorners);
+            }
+
             template <class Visitor>
             void operator()(Visitor&& visitor, const RecastMesh& value) const
             {
@@ -147,6 +153,9 @@ namespace DetourNavigator
                 visitor(*this, agentBounds);
                 visitor(*this, recastMesh);
                 visitor(*this, dbRefGeometryObjects);
+                // Written only when present to keep keys for tiles without obstacles the same as before
+                if (!recastMesh.getObstacles().empty())
+                    visitor(*this, recastMesh.getObstacles());
             }
 
             template <class Visitor, class T>
@@ -31,6 +31,11 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCache.mCachedNavMeshTiles));
             out.setAttribute(frameNumber, "NavMesh Cache Get", static_cast<double>(stats.mCache.mGetCount));
             out.setAttribute(frameNumber, "NavMesh Cache Hit", static_cast<double>(stats.mCache.mHitCount));
+
+            out.setAttribute(frameNumber, "NavMesh LayerCache Size", static_cast<double>(stats.mLayerCache.mSize));
+            out.setAttribute(frameNumber, "NavMesh LayerCache Items", static_cast<double>(stats.mLayerCache.mItems));
+            out.setAttribute(frameNumber, "NavMesh LayerCache Get", static_cast<double>(stats.mLayerCache.mGetCount));
+            out.setAttribute(frameNumber, "NavMesh LayerCache Hit", static_cast<double>(stats.mLayerCache.mHitCount));
         }
 
         void reportStats(const TileCachedRecastMeshManagerStats& stats, unsigned int frameNumber, osg::Stats& out)
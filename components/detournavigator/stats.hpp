@@ -39,6 +39,14 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    struct TileLayerCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mItems = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+    };
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
@@ -48,6 +56,7 @@ namespace DetourNavigator
         std::size_t mDbGetTileHits = 0;
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
+        TileLayerCacheStats mLayerCache;
     };
 
     struct TileCachedRecastMeshManagerStats
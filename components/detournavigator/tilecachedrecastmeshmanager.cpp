@@ -12,12 +12,21 @@
 
 #include <boost/geometry/geometry.hpp>
 
+#include <algorithm>
 #include <limits>
 
 namespace DetourNavigator
 {
     namespace
     {
+        // Lying objects like closed trapdoors are walked over so they can't be marked as not walkable
+        bool isUpright(const btCollisionShape& shape, const btTransform& transform)
+        {
+            const btAABB aabb = BulletHelpers::getAabb(shape, transform);
+            const btVector3 size = aabb.m_max - aabb.m_min;
+            return size.z() >= std::min(size.x(), size.y());
+        }
+
         const TilesPositionsRange infiniteRange{
             .mBegin = TilePosition(std::numeric_limits<int>::min(), std::numeric_limits<int>::min()),
             .mEnd = TilePosition(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()),
@@ -158,6 +167,19 @@ namespace DetourNavigator
 
     bool TileCachedRecastMeshManager::addObject(ObjectId id, const CollisionShape& shape, const btTransform& transform,
         const AreaType areaType, const UpdateGuard* guard)
+    {
+        return addObjectImpl(id, shape, transform, areaType, false, guard);
+    }
+
+    bool TileCachedRecastMeshManager::addObstacle(
+        ObjectId id, const CollisionShape& shape, const btTransform& transform, const UpdateGuard* guard)
+    {
+        // Area type is not used for obstacles but update with ground area type should not be considered as a change
+        return addObjectImpl(id, shape, transform, AreaType_ground, isUpright(shape.getShape(), transform), guard);
+    }
+
+    bool TileCachedRecastMeshManager::addObjectImpl(ObjectId id, const CollisionShape& shape,
+        const btTransform& transform, const AreaType areaType, bool obstacle, const UpdateGuard* guard)
     {
         const TilesPositionsRange range = makeTilesPositionsRange(shape.getShape(), transform, mSettings);
         {
@@ -171,6 +193,7 @@ namespace DetourNavigator
                       .emplace_hint(it, id,
                           std::unique_ptr<ObjectData>(new ObjectData{
                               .mObject = RecastMeshObject(shape, transform, areaType),
+                              .mObstacle = obstacle,
                               .mRange = range,
                               .mAabb = CommulativeAabb(revision, BulletHelpers::getAabb(shape.getShape(), transform)),
                               .mGeneration = mGeneration,
@@ -490,7 +513,7 @@ namespace DetourNavigator
     {
         RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, tilePosition));
         using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
-            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
+            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType, bool>;
         std::vector<Object> objects;
         Version version;
         bool hasInput = false;
@@ -513,7 +536,7 @@ namespace DetourNavigator
             {
                 const auto& object = it->second->mObject;
                 objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                    object.getTransform(), object.getAreaType(), it->second->mObstacle);
                 hasInput = true;
             }
             if (hasInput)
@@ -530,8 +553,13 @@ namespace DetourNavigator
         }
         if (!hasInput)
             return nullptr;
-        for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
-            builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        for (const auto& [instance, objectTransform, shape, transform, areaType, obstacle] : objects)
+        {
+            if (obstacle)
+                builder.addObstacle(shape, transform);
+            else
+                builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        }
         return std::move(builder).create(version);
     }
 
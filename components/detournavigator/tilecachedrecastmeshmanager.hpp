@@ -52,6 +52,11 @@ namespace DetourNavigator
         bool addObject(ObjectId id, const CollisionShape& shape, const btTransform& transform, AreaType areaType,
             const UpdateGuard* guard);
 
+        // Adds object represented by its oriented bounding boxes marking not walkable area instead of geometry.
+        // Object which is not upright (like a closed trapdoor) is added as a regular ground object.
+        bool addObstacle(ObjectId id, const CollisionShape& shape, const btTransform& transform,
+            const UpdateGuard* guard);
+
         bool updateObject(ObjectId id, const btTransform& transform, AreaType areaType, const UpdateGuard* guard);
 
         void removeObject(ObjectId id, const UpdateGuard* guard);
@@ -91,6 +96,7 @@ namespace DetourNavigator
         struct ObjectData
         {
             RecastMeshObject mObject;
+            bool mObstacle = false;
             TilesPositionsRange mRange;
             CommulativeAabb mAabb;
             std::size_t mGeneration = 0;
@@ -159,6 +165,9 @@ namespace DetourNavigator
         inline static auto makeIndexQuery(const TilePosition& tilePosition)
             -> decltype(boost::geometry::index::intersects(IndexBox()));
 
+        inline bool addObjectImpl(ObjectId id, const CollisionShape& shape, const btTransform& transform,
+            AreaType areaType, bool obstacle, const UpdateGuard* guard);
+
         inline std::shared_ptr<RecastMesh> makeMesh(const TilePosition& tilePosition) const;
 
         inline void addChangedTiles(const std::optional<TilesPositionsRange>& range, ChangeType changeType);
@@ -0,0 +1,74 @@
+#include "tilelayercache.hpp"
+#include "recastmesh.hpp"
+#include "stats.hpp"
+
+namespace DetourNavigator
+{
+    TileLayerCache::TileLayerCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const std::vector<std::byte>> TileLayerCache::get(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh)
+    {
+        const std::lock_guard lock(mMutex);
+
+        ++mGetCount;
+
+        const auto it = mValues.find(std::tie(agentBounds, tilePosition));
+        if (it == mValues.end() || !hasSameGeometry(*it->second->mRecastMesh, recastMesh))
+            return nullptr;
+
+        mItems.splice(mItems.begin(), mItems, it->second);
+
+        ++mHitCount;
+
+        return it->second->mLayer;
+    }
+
+    void TileLayerCache::set(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+        std::shared_ptr<const RecastMesh> recastMesh, std::vector<std::byte>&& layer)
+    {
+        const std::size_t size = sizeof(RecastMesh) + getSize(*recastMesh) + layer.size();
+
+        const std::lock_guard lock(mMutex);
+
+        if (const auto it = mValues.find(std::tie(agentBounds, tilePosition)); it != mValues.end())
+            remove(it->second);
+
+        if (size > mMaxSize)
+            return;
+
+        while (!mItems.empty() && mSize + size > mMaxSize)
+            remove(std::prev(mItems.end()));
+
+        mItems.push_front(Item{
+            .mAgentBounds = agentBounds,
+            .mTilePosition = tilePosition,
+            .mRecastMesh = std::move(recastMesh),
+            .mLayer = std::make_shared<const std::vector<std::byte>>(std::move(layer)),
+            .mSize = size,
+        });
+        mValues.emplace(std::make_tuple(agentBounds, tilePosition), mItems.begin());
+        mSize += size;
+    }
+
+    TileLayerCacheStats TileLayerCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return TileLayerCacheStats{
+            .mSize = mSize,
+            .mItems = mItems.size(),
+            .mGetCount = mGetCount,
+            .mHitCount = mHitCount,
+        };
+    }
+
+    void TileLayerCache::remove(ItemIterator iterator)
+    {
+        mSize -= iterator->mSize;
+        mValues.erase(std::make_tuple(iterator->mAgentBounds, iterator->mTilePosition));
+        mItems.erase(iterator);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILELAYERCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILELAYERCACHE_H
+
+#include "agentbounds.hpp"
+#include "tileposition.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct TileLayerCacheStats;
+
+    // Stores compressed rasterized tile geometry without obstacles. Allows to rebuild a tile after an obstacle change
+    // without rasterizing the geometry again.
+    class TileLayerCache
+    {
+    public:
+        explicit TileLayerCache(std::size_t maxSize);
+
+        std::shared_ptr<const std::vector<std::byte>> get(
+            const AgentBounds& agentBounds, const TilePosition& tilePosition, const RecastMesh& recastMesh);
+
+        void set(const AgentBounds& agentBounds, const TilePosition& tilePosition,
+            std::shared_ptr<const RecastMesh> recastMesh, std::vector<std::byte>&& layer);
+
+        TileLayerCacheStats getStats() const;
+
+    private:
+        struct Item
+        {
+            AgentBounds mAgentBounds;
+            TilePosition mTilePosition;
+            std::shared_ptr<const RecastMesh> mRecastMesh;
+            std::shared_ptr<const std::vector<std::byte>> mLayer;
+            std::size_t mSize;
+        };
+
+        using ItemIterator = std::list<Item>::iterator;
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::size_t mSize = 0;
+        std::size_t mGetCount = 0;
+        std::size_t mHitCount = 0;
+        std::list<Item> mItems;
+        std::map<std::tuple<AgentBounds, TilePosition>, ItemIterator> mValues;
+
+        void remove(ItemIterator iterator);
+    };
+}
+
+#endif
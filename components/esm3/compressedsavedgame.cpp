@@ -0,0 +1,319 @@
+#include "compressedsavedgame.hpp"
+
+#include "esmreader.hpp"
+
+#include <components/esm/defs.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/files/openfile.hpp>
+#include <components/misc/compression.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+
+namespace ESM
+{
+    namespace
+    {
+        constexpr std::array<char, 8> sSignature = { 'O', 'M', 'W', 'S', 'A', 'V', 'E', 'Z' };
+        constexpr std::uint32_t sVersion = 1;
+        // Large enough for a good compression ratio, small enough to load a single cell state without decompressing
+        // much more and to split a saved game into many chunks for parallel decompression
+        constexpr std::size_t sMaxChunkSize = 256 * 1024;
+
+        struct ChunkRange
+        {
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        template <class T>
+        void writeUint(std::ostream& stream, T value)
+        {
+            std::array<char, sizeof(T)> buffer;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+                buffer[i] = static_cast<char>(value >> (i * 8));
+            stream.write(buffer.data(), buffer.size());
+        }
+
+        template <class T>
+        T decodeUint(std::span<const std::byte, sizeof(T)> data)
+        {
+            T result = 0;
+            for (std::size_t i = 0; i < data.size(); ++i)
+                result |= static_cast<T>(data[i]) << (i * 8);
+            return result;
+        }
+
+        template <class T>
+        T readUint(std::istream& stream)
+        {
+            std::array<std::byte, sizeof(T)> buffer;
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+                throw std::runtime_error("Unexpected end of compressed saved game");
+            return decodeUint<T>(buffer);
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string result(readUint<std::uint32_t>(stream), '\0');
+            if (!stream.read(result.data(), result.size()))
+                throw std::runtime_error("Unexpected end of compressed saved game");
+            return result;
+        }
+
+        // Calls process for each index in [0, count) on the calling thread and up to threads - 1 helper threads
+        template <class Process>
+        void parallelFor(std::size_t threads, std::size_t count, Process&& process)
+        {
+            std::atomic_size_t next = 0;
+            const auto run = [&] {
+                for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+                    process(i);
+            };
+            std::vector<std::future<void>> helpers;
+            for (std::size_t i = 1; i < std::min(threads, count); ++i)
+                helpers.push_back(std::async(std::launch::async, run));
+            run();
+            for (std::future<void>& helper : helpers)
+                helper.get();
+        }
+
+        std::string decompressChunks(const std::vector<SavedGameChunk>& chunks, std::span<const std::byte> data,
+            std::size_t threads)
+        {
+            std::vector<std::size_t> offsets;
+            std::vector<std::size_t> compressedOffsets;
+            offsets.reserve(chunks.size() + 1);
+            compressedOffsets.reserve(chunks.size() + 1);
+            offsets.push_back(0);
+            compressedOffsets.push_back(0);
+            for (const SavedGameChunk& chunk : chunks)
+            {
+                offsets.push_back(offsets.back() + static_cast<std::size_t>(chunk.mSize));
+                compressedOffsets.push_back(compressedOffsets.back() + static_cast<std::size_t>(chunk.mCompressedSize));
+            }
+
+            if (compressedOffsets.back() > data.size())
+                throw std::runtime_error("Compressed saved game is truncated");
+
+            std::string result(offsets.back(), '\0');
+
+            const std::span<std::byte> output = std::as_writable_bytes(std::span(result));
+
+            parallelFor(threads, chunks.size(), [&](std::size_t i) {
+                const std::span<const std::byte> chunk
+                    = data.subspan(compressedOffsets[i], compressedOffsets[i + 1] - compressedOffsets[i]);
+                if (chunk.size() < sizeof(std::uint64_t))
+                    throw std::runtime_error(
+                        "Compressed saved game chunk is too small: " + std::to_string(chunk.size()));
+                const std::uint64_t size = decodeUint<std::uint64_t>(chunk.first<sizeof(std::uint64_t)>());
+                if (size != chunks[i].mSize)
+                    throw std::runtime_error("Size of compressed saved game chunk (" + std::to_string(size)
+                        + ") doesn't match index (" + std::to_string(chunks[i].mSize) + ")");
+                Misc::decompressBlock(
+                    chunk.subspan(sizeof(std::uint64_t)), output.subspan(offsets[i], offsets[i + 1] - offsets[i]));
+            });
+
+            return result;
+        }
+
+        template <class Read>
+        void openSavedGameImpl(ESMReader& reader, const std::filesystem::path& path, Read&& read)
+        {
+            std::unique_ptr<std::ifstream> stream = Files::openBinaryInputFileStream(path);
+            if (!isCompressedSavedGame(*stream))
+            {
+                reader.open(std::move(stream), path);
+                return;
+            }
+            CompressedSavedGameReader savedGameReader(*stream);
+            reader.open(std::make_unique<std::istringstream>(read(savedGameReader)), path);
+        }
+    }
+
+    bool isCompressedSavedGame(std::istream& stream)
+    {
+        const std::istream::pos_type position = stream.tellg();
+        std::array<char, sSignature.size()> signature;
+        const bool result = stream.read(signature.data(), signature.size()) && signature == sSignature;
+        stream.clear();
+        stream.seekg(position);
+        return result;
+    }
+
+    void writeCompressedSavedGame(std::string_view records, std::ostream& stream, std::size_t threads)
+    {
+        SavedGameIndex index;
+        std::vector<ChunkRange> ranges;
+
+        {
+            ESMReader reader;
+            reader.open(std::make_unique<Files::IMemStream>(records.data(), records.size()), "saved game");
+
+            // File header and saved game profile
+            const std::size_t profileBegin = reader.getFileOffset();
+            if (reader.hasMoreRecs())
+            {
+                reader.getRecName();
+                reader.getRecHeader();
+                reader.skipRecord();
+            }
+            ranges.push_back(ChunkRange{ 0, reader.getFileOffset() });
+            index.mChunks.push_back(
+                SavedGameChunk{ esm3Recname("TES3"), profileBegin < reader.getFileOffset() ? 2u : 1u });
+
+            while (reader.hasMoreRecs())
+            {
+                const std::size_t begin = reader.getFileOffset();
+                const NAME name = reader.getRecName();
+                reader.getRecHeader();
+                if (name == REC_CSTA)
+                    index.mCells.emplace_back(reader.getCellId(), 0);
+                reader.skipRecord();
+                const std::size_t end = reader.getFileOffset();
+
+                SavedGameChunk& last = index.mChunks.back();
+                if (index.mChunks.size() == 1 || last.mRecordType != name.toInt()
+                    || end - ranges.back().mBegin > sMaxChunkSize)
+                {
+                    ranges.push_back(ChunkRange{ begin, end });
+                    index.mChunks.push_back(SavedGameChunk{ name.toInt(), 1 });
+                }
+                else
+                {
+                    ranges.back().mEnd = end;
+                    ++last.mRecordCount;
+                }
+
+                if (name == REC_CSTA)
+                    index.mCells.back().second = static_cast<std::uint32_t>(index.mChunks.size() - 1);
+            }
+        }
+
+        std::vector<std::vector<std::byte>> compressed(ranges.size());
+        parallelFor(threads, ranges.size(), [&](std::size_t i) {
+            const std::span<const std::byte> data = std::as_bytes(std::span(records));
+            compressed[i] = Misc::compressBlock(data.subspan(ranges[i].mBegin, ranges[i].mEnd - ranges[i].mBegin));
+        });
+
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            index.mChunks[i].mSize = ranges[i].mEnd - ranges[i].mBegin;
+            index.mChunks[i].mCompressedSize = sizeof(std::uint64_t) + compressed[i].size();
+        }
+
+        stream.write(sSignature.data(), sSignature.size());
+        writeUint(stream, sVersion);
+        writeUint(stream, static_cast<std::uint32_t>(index.mChunks.size()));
+        for (const SavedGameChunk& chunk : index.mChunks)
+        {
+            writeUint(stream, chunk.mRecordType);
+            writeUint(stream, chunk.mRecordCount);
+            writeUint(stream, chunk.mSize);
+            writeUint(stream, chunk.mCompressedSize);
+        }
+        writeUint(stream, static_cast<std::uint32_t>(index.mCells.size()));
+        for (const auto& [cellId, chunk] : index.mCells)
+        {
+            writeString(stream, cellId.serializeText());
+            writeUint(stream, chunk);
+        }
+        // Each chunk is prefixed by its decompressed size
+        for (std::size_t i = 0; i < compressed.size(); ++i)
+        {
+            writeUint(stream, index.mChunks[i].mSize);
+            const std::vector<std::byte>& chunk = compressed[i];
+            stream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        }
+    }
+
+    CompressedSavedGameReader::CompressedSavedGameReader(std::istream& stream)
+        : mStream(stream)
+    {
+        std::array<char, sSignature.size()> signature;
+        if (!mStream.read(signature.data(), signature.size()) || signature != sSignature)
+            throw std::runtime_error("Invalid compressed saved game signature");
+        const std::uint32_t version = readUint<std::uint32_t>(mStream);
+        if (version != sVersion)
+            throw std::runtime_error("Unsupported compressed saved game version: " + std::to_string(version));
+
+        mIndex.mChunks.resize(readUint<std::uint32_t>(mStream));
+        for (SavedGameChunk& chunk : mIndex.mChunks)
+        {
+            chunk.mRecordType = readUint<std::uint32_t>(mStream);
+            chunk.mRecordCount = readUint<std::uint32_t>(mStream);
+            chunk.mSize = readUint<std::uint64_t>(mStream);
+            chunk.mCompressedSize = readUint<std::uint64_t>(mStream);
+        }
+        if (mIndex.mChunks.empty())
+            throw std::runtime_error("Compressed saved game has no chunks");
+
+        mIndex.mCells.resize(readUint<std::uint32_t>(mStream));
+        for (auto& [cellId, chunk] : mIndex.mCells)
+        {
+            cellId = RefId::deserializeText(readString(mStream));
+            chunk = readUint<std::uint32_t>(mStream);
+            if (chunk >= mIndex.mChunks.size())
+                throw std::runtime_error("Invalid chunk index for cell " + cellId.toDebugString());
+        }
+
+        mDataOffset = static_cast<std::uint64_t>(mStream.tellg());
+    }
+
+    std::uint64_t CompressedSavedGameReader::getSize() const
+    {
+        std::uint64_t result = 0;
+        for (const SavedGameChunk& chunk : mIndex.mChunks)
+            result += chunk.mSize;
+        return result;
+    }
+
+    std::string CompressedSavedGameReader::readProfile()
+    {
+        const SavedGameChunk& chunk = mIndex.mChunks.front();
+        std::vector<std::byte> data(static_cast<std::size_t>(chunk.mCompressedSize));
+        mStream.seekg(static_cast<std::streamoff>(mDataOffset));
+        if (!mStream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+            throw std::runtime_error("Compressed saved game is truncated");
+        return decompressChunks({ chunk }, data, 1);
+    }
+
+    std::string CompressedSavedGameReader::readAll(std::size_t threads)
+    {
+        std::uint64_t size = 0;
+        for (const SavedGameChunk& chunk : mIndex.mChunks)
+            size += chunk.mCompressedSize;
+        // Read everything at once, decompression is the part that is done in parallel
+        std::vector<std::byte> data(static_cast<std::size_t>(size));
+        mStream.seekg(static_cast<std::streamoff>(mDataOffset));
+        if (!mStream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
+            throw std::runtime_error("Compressed saved game is truncated");
+        return decompressChunks(mIndex.mChunks, data, threads);
+    }
+
+    void openSavedGame(ESMReader& reader, const std::filesystem::path& path, std::size_t threads)
+    {
+        openSavedGameImpl(
+            reader, path, [&](CompressedSavedGameReader& savedGame) { return savedGame.readAll(threads); });
+    }
+
+    void openSavedGameProfile(ESMReader& reader, const std::filesystem::path& path)
+    {
+        openSavedGameImpl(reader, path, [](CompressedSavedGameReader& savedGame) { return savedGame.readProfile(); });
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef OPENMW_COMPONENTS_ESM3_COMPRESSEDSAVEDGAME_H
+#define OPENMW_COMPONENTS_ESM3_COMPRESSEDSAVEDGAME_H
+
+#include <components/esm/refid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    class ESMReader;
+
+    /// @brief Sequence of whole records compressed independently from the rest of the saved game.
+    struct SavedGameChunk
+    {
+        // Type of the first record
+        std::uint32_t mRecordType;
+        std::uint32_t mRecordCount;
+        std::uint64_t mSize;
+        std::uint64_t mCompressedSize;
+    };
+
+    struct SavedGameIndex
+    {
+        std::vector<SavedGameChunk> mChunks;
+        // Index of the chunk holding state of each saved cell
+        std::vector<std::pair<RefId, std::uint32_t>> mCells;
+    };
+
+    /// Check whether the stream starts with the compressed saved game signature. Doesn't change the stream position.
+    bool isCompressedSavedGame(std::istream& stream);
+
+    /// Write records produced by ESMWriter as a compressed saved game. Records are split into chunks of the same type
+    /// and limited size compressed by up to threads threads. The first chunk holds only the file header and the saved
+    /// game profile.
+    void writeCompressedSavedGame(std::string_view records, std::ostream& stream, std::size_t threads);
+
+    /// @brief Reads index and chunks of a compressed saved game.
+    class CompressedSavedGameReader
+    {
+    public:
+        /// Read the signature and the index, chunks are read on demand.
+        explicit CompressedSavedGameReader(std::istream& stream);
+
+        const SavedGameIndex& getIndex() const { return mIndex; }
+
+        /// Total size of the decompressed records.
+        std::uint64_t getSize() const;
+
+        /// Read and decompress the first chunk which is enough to read the saved game profile.
+        std::string readProfile();
+
+        /// Read all chunks and decompress them by up to threads threads.
+        std::string readAll(std::size_t threads);
+
+    private:
+        std::istream& mStream;
+        SavedGameIndex mIndex;
+        std::uint64_t mDataOffset;
+    };
+
+    /// Open a saved game in either format, compressed chunks are decompressed by up to threads threads.
+    void openSavedGame(ESMReader& reader, const std::filesystem::path& path, std::size_t threads);
+
+    /// Open a saved game in either format to read only the saved game profile.
+    void openSavedGameProfile(ESMReader& reader, const std::filesystem::path& path);
+}
+
+#endif
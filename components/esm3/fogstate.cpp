@@ -8,52 +8,130 @@
 #include <components/debug/debuglog.hpp>
 #include <components/files/memorystream.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 namespace ESM
 {
     namespace
     {
-        void convertFogOfWar(std::vector<char>& imageData)
+        constexpr std::size_t maxLiteralLength = 128;
+        constexpr std::size_t minRepeatLength = 3;
+        constexpr std::size_t maxRepeatLength = 255 - maxLiteralLength + minRepeatLength;
+
+        // Header byte below maxLiteralLength is followed by header + 1 literal values, otherwise by a single value
+        // repeated header - maxLiteralLength + minRepeatLength times.
+        std::size_t getRepeatLength(std::span<const std::uint8_t> alpha, std::size_t index)
         {
-            if (imageData.empty())
-            {
-                return;
-            }
+            std::size_t length = 1;
+            while (index + length < alpha.size() && length < maxRepeatLength && alpha[index + length] == alpha[index])
+                ++length;
+            return length;
+        }
 
-            osgDB::ReaderWriter* tgaReader = osgDB::Registry::instance()->getReaderWriterForExtension("tga");
-            if (!tgaReader)
+        std::vector<char> convertFogOfWar(const std::vector<char>& imageData, const std::string& extension)
+        {
+            osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(extension);
+            if (!reader)
             {
-                Log(Debug::Error) << "Error: Unable to load fog, can't find a tga ReaderWriter";
-                return;
+                Log(Debug::Error) << "Error: Unable to load fog, can't find a " << extension << " ReaderWriter";
+                return {};
             }
 
             Files::IMemStream in(imageData.data(), imageData.size());
 
-            osgDB::ReaderWriter::ReadResult result = tgaReader->readImage(in);
+            osgDB::ReaderWriter::ReadResult result = reader->readImage(in);
             if (!result.success())
             {
                 Log(Debug::Error) << "Error: Failed to read fog: " << result.message() << " code " << result.status();
-                return;
+                return {};
             }
 
-            osgDB::ReaderWriter* pngWriter = osgDB::Registry::instance()->getReaderWriterForExtension("png");
-            if (!pngWriter)
+            // Images were stored bottom to top
+            osg::Image& image = *result.getImage();
+            image.flipVertical();
+
+            if (image.s() <= 0 || image.t() <= 0)
+                return {};
+
+            // Older versions used other resolutions, sample the image bilinearly at the texel centers
+            constexpr int resolution = FogTexture::sResolution;
+            const auto getAlpha = [&](int s, int t) {
+                return image.getColor(std::clamp(s, 0, image.s() - 1), std::clamp(t, 0, image.t() - 1)).a();
+            };
+            std::vector<std::uint8_t> alpha;
+            alpha.reserve(resolution * resolution);
+            for (int t = 0; t < resolution; ++t)
             {
-                Log(Debug::Error) << "Error: Unable to write fog, can't find a png ReaderWriter";
-                return;
+                const float y = (t + 0.5f) * image.t() / resolution - 0.5f;
+                const int t0 = static_cast<int>(std::floor(y));
+                const float fy = y - t0;
+                for (int s = 0; s < resolution; ++s)
+                {
+                    const float x = (s + 0.5f) * image.s() / resolution - 0.5f;
+                    const int s0 = static_cast<int>(std::floor(x));
+                    const float fx = x - s0;
+                    const float value = (getAlpha(s0, t0) * (1 - fx) + getAlpha(s0 + 1, t0) * fx) * (1 - fy)
+                        + (getAlpha(s0, t0 + 1) * (1 - fx) + getAlpha(s0 + 1, t0 + 1) * fx) * fy;
+                    alpha.push_back(static_cast<std::uint8_t>(std::clamp(value, 0.f, 1.f) * 255 + 0.5f));
+                }
             }
 
-            std::ostringstream ostream;
-            osgDB::ReaderWriter::WriteResult png = pngWriter->writeImage(*result.getImage(), ostream);
-            if (!png.success())
+            return packFogOfWar(alpha);
+        }
+    }
+
+    std::vector<char> packFogOfWar(std::span<const std::uint8_t> alpha)
+    {
+        std::vector<char> result;
+        std::size_t index = 0;
+        while (index < alpha.size())
+        {
+            const std::size_t repeatLength = getRepeatLength(alpha, index);
+            if (repeatLength >= minRepeatLength)
             {
-                Log(Debug::Error) << "Error: Unable to write fog: " << png.message() << " code " << png.status();
-                return;
+                result.push_back(static_cast<char>(repeatLength - minRepeatLength + maxLiteralLength));
+                result.push_back(static_cast<char>(alpha[index]));
+                index += repeatLength;
+                continue;
             }
-
-            std::string str = ostream.str();
-            imageData = std::vector<char>(str.begin(), str.end());
+            const std::size_t literalStart = index;
+            while (index < alpha.size() && index - literalStart < maxLiteralLength
+                && (index == literalStart || getRepeatLength(alpha, index) < minRepeatLength))
+                ++index;
+            result.push_back(static_cast<char>(index - literalStart - 1));
+            result.insert(result.end(), alpha.begin() + literalStart, alpha.begin() + index);
         }
+        return result;
+    }
 
+    bool unpackFogOfWar(std::span<const char> data, std::span<std::uint8_t> alpha)
+    {
+        std::size_t in = 0;
+        std::size_t out = 0;
+        while (in < data.size())
+        {
+            const std::size_t header = static_cast<std::uint8_t>(data[in++]);
+            if (header < maxLiteralLength)
+            {
+                const std::size_t length = header + 1;
+                if (in + length > data.size() || out + length > alpha.size())
+                    return false;
+                std::copy_n(data.begin() + in, length, alpha.begin() + out);
+                in += length;
+                out += length;
+            }
+            else
+            {
+                const std::size_t length = header - maxLiteralLength + minRepeatLength;
+                if (in == data.size() || out + length > alpha.size())
+                    return false;
+                std::fill_n(alpha.begin() + out, length, static_cast<std::uint8_t>(data[in++]));
+                out += length;
+            }
+        }
+        return out == alpha.size();
     }
 
     void FogState::load(ESMReader& esm)
@@ -79,8 +157,10 @@ namespace ESM
             tex.mImageData.resize(imageSize);
             esm.getExact(tex.mImageData.data(), imageSize);
 
-            if (dataFormat <= MaxOldFogOfWarFormatVersion)
-                convertFogOfWar(tex.mImageData);
+            if (dataFormat <= MaxOldFogOfWarFormatVersion && !tex.mImageData.empty())
+                tex.mImageData = convertFogOfWar(tex.mImageData, "tga");
+            else if (dataFormat <= MaxPngFogOfWarFormatVersion && !tex.mImageData.empty())
+                tex.mImageData = convertFogOfWar(tex.mImageData, "png");
 
             mFogTextures.push_back(std::move(tex));
         }
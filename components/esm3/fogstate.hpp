@@ -2,6 +2,7 @@
 #define OPENMW_ESM_FOGSTATE_H
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace ESM
@@ -11,10 +12,22 @@ namespace ESM
 
     struct FogTexture
     {
+        // Number of texels along each side of the fog of war texture
+        static constexpr int sResolution = 32;
+
         int32_t mX, mY; // Only used for interior cells
+        // Fog of war alpha packed by packFogOfWar, one value per texel in rows from top to bottom. Older formats
+        // storing a PNG or TGA image are converted and resampled to sResolution on load.
         std::vector<char> mImageData;
     };
 
+    // Run-length encoding of fog of war alpha values. Explored and unexplored areas are mostly uniform and pack into
+    // a few bytes.
+    std::vector<char> packFogOfWar(std::span<const std::uint8_t> alpha);
+
+    // Returns false if the data is malformed or doesn't contain exactly alpha.size() values.
+    bool unpackFogOfWar(std::span<const char> data, std::span<std::uint8_t> alpha);
+
     // format 0, saved games only
     // Fog of war state
     struct FogState
@@ -28,7 +28,8 @@ namespace ESM
     inline constexpr FormatVersion MaxOldCountFormatVersion = 30;
     inline constexpr FormatVersion MaxActiveSpellTypeVersion = 31;
     inline constexpr FormatVersion MaxPlayerBeforeCellDataFormatVersion = 32;
-    inline constexpr FormatVersion CurrentSaveGameFormatVersion = 34;
+    inline constexpr FormatVersion MaxPngFogOfWarFormatVersion = 34;
+    inline constexpr FormatVersion CurrentSaveGameFormatVersion = 35;
 
     inline constexpr FormatVersion MinSupportedSaveGameFormatVersion = 5;
     inline constexpr FormatVersion OpenMW0_49MinSaveGameFormatVersion = 5;
@@ -11,12 +11,16 @@ namespace Interpreter
     class OpReturn : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override { runtime.setPC(-1); }
     };
 
     class OpSkipZero : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
@@ -30,6 +34,8 @@ namespace Interpreter
     class OpSkipNonZero : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
@@ -43,6 +49,8 @@ namespace Interpreter
     class OpJumpForward : public Opcode1
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime, unsigned int arg0) override
         {
             if (arg0 == 0)
@@ -55,6 +63,8 @@ namespace Interpreter
     class OpJumpBackward : public Opcode1
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime, unsigned int arg0) override
         {
             if (arg0 == 0)
@@ -9,12 +9,16 @@ namespace Interpreter
     class OpPushInt : public Opcode1
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime, unsigned int arg0) override { runtime.push(static_cast<Type_Integer>(arg0)); }
     };
 
     class OpIntToFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
@@ -26,6 +30,8 @@ namespace Interpreter
     class OpFloatToInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Float data = runtime[0].mFloat;
@@ -37,6 +43,8 @@ namespace Interpreter
     class OpNegateInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
@@ -48,6 +56,8 @@ namespace Interpreter
     class OpNegateFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Float data = runtime[0].mFloat;
@@ -59,6 +69,8 @@ namespace Interpreter
     class OpIntToFloat1 : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[1].mInteger;
@@ -70,6 +82,8 @@ namespace Interpreter
     class OpFloatToInt1 : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Float data = runtime[1].mFloat;
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <format>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -12,27 +13,56 @@ namespace Interpreter
 {
     namespace
     {
-        [[noreturn]] void abortUnknownCode(int segment, int opcode)
+        struct SplitCode
         {
-            const std::string error = std::format("unknown opcode {} in segment {}", opcode, segment);
+            unsigned int mSegment;
+            int mOpcode;
+            unsigned int mArg0;
+        };
+
+        std::optional<SplitCode> splitCode(Type_Code code)
+        {
+            switch (code >> 30)
+            {
+                case 0:
+                    return SplitCode{ 0, static_cast<int>(code >> 24), code & 0xffffff };
+                case 2:
+                    return SplitCode{ 2, static_cast<int>((code >> 20) & 0x3ff), code & 0xfffff };
+            }
+
+            switch (code >> 26)
+            {
+                case 0x30:
+                    return SplitCode{ 3, static_cast<int>((code >> 8) & 0x3ffff), code & 0xff };
+                case 0x32:
+                    return SplitCode{ 5, static_cast<int>(code & 0x3ffffff), 0 };
+            }
+
+            return std::nullopt;
+        }
+
+        [[noreturn]] void abortUnknownCode(void* /*opcode*/, Runtime& /*runtime*/, unsigned int code)
+        {
+            const std::optional<SplitCode> split = splitCode(code);
+            assert(split.has_value());
+            const std::string error = std::format("unknown opcode {} in segment {}", split->mOpcode, split->mSegment);
             throw std::runtime_error(error);
         }
 
-        [[noreturn]] void abortUnknownSegment(Type_Code code)
+        [[noreturn]] void abortUnknownSegment(void* /*opcode*/, Runtime& /*runtime*/, unsigned int code)
         {
             const std::string error = std::format("opcode outside of the allocated segment range: {}", code);
             throw std::runtime_error(error);
         }
 
         template <typename T>
-        auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+        Instruction getInstruction(const T& segment, Type_Code code, const SplitCode& split)
         {
-            auto it = segment.find(opcode);
+            auto it = segment.find(split.mOpcode);
             if (it == segment.end())
-            {
-                abortUnknownCode(seg, opcode);
-            }
-            return it->second;
+                return Instruction{ &abortUnknownCode, nullptr, code, true };
+            const auto& handler = it->second;
+            return Instruction{ handler.mExecute, handler.mOpcode.get(), split.mArg0, handler.mHasSideEffects };
         }
     }
 
@@ -42,50 +72,33 @@ namespace Interpreter
             std::format("Duplicated interpreter instruction code in segment {}: {:#x}", name, code));
     }
 
-    void Interpreter::execute(Type_Code code)
+    Instruction Interpreter::decode(Type_Code code) const
     {
-        unsigned int segSpec = code >> 30;
+        const std::optional<SplitCode> split = splitCode(code);
 
-        switch (segSpec)
+        if (!split.has_value())
+            return Instruction{ &abortUnknownSegment, nullptr, code, true };
+
+        switch (split->mSegment)
         {
             case 0:
-            {
-                const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
-
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
-            }
-
+                return getInstruction(mSegment0, code, *split);
             case 2:
-            {
-                const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
-
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
-            }
-        }
-
-        segSpec = code >> 26;
-
-        switch (segSpec)
-        {
-            case 0x30:
-            {
-                const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
-
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
-            }
-
-            case 0x32:
-            {
-                const int opcode = code & 0x3ffffff;
-
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
-            }
+                return getInstruction(mSegment2, code, *split);
+            case 3:
+                return getInstruction(mSegment3, code, *split);
+            default:
+                return getInstruction(mSegment5, code, *split);
         }
+    }
 
-        abortUnknownSegment(code);
+    std::vector<Instruction> Interpreter::decode(const Program& program) const
+    {
+        std::vector<Instruction> result;
+        result.reserve(program.mInstructions.size());
+        for (const Type_Code code : program.mInstructions)
+            result.push_back(decode(code));
+        return result;
     }
 
     void Interpreter::begin()
@@ -115,20 +128,27 @@ namespace Interpreter
         }
     }
 
-    void Interpreter::run(const Program& program, Context& context)
+    bool Interpreter::run(const Program& program, std::span<const Instruction> instructions, Context& context)
     {
+        assert(instructions.size() == program.mInstructions.size());
+
         begin();
 
+        bool sideEffects = false;
+
         try
         {
             mRuntime.configure(program, context);
 
-            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < program.mInstructions.size())
+            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < instructions.size())
             {
-                const Type_Code instruction = program.mInstructions[mRuntime.getPC()];
+                const Instruction& instruction = instructions[mRuntime.getPC()];
                 mRuntime.setPC(mRuntime.getPC() + 1);
-                execute(instruction);
+                sideEffects |= instruction.mHasSideEffects;
+                instruction.mExecute(instruction.mOpcode, mRuntime, instruction.mArg0);
             }
+
+            sideEffects |= mRuntime.hasSideEffects();
         }
         catch (...)
         {
@@ -137,5 +157,7 @@ namespace Interpreter
         }
 
         end();
+
+        return sideEffects;
     }
 }
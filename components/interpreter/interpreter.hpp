@@ -3,8 +3,11 @@
 
 #include <map>
 #include <memory>
+#include <span>
 #include <stack>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "opcodes.hpp"
 #include "runtime.hpp"
@@ -14,17 +17,38 @@ namespace Interpreter
 {
     struct Program;
 
+    /// @brief Instruction with the opcode resolved to a handler of a particular interpreter.
+    /// @par Execute is a direct call of the concrete opcode class, there is no lookup or virtual call when a decoded
+    /// program is run.
+    struct Instruction
+    {
+        using Execute = void (*)(void* opcode, Runtime& runtime, unsigned int arg0);
+
+        Execute mExecute;
+        void* mOpcode;
+        unsigned int mArg0;
+        bool mHasSideEffects;
+    };
+
     class Interpreter
     {
+        template <class Base>
+        struct Handler
+        {
+            std::unique_ptr<Base> mOpcode;
+            Instruction::Execute mExecute;
+            bool mHasSideEffects;
+        };
+
         std::stack<Runtime> mCallstack;
         bool mRunning = false;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        std::map<int, Handler<Opcode1>> mSegment0;
+        std::map<int, Handler<Opcode1>> mSegment2;
+        std::map<int, Handler<Opcode1>> mSegment3;
+        std::map<int, Handler<Opcode0>> mSegment5;
 
-        void execute(Type_Code code);
+        Instruction decode(Type_Code code) const;
 
         void begin();
 
@@ -32,12 +56,38 @@ namespace Interpreter
 
         [[noreturn]] void abortDuplicateInstruction(std::string_view name, int code);
 
-        template <typename T, typename... Args>
-        void installSegment(auto& segment, std::string_view name, int code, Args&&... args)
+        template <class T>
+        static void executeOpcode0(void* opcode, Runtime& runtime, unsigned int /*arg0*/)
+        {
+            static_cast<T*>(static_cast<Opcode0*>(opcode))->T::execute(runtime);
+        }
+
+        template <class T>
+        static void executeOpcode1(void* opcode, Runtime& runtime, unsigned int arg0)
         {
+            static_cast<T*>(static_cast<Opcode1*>(opcode))->T::execute(runtime, arg0);
+        }
+
+        // Opcode may change the state of the game unless declared otherwise by static constexpr bool sHasSideEffects.
+        // Such opcode calls Runtime::markSideEffects when it changes something in a particular case.
+        template <typename T>
+        static constexpr bool hasSideEffects()
+        {
+            if constexpr (requires { T::sHasSideEffects; })
+                return T::sHasSideEffects;
+            else
+                return true;
+        }
+
+        template <typename T, typename Base, typename... Args>
+        void installSegment(std::map<int, Handler<Base>>& segment, std::string_view name, int code,
+            Instruction::Execute execute, Args&&... args)
+        {
+            static_assert(std::is_base_of_v<Base, T>);
             if (segment.find(code) != segment.end())
                 abortDuplicateInstruction(name, code);
-            segment.emplace(code, std::make_unique<T>(std::forward<Args>(args)...));
+            segment.emplace(
+                code, Handler<Base>{ std::make_unique<T>(std::forward<Args>(args)...), execute, hasSideEffects<T>() });
         }
 
     public:
@@ -49,28 +99,36 @@ namespace Interpreter
         template <typename T, typename... TArgs>
         void installSegment0(int code, TArgs&&... args)
         {
-            installSegment<T>(mSegment0, "0", code, std::forward<TArgs>(args)...);
+            installSegment<T>(mSegment0, "0", code, &executeOpcode1<T>, std::forward<TArgs>(args)...);
         }
 
         template <typename T, typename... TArgs>
         void installSegment2(int code, TArgs&&... args)
         {
-            installSegment<T>(mSegment2, "2", code, std::forward<TArgs>(args)...);
+            installSegment<T>(mSegment2, "2", code, &executeOpcode1<T>, std::forward<TArgs>(args)...);
         }
 
         template <typename T, typename... TArgs>
         void installSegment3(int code, TArgs&&... args)
         {
-            installSegment<T>(mSegment3, "3", code, std::forward<TArgs>(args)...);
+            installSegment<T>(mSegment3, "3", code, &executeOpcode1<T>, std::forward<TArgs>(args)...);
         }
 
         template <typename T, typename... TArgs>
         void installSegment5(int code, TArgs&&... args)
         {
-            installSegment<T>(mSegment5, "5", code, std::forward<TArgs>(args)...);
+            installSegment<T>(mSegment5, "5", code, &executeOpcode0<T>, std::forward<TArgs>(args)...);
         }
 
-        void run(const Program& program, Context& context);
+        /// Resolve opcodes of the program to handlers of this interpreter. Unknown opcodes are resolved to handlers
+        /// throwing an exception, so a program is rejected only when such an instruction is reached.
+        std::vector<Instruction> decode(const Program& program) const;
+
+        /// Run a program decoded by this interpreter.
+        /// @return Whether any executed instruction might have changed the state outside of the interpreter.
+        bool run(const Program& program, std::span<const Instruction> instructions, Context& context);
+
+        bool run(const Program& program, Context& context) { return run(program, decode(program), context); }
     };
 }
 
@@ -10,12 +10,18 @@ namespace Interpreter
     class OpStoreLocalShort : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
             int index = runtime[1].mInteger;
 
-            runtime.getContext().setLocalShort(index, data);
+            // Scripts often assign the same value every frame, this doesn't change the state
+            Context& context = runtime.getContext();
+            if (context.getLocalShort(index) != data)
+                runtime.markSideEffects();
+            context.setLocalShort(index, data);
 
             runtime.pop();
             runtime.pop();
@@ -25,12 +31,17 @@ namespace Interpreter
     class OpStoreLocalLong : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer data = runtime[0].mInteger;
             int index = runtime[1].mInteger;
 
-            runtime.getContext().setLocalLong(index, data);
+            Context& context = runtime.getContext();
+            if (context.getLocalLong(index) != data)
+                runtime.markSideEffects();
+            context.setLocalLong(index, data);
 
             runtime.pop();
             runtime.pop();
@@ -40,12 +51,17 @@ namespace Interpreter
     class OpStoreLocalFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Float data = runtime[0].mFloat;
             int index = runtime[1].mInteger;
 
-            runtime.getContext().setLocalFloat(index, data);
+            Context& context = runtime.getContext();
+            if (context.getLocalFloat(index) != data)
+                runtime.markSideEffects();
+            context.setLocalFloat(index, data);
 
             runtime.pop();
             runtime.pop();
@@ -55,6 +71,8 @@ namespace Interpreter
     class OpFetchIntLiteral : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer intValue = runtime.getIntegerLiteral(runtime[0].mInteger);
@@ -65,6 +83,8 @@ namespace Interpreter
     class OpFetchFloatLiteral : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Float floatValue = runtime.getFloatLiteral(runtime[0].mInteger);
@@ -75,6 +95,8 @@ namespace Interpreter
     class OpFetchLocalShort : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -86,6 +108,8 @@ namespace Interpreter
     class OpFetchLocalLong : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -97,6 +121,8 @@ namespace Interpreter
     class OpFetchLocalFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -159,6 +185,8 @@ namespace Interpreter
     class OpFetchGlobalShort : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -171,6 +199,8 @@ namespace Interpreter
     class OpFetchGlobalLong : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -183,6 +213,8 @@ namespace Interpreter
     class OpFetchGlobalFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int index = runtime[0].mInteger;
@@ -256,6 +288,8 @@ namespace Interpreter
     class OpFetchMemberShort : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer index = runtime[0].mInteger;
@@ -273,6 +307,8 @@ namespace Interpreter
     class OpFetchMemberLong : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer index = runtime[0].mInteger;
@@ -290,6 +326,8 @@ namespace Interpreter
     class OpFetchMemberFloat : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             Type_Integer index = runtime[0].mInteger;
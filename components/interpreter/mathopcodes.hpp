@@ -13,6 +13,8 @@ namespace Interpreter
     class OpAddInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             T result = getData<T>(runtime[1]) + getData<T>(runtime[0]);
@@ -27,6 +29,8 @@ namespace Interpreter
     class OpSubInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             T result = getData<T>(runtime[1]) - getData<T>(runtime[0]);
@@ -41,6 +45,8 @@ namespace Interpreter
     class OpMulInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             T result = getData<T>(runtime[1]) * getData<T>(runtime[0]);
@@ -55,6 +61,8 @@ namespace Interpreter
     class OpDivInt : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             T left = getData<T>(runtime[0]);
@@ -74,6 +82,8 @@ namespace Interpreter
     class OpCompare : public Opcode0
     {
     public:
+        static constexpr bool sHasSideEffects = false;
+
         void execute(Runtime& runtime) override
         {
             int result = C()(getData<T>(runtime[1]), getData<T>(runtime[0]));
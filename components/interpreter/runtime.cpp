@@ -44,6 +44,7 @@ namespace Interpreter
     {
         mContext = nullptr;
         mProgram = nullptr;
+        mSideEffects = false;
         mStack.clear();
     }
 
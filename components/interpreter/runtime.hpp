@@ -18,6 +18,7 @@ namespace Interpreter
         Context* mContext = nullptr;
         const Program* mProgram = nullptr;
         int mPC = 0;
+        bool mSideEffects = false;
         std::vector<Data> mStack;
 
     public:
@@ -55,6 +56,11 @@ namespace Interpreter
         ///< Access stack member, counted from the top.
 
         Context& getContext();
+
+        void markSideEffects() { mSideEffects = true; }
+        ///< Report a change of the state by an opcode declared without side effects.
+
+        bool hasSideEffects() const { return mSideEffects; }
     };
 }
 
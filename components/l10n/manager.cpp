@@ -9,6 +9,12 @@
 namespace L10n
 {
 
+    void Manager::dropCache()
+    {
+        const std::lock_guard lock(mCacheMutex);
+        mCache.clear();
+    }
+
     void Manager::setPreferredLocales(const std::vector<std::string>& langs, bool gmstHasPriority)
     {
         mPreferredLocales.clear();
@@ -30,6 +36,7 @@ namespace L10n
             for (const icu::Locale& l : mPreferredLocales)
                 msg << " " << l.getName();
         }
+        const std::lock_guard lock(mCacheMutex);
         for (auto& [key, context] : mCache)
             updateContext(std::get<0>(key), *context);
     }
@@ -92,6 +99,7 @@ namespace L10n
         std::string_view contextName, const std::string& fallbackLocaleName)
     {
         std::tuple<std::string_view, std::string_view> key(contextName, fallbackLocaleName);
+        const std::lock_guard lock(mCacheMutex);
         auto it = mCache.find(key);
         if (it != mCache.end())
             return it->second;
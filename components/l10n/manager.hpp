@@ -2,6 +2,7 @@
 #define COMPONENTS_L10N_MANAGER_H
 
 #include <memory>
+#include <mutex>
 
 #include <components/l10n/messagebundles.hpp>
 
@@ -21,11 +22,12 @@ namespace L10n
         {
         }
 
-        void dropCache() { mCache.clear(); }
+        void dropCache();
         void setPreferredLocales(const std::vector<std::string>& locales, bool gmstHasPriority = true);
         const std::vector<icu::Locale>& getPreferredLocales() const { return mPreferredLocales; }
         void setGmstLoader(std::function<std::string(std::string_view)> fn) { mGmstLoader = std::move(fn); }
 
+        // Thread safe, Lua states of different threads may share the manager
         std::shared_ptr<const MessageBundles> getContext(
             std::string_view contextName, const std::string& fallbackLocale = "en");
 
@@ -41,6 +43,7 @@ namespace L10n
         const VFS::Manager* mVFS;
         std::vector<icu::Locale> mPreferredLocales;
         std::map<std::tuple<std::string, std::string>, std::shared_ptr<MessageBundles>, std::less<>> mCache;
+        std::mutex mCacheMutex;
         std::function<std::string(std::string_view)> mGmstLoader;
     };
 
@@ -4,6 +4,12 @@
 
 #include <components/esm/luascripts.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace
 {
     struct ScriptInfo
@@ -11,6 +17,53 @@ namespace
         std::string_view mInitData;
         const ESM::LuaScript* mSavedData;
     };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+    };
+
+    class EventIds
+    {
+    public:
+        using EventId = LuaUtil::ScriptsContainer::EventId;
+
+        std::optional<EventId> find(std::string_view name) const
+        {
+            const std::shared_lock lock(mMutex);
+            const auto it = mIds.find(name);
+            if (it == mIds.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        EventId get(std::string_view name)
+        {
+            if (const std::optional<EventId> id = find(name))
+                return *id;
+            const std::unique_lock lock(mMutex);
+            return mIds.emplace(std::string(name), static_cast<EventId>(mIds.size())).first->second;
+        }
+
+    private:
+        mutable std::shared_mutex mMutex;
+        std::unordered_map<std::string, EventId, StringHash, std::equal_to<>> mIds;
+    };
+
+    EventIds& getEventIds()
+    {
+        static EventIds ids;
+        return ids;
+    }
+
+    template <class T>
+    auto findEventHandlers(T& handlers, LuaUtil::ScriptsContainer::EventId id)
+    {
+        return std::lower_bound(
+            handlers.begin(), handlers.end(), id, [](const auto& v, auto value) { return v.first < value; });
+    }
 }
 
 namespace LuaUtil
@@ -166,10 +219,10 @@ namespace LuaUtil
             {
                 for (const auto& [key, fn] : cast<sol::table>(eventHandlers))
                 {
-                    std::string_view eventName = cast<std::string_view>(key);
-                    auto it = data.mEventHandlers.find(eventName);
-                    if (it == data.mEventHandlers.end())
-                        it = data.mEventHandlers.emplace(std::string(eventName), EventHandlerList()).first;
+                    const EventId eventId = getEventId(cast<std::string_view>(key));
+                    auto it = findEventHandlers(data.mEventHandlers, eventId);
+                    if (it == data.mEventHandlers.end() || it->first != eventId)
+                        it = data.mEventHandlers.emplace(it, eventId, EventHandlerList());
                     insertHandler(it->second, scriptId, cast<sol::function>(fn));
                 }
             }
@@ -352,11 +405,20 @@ namespace LuaUtil
             list.end());
     }
 
+    ScriptsContainer::EventId ScriptsContainer::getEventId(std::string_view eventName)
+    {
+        return getEventIds().get(eventName);
+    }
+
     void ScriptsContainer::receiveEvent(std::string_view eventName, std::string_view eventData)
     {
         LoadedData& data = ensureLoaded();
-        auto it = data.mEventHandlers.find(eventName);
-        if (it == data.mEventHandlers.end())
+        // An event that no script has ever had a handler for doesn't need to be interned
+        const std::optional<EventId> eventId = getEventIds().find(eventName);
+        if (!eventId.has_value())
+            return;
+        auto it = findEventHandlers(data.mEventHandlers, *eventId);
+        if (it == data.mEventHandlers.end() || it->first != *eventId)
             return;
         mLua.protectedCall([&](LuaView& view) {
             sol::object object;
@@ -425,20 +487,20 @@ namespace LuaUtil
         }
         const auto& loadedData = std::get<LoadedData>(mData);
         std::map<int, std::vector<ESM::LuaTimer>> timers;
-        auto saveTimerFn = [&](const Timer& timer, TimerType timerType) {
+        auto saveTimerFn = [&](double time, const Timer& timer, TimerType timerType) {
             if (!timer.mSerializable)
                 return;
             ESM::LuaTimer savedTimer;
-            savedTimer.mTime = timer.mTime;
+            savedTimer.mTime = time;
             savedTimer.mType = timerType;
             savedTimer.mCallbackName = std::get<std::string>(timer.mCallback);
             savedTimer.mCallbackArgument = timer.mSerializedArg;
             timers[timer.mScriptId].push_back(std::move(savedTimer));
         };
-        for (const Timer& timer : loadedData.mSimulationTimersQueue)
-            saveTimerFn(timer, TimerType::SIMULATION_TIME);
-        for (const Timer& timer : loadedData.mGameTimersQueue)
-            saveTimerFn(timer, TimerType::GAME_TIME);
+        loadedData.mSimulationTimers.forEach(
+            [&](double time, const Timer& timer) { saveTimerFn(time, timer, TimerType::SIMULATION_TIME); });
+        loadedData.mGameTimers.forEach(
+            [&](double time, const Timer& timer) { saveTimerFn(time, timer, TimerType::GAME_TIME); });
         data.mScripts.clear();
         for (auto& [scriptId, script] : loadedData.mScripts)
         {
@@ -591,7 +653,6 @@ namespace LuaUtil
                     timer.mCallback = savedTimer.mCallbackName;
                     timer.mSerializable = true;
                     timer.mScriptId = scriptId;
-                    timer.mTime = savedTimer.mTime;
 
                     try
                     {
@@ -603,9 +664,9 @@ namespace LuaUtil
                         timer.mSerializedArg = serialize(timer.mArg, mSerializer);
 
                         if (savedTimer.mType == TimerType::GAME_TIME)
-                            data.mGameTimersQueue.push_back(std::move(timer));
+                            data.mGameTimers.insert(savedTimer.mTime, std::move(timer));
                         else
-                            data.mSimulationTimersQueue.push_back(std::move(timer));
+                            data.mSimulationTimers.insert(savedTimer.mTime, std::move(timer));
                     }
                     catch (std::exception& e)
                     {
@@ -615,9 +676,6 @@ namespace LuaUtil
             }
         });
 
-        std::make_heap(data.mSimulationTimersQueue.begin(), data.mSimulationTimersQueue.end());
-        std::make_heap(data.mGameTimersQueue.begin(), data.mGameTimersQueue.end());
-
         if (mTracker)
             mTracker->onLoad(*this);
 
@@ -665,8 +723,8 @@ namespace LuaUtil
                     for (auto& [_, handlers] : mEngineHandlers)
                         handlers->mList.clear();
                     variant.mEventHandlers.clear();
-                    variant.mSimulationTimersQueue.clear();
-                    variant.mGameTimersQueue.clear();
+                    variant.mSimulationTimers.clear();
+                    variant.mGameTimers.clear();
                     variant.mPublicInterfaces.clear();
                 }
             },
@@ -688,12 +746,6 @@ namespace LuaUtil
         getScript(scriptId).mRegisteredCallbacks.emplace(std::string(callbackName), std::move(callback));
     }
 
-    void ScriptsContainer::insertTimer(std::vector<Timer>& timerQueue, Timer&& t)
-    {
-        timerQueue.push_back(std::move(t));
-        std::push_heap(timerQueue.begin(), timerQueue.end());
-    }
-
     void ScriptsContainer::setupSerializableTimer(
         TimerType type, double time, int scriptId, std::string_view callbackName, sol::main_object callbackArg)
     {
@@ -701,11 +753,10 @@ namespace LuaUtil
         t.mCallback = std::string(callbackName);
         t.mScriptId = scriptId;
         t.mSerializable = true;
-        t.mTime = time;
         t.mArg = std::move(callbackArg);
         t.mSerializedArg = serialize(t.mArg, mSerializer);
         LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? data.mGameTimers : data.mSimulationTimers).insert(time, std::move(t));
     }
 
     void ScriptsContainer::setupUnsavableTimer(
@@ -714,13 +765,12 @@ namespace LuaUtil
         Timer t;
         t.mScriptId = scriptId;
         t.mSerializable = false;
-        t.mTime = time;
 
         t.mCallback = mTemporaryCallbackCounter;
         getScript(t.mScriptId).mTemporaryCallbacks.emplace(mTemporaryCallbackCounter, std::move(callback));
         mTemporaryCallbackCounter++;
         LoadedData& data = ensureLoaded();
-        insertTimer(type == TimerType::GAME_TIME ? data.mGameTimersQueue : data.mSimulationTimersQueue, std::move(t));
+        (type == TimerType::GAME_TIME ? data.mGameTimers : data.mSimulationTimers).insert(time, std::move(t));
     }
 
     void ScriptsContainer::callTimer(const Timer& t)
@@ -749,22 +799,19 @@ namespace LuaUtil
         }
     }
 
-    void ScriptsContainer::updateTimerQueue(std::vector<Timer>& timerQueue, double time)
+    void ScriptsContainer::processTimers(double simulationTime, double gameTime)
     {
-        while (!timerQueue.empty() && timerQueue.front().mTime <= time)
+        // Most containers have no expired timers in most frames, don't enter Lua for them
+        if (LoadedData* data = std::get_if<LoadedData>(&mData))
         {
-            callTimer(timerQueue.front());
-            std::pop_heap(timerQueue.begin(), timerQueue.end());
-            timerQueue.pop_back();
+            const bool hasSimulationTimers = data->mSimulationTimers.advance(simulationTime);
+            if (!data->mGameTimers.advance(gameTime) && !hasSimulationTimers)
+                return;
         }
-    }
-
-    void ScriptsContainer::processTimers(double simulationTime, double gameTime)
-    {
         mLua.protectedCall([&](LuaView& view) {
             LoadedData& data = ensureLoaded();
-            updateTimerQueue(data.mSimulationTimersQueue, simulationTime);
-            updateTimerQueue(data.mGameTimersQueue, gameTime);
+            data.mSimulationTimers.process(simulationTime, [&](const Timer& timer) { callTimer(timer); });
+            data.mGameTimers.process(gameTime, [&](const Timer& timer) { callTimer(timer); });
         });
     }
 
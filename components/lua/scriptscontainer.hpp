@@ -1,16 +1,20 @@
 #ifndef COMPONENTS_LUA_SCRIPTSCONTAINER_H
 #define COMPONENTS_LUA_SCRIPTSCONTAINER_H
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/luascripts.hpp>
 
 #include "luastate.hpp"
 #include "serialization.hpp"
+#include "timerwheel.hpp"
 
 namespace LuaUtil
 {
@@ -73,6 +77,12 @@ namespace LuaUtil
 
         using TimerType = ESM::LuaTimer::Type;
 
+        // Event names are interned to dispatch events using a flat table of handlers.
+        // Ids are shared by all containers and never released.
+        using EventId = std::uint32_t;
+
+        static EventId getEventId(std::string_view eventName);
+
         // `namePrefix` is a common prefix for all scripts in the container. Used in logs for error messages and `print`
         // output. `tracker` is a tracker for managing the container's state. `load` specifies whether the container
         // should be constructed in a loaded state.
@@ -249,17 +259,18 @@ namespace LuaUtil
         };
         struct Timer
         {
-            double mTime;
             bool mSerializable;
             int mScriptId;
             std::variant<std::string, int64_t> mCallback; // string if serializable, integer otherwise
             sol::main_object mArg;
             std::string mSerializedArg;
-
-            bool operator<(const Timer& t) const { return mTime > t.mTime; }
         };
         using EventHandlerList = std::vector<Handler>;
 
+        // Simulation time is in seconds, game time is in game seconds that are usually 30 times faster
+        static constexpr double sSimulationTimersResolution = 0.1;
+        static constexpr double sGameTimersResolution = 2;
+
         friend class LuaState;
         void addInstructionCount(int scriptId, int64_t instructionCount);
         void addMemoryUsage(int scriptId, int64_t memoryDelta);
@@ -280,8 +291,6 @@ namespace LuaUtil
 
         void callOnInit(LuaView& view, int scriptId, const sol::function& onInit, std::string_view data);
         void callTimer(const Timer& t);
-        void updateTimerQueue(std::vector<Timer>& timerQueue, double time);
-        static void insertTimer(std::vector<Timer>& timerQueue, Timer&& t);
         static void insertHandler(std::vector<Handler>& list, int scriptId, sol::function fn);
         static void removeHandler(std::vector<Handler>& list, int scriptId);
         void insertInterface(int scriptId, const Script& script);
@@ -298,10 +307,11 @@ namespace LuaUtil
             std::map<int, Script> mScripts;
             sol::main_table mPublicInterfaces;
 
-            std::map<std::string, EventHandlerList, std::less<>> mEventHandlers;
+            // Sorted by event id
+            std::vector<std::pair<EventId, EventHandlerList>> mEventHandlers;
 
-            std::vector<Timer> mSimulationTimersQueue;
-            std::vector<Timer> mGameTimersQueue;
+            TimerWheel<Timer> mSimulationTimers{ sSimulationTimersResolution };
+            TimerWheel<Timer> mGameTimers{ sGameTimersResolution };
         };
         using UnloadedData = ESM::LuaScripts;
 
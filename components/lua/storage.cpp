@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 
 #include <components/debug/debuglog.hpp>
 
@@ -17,6 +18,69 @@ namespace sol
 
 namespace LuaUtil
 {
+    namespace
+    {
+        constexpr std::string_view sFileMagic = "OMWLUAST";
+        constexpr std::uint32_t sFileVersion = 1;
+        constexpr std::size_t sHeaderSize = sFileMagic.size() + 4;
+
+        void appendUint(std::string& out, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+                out.push_back(static_cast<char>(value >> (i * 8)));
+        }
+
+        void appendString(std::string& out, std::string_view value)
+        {
+            appendUint(out, static_cast<std::uint32_t>(value.size()));
+            out.append(value);
+        }
+
+        // Chunk is a section name and its serialized values, empty values mean that the section is removed
+        std::string makeChunk(std::string_view sectionName, std::string_view values)
+        {
+            std::string result;
+            result.reserve(8 + sectionName.size() + values.size());
+            appendString(result, sectionName);
+            appendString(result, values);
+            return result;
+        }
+
+        class Reader
+        {
+        public:
+            explicit Reader(std::string_view data)
+                : mData(data)
+            {
+            }
+
+            std::size_t size() const { return mData.size(); }
+
+            std::uint32_t readUint()
+            {
+                const std::string_view bytes = read(4);
+                std::uint32_t result = 0;
+                for (std::size_t i = 0; i < bytes.size(); ++i)
+                    result |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (i * 8);
+                return result;
+            }
+
+            std::string_view readString() { return read(readUint()); }
+
+        private:
+            std::string_view read(std::size_t size)
+            {
+                if (size > mData.size())
+                    throw std::runtime_error("unexpected end of data");
+                const std::string_view result = mData.substr(0, size);
+                mData.remove_prefix(size);
+                return result;
+            }
+
+            std::string_view mData;
+        };
+    }
+
     LuaStorage::Value LuaStorage::Section::sEmpty;
 
     void LuaStorage::registerLifeTime(LuaUtil::LuaView& view, sol::table& res)
@@ -29,6 +93,13 @@ namespace LuaUtil
             }));
     }
 
+    LuaStorage::Value LuaStorage::Value::fromSerialized(std::string serializedValue)
+    {
+        Value result;
+        result.mSerializedValue = std::move(serializedValue);
+        return result;
+    }
+
     sol::object LuaStorage::Value::getCopy(lua_State* state) const
     {
         return deserialize(state, mSerializedValue);
@@ -36,9 +107,13 @@ namespace LuaUtil
 
     sol::object LuaStorage::Value::getReadOnly(lua_State* state) const
     {
-        if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
-            mReadOnlyValue = sol::main_object(deserialize(state, mSerializedValue, nullptr, true));
-        return mReadOnlyValue;
+        if (mSerializedValue.empty())
+            return sol::nil;
+        lua_State* mainThread = sol::main_thread(state, state);
+        for (const sol::main_object& value : mReadOnlyValues)
+            if (value.lua_state() == mainThread)
+                return value;
+        return mReadOnlyValues.emplace_back(deserialize(state, mSerializedValue, nullptr, true));
     }
 
     const LuaStorage::Value& LuaStorage::Section::get(std::string_view key) const
@@ -87,6 +162,7 @@ namespace LuaUtil
     {
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
+        mChanged = true;
         if (value != sol::nil)
             mValues[std::string(key)] = Value(value);
         else
@@ -104,6 +180,7 @@ namespace LuaUtil
     {
         checkIfActive();
         throwIfCallbackRecursionIsTooDeep();
+        mChanged = true;
         mValues.clear();
         if (values)
         {
@@ -124,10 +201,47 @@ namespace LuaUtil
         return res;
     }
 
+    std::string LuaStorage::Section::serializeValues() const
+    {
+        if (!mPendingValues.empty())
+            return mPendingValues;
+        std::string result;
+        appendUint(result, static_cast<std::uint32_t>(mValues.size()));
+        for (const auto& [key, value] : mValues)
+        {
+            appendString(result, key);
+            appendString(result, value.getSerialized());
+        }
+        return result;
+    }
+
+    void LuaStorage::Section::loadPendingValues()
+    {
+        if (mPendingValues.empty())
+            return;
+        const std::string data = std::move(mPendingValues);
+        mPendingValues.clear();
+        try
+        {
+            Reader reader(data);
+            const std::uint32_t count = reader.readUint();
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                std::string key(reader.readString());
+                mValues.insert_or_assign(std::move(key), Value::fromSerialized(std::string(reader.readString())));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Cannot read Lua storage section \"" << mSectionName << "\": " << e.what();
+        }
+    }
+
     void LuaStorage::initLuaBindings(LuaUtil::LuaView& view)
     {
         sol::usertype<SectionView> sview = view.sol().new_usertype<SectionView>("Section");
         sview["get"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             return section.mSection->get(key).getReadOnly(s);
         };
         sview["getCopy"] = [](sol::this_state s, const SectionView& section, std::string_view key) {
@@ -136,6 +250,7 @@ namespace LuaUtil
         sview["asTable"]
             = [](sol::this_state lua, const SectionView& section) { return section.mSection->asTable(lua); };
         sview["subscribe"] = [](const SectionView& section, const sol::table& callback) {
+            const std::lock_guard lock(section.mSection->mStorage->mMutex);
             std::vector<Callback>& callbacks
                 = section.mForMenuScripts ? section.mSection->mMenuScriptsCallbacks : section.mSection->mCallbacks;
             if (!callbacks.empty() && callbacks.size() == callbacks.capacity())
@@ -253,12 +368,54 @@ namespace LuaUtil
 
             std::ifstream fin(path, std::fstream::binary);
             std::string serializedData((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
-            sol::table data = deserialize(state, serializedData);
-            for (const auto& [sectionName, sectionTable] : data)
+            if (!serializedData.starts_with(sFileMagic))
+            {
+                // Old format, the whole storage is a single serialized table
+                sol::table data = deserialize(state, serializedData);
+                for (const auto& [sectionName, sectionTable] : data)
+                {
+                    const std::shared_ptr<Section>& section = getSection(cast<std::string_view>(sectionName));
+                    for (const auto& [key, value] : cast<sol::table>(sectionTable))
+                        section->set(cast<std::string_view>(key), value);
+                }
+                return;
+            }
+
+            Reader reader(std::string_view(serializedData).substr(sFileMagic.size()));
+            if (reader.readUint() != sFileVersion)
+                throw std::runtime_error("Unsupported storage file version");
+            std::map<std::string, std::string_view, std::less<>> sections;
+            std::size_t validSize = sHeaderSize;
+            try
+            {
+                while (reader.size() > 0)
+                {
+                    const std::string_view sectionName = reader.readString();
+                    const std::string_view values = reader.readString();
+                    validSize = serializedData.size() - reader.size();
+                    sections.insert_or_assign(std::string(sectionName), values);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // Saving was interrupted, the previous chunks are still valid
+                Log(Debug::Warning) << "Lua storage \"" << path << "\" is truncated: " << e.what();
+            }
+
+            for (const auto& [sectionName, values] : sections)
             {
-                const std::shared_ptr<Section>& section = getSection(cast<std::string_view>(sectionName));
-                for (const auto& [key, value] : cast<sol::table>(sectionTable))
-                    section->set(cast<std::string_view>(key), value);
+                if (values.empty())
+                    continue;
+                auto section = std::make_shared<Section>(this, sectionName);
+                section->mPendingValues = values;
+                section->mChanged = false;
+                mSavedChunkSizes.emplace(sectionName, makeChunk(sectionName, values).size());
+                mData.emplace(section->mSectionName, std::move(section));
+            }
+            if (validSize == serializedData.size())
+            {
+                mFilePath = path;
+                mFileSize = validSize;
             }
         }
         catch (std::exception& e)
@@ -267,27 +424,100 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::save(lua_State* state, const std::filesystem::path& path) const
+    void LuaStorage::save(const std::filesystem::path& path)
     {
-        sol::table data(state, sol::create);
+        std::map<std::string, std::size_t, std::less<>> savedChunkSizes = mSavedChunkSizes;
+        std::string changedChunks;
         for (const auto& [sectionName, section] : mData)
         {
-            if (section->mLifeTime == Section::Persistent && !section->mValues.empty())
-                data[sectionName] = section->asTable(state);
+            const bool persistent = section->mLifeTime == Section::Persistent && section->hasValues();
+            const auto it = savedChunkSizes.find(sectionName);
+            if (persistent && (section->mChanged || it == savedChunkSizes.end()))
+            {
+                const std::string chunk = makeChunk(sectionName, section->serializeValues());
+                savedChunkSizes.insert_or_assign(std::string(sectionName), chunk.size());
+                changedChunks += chunk;
+            }
+            else if (!persistent && it != savedChunkSizes.end())
+            {
+                changedChunks += makeChunk(sectionName, {});
+                savedChunkSizes.erase(it);
+            }
+        }
+        for (auto it = savedChunkSizes.begin(); it != savedChunkSizes.end();)
+        {
+            if (mData.contains(it->first))
+                ++it;
+            else
+            {
+                changedChunks += makeChunk(it->first, {});
+                it = savedChunkSizes.erase(it);
+            }
+        }
+
+        std::size_t liveSize = sHeaderSize;
+        for (const auto& [sectionName, size] : savedChunkSizes)
+            liveSize += size;
+
+        try
+        {
+            std::error_code ec;
+            const bool fileIsKnown
+                = !mFilePath.empty() && path == mFilePath && std::filesystem::file_size(path, ec) == mFileSize;
+            if (fileIsKnown && changedChunks.empty())
+                return;
+            if (fileIsKnown && mFileSize + changedChunks.size() <= 2 * liveSize)
+            {
+                Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << changedChunks.size()
+                                 << " bytes appended)";
+                std::ofstream fout(path, std::fstream::binary | std::fstream::app);
+                fout.exceptions(std::ios::failbit | std::ios::badbit);
+                fout.write(changedChunks.data(), changedChunks.size());
+                fout.close();
+                mFileSize += changedChunks.size();
+            }
+            else
+            {
+                std::string data(sFileMagic);
+                appendUint(data, sFileVersion);
+                for (const auto& [sectionName, size] : savedChunkSizes)
+                    data += makeChunk(sectionName, mData.find(sectionName)->second->serializeValues());
+                Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << data.size() << " bytes)";
+                // Never leave a partially written file with outdated chunks removed
+                std::filesystem::path temporary = path;
+                temporary += ".tmp";
+                {
+                    std::ofstream fout(temporary, std::fstream::binary);
+                    fout.exceptions(std::ios::failbit | std::ios::badbit);
+                    fout.write(data.data(), data.size());
+                }
+                std::filesystem::rename(temporary, path);
+                mFileSize = data.size();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Cannot write \"" << path << "\": " << e.what();
+            mFilePath.clear();
+            return;
         }
-        std::string serializedData = serialize(data);
-        Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
-        std::ofstream fout(path, std::fstream::binary);
-        fout.write(serializedData.data(), serializedData.size());
-        fout.close();
+
+        mFilePath = path;
+        mSavedChunkSizes = std::move(savedChunkSizes);
+        for (const auto& [sectionName, section] : mData)
+            section->mChanged = false;
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
     {
         checkIfActive();
+        const std::lock_guard lock(mMutex);
         auto it = mData.find(sectionName);
         if (it != mData.end())
+        {
+            it->second->loadPendingValues();
             return it->second;
+        }
         auto section = std::make_shared<Section>(this, std::string(sectionName));
         sectionName = section->mSectionName;
         auto [newIt, _] = mData.emplace(sectionName, std::move(section));
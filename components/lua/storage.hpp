@@ -1,9 +1,14 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <cstdint>
+#include <filesystem>
 #include <map>
+#include <mutex>
 #include <sol/sol.hpp>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "asyncpackage.hpp"
 #include "serialization.hpp"
@@ -25,8 +30,13 @@ namespace LuaUtil
         explicit LuaStorage() {}
 
         void clearTemporaryAndRemoveCallbacks();
+
+        // The file is a sequence of chunks, one per section. Saving to the file that was loaded or saved last time
+        // appends chunks only for changed and removed sections, the file is rewritten when it contains too many
+        // outdated chunks. Values of loaded sections are parsed on first access to the section.
+        // `state` is used only to read files of the old format (a single serialized table).
         void load(lua_State* state, const std::filesystem::path& path);
-        void save(lua_State* state, const std::filesystem::path& path) const;
+        void save(const std::filesystem::path& path);
 
         sol::object getSection(
             lua_State* state, std::string_view sectionName, bool readOnly, bool forMenuScripts = false);
@@ -70,12 +80,15 @@ namespace LuaUtil
                 : mSerializedValue(serialize(value))
             {
             }
+            static Value fromSerialized(std::string serializedValue);
+            const std::string& getSerialized() const { return mSerializedValue; }
             sol::object getCopy(lua_State* state) const;
             sol::object getReadOnly(lua_State* state) const;
 
         private:
             std::string mSerializedValue;
-            mutable sol::main_object mReadOnlyValue = sol::nil;
+            // One copy per Lua state, local scripts can be distributed among several states
+            mutable std::vector<sol::main_object> mReadOnlyValues;
         };
 
         struct Section
@@ -98,10 +111,17 @@ namespace LuaUtil
             sol::table asTable(lua_State* state);
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
+            bool hasValues() const { return !mPendingValues.empty() || !mValues.empty(); }
+            std::string serializeValues() const;
+            void loadPendingValues();
 
             LuaStorage* mStorage;
             std::string mSectionName;
             std::map<std::string, Value, std::less<>> mValues;
+            // Values read from the file and not parsed yet
+            std::string mPendingValues;
+            // Since the last save or load
+            bool mChanged = true;
             std::vector<Callback> mCallbacks;
             std::vector<Callback> mMenuScriptsCallbacks; // menu callbacks are in a separate vector because we don't
                                                          // remove them in clear()
@@ -120,8 +140,15 @@ namespace LuaUtil
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
         std::map<std::string_view, std::shared_ptr<Section>> mData;
+        // State of the file that was loaded or saved last time
+        std::filesystem::path mFilePath;
+        std::uintmax_t mFileSize = 0;
+        std::map<std::string, std::size_t, std::less<>> mSavedChunkSizes;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
+        // Guards sections that can be accessed by local scripts running in parallel in different Lua states.
+        // Modifications are done only by global and player scripts which never run concurrently with local scripts.
+        std::mutex mMutex;
         bool mActive = false;
         void checkIfActive() const
         {
@@ -0,0 +1,162 @@
+#ifndef COMPONENTS_LUA_TIMERWHEEL_H
+#define COMPONENTS_LUA_TIMERWHEEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace LuaUtil
+{
+    // Queue of timers ordered by time. Timers that are close to the current time are stored in a ring of unsorted
+    // buckets covering `resolution` units of time each, only the current bucket is kept sorted. Further timers are
+    // stored in a heap and moved into the ring when it reaches them. So most insertions are O(1) and processing
+    // a frame without expired timers doesn't touch any timer.
+    // Timers with the same time are called in the order they were inserted.
+    template <class T>
+    class TimerWheel
+    {
+    public:
+        explicit TimerWheel(double resolution, std::size_t bucketsCount = 64)
+            : mResolution(resolution)
+            , mBuckets(bucketsCount)
+        {
+        }
+
+        std::size_t size() const { return mWheelSize + mOverflow.size(); }
+
+        bool empty() const { return size() == 0; }
+
+        void insert(double time, T value)
+        {
+            Entry entry{ time, mNextSequence++, std::move(value) };
+            const std::int64_t tick = toTick(time);
+            if (tick <= mCurrentTick)
+            {
+                Bucket& current = getBucket(mCurrentTick);
+                current.insert(std::lower_bound(current.begin(), current.end(), entry, isLater), std::move(entry));
+                ++mWheelSize;
+            }
+            else if (tick < mCurrentTick + static_cast<std::int64_t>(mBuckets.size()))
+            {
+                getBucket(tick).push_back(std::move(entry));
+                ++mWheelSize;
+            }
+            else
+            {
+                mOverflow.push_back(std::move(entry));
+                std::push_heap(mOverflow.begin(), mOverflow.end(), isLater);
+            }
+        }
+
+        // Moves the wheel up to `now`. Returns whether there are timers with time <= now.
+        bool advance(double now)
+        {
+            const std::int64_t nowTick = toTick(now);
+            while (true)
+            {
+                const Bucket& current = getBucket(mCurrentTick);
+                if (!current.empty())
+                    return current.back().mTime <= now;
+                if (mCurrentTick >= nowTick)
+                    return false;
+                if (mWheelSize != 0)
+                    ++mCurrentTick;
+                else if (!mOverflow.empty())
+                    mCurrentTick = std::min(nowTick, toTick(mOverflow.front().mTime));
+                else
+                    mCurrentTick = nowTick;
+                while (!mOverflow.empty()
+                    && toTick(mOverflow.front().mTime) < mCurrentTick + static_cast<std::int64_t>(mBuckets.size()))
+                {
+                    std::pop_heap(mOverflow.begin(), mOverflow.end(), isLater);
+                    getBucket(toTick(mOverflow.back().mTime)).push_back(std::move(mOverflow.back()));
+                    mOverflow.pop_back();
+                    ++mWheelSize;
+                }
+                Bucket& next = getBucket(mCurrentTick);
+                std::sort(next.begin(), next.end(), isLater);
+            }
+        }
+
+        // Removes timers with time <= now and calls `fn(value)` for each of them in order of time. The timer is removed
+        // before the call, so `fn` can insert new timers; they are called by the same `process` if already expired.
+        template <class Fn>
+        void process(double now, Fn&& fn)
+        {
+            while (advance(now))
+            {
+                Bucket& current = getBucket(mCurrentTick);
+                T value = std::move(current.back().mValue);
+                current.pop_back();
+                --mWheelSize;
+                fn(value);
+            }
+        }
+
+        // Calls `fn(time, value)` for each timer in unspecified order.
+        template <class Fn>
+        void forEach(Fn&& fn) const
+        {
+            for (const Bucket& bucket : mBuckets)
+                for (const Entry& entry : bucket)
+                    fn(entry.mTime, entry.mValue);
+            for (const Entry& entry : mOverflow)
+                fn(entry.mTime, entry.mValue);
+        }
+
+        void clear()
+        {
+            for (Bucket& bucket : mBuckets)
+                bucket.clear();
+            mOverflow.clear();
+            mWheelSize = 0;
+        }
+
+    private:
+        struct Entry
+        {
+            double mTime;
+            std::uint64_t mSequence;
+            T mValue;
+        };
+
+        using Bucket = std::vector<Entry>;
+
+        static bool isLater(const Entry& l, const Entry& r)
+        {
+            if (l.mTime != r.mTime)
+                return l.mTime > r.mTime;
+            return l.mSequence > r.mSequence;
+        }
+
+        std::int64_t toTick(double time) const
+        {
+            // Far enough to never overflow when the number of buckets is added
+            constexpr double limit = static_cast<double>(std::numeric_limits<std::int64_t>::max() / 4);
+            const double tick = std::floor(time / mResolution);
+            if (!(tick < limit)) // NaN timers are never called
+                return static_cast<std::int64_t>(limit);
+            if (!(tick > -limit))
+                return static_cast<std::int64_t>(-limit);
+            return static_cast<std::int64_t>(tick);
+        }
+
+        Bucket& getBucket(std::int64_t tick)
+        {
+            const auto size = static_cast<std::int64_t>(mBuckets.size());
+            return mBuckets[static_cast<std::size_t>((tick % size + size) % size)];
+        }
+
+        double mResolution;
+        std::int64_t mCurrentTick = 0;
+        std::uint64_t mNextSequence = 0;
+        std::size_t mWheelSize = 0;
+        std::vector<Bucket> mBuckets;
+        std::vector<Entry> mOverflow;
+    };
+}
+
+#endif // COMPONENTS_LUA_TIMERWHEEL_H
@@ -4,40 +4,67 @@
 
 #include <cstddef>
 #include <cstring>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace Misc
 {
-    std::vector<std::byte> compress(const std::vector<std::byte>& data)
+    namespace
+    {
+        std::size_t compressBlock(std::span<const std::byte> data, std::span<std::byte> result)
+        {
+            const int size = LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
+                reinterpret_cast<char*>(result.data()), static_cast<int>(data.size()),
+                static_cast<int>(result.size()));
+            if (size == 0)
+                throw std::runtime_error("Failed to compress");
+            return static_cast<std::size_t>(size);
+        }
+
+        std::size_t getCompressBound(std::size_t size)
+        {
+            return static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(size)));
+        }
+    }
+
+    std::vector<std::byte> compress(std::span<const std::byte> data)
     {
         const std::size_t originalSize = data.size();
-        std::vector<std::byte> result(
-            static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(originalSize)) + sizeof(originalSize)));
-        const int size = LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
-            reinterpret_cast<char*>(result.data()) + sizeof(originalSize), static_cast<int>(data.size()),
-            static_cast<int>(result.size() - sizeof(originalSize)));
-        if (size == 0)
-            throw std::runtime_error("Failed to compress");
+        std::vector<std::byte> result(getCompressBound(originalSize) + sizeof(originalSize));
+        const std::size_t size = compressBlock(data, std::span(result).subspan(sizeof(originalSize)));
         std::memcpy(result.data(), &originalSize, sizeof(originalSize));
-        result.resize(static_cast<std::size_t>(size) + sizeof(originalSize));
+        result.resize(size + sizeof(originalSize));
         return result;
     }
 
-    std::vector<std::byte> decompress(const std::vector<std::byte>& data)
+    std::vector<std::byte> decompress(std::span<const std::byte> data)
     {
         std::size_t originalSize;
+        if (data.size() < sizeof(originalSize))
+            throw std::runtime_error("Compressed data is too small: " + std::to_string(data.size()));
         std::memcpy(&originalSize, data.data(), sizeof(originalSize));
         std::vector<std::byte> result(originalSize);
-        const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()) + sizeof(originalSize),
-            reinterpret_cast<char*>(result.data()), static_cast<int>(data.size() - sizeof(originalSize)),
-            static_cast<int>(result.size()));
+        decompressBlock(data.subspan(sizeof(originalSize)), result);
+        return result;
+    }
+
+    std::vector<std::byte> compressBlock(std::span<const std::byte> data)
+    {
+        std::vector<std::byte> result(getCompressBound(data.size()));
+        result.resize(compressBlock(data, result));
+        return result;
+    }
+
+    void decompressBlock(std::span<const std::byte> data, std::span<std::byte> result)
+    {
+        const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data.data()),
+            reinterpret_cast<char*>(result.data()), static_cast<int>(data.size()), static_cast<int>(result.size()));
         if (size < 0)
             throw std::runtime_error("Failed to decompress");
-        if (originalSize != static_cast<std::size_t>(size))
-            throw std::runtime_error("Size of decompressed data (" + std::to_string(size) + ") doesn't match stored ("
-                + std::to_string(originalSize) + ")");
-        return result;
+        if (result.size() != static_cast<std::size_t>(size))
+            throw std::runtime_error("Size of decompressed data (" + std::to_string(size) + ") doesn't match expected ("
+                + std::to_string(result.size()) + ")");
     }
 }
@@ -2,13 +2,20 @@
 #define OPENMW_COMPONENTS_MISC_COMPRESSION_H
 
 #include <cstddef>
+#include <span>
 #include <vector>
 
 namespace Misc
 {
-    std::vector<std::byte> compress(const std::vector<std::byte>& data);
+    std::vector<std::byte> compress(std::span<const std::byte> data);
 
-    std::vector<std::byte> decompress(const std::vector<std::byte>& data);
+    std::vector<std::byte> decompress(std::span<const std::byte> data);
+
+    // Compress into a raw LZ4 block without the size prefix added by compress
+    std::vector<std::byte> compressBlock(std::span<const std::byte> data);
+
+    // Decompress a raw LZ4 block into a buffer of exactly the original size
+    void decompressBlock(std::span<const std::byte> data, std::span<std::byte> result);
 }
 
 #endif
@@ -74,8 +74,8 @@ namespace Resource
                 "",
                 "Lua UsedMemory",
                 "",
-                "",
-                "",
+                "Skinning Rigs",
+                "Skinning Shared",
             };
 
             static_assert(std::size(firstPage) == itemsPerPage);
@@ -90,6 +90,7 @@ namespace Resource
                 "BSShader Material",
                 "Groundcover Chunk",
                 "Object Chunk",
+                "Object Batch",
                 "Terrain Chunk",
                 "Terrain Texture",
                 "Land",
@@ -104,6 +105,20 @@ namespace Resource
                 "CellPreloader Expired",
             };
 
+            constexpr std::string_view localScripts[] = {
+                "LocalScripts Count",
+                "LocalScripts Run",
+                "LocalScripts Skipped",
+            };
+
+            constexpr std::string_view sound[] = {
+                "SoundBuffer Decoding",
+                "SoundBuffer CacheSize",
+                "SoundBuffer DecodeWait",
+                "Sound RealVoices",
+                "Sound VirtualVoices",
+            };
+
             constexpr std::string_view navMesh[] = {
                 "NavMesh Jobs",
                 "NavMesh Removing",
@@ -120,6 +135,10 @@ namespace Resource
                 "NavMesh CachedTiles",
                 "NavMesh Cache Get",
                 "NavMesh Cache Hit",
+                "NavMesh LayerCache Size",
+                "NavMesh LayerCache Items",
+                "NavMesh LayerCache Get",
+                "NavMesh LayerCache Hit",
                 "NavMesh Recast Tiles",
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
@@ -141,6 +160,16 @@ namespace Resource
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : localScripts)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : sound)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
@@ -0,0 +1,131 @@
+#include "lightgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SceneUtil
+{
+    namespace
+    {
+        // Testing each light is cheaper than a grid lookup for a small number of lights
+        constexpr std::size_t sMinLightsForGrid = 16;
+
+        constexpr int sMaxClustersPerAxis = 16;
+
+        int getClustersPerAxis(std::size_t lights)
+        {
+            const int value = static_cast<int>(std::lround(std::cbrt(static_cast<double>(lights)) * 2));
+            return std::clamp(value, 1, sMaxClustersPerAxis);
+        }
+
+        bool intersects(const osg::BoundingSphere& bound, const osg::BoundingBoxf& box)
+        {
+            const osg::Vec3f& center = bound.center();
+            const float radius = bound.radius();
+            return center.x() + radius >= box.xMin() && center.x() - radius <= box.xMax()
+                && center.y() + radius >= box.yMin() && center.y() - radius <= box.yMax()
+                && center.z() + radius >= box.zMin() && center.z() - radius <= box.zMax();
+        }
+    }
+
+    std::array<int, 3> LightGrid::getCluster(const osg::Vec3f& position) const
+    {
+        std::array<int, 3> result;
+        for (int i = 0; i < 3; ++i)
+        {
+            const int value = static_cast<int>(std::floor((position[i] - mBox._min[i]) / mClusterSize[i]));
+            result[i] = std::clamp(value, 0, mSize[i] - 1);
+        }
+        return result;
+    }
+
+    template <class Function>
+    void LightGrid::forEachCluster(const osg::BoundingSphere& bound, Function&& function) const
+    {
+        if (!bound.valid() || !intersects(bound, mBox))
+            return;
+
+        const osg::Vec3f radius(bound.radius(), bound.radius(), bound.radius());
+        const std::array<int, 3> min = getCluster(bound.center() - radius);
+        const std::array<int, 3> max = getCluster(bound.center() + radius);
+
+        for (int z = min[2]; z <= max[2]; ++z)
+            for (int y = min[1]; y <= max[1]; ++y)
+                for (int x = min[0]; x <= max[0]; ++x)
+                    function(getIndex(x, y, z));
+    }
+
+    void LightGrid::build()
+    {
+        mBox.init();
+        mSize = { 0, 0, 0 };
+        mOffsets.clear();
+        mLights.clear();
+
+        if (mBounds.size() < sMinLightsForGrid)
+            return;
+
+        for (const osg::BoundingSphere& bound : mBounds)
+            if (bound.valid())
+                mBox.expandBy(bound);
+
+        if (!mBox.valid())
+            return;
+
+        const int clustersPerAxis = getClustersPerAxis(mBounds.size());
+        for (int i = 0; i < 3; ++i)
+        {
+            mSize[i] = clustersPerAxis;
+            const float extent = mBox._max[i] - mBox._min[i];
+            mClusterSize[i] = extent > 0 ? extent / clustersPerAxis : 1;
+        }
+
+        // Counting sort of (cluster, light) pairs keeps light indices ascending within each cluster
+        mOffsets.assign(static_cast<std::size_t>(mSize[0]) * mSize[1] * mSize[2] + 1, 0);
+
+        for (const osg::BoundingSphere& bound : mBounds)
+            forEachCluster(bound, [&](std::size_t cluster) { ++mOffsets[cluster + 1]; });
+
+        for (std::size_t i = 1; i < mOffsets.size(); ++i)
+            mOffsets[i] += mOffsets[i - 1];
+
+        mLights.resize(mOffsets.back());
+
+        std::vector<std::uint32_t> positions(mOffsets.begin(), mOffsets.end() - 1);
+        for (std::size_t i = 0; i < mBounds.size(); ++i)
+            forEachCluster(mBounds[i],
+                [&](std::size_t cluster) { mLights[positions[cluster]++] = static_cast<std::uint32_t>(i); });
+    }
+
+    void LightGrid::query(const osg::BoundingSphere& bound, std::vector<std::size_t>& result) const
+    {
+        result.clear();
+
+        if (mSize[0] == 0)
+        {
+            for (std::size_t i = 0; i < mBounds.size(); ++i)
+                if (mBounds[i].intersects(bound))
+                    result.push_back(i);
+            return;
+        }
+
+        forEachCluster(bound, [&](std::size_t cluster) {
+            result.insert(result.end(), mLights.begin() + mOffsets[cluster], mLights.begin() + mOffsets[cluster + 1]);
+        });
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        result.erase(std::remove_if(result.begin(), result.end(),
+                         [&](std::size_t index) { return !mBounds[index].intersects(bound); }),
+            result.end());
+    }
+
+    void LightGrid::clear()
+    {
+        mBounds.clear();
+        mBox.init();
+        mSize = { 0, 0, 0 };
+        mOffsets.clear();
+        mLights.clear();
+    }
+}
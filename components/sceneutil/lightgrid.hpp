@@ -0,0 +1,55 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_LIGHTGRID_H
+#define OPENMW_COMPONENTS_SCENEUTIL_LIGHTGRID_H
+
+#include <osg/BoundingBox>
+#include <osg/BoundingSphere>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Uniform 3D grid of clusters over view space bounds of lights.
+    /// @par Each cluster stores indices of the lights overlapping it, so finding lights affecting an object requires to
+    /// test only the lights of the clusters the object overlaps. Lights are stored in a single array ordered by
+    /// cluster.
+    class LightGrid
+    {
+    public:
+        /// Appends light bound. Light index is the number of previously added lights.
+        void add(const osg::BoundingSphere& bound) { mBounds.push_back(bound); }
+
+        /// Bins added lights into clusters. Must be called before query.
+        void build();
+
+        /// Fills result with indices of lights intersecting the bound in ascending order.
+        void query(const osg::BoundingSphere& bound, std::vector<std::size_t>& result) const;
+
+        std::size_t getLightsCount() const { return mBounds.size(); }
+
+        void clear();
+
+    private:
+        std::vector<osg::BoundingSphere> mBounds;
+        osg::BoundingBoxf mBox;
+        std::array<int, 3> mSize{ 0, 0, 0 };
+        osg::Vec3f mClusterSize;
+        // Offsets of each cluster in mLights, has one more element than the number of clusters
+        std::vector<std::uint32_t> mOffsets;
+        std::vector<std::uint32_t> mLights;
+
+        std::array<int, 3> getCluster(const osg::Vec3f& position) const;
+
+        std::size_t getIndex(int x, int y, int z) const
+        {
+            return (static_cast<std::size_t>(z) * mSize[1] + y) * mSize[0] + x;
+        }
+
+        template <class Function>
+        void forEachCluster(const osg::BoundingSphere& bound, Function&& function) const;
+    };
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <osg/Group>
 #include <osg/Light>
@@ -13,6 +14,7 @@
 
 #include <components/sceneutil/nodecallback.hpp>
 
+#include "lightgrid.hpp"
 #include "lightingmethod.hpp"
 
 namespace SceneUtil
@@ -210,6 +212,13 @@ namespace SceneUtil
             osg::BoundingSphere mViewBound;
         };
 
+        struct LightsInViewSpace
+        {
+            std::vector<LightSourceViewBound> mLights;
+            // Clusters of mLights bounds
+            LightGrid mGrid;
+        };
+
         using LightList = std::vector<const LightSourceViewBound*>;
         using SupportedMethods = std::array<bool, 3>;
 
@@ -237,7 +246,7 @@ namespace SceneUtil
         /// Internal use only, called automatically by the LightSource's UpdateCallback
         void addLight(LightSource* lightSource, const osg::Matrixf& worldMat, size_t frameNum);
 
-        const std::vector<LightSourceViewBound>& getLightsInViewSpace(
+        const LightsInViewSpace& getLightsInViewSpace(
             osgUtil::CullVisitor* cv, const osg::RefMatrix* viewMatrix, size_t frameNum);
 
         osg::ref_ptr<osg::StateSet> getLightListStateSet(
@@ -294,8 +303,7 @@ namespace SceneUtil
 
         std::vector<LightSourceTransform> mLights;
 
-        using LightSourceViewBoundCollection = std::vector<LightSourceViewBound>;
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection> mLightsInViewSpace;
+        std::map<osg::observer_ptr<osg::Camera>, LightsInViewSpace> mLightsInViewSpace;
 
         using LightIdList = std::vector<int>;
         struct HashLightIdList
@@ -374,6 +382,7 @@ namespace SceneUtil
         LightManager* mLightManager;
         size_t mLastFrameNumber;
         LightManager::LightList mLightList;
+        std::vector<std::size_t> mLightIndices;
         std::set<SceneUtil::LightSource*> mIgnoredLightSources;
     };
 
@@ -41,6 +41,7 @@
 #include <cassert>
 
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 // NOLINTBEGIN(readability-identifier-naming)
 
@@ -119,6 +120,7 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         mgv.setTargetMaximumNumberOfVertices(1000000);
         mgv.setMergeAlphaBlending(_mergeAlphaBlending);
         mgv.setViewPoint(_viewPoint);
+        mgv.setWorkQueue(_workQueue, _maxWorkQueueHelpers);
         node->accept(mgv);
 
         osg::Timer_t endTick = osg::Timer::instance()->tick();
@@ -1204,6 +1206,9 @@ bool containsSharedPrimitives(const osg::Geometry* geom)
 
     namespace
     {
+        // Merging smaller groups in parallel costs more in scheduling than it saves
+        constexpr unsigned minParallelMergeVertices = 16384;
+
         unsigned getArraySizeOrZero(const osg::Array* array)
         {
             return array == nullptr ? 0 : array->getNumElements();
@@ -1362,6 +1367,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
 
         // then build merge list using _targetMaximumNumberOfVertices
         bool needToDoMerge = false;
+        unsigned int numVerticesToMerge = 0;
         // dequeue each DuplicateList when vertices limit is reached or when all elements has been checked
         for(MergeList::iterator itr=mergeListChecked.begin(); itr!=mergeListChecked.end(); ++itr)
         {
@@ -1393,7 +1399,11 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                 }
                 totalNumberVertices += numVertices;
                 subset.push_back(geometry);
-                if (subset.size()>1) needToDoMerge = true;
+                if (subset.size()>1)
+                {
+                    needToDoMerge = true;
+                    numVerticesToMerge += numVertices;
+                }
             }
             if (!subset.empty()) mergeList.push_back(std::move(subset));
         }
@@ -1410,10 +1420,8 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                 group.addChild(*itr);
             }
 
-            // Place outside the loop to keep vectors allocated
-            GeometryArraySizes sizes;
-
-            // now do the merging of geometries
+            // merge lists don't share geometries, so each one can be merged independently once the children are placed.
+            std::vector<DuplicateList*> duplicateListsToMerge;
             for(MergeList::iterator mitr = mergeList.begin();
                 mitr != mergeList.end();
                 ++mitr)
@@ -1427,22 +1435,48 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                         lgvp._viewPoint = _viewPoint;
                         std::sort(duplicateList.begin(), duplicateList.end(), lgvp);
                     }
-                    DuplicateList::iterator ditr = duplicateList.begin();
-                    osg::ref_ptr<osg::Geometry> lhs = *ditr++;
+                    group.addChild(duplicateList.front().get());
+                    if (duplicateList.size() > 1)
+                        duplicateListsToMerge.push_back(&duplicateList);
+                }
+            }
 
-                    initArraySizes(*lhs, sizes);
+            const auto mergeDuplicateList = [] (DuplicateList& duplicateList, GeometryArraySizes& sizes)
+            {
+                DuplicateList::iterator ditr = duplicateList.begin();
+                osg::Geometry& lhs = **ditr++;
 
-                    for (auto it = ditr; it != duplicateList.end(); ++it)
-                        addArraysSizes(*lhs, **it, sizes);
+                // reserve space for all merged arrays at once
+                initArraySizes(lhs, sizes);
 
-                    group.addChild(lhs.get());
-                    for(;
-                        ditr != duplicateList.end();
-                        ++ditr)
-                    {
-                        mergeGeometry(*lhs, **ditr, sizes);
-                    }
+                for (auto it = ditr; it != duplicateList.end(); ++it)
+                    addArraysSizes(lhs, **it, sizes);
+
+                for(;
+                    ditr != duplicateList.end();
+                    ++ditr)
+                {
+                    mergeGeometry(lhs, **ditr, sizes);
                 }
+            };
+
+            if (_workQueue != nullptr && duplicateListsToMerge.size() > 1
+                && numVerticesToMerge >= minParallelMergeVertices)
+            {
+                const std::size_t count = duplicateListsToMerge.size();
+                SceneUtil::parallelFor(_workQueue, _maxWorkQueueHelpers, count, [&] (std::size_t index)
+                {
+                    GeometryArraySizes sizes;
+                    mergeDuplicateList(*duplicateListsToMerge[index], sizes);
+                });
+            }
+            else
+            {
+                // Place outside the loop to keep vectors allocated
+                GeometryArraySizes sizes;
+
+                for (DuplicateList* duplicateList : duplicateListsToMerge)
+                    mergeDuplicateList(*duplicateList, sizes);
             }
         }
 
@@ -1503,8 +1537,6 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
 #if 1
                 bool doneCombine = false;
 
-                std::set<osg::PrimitiveSet*> toremove;
-
                 osg::Geometry::PrimitiveSetList& primitives = geom->getPrimitiveSetList();
                 unsigned int lhsNo=0;
                 unsigned int rhsNo=1;
@@ -1562,7 +1594,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                     if (combine)
                     {
                         // make this primitive set as invalid and needing cleaning up.
-                        toremove.insert(rhs);
+                        primitives[rhsNo] = nullptr;
                         doneCombine = true;
                         ++rhsNo;
                     }
@@ -1577,17 +1609,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                 if (doneCombine)
                 {
                     // now need to clean up primitiveset so it no longer contains the rhs combined primitives.
-                    // first swap with a empty primitiveSet to empty it completely.
-                    osg::Geometry::PrimitiveSetList oldPrimitives;
-                    primitives.swap(oldPrimitives);
-
-                    // now add the active primitive sets
-                    for(osg::Geometry::PrimitiveSetList::iterator pitr = oldPrimitives.begin();
-                        pitr != oldPrimitives.end();
-                        ++pitr)
-                    {
-                        if (!toremove.count(*pitr)) primitives.push_back(*pitr);
-                    }
+                    primitives.erase(std::remove(primitives.begin(), primitives.end(), nullptr), primitives.end());
                 }
     #endif
 
@@ -1875,7 +1897,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGeometry(osg::Geometry& lhs, osg::Geo
                     osg::DrawElementsUInt* new_primitive = new osg::DrawElementsUInt(primitive->getMode());
                     if (!ebo) ebo = new osg::ElementBufferObject;
                     new_primitive->setElementBufferObject(ebo);
-                    std::copy(primitiveUByte->begin(),primitiveUByte->end(),std::back_inserter(*new_primitive));
+                    new_primitive->insert(new_primitive->end(),primitiveUByte->begin(),primitiveUByte->end());
                     new_primitive->offsetIndices(base);
                     (*primItr) = new_primitive;
                 } else if ((base+currentMaximum)>=256)
@@ -1884,7 +1906,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGeometry(osg::Geometry& lhs, osg::Geo
                     osg::DrawElementsUShort* new_primitive = new osg::DrawElementsUShort(primitive->getMode());
                     if (!ebo) ebo = new osg::ElementBufferObject;
                     new_primitive->setElementBufferObject(ebo);
-                    std::copy(primitiveUByte->begin(),primitiveUByte->end(),std::back_inserter(*new_primitive));
+                    new_primitive->insert(new_primitive->end(),primitiveUByte->begin(),primitiveUByte->end());
                     new_primitive->offsetIndices(base);
                     (*primItr) = new_primitive;
                 }
@@ -1912,7 +1934,7 @@ bool Optimizer::MergeGeometryVisitor::mergeGeometry(osg::Geometry& lhs, osg::Geo
                     osg::DrawElementsUInt* new_primitive = new osg::DrawElementsUInt(primitive->getMode());
                     if (!ebo) ebo = new osg::ElementBufferObject;
                     new_primitive->setElementBufferObject(ebo);
-                    std::copy(primitiveUShort->begin(),primitiveUShort->end(),std::back_inserter(*new_primitive));
+                    new_primitive->insert(new_primitive->end(),primitiveUShort->begin(),primitiveUShort->end());
                     new_primitive->offsetIndices(base);
                     (*primItr) = new_primitive;
                 }
@@ -40,6 +40,7 @@ namespace SceneUtil {
 
 // forward declare
 class Optimizer;
+class WorkQueue;
 
 /** Helper base class for implementing Optimizer techniques.*/
 class BaseOptimizerVisitor : public osg::NodeVisitor
@@ -74,7 +75,8 @@ class Optimizer
 
     public:
 
-        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr) {}
+        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr),
+            _workQueue(nullptr), _maxWorkQueueHelpers(0) {}
         virtual ~Optimizer() {}
 
         enum OptimizationOptions
@@ -132,6 +134,14 @@ class Optimizer
 
         void setSharedStateManager(osgDB::SharedStateManager* sharedStateManager, std::mutex* sharedStateMutex) { _sharedStateMutex = sharedStateMutex; _sharedStateManager = sharedStateManager; }
 
+        /** Merge independent geometry lists of large groups in parallel using up to maxHelpers work items of the
+          * given queue in addition to the calling thread. The queue must outlive the call to optimize().*/
+        void setWorkQueue(WorkQueue* workQueue, std::size_t maxHelpers)
+        {
+            _workQueue = workQueue;
+            _maxWorkQueueHelpers = maxHelpers;
+        }
+
         /** Reset internal data to initial state - the getPermissibleOptionsMap is cleared.*/
         void reset();
 
@@ -272,6 +282,9 @@ class Optimizer
         osgDB::SharedStateManager* _sharedStateManager;
         mutable std::mutex* _sharedStateMutex;
 
+        WorkQueue* _workQueue;
+        std::size_t _maxWorkQueueHelpers;
+
     public:
 
         /** Flatten Static Transform nodes by applying their transform to the
@@ -410,7 +423,8 @@ class Optimizer
                 /// default to traversing all children.
                 MergeGeometryVisitor(Optimizer* optimizer=0) :
                     BaseOptimizerVisitor(optimizer, MERGE_GEOMETRY),
-                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false) {}
+                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false),
+                    _workQueue(nullptr), _maxWorkQueueHelpers(0) {}
 
                 void setMergeAlphaBlending(bool merge)
                 {
@@ -421,6 +435,12 @@ class Optimizer
                     _viewPoint = viewPoint;
                 }
 
+                void setWorkQueue(WorkQueue* workQueue, std::size_t maxHelpers)
+                {
+                    _workQueue = workQueue;
+                    _maxWorkQueueHelpers = maxHelpers;
+                }
+
                 void setTargetMaximumNumberOfVertices(unsigned int num)
                 {
                     _targetMaximumNumberOfVertices = num;
@@ -455,6 +475,8 @@ class Optimizer
                 bool _alphaBlendingActive;
                 bool _mergeAlphaBlending;
                 osg::Vec3f _viewPoint;
+                WorkQueue* _workQueue;
+                std::size_t _maxWorkQueueHelpers;
         };
 
 };
@@ -11,6 +11,7 @@
 #include <components/resource/scenemanager.hpp>
 
 #include "skeleton.hpp"
+#include "skinning.hpp"
 #include "util.hpp"
 
 namespace SceneUtil
@@ -28,14 +29,19 @@ namespace SceneUtil
     {
         setSourceGeometry(copy.mSourceGeometry);
         setNumChildrenRequiringUpdateTraversal(1);
+        if (mData != nullptr && mSourceGeometry != nullptr)
+            mSkinningSource = copy.getSkinningSource();
     }
 
+    RigGeometry::~RigGeometry() = default;
+
     void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
     {
         for (unsigned int i = 0; i < 2; ++i)
             mGeometry[i] = nullptr;
 
         mSourceGeometry = sourceGeometry;
+        mSkinningSource = nullptr;
 
         for (unsigned int i = 0; i < 2; ++i)
         {
@@ -149,20 +155,37 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        mLastCullFrameNumber = traversalNumber;
+        mSkeleton->waitForSkinning();
+        if (mSkinnedFrameNumber == traversalNumber)
+            mLastFrameNumber = traversalNumber;
+        // Geometry shared in a previous frame may be already overwritten by its owner
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0 && !mSkeleton->getActive() && mSharedGeometry == nullptr))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
+            osg::ref_ptr<osg::Geometry> geom = getSkinnedGeometry();
+            nv->pushOntoNodePath(geom);
+            nv->apply(*geom);
             nv->popFromNodePath();
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
-        // skinning
+        skin(traversalNumber);
+
+        osg::ref_ptr<osg::Geometry> geom = getSkinnedGeometry();
+        nv->pushOntoNodePath(geom);
+        nv->apply(*geom);
+        nv->popFromNodePath();
+    }
+
+    void RigGeometry::skin(unsigned int traversalNumber)
+    {
+        osg::Geometry& geom = *getGeometry(traversalNumber);
+        const std::shared_ptr<const SkinningSource> source = getSkinningSource();
+
         const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
         const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
         const osg::Vec4Array* tangentSrc = mSourceTangents;
@@ -188,8 +211,22 @@ namespace SceneUtil
         else
             transform = mData->mTransform;
 
-        for (const auto& [influences, vertices] : mData->mInfluences)
+        SharedSkinning& sharedSkinning = getSharedSkinning();
+        const std::size_t poseHash = mSkeleton->getPoseHash();
+        if (osg::ref_ptr<osg::Geometry> shared
+            = sharedSkinning.find(traversalNumber, mSourceGeometry.get(), poseHash, boneMatrices, transform))
+        {
+            setSharedGeometry(std::move(shared));
+            mSkinnedFrameNumber = traversalNumber;
+            countSkinning(true);
+            return;
+        }
+        setSharedGeometry(nullptr);
+
+        for (std::size_t group = 0; group < mData->mInfluences.size(); ++group)
         {
+            const auto& [influences, vertices] = mData->mInfluences[group];
+
             osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
 
             for (const auto& [index, weight] : influences)
@@ -205,6 +242,33 @@ namespace SceneUtil
 
             resultMat *= transform;
 
+            if (isAffine(resultMat))
+            {
+                const std::size_t begin = source->mGroupOffsets[group];
+                const std::size_t count = source->mGroupOffsets[group + 1] - begin;
+                const unsigned short* const indices = source->mVertices.data() + begin;
+
+                const auto& positions = source->mPositions;
+                transformPoints(resultMat, positions[0].data() + begin, positions[1].data() + begin,
+                    positions[2].data() + begin, indices, count, positionDst->data());
+
+                if (normalDst && !source->mNormals[0].empty())
+                {
+                    const auto& normals = source->mNormals;
+                    transformDirections(resultMat, normals[0].data() + begin, normals[1].data() + begin,
+                        normals[2].data() + begin, indices, count, normalDst->data());
+                }
+
+                if (tangentDst && !source->mTangents[0].empty())
+                {
+                    const auto& tangents = source->mTangents;
+                    transformDirections(resultMat, tangents[0].data() + begin, tangents[1].data() + begin,
+                        tangents[2].data() + begin, indices, count, tangentDst->data());
+                }
+
+                continue;
+            }
+
             for (unsigned short vertex : vertices)
             {
                 (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
@@ -229,9 +293,44 @@ namespace SceneUtil
 
         geom.osg::Drawable::dirtyGLObjects();
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+        mSkinnedFrameNumber = traversalNumber;
+        countSkinning(false);
+        sharedSkinning.add(traversalNumber, mSourceGeometry.get(), poseHash, std::move(boneMatrices), transform, &geom);
+    }
+
+    std::shared_ptr<const SkinningSource> RigGeometry::getSkinningSource() const
+    {
+        const std::lock_guard lock(mSkinningSourceMutex);
+
+        if (mSkinningSource != nullptr)
+            return mSkinningSource;
+
+        const osg::Vec3Array* positions = static_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+        const osg::Vec3Array* normals = static_cast<const osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+        const osg::Vec4Array* tangents = mSourceTangents;
+
+        auto source = std::make_shared<SkinningSource>();
+        source->mGroupOffsets.reserve(mData->mInfluences.size() + 1);
+        source->mGroupOffsets.push_back(0);
+        for (const auto& [influences, vertices] : mData->mInfluences)
+        {
+            for (unsigned short vertex : vertices)
+            {
+                source->mVertices.push_back(vertex);
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    source->mPositions[i].push_back((*positions)[vertex][i]);
+                    if (normals != nullptr)
+                        source->mNormals[i].push_back((*normals)[vertex][i]);
+                    if (tangents != nullptr)
+                        source->mTangents[i].push_back((*tangents)[vertex][i]);
+                }
+            }
+            source->mGroupOffsets.push_back(source->mVertices.size());
+        }
+
+        mSkinningSource = std::move(source);
+        return mSkinningSource;
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -353,6 +452,7 @@ namespace SceneUtil
 
         mData->mInfluences.reserve(influencesToVertices.size());
         mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mSkinningSource = nullptr;
     }
 
     void RigGeometry::setInfluences(const std::vector<BoneWeights>& influences)
@@ -366,6 +466,7 @@ namespace SceneUtil
 
         mData->mInfluences.reserve(influencesToVertices.size());
         mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mSkinningSource = nullptr;
     }
 
     void RigGeometry::setTransform(osg::Matrixf&& transform)
@@ -403,7 +504,15 @@ namespace SceneUtil
                 cv->popStateSet();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
+        {
             updateBounds(&nv);
+            // Rig not culled in the last frame is likely to be not visible in this one as well, if it becomes
+            // visible it's skinned by the cull traversal
+            if (mSkeleton != nullptr
+                && (mLastFrameNumber == 0
+                    || (mSkeleton->getActive() && mLastCullFrameNumber + 1 >= nv.getTraversalNumber())))
+                mSkeleton->requestSkinning(this);
+        }
         else
             nv.apply(*this);
 
@@ -412,7 +521,7 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
+        getSkinnedGeometry()->accept(func);
     }
 
     osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
@@ -420,4 +529,18 @@ namespace SceneUtil
         return mGeometry[frame % 2].get();
     }
 
+    osg::ref_ptr<osg::Geometry> RigGeometry::getSkinnedGeometry() const
+    {
+        const std::lock_guard lock(mSharedGeometryMutex);
+        if (mSharedGeometry != nullptr)
+            return mSharedGeometry;
+        return getGeometry(mLastFrameNumber);
+    }
+
+    void RigGeometry::setSharedGeometry(osg::ref_ptr<osg::Geometry>&& geometry)
+    {
+        const std::lock_guard lock(mSharedGeometryMutex);
+        mSharedGeometry = std::move(geometry);
+    }
+
 }
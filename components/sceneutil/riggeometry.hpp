@@ -4,12 +4,15 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <memory>
+#include <mutex>
 #include <string_view>
 
 namespace SceneUtil
 {
     class Skeleton;
     class Bone;
+    struct SkinningSource;
 
     // TODO: This class has a lot of issues.
     // - We require too many workarounds to ensure safety.
@@ -30,6 +33,7 @@ namespace SceneUtil
     public:
         RigGeometry();
         RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop);
+        ~RigGeometry();
 
         META_Object(SceneUtil, RigGeometry)
 
@@ -66,6 +70,10 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Update skinned geometry for the given frame. Bone matrices must be already updated for this frame.
+        /// @note Called by the Skeleton from a worker thread when skinning is done after the update traversal.
+        void skin(unsigned int traversalNumber);
+
         void accept(osg::NodeVisitor& nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -91,6 +99,10 @@ namespace SceneUtil
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
+        osg::ref_ptr<osg::Geometry> getSkinnedGeometry() const;
+
+        void setSharedGeometry(osg::ref_ptr<osg::Geometry>&& geometry);
+
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
         Skeleton* mSkeleton{ nullptr };
@@ -109,8 +121,20 @@ namespace SceneUtil
         std::vector<Bone*> mNodes;
 
         unsigned int mLastFrameNumber{ 0 };
+        unsigned int mLastCullFrameNumber{ 0 };
+        unsigned int mSkinnedFrameNumber{ 0 };
+        // Skinned by another rig with the same source geometry and pose in mSkinnedFrameNumber, drawn instead of
+        // own geometry
+        osg::ref_ptr<osg::Geometry> mSharedGeometry;
+        mutable std::mutex mSharedGeometryMutex;
         bool mBoundsFirstFrame{ true };
 
+        // Shared between copies of the same template
+        mutable std::mutex mSkinningSourceMutex;
+        mutable std::shared_ptr<const SkinningSource> mSkinningSource;
+
+        std::shared_ptr<const SkinningSource> getSkinningSource() const;
+
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
 
         void updateSkinToSkelMatrix(const osg::NodePath& nodePath);
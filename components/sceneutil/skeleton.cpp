@@ -3,9 +3,15 @@
 #include <osg/MatrixTransform>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/hash.hpp>
 #include <components/misc/strings/lower.hpp>
 
+#include "riggeometry.hpp"
+#include "skinning.hpp"
+#include "workqueue.hpp"
+
 #include <algorithm>
+#include <span>
 
 namespace SceneUtil
 {
@@ -33,6 +39,43 @@ namespace SceneUtil
         std::unordered_map<std::string, TransformPath>& mCache;
     };
 
+    namespace
+    {
+        void hashPose(const Bone& bone, std::size_t& seed)
+        {
+            for (const float value : std::span(bone.mMatrixInSkeletonSpace.ptr(), 16))
+                Misc::hashCombine(seed, value);
+            for (const auto& child : bone.mChildren)
+                hashPose(*child, seed);
+        }
+
+        class SkinningWorkItem : public WorkItem
+        {
+        public:
+            explicit SkinningWorkItem(
+                osg::ref_ptr<Skeleton> skeleton, std::vector<osg::ref_ptr<RigGeometry>>&& rigs, unsigned int frame)
+                : mSkeleton(std::move(skeleton))
+                , mRigs(std::move(rigs))
+                , mFrameNumber(frame)
+            {
+            }
+
+            void doWork() override
+            {
+                for (const osg::ref_ptr<RigGeometry>& rig : mRigs)
+                    rig->skin(mFrameNumber);
+                // Skeleton keeps a reference to this item until it's waited for
+                mRigs.clear();
+                mSkeleton = nullptr;
+            }
+
+        private:
+            osg::ref_ptr<Skeleton> mSkeleton;
+            std::vector<osg::ref_ptr<RigGeometry>> mRigs;
+            unsigned int mFrameNumber;
+        };
+    }
+
     Skeleton::Skeleton()
         : mBoneCacheInit(false)
         , mNeedToUpdateBoneMatrices(true)
@@ -101,10 +144,14 @@ namespace SceneUtil
 
         if (mNeedToUpdateBoneMatrices)
         {
+            mPoseHash = 0;
             if (mRootBone.get())
             {
                 for (const auto& child : mRootBone->mChildren)
+                {
                     child->update(nullptr);
+                    hashPose(*child, mPoseHash);
+                }
             }
 
             mNeedToUpdateBoneMatrices = false;
@@ -123,6 +170,7 @@ namespace SceneUtil
 
     void Skeleton::markDirty()
     {
+        waitForSkinning();
         mLastFrameNumber = 0;
         mBoneCache.clear();
         mBoneCacheInit = false;
@@ -132,10 +180,23 @@ namespace SceneUtil
     {
         if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
         {
+            waitForSkinning();
             if (mActive == Inactive && mLastFrameNumber != 0)
                 return;
             if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
                 return;
+
+            osg::Group::traverse(nv);
+
+            if (!mSkinningRequests.empty())
+            {
+                // Bone matrices are read by the worker, they must not be updated concurrently
+                updateBoneMatrices(nv.getTraversalNumber());
+                mSkinning = new SkinningWorkItem(this, std::move(mSkinningRequests), nv.getTraversalNumber());
+                mSkinningRequests.clear();
+                getSkinningWorkQueue()->addWorkItem(mSkinning);
+            }
+            return;
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
             mLastCullFrameNumber = nv.getTraversalNumber();
@@ -143,6 +204,21 @@ namespace SceneUtil
         osg::Group::traverse(nv);
     }
 
+    void Skeleton::requestSkinning(RigGeometry* rig)
+    {
+        if (getSkinningWorkQueue() == nullptr)
+            return;
+        mSkinningRequests.emplace_back(rig);
+    }
+
+    void Skeleton::waitForSkinning()
+    {
+        if (mSkinning == nullptr)
+            return;
+        mSkinning->waitTillDone();
+        mSkinning = nullptr;
+    }
+
     void Skeleton::childInserted(unsigned int)
     {
         markDirty();
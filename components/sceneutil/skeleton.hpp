@@ -5,9 +5,12 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace SceneUtil
 {
+    class RigGeometry;
+    class WorkItem;
 
     /// @brief Defines a Bone hierarchy, used for updating of skeleton-space bone matrices.
     /// @note To prevent unnecessary updates, only bones that are used for skinning will be added to this hierarchy.
@@ -43,6 +46,10 @@ namespace SceneUtil
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
         void updateBoneMatrices(unsigned int traversalNumber);
 
+        /// Hash of skeleton-space matrices of all bones as of the last updateBoneMatrices call.
+        /// Skeletons with equal hashes are likely, but not guaranteed, to have the same pose.
+        std::size_t getPoseHash() const { return mPoseHash; }
+
         enum ActiveType
         {
             Inactive = 0,
@@ -60,6 +67,13 @@ namespace SceneUtil
 
         void markDirty();
 
+        /// Skin the RigGeometry on the skinning work queue once the update traversal of this skeleton is done.
+        /// No-op when the work queue is not set.
+        void requestSkinning(RigGeometry* rig);
+
+        /// Wait until skinning requested in the last update traversal is done.
+        void waitForSkinning();
+
         void childInserted(unsigned int) override;
         void childRemoved(unsigned int, unsigned int) override;
 
@@ -78,6 +92,11 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        std::size_t mPoseHash = 0;
+
+        std::vector<osg::ref_ptr<RigGeometry>> mSkinningRequests;
+        osg::ref_ptr<WorkItem> mSkinning;
     };
 
 }
@@ -0,0 +1,237 @@
+#include "skinning.hpp"
+
+#include "workqueue.hpp"
+
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>
+#define OPENMW_SCENEUTIL_SKINNING_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OPENMW_SCENEUTIL_SKINNING_NEON
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        osg::ref_ptr<WorkQueue> sSkinningWorkQueue;
+
+        std::atomic_size_t sSkinned{ 0 };
+        std::atomic_size_t sShared{ 0 };
+
+        bool isSame(const osg::Matrixf& lhs, const osg::Matrixf& rhs)
+        {
+            return std::memcmp(lhs.ptr(), rhs.ptr(), sizeof(float) * 16) == 0;
+        }
+
+        // Operations order matches osg::Matrixf::preMult and osg::Matrixf::transform3x3 so results are the same
+        // regardless of the implementation.
+        template <bool translate, std::size_t stride>
+        void transform(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+            const unsigned short* indices, std::size_t count, float* dst)
+        {
+            const float* const m = matrix.ptr();
+            std::size_t i = 0;
+
+#if defined(OPENMW_SCENEUTIL_SKINNING_SSE)
+            const __m128 m00 = _mm_set1_ps(m[0]);
+            const __m128 m01 = _mm_set1_ps(m[1]);
+            const __m128 m02 = _mm_set1_ps(m[2]);
+            const __m128 m10 = _mm_set1_ps(m[4]);
+            const __m128 m11 = _mm_set1_ps(m[5]);
+            const __m128 m12 = _mm_set1_ps(m[6]);
+            const __m128 m20 = _mm_set1_ps(m[8]);
+            const __m128 m21 = _mm_set1_ps(m[9]);
+            const __m128 m22 = _mm_set1_ps(m[10]);
+            const __m128 m30 = _mm_set1_ps(m[12]);
+            const __m128 m31 = _mm_set1_ps(m[13]);
+            const __m128 m32 = _mm_set1_ps(m[14]);
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 vx = _mm_loadu_ps(x + i);
+                const __m128 vy = _mm_loadu_ps(y + i);
+                const __m128 vz = _mm_loadu_ps(z + i);
+
+                __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m00), _mm_mul_ps(vy, m10)), _mm_mul_ps(vz, m20));
+                __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m01), _mm_mul_ps(vy, m11)), _mm_mul_ps(vz, m21));
+                __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m02), _mm_mul_ps(vy, m12)), _mm_mul_ps(vz, m22));
+                if constexpr (translate)
+                {
+                    rx = _mm_add_ps(rx, m30);
+                    ry = _mm_add_ps(ry, m31);
+                    rz = _mm_add_ps(rz, m32);
+                }
+
+                alignas(16) float ox[4];
+                alignas(16) float oy[4];
+                alignas(16) float oz[4];
+                _mm_store_ps(ox, rx);
+                _mm_store_ps(oy, ry);
+                _mm_store_ps(oz, rz);
+
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    float* const out = dst + indices[i + k] * stride;
+                    out[0] = ox[k];
+                    out[1] = oy[k];
+                    out[2] = oz[k];
+                }
+            }
+#elif defined(OPENMW_SCENEUTIL_SKINNING_NEON)
+            for (; i + 4 <= count; i += 4)
+            {
+                const float32x4_t vx = vld1q_f32(x + i);
+                const float32x4_t vy = vld1q_f32(y + i);
+                const float32x4_t vz = vld1q_f32(z + i);
+
+                float32x4_t rx
+                    = vaddq_f32(vaddq_f32(vmulq_n_f32(vx, m[0]), vmulq_n_f32(vy, m[4])), vmulq_n_f32(vz, m[8]));
+                float32x4_t ry
+                    = vaddq_f32(vaddq_f32(vmulq_n_f32(vx, m[1]), vmulq_n_f32(vy, m[5])), vmulq_n_f32(vz, m[9]));
+                float32x4_t rz
+                    = vaddq_f32(vaddq_f32(vmulq_n_f32(vx, m[2]), vmulq_n_f32(vy, m[6])), vmulq_n_f32(vz, m[10]));
+                if constexpr (translate)
+                {
+                    rx = vaddq_f32(rx, vdupq_n_f32(m[12]));
+                    ry = vaddq_f32(ry, vdupq_n_f32(m[13]));
+                    rz = vaddq_f32(rz, vdupq_n_f32(m[14]));
+                }
+
+                float ox[4];
+                float oy[4];
+                float oz[4];
+                vst1q_f32(ox, rx);
+                vst1q_f32(oy, ry);
+                vst1q_f32(oz, rz);
+
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    float* const out = dst + indices[i + k] * stride;
+                    out[0] = ox[k];
+                    out[1] = oy[k];
+                    out[2] = oz[k];
+                }
+            }
+#endif
+
+            for (; i < count; ++i)
+            {
+                float* const out = dst + indices[i] * stride;
+                out[0] = x[i] * m[0] + y[i] * m[4] + z[i] * m[8];
+                out[1] = x[i] * m[1] + y[i] * m[5] + z[i] * m[9];
+                out[2] = x[i] * m[2] + y[i] * m[6] + z[i] * m[10];
+                if constexpr (translate)
+                {
+                    out[0] += m[12];
+                    out[1] += m[13];
+                    out[2] += m[14];
+                }
+            }
+        }
+    }
+
+    bool isAffine(const osg::Matrixf& matrix)
+    {
+        return matrix(0, 3) == 0 && matrix(1, 3) == 0 && matrix(2, 3) == 0 && matrix(3, 3) == 1;
+    }
+
+    void transformPoints(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec3f* dst)
+    {
+        transform<true, 3>(matrix, x, y, z, indices, count, dst->ptr());
+    }
+
+    void transformDirections(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec3f* dst)
+    {
+        transform<false, 3>(matrix, x, y, z, indices, count, dst->ptr());
+    }
+
+    void transformDirections(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec4f* dst)
+    {
+        transform<false, 4>(matrix, x, y, z, indices, count, dst->ptr());
+    }
+
+    osg::ref_ptr<osg::Geometry> SharedSkinning::find(unsigned int frame, const osg::Geometry* source,
+        std::size_t poseHash, std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mFrame != frame)
+            return nullptr;
+        const auto it = mEntries.find(std::make_pair(source, poseHash));
+        if (it == mEntries.end())
+            return nullptr;
+        const Entry& entry = it->second;
+        // Hash only selects a candidate, the result can be reused only for bit-identical input
+        if (!isSame(entry.mTransform, transform)
+            || !std::equal(entry.mBoneMatrices.begin(), entry.mBoneMatrices.end(), boneMatrices.begin(),
+                boneMatrices.end(), isSame))
+            return nullptr;
+        return entry.mResult;
+    }
+
+    void SharedSkinning::add(unsigned int frame, const osg::Geometry* source, std::size_t poseHash,
+        std::vector<osg::Matrixf>&& boneMatrices, const osg::Matrixf& transform, osg::Geometry* result)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mFrame != frame)
+        {
+            mEntries.clear();
+            mFrame = frame;
+        }
+        mEntries.emplace(std::make_pair(source, poseHash),
+            Entry{ .mBoneMatrices = std::move(boneMatrices), .mTransform = transform, .mResult = result });
+    }
+
+    void SharedSkinning::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mEntries.clear();
+    }
+
+    std::size_t SharedSkinning::KeyHash::operator()(const std::pair<const osg::Geometry*, std::size_t>& key) const
+    {
+        std::size_t seed = key.second;
+        Misc::hashCombine(seed, key.first);
+        return seed;
+    }
+
+    SharedSkinning& getSharedSkinning()
+    {
+        static SharedSkinning sharedSkinning;
+        return sharedSkinning;
+    }
+
+    void countSkinning(bool shared)
+    {
+        sSkinned.fetch_add(1, std::memory_order_relaxed);
+        if (shared)
+            sShared.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SkinningStats takeSkinningStats()
+    {
+        return SkinningStats{
+            .mSkinned = sSkinned.exchange(0, std::memory_order_relaxed),
+            .mShared = sShared.exchange(0, std::memory_order_relaxed),
+        };
+    }
+
+    void setSkinningWorkQueue(osg::ref_ptr<WorkQueue> workQueue)
+    {
+        sSkinningWorkQueue = std::move(workQueue);
+    }
+
+    WorkQueue* getSkinningWorkQueue()
+    {
+        return sSkinningWorkQueue.get();
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Geometry>
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+
+    /// @brief Source vertex data of a rig stored as structure of arrays.
+    /// @par Vertices are ordered by influence group so vertices sharing a skinning matrix are stored contiguously.
+    struct SkinningSource
+    {
+        /// Offsets of each influence group in vertex arrays. Has one more element than the number of groups.
+        std::vector<std::size_t> mGroupOffsets;
+        /// Index of each vertex in the skinned geometry.
+        std::vector<unsigned short> mVertices;
+        std::array<std::vector<float>, 3> mPositions;
+        /// Empty when the geometry has no normals.
+        std::array<std::vector<float>, 3> mNormals;
+        /// Empty when the geometry has no tangents.
+        std::array<std::vector<float>, 3> mTangents;
+    };
+
+    /// @return true if the matrix can be applied without a perspective division.
+    bool isAffine(const osg::Matrixf& matrix);
+
+    /// Computes dst[indices[i]] = matrix.preMult(source[i]) for affine matrix and source points given as structure of
+    /// arrays.
+    void transformPoints(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec3f* dst);
+
+    /// Computes dst[indices[i]] = osg::Matrixf::transform3x3(source[i], matrix) for source directions given as
+    /// structure of arrays.
+    void transformDirections(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec3f* dst);
+
+    /// Same as above but keeps w component of the destination.
+    void transformDirections(const osg::Matrixf& matrix, const float* x, const float* y, const float* z,
+        const unsigned short* indices, std::size_t count, osg::Vec4f* dst);
+
+    /// @brief Geometries skinned in the current frame shared by rigs with the same source geometry and pose.
+    /// @par Thread safe.
+    class SharedSkinning
+    {
+    public:
+        /// @return Geometry skinned in the given frame from the source with exactly the same bone matrices or nullptr.
+        osg::ref_ptr<osg::Geometry> find(unsigned int frame, const osg::Geometry* source, std::size_t poseHash,
+            std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform);
+
+        /// Make fully skinned geometry available to other rigs. Drops geometries skinned in previous frames.
+        void add(unsigned int frame, const osg::Geometry* source, std::size_t poseHash,
+            std::vector<osg::Matrixf>&& boneMatrices, const osg::Matrixf& transform, osg::Geometry* result);
+
+        void clear();
+
+    private:
+        struct Entry
+        {
+            std::vector<osg::Matrixf> mBoneMatrices;
+            osg::Matrixf mTransform;
+            osg::ref_ptr<osg::Geometry> mResult;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const std::pair<const osg::Geometry*, std::size_t>& key) const;
+        };
+
+        std::mutex mMutex;
+        unsigned int mFrame = 0;
+        std::unordered_map<std::pair<const osg::Geometry*, std::size_t>, Entry, KeyHash> mEntries;
+    };
+
+    SharedSkinning& getSharedSkinning();
+
+    struct SkinningStats
+    {
+        std::size_t mSkinned = 0;
+        std::size_t mShared = 0;
+    };
+
+    /// Count skinned rigs. Shared are the ones that reused geometry skinned for another rig.
+    void countSkinning(bool shared);
+
+    /// @return Counters accumulated since the previous call.
+    SkinningStats takeSkinningStats();
+
+    /// Set work queue used to skin RigGeometries of active skeletons right after their update traversal.
+    /// When not set, skinning is done during the cull traversal.
+    void setSkinningWorkQueue(osg::ref_ptr<WorkQueue> workQueue);
+
+    WorkQueue* getSkinningWorkQueue();
+}
+
+#endif
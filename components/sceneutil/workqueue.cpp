@@ -2,6 +2,9 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
 #include <numeric>
 
 namespace SceneUtil
@@ -142,4 +145,85 @@ namespace SceneUtil
         return mActive;
     }
 
+    namespace
+    {
+        struct ParallelJob
+        {
+            std::function<void(std::size_t)> mProcess;
+            std::size_t mCount = 0;
+            std::atomic_size_t mNext{ 0 };
+            std::size_t mDone = 0;
+            std::exception_ptr mError;
+            std::mutex mMutex;
+            std::condition_variable mDoneCondition;
+
+            void run()
+            {
+                while (true)
+                {
+                    const std::size_t index = mNext.fetch_add(1);
+                    if (index >= mCount)
+                        return;
+                    std::exception_ptr error;
+                    try
+                    {
+                        mProcess(index);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    const std::lock_guard lock(mMutex);
+                    if (error != nullptr && mError == nullptr)
+                        mError = error;
+                    if (++mDone == mCount)
+                        mDoneCondition.notify_all();
+                }
+            }
+
+            void wait()
+            {
+                std::unique_lock lock(mMutex);
+                mDoneCondition.wait(lock, [&] { return mDone == mCount; });
+                if (mError != nullptr)
+                    std::rethrow_exception(mError);
+            }
+        };
+
+        class ParallelJobWorkItem : public WorkItem
+        {
+        public:
+            explicit ParallelJobWorkItem(std::shared_ptr<ParallelJob> job)
+                : mJob(std::move(job))
+            {
+            }
+
+            void doWork() override { mJob->run(); }
+
+        private:
+            std::shared_ptr<ParallelJob> mJob;
+        };
+    }
+
+    void parallelFor(WorkQueue* workQueue, std::size_t maxHelpers, std::size_t count,
+        const std::function<void(std::size_t)>& process)
+    {
+        if (count == 0)
+            return;
+
+        // Helpers may outlive the call when they are still in the queue
+        const auto job = std::make_shared<ParallelJob>();
+        job->mCount = count;
+        job->mProcess = process;
+
+        if (workQueue != nullptr)
+        {
+            const std::size_t helpers = std::min(maxHelpers, count - 1);
+            for (std::size_t i = 0; i < helpers; ++i)
+                workQueue->addWorkItem(new ParallelJobWorkItem(job));
+        }
+
+        job->run();
+        job->wait();
+    }
 }
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -94,6 +95,14 @@ namespace SceneUtil
         void run();
     };
 
+    /// Call process for each index in [0, count) on the calling thread and up to maxHelpers work items added to the
+    /// queue. The calling thread takes part in the work, so it never waits for a helper stuck in the queue, helpers
+    /// started after all indices are claimed return immediately. Runs everything on the calling thread when the queue
+    /// is null.
+    /// @par Rethrows the first exception thrown by process after all indices are processed.
+    void parallelFor(WorkQueue* workQueue, std::size_t maxHelpers, std::size_t count,
+        const std::function<void(std::size_t)>& process);
+
 }
 
 #endif
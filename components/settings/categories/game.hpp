@@ -74,6 +74,14 @@ namespace Settings
         SettingValue<DetourNavigator::CollisionShapeType> mActorCollisionShapeType{ mIndex, "Game",
             "actor collision shape type" };
         SettingValue<bool> mPlayerMovementIgnoresAnimation{ mIndex, "Game", "player movement ignores animation" };
+        SettingValue<bool> mPrecompileScripts{ mIndex, "Game", "precompile scripts" };
+        SettingValue<bool> mLocalScriptsScheduling{ mIndex, "Game", "local scripts scheduling" };
+        SettingValue<float> mLocalScriptsSchedulingDistance{ mIndex, "Game", "local scripts scheduling distance",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mLocalScriptsFrameBudget{ mIndex, "Game", "local scripts frame budget",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<int> mLocalScriptsMaxSkippedFrames{ mIndex, "Game", "local scripts max skipped frames",
+            makeMaxSanitizerInt(0) };
     };
 }
 
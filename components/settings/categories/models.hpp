@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_SETTINGS_CATEGORIES_MODELS_H
 #define OPENMW_COMPONENTS_SETTINGS_CATEGORIES_MODELS_H
 
+#include <components/settings/sanitizerimpl.hpp>
 #include <components/settings/settingvalue.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -11,6 +12,7 @@ namespace Settings
         using WithIndex::WithIndex;
 
         SettingValue<bool> mLoadUnsupportedNifFiles{ mIndex, "Models", "load unsupported nif files" };
+        SettingValue<int> mSkinningThreads{ mIndex, "Models", "skinning threads", makeMaxSanitizerInt(0) };
         SettingValue<VFS::Path::Normalized> mXbaseanim{ mIndex, "Models", "xbaseanim" };
         SettingValue<VFS::Path::Normalized> mBaseanim{ mIndex, "Models", "baseanim" };
         SettingValue<VFS::Path::Normalized> mXbaseanim1st{ mIndex, "Models", "xbaseanim1st" };
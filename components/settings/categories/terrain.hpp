@@ -37,6 +37,8 @@ namespace Settings
             makeMaxStrictSanitizerFloat(0) };
         SettingValue<float> mObjectPagingMinSizeCostMultiplier{ mIndex, "Terrain",
             "object paging min size cost multiplier", makeMaxStrictSanitizerFloat(0) };
+        SettingValue<int> mObjectPagingMergeThreads{ mIndex, "Terrain", "object paging merge threads",
+            makeMaxSanitizerInt(0) };
         SettingValue<bool> mWaterCulling{ mIndex, "Terrain", "water culling" };
 
         // Snow deformation settings
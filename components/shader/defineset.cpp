@@ -0,0 +1,92 @@
+#include "defineset.hpp"
+
+#include "insertonlymap.hpp"
+
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
+#include <variant>
+
+namespace Shader
+{
+    namespace
+    {
+        using Atoms = InsertOnlyMap<std::string, std::monostate, 1024>;
+
+        Atoms& getAtoms()
+        {
+            static Atoms atoms;
+            return atoms;
+        }
+
+        const std::string* intern(std::string_view value)
+        {
+            Atoms& atoms = getAtoms();
+            const std::size_t hash = std::hash<std::string_view>()(value);
+            if (const Atoms::Item* const item = atoms.find(value, hash))
+                return &item->mKey;
+            return &atoms.insert(value, hash, [] { return std::monostate(); }).mKey;
+        }
+
+        std::size_t getValueHash(DefineAtom name, DefineAtom value)
+        {
+            std::size_t seed = name.getHash();
+            Misc::hashCombine(seed, value.getHash());
+            return seed;
+        }
+
+        bool compareNames(const std::pair<DefineAtom, DefineAtom>& lhs, DefineAtom rhs)
+        {
+            return lhs.first < rhs;
+        }
+    }
+
+    DefineAtom::DefineAtom(std::string_view value)
+        : mValue(intern(value))
+    {
+    }
+
+    DefineSet::DefineSet(const DefineMap& defines)
+    {
+        mValues.reserve(defines.size());
+        for (const auto& [name, value] : defines)
+            set(name, value);
+    }
+
+    void DefineSet::set(DefineAtom name, DefineAtom value)
+    {
+        const auto it = std::lower_bound(mValues.begin(), mValues.end(), name, compareNames);
+        if (it != mValues.end() && it->first == name)
+        {
+            mHash -= getValueHash(name, it->second);
+            it->second = value;
+        }
+        else
+        {
+            mValues.emplace(it, name, value);
+        }
+        mHash += getValueHash(name, value);
+    }
+
+    std::optional<DefineAtom> DefineSet::get(DefineAtom name) const
+    {
+        const auto it = std::lower_bound(mValues.begin(), mValues.end(), name, compareNames);
+        if (it == mValues.end() || !(it->first == name))
+            return std::nullopt;
+        return it->second;
+    }
+
+    void DefineSet::clear()
+    {
+        mValues.clear();
+        mHash = 0;
+    }
+
+    DefineSet::DefineMap DefineSet::toMap() const
+    {
+        DefineMap result;
+        for (const auto& [name, value] : mValues)
+            result.emplace(name.getValue(), value.getValue());
+        return result;
+    }
+}
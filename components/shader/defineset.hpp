@@ -0,0 +1,75 @@
+#ifndef OPENMW_COMPONENTS_SHADER_DEFINESET_H
+#define OPENMW_COMPONENTS_SHADER_DEFINESET_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Shader
+{
+    /// @brief Interned string used as a define name or value.
+    /// @par Atoms are compared and hashed by identity of the interned string. Interned strings are never released, so
+    /// only a bounded set of strings like define names and small numbers should be interned.
+    class DefineAtom
+    {
+    public:
+        /// Intern the value. Lookup of an already interned value doesn't lock.
+        /// @note Thread safe.
+        explicit DefineAtom(std::string_view value);
+
+        const std::string& getValue() const { return *mValue; }
+
+        std::size_t getHash() const { return std::hash<const std::string*>()(mValue); }
+
+        friend bool operator==(DefineAtom lhs, DefineAtom rhs) { return lhs.mValue == rhs.mValue; }
+
+        friend bool operator<(DefineAtom lhs, DefineAtom rhs) { return std::less<>()(lhs.mValue, rhs.mValue); }
+
+    private:
+        const std::string* mValue;
+    };
+
+    /// @brief Set of shader define values with a precomputed hash.
+    /// @par Values are stored in a vector sorted by the name atom so comparison doesn't compare strings. Clearing keeps
+    /// allocated memory, a reused set doesn't allocate.
+    class DefineSet
+    {
+    public:
+        using DefineMap = std::map<std::string, std::string>;
+
+        DefineSet() = default;
+
+        explicit DefineSet(const DefineMap& defines);
+
+        void set(DefineAtom name, DefineAtom value);
+
+        void set(std::string_view name, std::string_view value) { set(DefineAtom(name), DefineAtom(value)); }
+
+        std::optional<DefineAtom> get(DefineAtom name) const;
+
+        void clear();
+
+        std::size_t size() const { return mValues.size(); }
+
+        std::size_t getHash() const { return mHash; }
+
+        DefineMap toMap() const;
+
+        friend bool operator==(const DefineSet& lhs, const DefineSet& rhs)
+        {
+            return lhs.mHash == rhs.mHash && lhs.mValues == rhs.mValues;
+        }
+
+    private:
+        std::vector<std::pair<DefineAtom, DefineAtom>> mValues;
+        // Sum of the hashes of the values, so replacing a value doesn't require to rehash the set
+        std::size_t mHash = 0;
+    };
+}
+
+#endif
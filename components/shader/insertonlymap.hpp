@@ -0,0 +1,74 @@
+#ifndef OPENMW_COMPONENTS_SHADER_INSERTONLYMAP_H
+#define OPENMW_COMPONENTS_SHADER_INSERTONLYMAP_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace Shader
+{
+    /// @brief Hash table with lookups not blocked by inserts.
+    /// @par Items are never removed or modified, so each bucket is a singly linked list published with a single atomic
+    /// store. Lookups don't take a lock, inserts are serialized by a mutex. Suitable for read-mostly data with a small
+    /// number of items known at loading time, there is no rehashing.
+    template <class Key, class Value, std::size_t bucketCount>
+    class InsertOnlyMap
+    {
+    public:
+        struct Item
+        {
+            Key mKey;
+            Value mValue;
+            std::size_t mHash;
+            const Item* mNext;
+        };
+
+        InsertOnlyMap() = default;
+
+        InsertOnlyMap(const InsertOnlyMap&) = delete;
+
+        /// @note Thread safe.
+        template <class K>
+        const Item* find(const K& key, std::size_t hash) const
+        {
+            for (const Item* item = mBuckets[hash % bucketCount].load(std::memory_order_acquire); item != nullptr;
+                 item = item->mNext)
+                if (item->mHash == hash && item->mKey == key)
+                    return item;
+            return nullptr;
+        }
+
+        /// Insert an item unless there is one with the same key.
+        /// @return Inserted or existing item.
+        /// @note Thread safe.
+        template <class K, class MakeValue>
+        const Item& insert(const K& key, std::size_t hash, MakeValue&& makeValue)
+        {
+            const std::lock_guard lock(mMutex);
+            if (const Item* const existing = find(key, hash))
+                return *existing;
+            std::atomic<const Item*>& bucket = mBuckets[hash % bucketCount];
+            const Item& item = mItems.emplace_back(
+                Item{ Key(key), makeValue(), hash, bucket.load(std::memory_order_relaxed) });
+            bucket.store(&item, std::memory_order_release);
+            return item;
+        }
+
+        /// @note Thread safe.
+        std::size_t size() const
+        {
+            const std::lock_guard lock(mMutex);
+            return mItems.size();
+        }
+
+    private:
+        std::array<std::atomic<const Item*>, bucketCount> mBuckets{};
+        mutable std::mutex mMutex;
+        // Deque doesn't move items on insert
+        std::deque<Item> mItems;
+    };
+}
+
+#endif
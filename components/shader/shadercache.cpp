@@ -0,0 +1,343 @@
+#include "shadercache.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+namespace Shader
+{
+    namespace
+    {
+        constexpr std::array<char, 8> sMagic = { 'O', 'M', 'W', 'S', 'H', 'D', 'R', 'C' };
+        constexpr std::uint32_t sVersion = 1;
+        // Entries for other drivers, settings or game versions are not worth keeping for longer
+        constexpr std::chrono::hours sMaxUnusedAge(24 * 30);
+
+        // Keys are stored in file names so the hash has to be the same across runs and platforms
+        class Hash
+        {
+        public:
+            void add(std::string_view value)
+            {
+                add(static_cast<std::uint64_t>(value.size()));
+                for (const char c : value)
+                    addByte(static_cast<unsigned char>(c));
+            }
+
+            void add(std::uint64_t value)
+            {
+                for (int i = 0; i < 8; ++i)
+                    addByte(static_cast<unsigned char>(value >> (i * 8)));
+            }
+
+            void add(const ShaderCache::DefineMap& defines)
+            {
+                add(static_cast<std::uint64_t>(defines.size()));
+                for (const auto& [name, value] : defines)
+                {
+                    add(name);
+                    add(value);
+                }
+            }
+
+            std::uint64_t get() const { return mValue; }
+
+        private:
+            // FNV-1a
+            std::uint64_t mValue = 14695981039346656037ull;
+
+            void addByte(unsigned char value)
+            {
+                mValue ^= value;
+                mValue *= 1099511628211ull;
+            }
+        };
+
+        void writeUint(std::ostream& stream, std::uint32_t value)
+        {
+            std::array<char, 4> buffer;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+                buffer[i] = static_cast<char>(value >> (i * 8));
+            stream.write(buffer.data(), buffer.size());
+        }
+
+        std::uint32_t readUint(std::istream& stream)
+        {
+            std::array<unsigned char, 4> buffer;
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+                throw std::runtime_error("unexpected end of file");
+            std::uint32_t result = 0;
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+                result |= static_cast<std::uint32_t>(buffer[i]) << (i * 8);
+            return result;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string result(readUint(stream), '\0');
+            if (!stream.read(result.data(), result.size()))
+                throw std::runtime_error("unexpected end of file");
+            return result;
+        }
+
+        void writeDefines(std::ostream& stream, const ShaderCache::DefineMap& defines)
+        {
+            writeUint(stream, static_cast<std::uint32_t>(defines.size()));
+            for (const auto& [name, value] : defines)
+            {
+                writeString(stream, name);
+                writeString(stream, value);
+            }
+        }
+
+        ShaderCache::DefineMap readDefines(std::istream& stream)
+        {
+            ShaderCache::DefineMap result;
+            const std::uint32_t size = readUint(stream);
+            for (std::uint32_t i = 0; i < size; ++i)
+            {
+                std::string name = readString(stream);
+                result.emplace(std::move(name), readString(stream));
+            }
+            return result;
+        }
+
+        void writeHeader(std::ostream& stream)
+        {
+            stream.write(sMagic.data(), sMagic.size());
+            writeUint(stream, sVersion);
+        }
+
+        void readHeader(std::istream& stream)
+        {
+            std::array<char, sMagic.size()> magic;
+            if (!stream.read(magic.data(), magic.size()) || magic != sMagic)
+                throw std::runtime_error("invalid file signature");
+            if (readUint(stream) != sVersion)
+                throw std::runtime_error("unsupported version");
+        }
+
+        // Multiple processes may use the same cache, never leave a partially written file
+        template <class Write>
+        void writeFile(const std::filesystem::path& path, Write&& write)
+        {
+            try
+            {
+                std::filesystem::create_directories(path.parent_path());
+                std::filesystem::path temporary = path;
+                temporary += ".tmp";
+                {
+                    std::ofstream stream(temporary, std::ios::binary);
+                    stream.exceptions(std::ios::failbit | std::ios::badbit);
+                    writeHeader(stream);
+                    write(stream);
+                }
+                std::filesystem::rename(temporary, path);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write shader cache file " << path << ": " << e.what();
+            }
+        }
+
+        template <class Read>
+        std::optional<std::invoke_result_t<Read&, std::istream&>> readFile(
+            const std::filesystem::path& path, Read&& read)
+        {
+            std::error_code ec;
+            if (!std::filesystem::exists(path, ec))
+                return std::nullopt;
+            try
+            {
+                std::ifstream stream(path, std::ios::binary);
+                if (!stream)
+                    throw std::runtime_error("failed to open");
+                readHeader(stream);
+                return read(stream);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read shader cache file " << path << ": " << e.what();
+                return std::nullopt;
+            }
+        }
+    }
+
+    ShaderCache::ShaderCache(const std::filesystem::path& path, std::string_view driver)
+        : mPath(path)
+        , mDriver(driver)
+    {
+        std::optional<std::vector<ProgramVariant>> variants
+            = readFile(getVariantsPath(), [](std::istream& stream) {
+                  std::vector<ProgramVariant> result(readUint(stream));
+                  for (ProgramVariant& variant : result)
+                  {
+                      variant.mVertexTemplate = readString(stream);
+                      variant.mVertexDefines = readDefines(stream);
+                      variant.mFragmentTemplate = readString(stream);
+                      variant.mFragmentDefines = readDefines(stream);
+                  }
+                  return result;
+              });
+        if (variants.has_value())
+            mPreviousVariants = std::move(*variants);
+    }
+
+    std::uint64_t ShaderCache::makeSourceKey(
+        std::string_view templateSource, const DefineMap& defines, const DefineMap& globalDefines)
+    {
+        Hash hash;
+        hash.add(templateSource);
+        hash.add(defines);
+        hash.add(globalDefines);
+        return hash.get();
+    }
+
+    std::uint64_t ShaderCache::makeProgramKey(const std::vector<std::string_view>& sources) const
+    {
+        Hash hash;
+        hash.add(mDriver);
+        hash.add(static_cast<std::uint64_t>(sources.size()));
+        for (const std::string_view source : sources)
+            hash.add(source);
+        return hash.get();
+    }
+
+    std::optional<ShaderCache::Source> ShaderCache::getSource(std::uint64_t key) const
+    {
+        markUsed(getSourcePath(key));
+        return readFile(getSourcePath(key), [](std::istream& stream) {
+            Source result;
+            result.mSource = readString(stream);
+            result.mLinkedShaderTemplateNames.resize(readUint(stream));
+            for (std::string& name : result.mLinkedShaderTemplateNames)
+                name = readString(stream);
+            return result;
+        });
+    }
+
+    void ShaderCache::addSource(std::uint64_t key, const Source& source) const
+    {
+        markUsed(getSourcePath(key));
+        writeFile(getSourcePath(key), [&](std::ostream& stream) {
+            writeString(stream, source.mSource);
+            writeUint(stream, static_cast<std::uint32_t>(source.mLinkedShaderTemplateNames.size()));
+            for (const std::string& name : source.mLinkedShaderTemplateNames)
+                writeString(stream, name);
+        });
+    }
+
+    std::optional<ShaderCache::ProgramBinary> ShaderCache::getProgramBinary(std::uint64_t key) const
+    {
+        markUsed(getProgramPath(key));
+        return readFile(getProgramPath(key), [](std::istream& stream) {
+            ProgramBinary result;
+            result.mFormat = readUint(stream);
+            result.mData.resize(readUint(stream));
+            if (!stream.read(reinterpret_cast<char*>(result.mData.data()), result.mData.size()))
+                throw std::runtime_error("unexpected end of file");
+            return result;
+        });
+    }
+
+    void ShaderCache::addProgramBinary(std::uint64_t key, const ProgramBinary& binary) const
+    {
+        markUsed(getProgramPath(key));
+        writeFile(getProgramPath(key), [&](std::ostream& stream) {
+            writeUint(stream, binary.mFormat);
+            writeUint(stream, static_cast<std::uint32_t>(binary.mData.size()));
+            stream.write(reinterpret_cast<const char*>(binary.mData.data()), binary.mData.size());
+        });
+    }
+
+    void ShaderCache::removeProgramBinary(std::uint64_t key) const
+    {
+        std::error_code ec;
+        std::filesystem::remove(getProgramPath(key), ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to remove shader cache file " << getProgramPath(key) << ": " << ec.message();
+    }
+
+    void ShaderCache::addVariant(ProgramVariant&& variant)
+    {
+        const std::lock_guard lock(mMutex);
+        mVariants.insert(std::move(variant));
+    }
+
+    void ShaderCache::saveVariants() const
+    {
+        const std::lock_guard lock(mMutex);
+        writeFile(getVariantsPath(), [&](std::ostream& stream) {
+            writeUint(stream, static_cast<std::uint32_t>(mVariants.size()));
+            for (const ProgramVariant& variant : mVariants)
+            {
+                writeString(stream, variant.mVertexTemplate);
+                writeDefines(stream, variant.mVertexDefines);
+                writeString(stream, variant.mFragmentTemplate);
+                writeDefines(stream, variant.mFragmentDefines);
+            }
+        });
+        Log(Debug::Verbose) << "Saved " << mVariants.size() << " shader program variants to " << getVariantsPath();
+    }
+
+    void ShaderCache::prune() const
+    {
+        const std::lock_guard lock(mMutex);
+        const auto now = std::filesystem::file_time_type::clock::now();
+        std::size_t removed = 0;
+        for (const std::filesystem::path& directory : { mPath / "sources", mPath / "programs" })
+        {
+            std::error_code ec;
+            for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                const std::filesystem::path& path = it->path();
+                std::error_code fileEc;
+                if (mUsedFiles.contains(path))
+                {
+                    // Other processes may share the cache, keep the used entries for them as well
+                    std::filesystem::last_write_time(path, now, fileEc);
+                    continue;
+                }
+                const auto lastWriteTime = std::filesystem::last_write_time(path, fileEc);
+                if (fileEc || now - lastWriteTime < sMaxUnusedAge)
+                    continue;
+                if (std::filesystem::remove(path, fileEc))
+                    ++removed;
+            }
+        }
+        Log(Debug::Verbose) << "Removed " << removed << " unused shader cache files from " << mPath;
+    }
+
+    void ShaderCache::markUsed(const std::filesystem::path& path) const
+    {
+        const std::lock_guard lock(mMutex);
+        mUsedFiles.insert(path);
+    }
+
+    std::filesystem::path ShaderCache::getSourcePath(std::uint64_t key) const
+    {
+        return mPath / "sources" / std::format("{:016x}", key);
+    }
+
+    std::filesystem::path ShaderCache::getProgramPath(std::uint64_t key) const
+    {
+        return mPath / "programs" / std::format("{:016x}", key);
+    }
+
+    std::filesystem::path ShaderCache::getVariantsPath() const
+    {
+        return mPath / "variants";
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef OPENMW_COMPONENTS_SHADER_SHADERCACHE_H
+#define OPENMW_COMPONENTS_SHADER_SHADERCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Shader
+{
+    /// @brief Persistent storage for shader data reused between sessions.
+    /// @par Stores preprocessed shader sources, program binaries and the program variants requested during a session.
+    /// Does not depend on an OpenGL context, program binaries are stored as opaque data.
+    class ShaderCache
+    {
+    public:
+        using DefineMap = std::map<std::string, std::string>;
+
+        struct Source
+        {
+            std::string mSource;
+            std::vector<std::string> mLinkedShaderTemplateNames;
+        };
+
+        struct ProgramBinary
+        {
+            std::uint32_t mFormat = 0;
+            std::vector<unsigned char> mData;
+        };
+
+        struct ProgramVariant
+        {
+            std::string mVertexTemplate;
+            DefineMap mVertexDefines;
+            std::string mFragmentTemplate;
+            DefineMap mFragmentDefines;
+
+            friend auto operator<=>(const ProgramVariant&, const ProgramVariant&) = default;
+        };
+
+        /// @param driver Identifies the OpenGL driver. Program binaries stored for another driver are not used.
+        /// @note Loads the program variants stored by the previous session.
+        explicit ShaderCache(const std::filesystem::path& path, std::string_view driver);
+
+        /// Key of a shader preprocessed from the template source with given defines.
+        static std::uint64_t makeSourceKey(
+            std::string_view templateSource, const DefineMap& defines, const DefineMap& globalDefines);
+
+        /// Key of a program linked from the given shader sources.
+        std::uint64_t makeProgramKey(const std::vector<std::string_view>& sources) const;
+
+        std::optional<Source> getSource(std::uint64_t key) const;
+
+        void addSource(std::uint64_t key, const Source& source) const;
+
+        std::optional<ProgramBinary> getProgramBinary(std::uint64_t key) const;
+
+        void addProgramBinary(std::uint64_t key, const ProgramBinary& binary) const;
+
+        /// Remove a program binary rejected by the driver.
+        void removeProgramBinary(std::uint64_t key) const;
+
+        /// Program variants requested by the previous session.
+        const std::vector<ProgramVariant>& getPreviousVariants() const { return mPreviousVariants; }
+
+        /// Record program variant requested by the current session.
+        /// @note Thread safe.
+        void addVariant(ProgramVariant&& variant);
+
+        /// Store variants requested by the current session to be used by the next one.
+        void saveVariants() const;
+
+        /// Remove sources and program binaries not used by this session and not modified for a long time. Refresh the
+        /// modification time of the used ones.
+        void prune() const;
+
+    private:
+        std::filesystem::path mPath;
+        std::string mDriver;
+        std::vector<ProgramVariant> mPreviousVariants;
+        mutable std::mutex mMutex;
+        std::set<ProgramVariant> mVariants;
+        mutable std::set<std::filesystem::path> mUsedFiles;
+
+        void markUsed(const std::filesystem::path& path) const;
+
+        std::filesystem::path getSourcePath(std::uint64_t key) const;
+        std::filesystem::path getProgramPath(std::uint64_t key) const;
+        std::filesystem::path getVariantsPath() const;
+    };
+}
+
+#endif
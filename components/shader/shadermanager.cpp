@@ -1,6 +1,9 @@
 #include "shadermanager.hpp"
 
+#include "shadercache.hpp"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
@@ -16,6 +19,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
+#include <components/misc/hash.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/conversion.hpp>
@@ -23,6 +27,47 @@
 
 namespace
 {
+    // Links from the shader sources if the driver rejects the cached program binary, e.g. after a driver update which
+    // didn't change the version string
+    class ProgramWithBinary : public osg::Program
+    {
+    public:
+        ProgramWithBinary() = default;
+
+        ProgramWithBinary(const osg::Program& program, const osg::CopyOp& copyop)
+            : osg::Program(program, copyop)
+        {
+            for (const auto& [name, index] : program.getUniformBlockBindingList())
+                addBindUniformBlock(name, index);
+        }
+
+        META_StateAttribute(Shader, ProgramWithBinary, PROGRAM)
+
+        void compileGLObjects(osg::State& state) const override
+        {
+            osg::Program::compileGLObjects(state);
+
+            if (getProgramBinary() == nullptr)
+                return;
+            const PerContextProgram* const pcp = getPCP(state);
+            if (pcp == nullptr || pcp->isLinked())
+                return;
+
+            Log(Debug::Warning) << "Cached binary of shader program \"" << getName()
+                                << "\" is rejected by the driver, linking from the sources";
+            mBinaryRejected = true;
+            ProgramWithBinary& program = const_cast<ProgramWithBinary&>(*this);
+            program.setProgramBinary(nullptr);
+            program.dirtyProgram();
+            osg::Program::compileGLObjects(state);
+        }
+
+        bool isBinaryRejected() const { return mBinaryRejected; }
+
+    private:
+        mutable std::atomic_bool mBinaryRejected{ false };
+    };
+
     osg::Shader::Type getShaderType(const std::string& templateName)
     {
         std::string_view ext = Misc::getFileExtension(templateName);
@@ -89,6 +134,14 @@ namespace Shader
         mPath = path;
     }
 
+    void ShaderManager::setCachePath(const std::filesystem::path& path, std::string_view driver)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCache = std::make_unique<ShaderCache>(path, driver);
+        Log(Debug::Info) << "Using shader cache " << path << " with " << mCache->getPreviousVariants().size()
+                         << " program variants from the previous session";
+    }
+
     bool addLineDirectivesAfterConditionalBlocks(std::string& source)
     {
         for (size_t position = 0; position < source.length();)
@@ -491,6 +544,7 @@ namespace Shader
                             break;
                         }
                         shaderIt->second->setShaderSource(shaderSource);
+                        manager.clearProgramBinaries();
                     }
                 }
             }
@@ -542,7 +596,7 @@ namespace Shader
         {
             std::string shaderSource = templateIt->second;
             std::vector<std::string> linkedShaderNames;
-            if (!createSourceFromTemplate(shaderSource, linkedShaderNames, templateName, defines))
+            if (!createCachedSourceFromTemplate(shaderSource, linkedShaderNames, templateName, defines))
             {
                 // Add to the cache anyway to avoid logging the same error over and over.
                 mShaders.insert(std::make_pair(std::make_pair(templateName, defines), nullptr));
@@ -563,6 +617,7 @@ namespace Shader
             lock.lock();
 
             shaderIt = mShaders.insert(std::make_pair(std::make_pair(templateName, defines), shader)).first;
+            mShaderKeys.emplace(shader.get(), shaderIt->first);
         }
         return shaderIt->second;
     }
@@ -579,6 +634,20 @@ namespace Shader
         return getProgram(std::move(vert), std::move(frag), programTemplate);
     }
 
+    osg::ref_ptr<osg::Program> ShaderManager::getProgram(
+        const std::string& templateName, const DefineSet& defines, const osg::Program* programTemplate)
+    {
+        const ProgramKeyView key{ DefineAtom(templateName), defines };
+        std::size_t hash = key.mTemplateName.getHash();
+        Misc::hashCombine(hash, defines.getHash());
+
+        if (const auto* const item = mProgramsByDefines.find(key, hash))
+            return item->mValue;
+
+        osg::ref_ptr<osg::Program> program = getProgram(templateName, defines.toMap(), programTemplate);
+        return mProgramsByDefines.insert(key, hash, [&] { return std::move(program); }).mValue;
+    }
+
     osg::ref_ptr<osg::Program> ShaderManager::getProgram(osg::ref_ptr<osg::Shader> vertexShader,
         osg::ref_ptr<osg::Shader> fragmentShader, const osg::Program* programTemplate)
     {
@@ -588,13 +657,41 @@ namespace Shader
         {
             if (!programTemplate)
                 programTemplate = mProgramTemplate;
-            osg::ref_ptr<osg::Program> program
-                = programTemplate ? cloneProgram(programTemplate) : osg::ref_ptr<osg::Program>(new osg::Program);
+            osg::ref_ptr<osg::Program> program;
+            if (mCache != nullptr)
+                program = programTemplate ? new ProgramWithBinary(*programTemplate, osg::CopyOp::SHALLOW_COPY)
+                                          : new ProgramWithBinary;
+            else if (programTemplate)
+                program = cloneProgram(programTemplate);
+            else
+                program = new osg::Program;
             program->addShader(vertexShader);
             program->addShader(fragmentShader);
             addLinkedShaders(vertexShader, program);
             addLinkedShaders(fragmentShader, program);
 
+            if (mCache != nullptr)
+            {
+                const auto vertexKey = mShaderKeys.find(vertexShader.get());
+                const auto fragmentKey = mShaderKeys.find(fragmentShader.get());
+                if (vertexKey != mShaderKeys.end() && fragmentKey != mShaderKeys.end())
+                    mCache->addVariant(ShaderCache::ProgramVariant{
+                        .mVertexTemplate = vertexKey->second.first,
+                        .mVertexDefines = vertexKey->second.second,
+                        .mFragmentTemplate = fragmentKey->second.first,
+                        .mFragmentDefines = fragmentKey->second.second,
+                    });
+
+                if (const std::optional<ShaderCache::ProgramBinary> binary
+                    = mCache->getProgramBinary(getProgramKey(*program)))
+                {
+                    osg::ref_ptr<osg::Program::ProgramBinary> programBinary = new osg::Program::ProgramBinary;
+                    programBinary->setFormat(binary->mFormat);
+                    programBinary->assign(static_cast<unsigned>(binary->mData.size()), binary->mData.data());
+                    program->setProgramBinary(programBinary);
+                }
+            }
+
             found = mPrograms.insert(std::make_pair(std::make_pair(vertexShader, fragmentShader), program)).first;
         }
         return found->second;
@@ -615,7 +712,11 @@ namespace Shader
 
     void ShaderManager::setGlobalDefines(DefineMap& globalDefines)
     {
+        // Sources stay the same so program binaries loaded from the cache are still valid
+        if (globalDefines == mGlobalDefines)
+            return;
         mGlobalDefines = globalDefines;
+        clearProgramBinaries();
         for (const auto& [key, shader] : mShaders)
         {
             std::string templateId = key.first;
@@ -626,7 +727,7 @@ namespace Shader
                 continue;
             std::string shaderSource = mShaderTemplates[templateId];
             std::vector<std::string> linkedShaderNames;
-            if (!createSourceFromTemplate(shaderSource, linkedShaderNames, templateId, defines))
+            if (!createCachedSourceFromTemplate(shaderSource, linkedShaderNames, templateId, defines))
                 // We just broke the shader and there's no way to force existing objects back to fixed-function mode as
                 // we would when creating the shader. If we put a nullptr in the shader map, we just lose the ability to
                 // put a working one in later.
@@ -660,6 +761,108 @@ namespace Shader
         return true;
     }
 
+    bool ShaderManager::createCachedSourceFromTemplate(std::string& source,
+        std::vector<std::string>& linkedShaderTemplateNames, const std::string& templateName,
+        const ShaderManager::DefineMap& defines)
+    {
+        if (mCache == nullptr)
+            return createSourceFromTemplate(source, linkedShaderTemplateNames, templateName, defines);
+
+        const std::uint64_t key = ShaderCache::makeSourceKey(source, defines, mGlobalDefines);
+        if (std::optional<ShaderCache::Source> cached = mCache->getSource(key))
+        {
+            source = std::move(cached->mSource);
+            linkedShaderTemplateNames = std::move(cached->mLinkedShaderTemplateNames);
+            return true;
+        }
+
+        if (!createSourceFromTemplate(source, linkedShaderTemplateNames, templateName, defines))
+            return false;
+
+        mCache->addSource(
+            key, ShaderCache::Source{ .mSource = source, .mLinkedShaderTemplateNames = linkedShaderTemplateNames });
+        return true;
+    }
+
+    std::uint64_t ShaderManager::getProgramKey(const osg::Program& program) const
+    {
+        std::vector<std::string_view> sources;
+        sources.reserve(program.getNumShaders());
+        for (unsigned i = 0; i < program.getNumShaders(); ++i)
+            sources.push_back(program.getShader(i)->getShaderSource());
+        return mCache->makeProgramKey(sources);
+    }
+
+    void ShaderManager::clearProgramBinaries()
+    {
+        for (const auto& [_, program] : mPrograms)
+            program->setProgramBinary(nullptr);
+    }
+
+    std::vector<osg::ref_ptr<osg::Program>> ShaderManager::prewarm()
+    {
+        if (mCache == nullptr)
+            return {};
+
+        std::vector<osg::ref_ptr<osg::Program>> result;
+        for (const ShaderCache::ProgramVariant& variant : mCache->getPreviousVariants())
+        {
+            osg::ref_ptr<osg::Shader> vertex
+                = getShader(variant.mVertexTemplate, variant.mVertexDefines, osg::Shader::VERTEX);
+            osg::ref_ptr<osg::Shader> fragment
+                = getShader(variant.mFragmentTemplate, variant.mFragmentDefines, osg::Shader::FRAGMENT);
+            if (vertex == nullptr || fragment == nullptr)
+                continue;
+            result.push_back(getProgram(std::move(vertex), std::move(fragment)));
+        }
+
+        Log(Debug::Info) << "Prewarmed " << result.size() << " shader programs";
+
+        return result;
+    }
+
+    void ShaderManager::saveProgramBinaries(osg::State& state)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mCache == nullptr)
+            return;
+
+        std::size_t count = 0;
+        for (const auto& [_, program] : mPrograms)
+        {
+            const auto* const programWithBinary = dynamic_cast<const ProgramWithBinary*>(program.get());
+            if (programWithBinary != nullptr && programWithBinary->isBinaryRejected())
+                mCache->removeProgramBinary(getProgramKey(*program));
+            // Already loaded from the cache
+            if (program->getProgramBinary() != nullptr)
+                continue;
+            osg::Program::PerContextProgram* const pcp = program->getPCP(state);
+            if (pcp == nullptr || !pcp->isLinked())
+                continue;
+            const osg::ref_ptr<osg::Program::ProgramBinary> binary = pcp->compileProgramBinary(state);
+            if (binary == nullptr || binary->getSize() == 0)
+                continue;
+            mCache->addProgramBinary(getProgramKey(*program),
+                ShaderCache::ProgramBinary{
+                    .mFormat = binary->getFormat(),
+                    .mData = std::vector<unsigned char>(binary->getData(), binary->getData() + binary->getSize()),
+                });
+            ++count;
+        }
+
+        Log(Debug::Info) << "Saved " << count << " shader program binaries";
+    }
+
+    void ShaderManager::saveCache()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mCache != nullptr)
+        {
+            mCache->saveVariants();
+            mCache->prune();
+        }
+    }
+
     void ShaderManager::getLinkedShaders(
         osg::ref_ptr<osg::Shader> shader, const std::vector<std::string>& linkedShaderNames, const DefineMap& defines)
     {
@@ -2,18 +2,23 @@
 #define OPENMW_COMPONENTS_SHADERMANAGER_H
 
 #include <array>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <osg/Program>
 #include <osg/Shader>
 #include <osg/ref_ptr>
 
+#include "defineset.hpp"
+#include "insertonlymap.hpp"
+
 namespace osgViewer
 {
     class Viewer;
@@ -22,6 +27,8 @@ namespace osgViewer
 namespace Shader
 {
     struct HotReloadManager;
+    class ShaderCache;
+
     /// @brief Reads shader template files and turns them into a concrete shader, based on a list of define's.
     /// @par Shader templates can get the value of a define with the syntax @define.
     class ShaderManager
@@ -33,6 +40,22 @@ namespace Shader
 
         void setShaderPath(const std::filesystem::path& path);
 
+        /// Reuse preprocessed shader sources and program binaries stored in the directory by previous sessions.
+        /// @param driver Identifies the OpenGL driver, program binaries are reused only for the same driver.
+        void setCachePath(const std::filesystem::path& path, std::string_view driver);
+
+        /// Create programs requested by the previous session using the current global defines.
+        /// @return Created programs, they are compiled on first use unless passed to an IncrementalCompileOperation.
+        std::vector<osg::ref_ptr<osg::Program>> prewarm();
+
+        /// Store binaries of the programs linked for the state.
+        /// @note Requires the state's graphics context to be current.
+        void saveProgramBinaries(osg::State& state);
+
+        /// Store programs requested by this session to be prewarmed by the next one and remove cache entries unused for
+        /// a long time.
+        void saveCache();
+
         typedef std::map<std::string, std::string> DefineMap;
 
         /// Create or retrieve a shader instance.
@@ -47,6 +70,12 @@ namespace Shader
         osg::ref_ptr<osg::Program> getProgram(const std::string& templateName, const DefineMap& defines = {},
             const osg::Program* programTemplate = nullptr);
 
+        /// Get a program for the template with the defines.
+        /// @note Doesn't lock if the program was already requested with the same defines.
+        /// @note Thread safe.
+        osg::ref_ptr<osg::Program> getProgram(
+            const std::string& templateName, const DefineSet& defines, const osg::Program* programTemplate);
+
         osg::ref_ptr<osg::Program> getProgram(osg::ref_ptr<osg::Shader> vertexShader,
             osg::ref_ptr<osg::Shader> fragmentShader, const osg::Program* programTemplate = nullptr);
 
@@ -64,6 +93,7 @@ namespace Shader
         /// @note This will change the source code for any shaders already created, potentially causing problems if
         /// they're being used to render a frame. It is recommended that any associated Viewers have their threading
         /// stopped while this function is running if any shaders are in use.
+        /// @note Does nothing if the values are the same as the current ones.
         void setGlobalDefines(DefineMap& globalDefines);
 
         void releaseGLObjects(osg::State* state);
@@ -94,6 +124,14 @@ namespace Shader
             const DefineMap& defines);
         void addLinkedShaders(osg::ref_ptr<osg::Shader> shader, osg::ref_ptr<osg::Program> program);
 
+        bool createCachedSourceFromTemplate(std::string& source, std::vector<std::string>& linkedShaderTemplateNames,
+            const std::string& templateName, const ShaderManager::DefineMap& defines);
+
+        std::uint64_t getProgramKey(const osg::Program& program) const;
+
+        // Program binary is used instead of sources, it has to be dropped once any source is changed
+        void clearProgramBinaries();
+
         std::filesystem::path mPath;
 
         DefineMap mGlobalDefines;
@@ -114,6 +152,32 @@ namespace Shader
         typedef std::map<osg::ref_ptr<osg::Shader>, ShaderList> LinkedShadersMap;
         LinkedShadersMap mLinkedShaders;
 
+        std::map<const osg::Shader*, MapKey> mShaderKeys;
+
+        struct ProgramKey
+        {
+            DefineAtom mTemplateName;
+            DefineSet mDefines;
+        };
+
+        struct ProgramKeyView
+        {
+            DefineAtom mTemplateName;
+            const DefineSet& mDefines;
+
+            operator ProgramKey() const { return ProgramKey{ mTemplateName, mDefines }; }
+
+            friend bool operator==(const ProgramKey& lhs, const ProgramKeyView& rhs)
+            {
+                return lhs.mTemplateName == rhs.mTemplateName && lhs.mDefines == rhs.mDefines;
+            }
+        };
+
+        // Programs are never removed, shaders are updated in place on reload
+        InsertOnlyMap<ProgramKey, osg::ref_ptr<osg::Program>, 1024> mProgramsByDefines;
+
+        std::unique_ptr<ShaderCache> mCache;
+
         std::mutex mMutex;
 
         osg::ref_ptr<const osg::Program> mProgramTemplate;
@@ -1,5 +1,7 @@
 #include "shadervisitor.hpp"
 
+#include <array>
+#include <charconv>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -300,6 +302,58 @@ namespace Shader
             return name == "normalHeightMap";
     }
 
+    // Define names and values used for each created program are interned once
+    struct DefineAtoms
+    {
+        // <texture name, texture coordinates name>
+        std::vector<std::pair<DefineAtom, DefineAtom>> mTextures;
+        DefineAtom mZero{ "0" };
+        DefineAtom mOne{ "1" };
+        DefineAtom mDiffuseMap{ "diffuseMap" };
+        DefineAtom mDiffuseParallax{ "diffuseParallax" };
+        DefineAtom mParallax{ "parallax" };
+        DefineAtom mReconstructNormalZ{ "reconstructNormalZ" };
+        DefineAtom mAlphaFunc{ "alphaFunc" };
+        DefineAtom mAdditiveBlending{ "additiveBlending" };
+        DefineAtom mAlphaToCoverage{ "alphaToCoverage" };
+        DefineAtom mAdjustCoverage{ "adjustCoverage" };
+        DefineAtom mUseGPUShader4{ "useGPUShader4" };
+        DefineAtom mEndLight{ "endLight" };
+        DefineAtom mForcePPL{ "forcePPL" };
+        DefineAtom mParticleOcclusion{ "particleOcclusion" };
+        DefineAtom mDisableNormals{ "disableNormals" };
+        DefineAtom mSoftParticles{ "softParticles" };
+
+        DefineAtoms()
+        {
+            for (const char* name : defaultTextures)
+                mTextures.emplace_back(DefineAtom(name), DefineAtom(std::string(name) + "UV"));
+        }
+
+        DefineAtom get(bool value) const { return value ? mOne : mZero; }
+
+        DefineAtom getTextureCoordinates(DefineAtom texture) const
+        {
+            for (const auto& [name, coordinates] : mTextures)
+                if (name == texture)
+                    return coordinates;
+            return DefineAtom(texture.getValue() + "UV");
+        }
+    };
+
+    const DefineAtoms& getDefineAtoms()
+    {
+        static const DefineAtoms atoms;
+        return atoms;
+    }
+
+    DefineAtom toDefineAtom(int value)
+    {
+        std::array<char, 16> buffer;
+        const char* const end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value).ptr;
+        return DefineAtom(std::string_view(buffer.data(), end));
+    }
+
     void ShaderVisitor::applyStateSet(osg::ref_ptr<osg::StateSet> stateset, osg::Node& node)
     {
         osg::StateSet* writableStateSet = nullptr;
@@ -639,35 +693,37 @@ namespace Shader
         if (!previousAddedState)
             previousAddedState = new AddedState;
 
-        ShaderManager::DefineMap defineMap;
-        for (unsigned int i = 0; i < sizeof(defaultTextures) / sizeof(defaultTextures[0]); ++i)
+        const DefineAtoms& atoms = getDefineAtoms();
+        DefineSet& defines = mDefines;
+        defines.clear();
+        for (const auto& [name, coordinates] : atoms.mTextures)
         {
-            defineMap[defaultTextures[i]] = "0";
-            defineMap[std::string(defaultTextures[i]) + std::string("UV")] = "0";
+            defines.set(name, atoms.mZero);
+            defines.set(coordinates, atoms.mZero);
         }
-        for (std::map<int, std::string>::const_iterator texIt = reqs.mTextures.begin(); texIt != reqs.mTextures.end();
-             ++texIt)
+        for (const auto& [unit, name] : reqs.mTextures)
         {
-            defineMap[texIt->second] = "1";
-            defineMap[texIt->second + std::string("UV")] = std::to_string(texIt->first);
+            const DefineAtom texture(name);
+            defines.set(texture, atoms.mOne);
+            defines.set(atoms.getTextureCoordinates(texture), toDefineAtom(unit));
         }
 
-        if (defineMap["diffuseMap"] == "0")
+        if (defines.get(atoms.mDiffuseMap) == atoms.mZero)
         {
             writableStateSet->addUniform(new osg::Uniform("useDiffuseMapForShadowAlpha", false));
             addedState->addUniform("useDiffuseMapForShadowAlpha");
         }
 
-        defineMap["diffuseParallax"] = reqs.mDiffuseHeight ? "1" : "0";
-        defineMap["parallax"] = reqs.mNormalHeight ? "1" : "0";
-        defineMap["reconstructNormalZ"] = reqs.mReconstructNormalZ ? "1" : "0";
+        defines.set(atoms.mDiffuseParallax, atoms.get(reqs.mDiffuseHeight));
+        defines.set(atoms.mParallax, atoms.get(reqs.mNormalHeight));
+        defines.set(atoms.mReconstructNormalZ, atoms.get(reqs.mReconstructNormalZ));
 
         writableStateSet->addUniform(new osg::Uniform("colorMode", reqs.mColorMode));
         addedState->addUniform("colorMode");
 
-        defineMap["alphaFunc"] = std::to_string(reqs.mAlphaFunc);
+        defines.set(atoms.mAlphaFunc, toDefineAtom(static_cast<int>(reqs.mAlphaFunc)));
 
-        defineMap["additiveBlending"] = reqs.mAdditiveBlending ? "1" : "0";
+        defines.set(atoms.mAdditiveBlending, atoms.get(reqs.mAdditiveBlending));
 
         osg::ref_ptr<osg::StateSet> removedState;
         if ((removedState = getRemovedState(*writableStateSet)) && !mAllowedToModifyStateSets)
@@ -675,8 +731,8 @@ namespace Shader
         if (!removedState)
             removedState = new osg::StateSet();
 
-        defineMap["alphaToCoverage"] = "0";
-        defineMap["adjustCoverage"] = "0";
+        defines.set(atoms.mAlphaToCoverage, atoms.mZero);
+        defines.set(atoms.mAdjustCoverage, atoms.mZero);
         if (reqs.mAlphaFunc != osg::AlphaFunc::ALWAYS)
         {
             writableStateSet->addUniform(new osg::Uniform("alphaRef", reqs.mAlphaRef));
@@ -699,37 +755,37 @@ namespace Shader
             {
                 writableStateSet->setMode(GL_SAMPLE_ALPHA_TO_COVERAGE_ARB, osg::StateAttribute::ON);
                 addedState->setMode(GL_SAMPLE_ALPHA_TO_COVERAGE_ARB);
-                defineMap["alphaToCoverage"] = "1";
+                defines.set(atoms.mAlphaToCoverage, atoms.mOne);
             }
 
             // Adjusting coverage isn't safe with blending on as blending requires the alpha to be intact.
             // Maybe we could also somehow (e.g. userdata) detect when the diffuse map has coverage-preserving mip maps
             // in the future
             if (mAdjustCoverageForAlphaTest && !reqs.mAlphaBlend)
-                defineMap["adjustCoverage"] = "1";
+                defines.set(atoms.mAdjustCoverage, atoms.mOne);
 
             // Preventing alpha tested stuff shrinking as lower mip levels are used requires knowing the texture size
             if (SceneUtil::getGLExtensions().isGpuShader4Supported)
-                defineMap["useGPUShader4"] = "1";
+                defines.set(atoms.mUseGPUShader4, atoms.mOne);
             // We could fall back to a texture size uniform if EXT_gpu_shader4 is missing
         }
 
         bool simpleLighting = false;
         node.getUserValue("simpleLighting", simpleLighting);
         if (simpleLighting)
-            defineMap["endLight"] = "0";
+            defines.set(atoms.mEndLight, atoms.mZero);
 
         if (simpleLighting || dynamic_cast<osgParticle::ParticleSystem*>(&node))
-            defineMap["forcePPL"] = "0";
+            defines.set(atoms.mForcePPL, atoms.mZero);
 
         bool particleOcclusion = false;
         node.getUserValue("particleOcclusion", particleOcclusion);
-        defineMap["particleOcclusion"] = particleOcclusion && mWeatherParticleOcclusion ? "1" : "0";
+        defines.set(atoms.mParticleOcclusion, atoms.get(particleOcclusion && mWeatherParticleOcclusion));
 
         if (reqs.mAlphaBlend && mSupportsNormalsRT)
         {
             if (reqs.mSoftParticles)
-                defineMap["disableNormals"] = "1";
+                defines.set(atoms.mDisableNormals, atoms.mOne);
             auto colorMask = new osg::ColorMaski(1, false, false, false, false);
             writableStateSet->setAttribute(colorMask);
             addedState->setAttribute(colorMask);
@@ -762,15 +818,15 @@ namespace Shader
             updateRemovedState(*writableUserData, removedState);
         }
 
-        defineMap["softParticles"] = reqs.mSoftParticles ? "1" : "0";
+        defines.set(atoms.mSoftParticles, atoms.get(reqs.mSoftParticles));
 
-        Stereo::shaderStereoDefines(defineMap);
+        Stereo::shaderStereoDefines(defines);
 
         std::string shaderPrefix;
         if (!node.getUserValue("shaderPrefix", shaderPrefix))
             shaderPrefix = mDefaultShaderPrefix;
 
-        auto program = mShaderManager.getProgram(shaderPrefix, defineMap, mProgramTemplate);
+        auto program = mShaderManager.getProgram(shaderPrefix, defines, mProgramTemplate);
         writableStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
         addedState->setAttributeAndModes(std::move(program));
 
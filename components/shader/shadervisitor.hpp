@@ -4,6 +4,8 @@
 #include <osg/NodeVisitor>
 #include <osg/Program>
 
+#include "defineset.hpp"
+
 namespace Resource
 {
     class ImageManager;
@@ -124,6 +126,9 @@ namespace Shader
 
         std::string mDefaultShaderPrefix;
 
+        // Reused by createProgram to avoid allocations
+        DefineSet mDefines;
+
         void createProgram(const ShaderRequirements& reqs);
         void ensureFFP(osg::Node& node);
         bool adjustGeometry(osg::Geometry& sourceGeometry, const ShaderRequirements& reqs);
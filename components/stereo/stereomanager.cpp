@@ -164,6 +164,22 @@ namespace Stereo
         }
     }
 
+    void shaderStereoDefines(Shader::DefineSet& defines)
+    {
+        static const Shader::DefineAtom useMultiview("useOVR_multiview");
+        static const Shader::DefineAtom numViews("numViews");
+        if (getMultiview())
+        {
+            defines.set(useMultiview, Shader::DefineAtom("1"));
+            defines.set(numViews, Shader::DefineAtom("2"));
+        }
+        else
+        {
+            defines.set(useMultiview, Shader::DefineAtom("0"));
+            defines.set(numViews, Shader::DefineAtom("1"));
+        }
+    }
+
     void Manager::overrideEyeResolution(const osg::Vec2i& eyeResolution)
     {
         mEyeResolutionOverride = eyeResolution;
@@ -41,6 +41,7 @@ namespace Stereo
 
     //! Sets up any definitions necessary for stereo rendering
     void shaderStereoDefines(Shader::ShaderManager::DefineMap& defines);
+    void shaderStereoDefines(Shader::DefineSet& defines);
 
     //! Class that provides tools for managing stereo mode
     class Manager